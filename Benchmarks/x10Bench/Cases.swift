@@ -0,0 +1,318 @@
+import Foundation
+import x10Core
+import x10Runtime
+import x10Diagnostics
+import x10InteropDLPack
+import x10BackendsIREE
+import x10BackendsPJRT
+
+enum BenchCases {
+  static func all() -> [BenchCase] {
+    var cases: [BenchCase] = [
+      makeCacheKeyCase(),
+      textualCase(),
+      cacheContentionCase(tasks: 1),
+      cacheContentionCase(tasks: 8),
+    ]
+    for bytes in [4 << 10, 1 << 20, 16 << 20] {
+      cases.append(dlpackCase(bytes: bytes))
+    }
+    for tasks in [1, 8] {
+      cases.append(dlpackChurnCase(tasks: tasks))
+    }
+    for elements in [1 << 10, 1 << 16, 1 << 20] {
+      cases.append(ireeRuntimeInvokeCase(elements: elements))
+    }
+    for elements in [16, 1 << 10] {
+      cases.append(ireeCLICase(elements: elements))
+    }
+    for dtype in [DType.f16, .bf16] {
+      cases.append(narrowCase(dtype: dtype, elements: 1 << 20))
+    }
+    for dtype in [DType.f8E4M3FN, .f8E5M2] {
+      cases.append(quantizeCase(dtype: dtype, elements: 1 << 20))
+    }
+    // The shim's copy engine against single-threaded memcpy (16 MiB memcpy is below).
+    cases.append(memcpyCase(bytes: 256 << 20))
+    for bytes in [16 << 20, 256 << 20] {
+      cases.append(hostCopyCase(bytes: bytes))
+    }
+    // All-reduce bandwidth next to plain memcpy of the same payload.
+    for bytes in [64 << 10, 16 << 20] {
+      cases.append(memcpyCase(bytes: bytes))
+      for algorithm in [CollectiveAlgorithm.ring, .tree] {
+        cases.append(allReduceCase(ranks: 4, bytes: bytes, algorithm: algorithm))
+      }
+    }
+    cases.append(endToEndCase(backend: PJRTBackend(), label: "pjrt-stub"))
+    cases.append(ireeEndToEndCase())
+    return cases
+  }
+
+  // MARK: - Fixtures
+
+  /// Source and destination blocks for copy cases, freed when the timed body
+  /// (which captures them) is dropped after the case runs.
+  final class CopyBuffers: @unchecked Sendable {
+    let src: UnsafeMutableRawPointer
+    let dst: UnsafeMutableRawPointer
+
+    init(bytes: Int) {
+      src = .allocate(byteCount: bytes, alignment: 64)
+      dst = .allocate(byteCount: bytes, alignment: 64)
+      src.initializeMemory(as: UInt8.self, repeating: 1, count: bytes)
+    }
+
+    deinit {
+      src.deallocate()
+      dst.deallocate()
+    }
+  }
+
+  /// Typed output block for conversion cases, freed like `CopyBuffers`.
+  final class Scratch<T>: @unchecked Sendable {
+    let pointer: UnsafeMutablePointer<T>
+
+    init(count: Int) { pointer = .allocate(capacity: count) }
+
+    deinit { pointer.deallocate() }
+  }
+
+  /// r = a + b on f32[n]; `name` keeps modules distinct in the cache.
+  static func addModule(elements n: Int, name: String = "main") -> StableHLOModule {
+    let builder = IRBuilder()
+    let fn = builder.function(
+      name: name,
+      args: [("a", [n], .f32), ("b", [n], .f32)],
+      results: [("r", [n], .f32)]
+    ) { f in
+      let a = f.args[0], b = f.args[1], r = f.results[0]
+      f.parameter(0, into: a)
+      f.parameter(1, into: b)
+      f.add(a, b, into: r)
+      f.returnValues([r])
+    }
+    return StableHLOModule(functions: [fn])
+  }
+
+  static func requireIREECompiler() throws {
+    guard IREECompileCLI.find() != nil else {
+      throw BenchSkip(reason: "iree-compile not found (set X10_IREE_PREFIX / X10_IREE_BIN)")
+    }
+  }
+
+  static func inputs(_ backend: IREEBackend, elements n: Int) throws -> [Buffer] {
+    let values = [Float](repeating: 1.5, count: n)
+    return try values.withUnsafeBytes { raw in
+      [
+        try backend.toDevice(raw, shape: [n], dtype: .f32, on: .init(ordinal: 0)),
+        try backend.toDevice(raw, shape: [n], dtype: .f32, on: .init(ordinal: 0)),
+      ]
+    }
+  }
+
+  // MARK: - Micro
+
+  static func makeCacheKeyCase() -> BenchCase {
+    BenchCase(name: "micro.makeCacheKey", kind: .micro, ops: 1) {
+      let module = addModule(elements: 128)
+      return {
+        _ = makeCacheKey(
+          module: module, backendKey: "bench", deviceKey: "cpu:0", versionSalt: "bench:dev",
+          concreteShape: [128], bucketing: .default,
+          extraComponents: ["precision=a:f32,m:f32,acc:f32", "flags="])
+      }
+    }
+  }
+
+  static func textualCase() -> BenchCase {
+    BenchCase(name: "micro.StableHLOModule.textual", kind: .micro, ops: 1) {
+      let module = addModule(elements: 1024)
+      return { _ = module.textual() }
+    }
+  }
+
+  /// get/put mix from `tasks` concurrent tasks on a private cache.
+  static func cacheContentionCase(tasks: Int) -> BenchCase {
+    let opsPerTask = 256
+    return BenchCase(name: "micro.ExecutableCache.getput.tasks\(tasks)", kind: .micro, ops: tasks * opsPerTask) {
+      let cache = ExecutableCache(policy: CachePolicy(maxEntries: 64, maxBytes: 1 << 30))
+      let keys = (0..<128).map { ShapeKey(fingerprint: "k\($0)", versionSalt: "bench") }
+      return {
+        await withTaskGroup(of: Void.self) { group in
+          for t in 0..<tasks {
+            group.addTask {
+              for i in 0..<opsPerTask {
+                let key = keys[(t &* 31 &+ i) % keys.count]
+                if await cache.get(key) == nil {
+                  await cache.put(Executable(), for: key)
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  static func dlpackCase(bytes: Int) -> BenchCase {
+    BenchCase(name: "micro.DLPack.wrapCopy.\(bytes >> 10)KiB", kind: .micro, ops: 1) {
+      guard DLPack.isAvailable else { throw BenchSkip(reason: "DLPack shim not compiled in") }
+      let host = [UInt8](repeating: 7, count: bytes)
+      let count = bytes / MemoryLayout<Float>.stride
+      return {
+        let cap = try host.withUnsafeBytes {
+          try DLPackHost.wrapHostCopy(bytes: $0, shape: [count], dtype: .f32, device: .cpu(0))
+        }
+        defer { DLPack.dispose(cap) }
+        _ = try DLPackHost.toHostData(cap)
+      }
+    }
+  }
+
+  /// Wrap + view + retain/dispose of tiny capsules from `tasks` concurrent
+  /// tasks: allocator and refcount traffic, not copying.
+  static func dlpackChurnCase(tasks: Int) -> BenchCase {
+    let opsPerTask = 1024
+    return BenchCase(name: "micro.DLPack.capsuleChurn.tasks\(tasks)", kind: .micro, ops: tasks * opsPerTask) {
+      guard DLPack.isAvailable else { throw BenchSkip(reason: "DLPack shim not compiled in") }
+      // Released with the body once the case has run.
+      let owner = DLPackCapsuleReference(
+        adopting: try DLPack.wrapHostBufferFree(ptr: .allocate(byteCount: 64, alignment: 64), shape: [16], dtype: .f32))
+      return {
+        let shared = owner.capsule
+        try await withThrowingTaskGroup(of: Void.self) { group in
+          for _ in 0..<tasks {
+            group.addTask {
+              for _ in 0..<opsPerTask {
+                let mine = try DLPack.wrapHostBufferFree(ptr: .allocate(byteCount: 64, alignment: 64),
+                                                         shape: [4, 4], dtype: .f32)
+                let view = try DLPack.slice(DLPack.retain(shared), axis: 0, 0..<8)
+                DLPack.dispose(view)
+                DLPack.dispose(shared)
+                DLPack.dispose(mine)
+              }
+            }
+          }
+          try await group.waitForAll()
+        }
+      }
+    }
+  }
+
+  /// f32 -> half narrowing, the host-side cost of `PrecisionPolicy.castInputs`.
+  static func narrowCase(dtype: DType, elements: Int) -> BenchCase {
+    BenchCase(name: "micro.HalfPrecision.narrow.\(dtype).\(elements)", kind: .micro, ops: 1, bytes: elements * 4) {
+      let src = (0..<elements).map { Float($0) * 0.001 }
+      let dst = Scratch<UInt16>(count: elements)
+      return { HalfPrecision.narrow(src, into: dst.pointer, count: elements, as: dtype) }
+    }
+  }
+
+  /// f32 -> FP8 with a per-tensor scale (absmax pass + quantize pass).
+  static func quantizeCase(dtype: DType, elements: Int) -> BenchCase {
+    BenchCase(name: "micro.FP8.quantize.\(dtype).\(elements)", kind: .micro, ops: 1, bytes: elements * 4) {
+      let src = (0..<elements).map { Float($0) * 0.001 - 500 }
+      let dst = Scratch<UInt8>(count: elements)
+      return {
+        src.withUnsafeBufferPointer { values in
+          FP8.quantize(values.baseAddress!, into: dst.pointer, count: elements, as: dtype,
+                       scale: FP8.scale(for: values, as: dtype))
+        }
+      }
+    }
+  }
+
+  static func hostCopyCase(bytes: Int) -> BenchCase {
+    BenchCase(name: "micro.DLPack.copyBytes.\(bytes >> 10)KiB", kind: .micro, ops: 1, bytes: bytes) {
+      guard DLPack.isAvailable else { throw BenchSkip(reason: "DLPack shim not compiled in") }
+      let buffers = CopyBuffers(bytes: bytes)
+      return { DLPackHost.copyBytes(from: buffers.src, to: buffers.dst, count: bytes) }
+    }
+  }
+
+  static func memcpyCase(bytes: Int) -> BenchCase {
+    BenchCase(name: "micro.memcpy.\(bytes >> 10)KiB", kind: .micro, ops: 1, bytes: bytes) {
+      let buffers = CopyBuffers(bytes: bytes)
+      return { buffers.dst.copyMemory(from: buffers.src, byteCount: bytes) }
+    }
+  }
+
+  /// `ranks` concurrent participants each all-reducing `bytes` of f32.
+  static func allReduceCase(ranks: Int, bytes: Int, algorithm: CollectiveAlgorithm) -> BenchCase {
+    let name = "macro.Collectives.allReduce.\(algorithm.rawValue).\(ranks)x\(bytes >> 10)KiB"
+    return BenchCase(name: name, kind: .macro, ops: 1, bytes: bytes) {
+      let groups = CollectiveGroup.make(members: (0..<ranks).map { "bench:\($0)" },
+                                        config: CollectiveConfig(algorithm: algorithm))
+      let payload = [Float](repeating: 1, count: bytes / 4).withUnsafeBytes { Data($0) }
+      return {
+        try await withThrowingTaskGroup(of: Void.self) { tasks in
+          for g in groups {
+            tasks.addTask { _ = try await g.allReduce(payload, dtype: .f32, op: .sum) }
+          }
+          try await tasks.waitForAll()
+        }
+      }
+    }
+  }
+
+  // MARK: - Macro (backend-dependent)
+
+  static func ireeRuntimeInvokeCase(elements n: Int) -> BenchCase {
+    BenchCase(name: "macro.IREEVM.invoke.f32x\(n)", kind: .macro, ops: 1) {
+      try requireIREECompiler()
+      guard IREEBackend.isRuntimeAvailable else {
+        throw BenchSkip(reason: "IREE runtime shim not loadable (set X10_IREE_RUNTIME_LIB)")
+      }
+      let backend = IREEBackend()
+      let exec = try backend.compile(
+        stablehlo: addModule(elements: n),
+        options: CompileOptions(device: .cpu(0), flags: ["iree_runtime": "1"]))
+      let args = try inputs(backend, elements: n)
+      return { _ = try await backend.execute(exec, inputs: args, stream: nil) }
+    }
+  }
+
+  static func ireeCLICase(elements n: Int) -> BenchCase {
+    BenchCase(name: "macro.IREE.cliFallback.f32x\(n)", kind: .macro, ops: 1) {
+      try requireIREECompiler()
+      guard IREEExecuteCLI.find() != nil else {
+        throw BenchSkip(reason: "iree-run-module not found (set X10_IREE_RUN_BIN)")
+      }
+      let backend = IREEBackend()
+      // The CLI path even if X10_IREE_RUNTIME is set for this run.
+      let exec = try backend.compile(stablehlo: addModule(elements: n),
+                                     options: CompileOptions(device: .cpu(0), flags: ["iree_cli": "1"]))
+      let args = try inputs(backend, elements: n)
+      return { _ = try await backend.execute(exec, inputs: args, stream: nil) }
+    }
+  }
+
+  /// compileCached (cache hit after warmup) + execute through the JIT.
+  static func endToEndCase<B: Backend>(backend: B, label: String) -> BenchCase {
+    BenchCase(name: "macro.e2e.compileCached+execute.\(label)", kind: .macro, ops: 1) {
+      let module = addModule(elements: 256, name: "bench_e2e")
+      let options = CompileOptions(device: .cpu(0))
+      let device = try backend.devices().first
+      let values = [Float](repeating: 1, count: 256)
+      return {
+        let exec = try await JIT.compileCached(module, with: backend, options: options)
+        guard let device else { return }
+        let args = try values.withUnsafeBytes { raw in
+          [try backend.toDevice(raw, shape: [256], dtype: .f32, on: device),
+           try backend.toDevice(raw, shape: [256], dtype: .f32, on: device)]
+        }
+        let outs = try await backend.execute(exec, inputs: args, stream: nil)
+        _ = try outs.first.map { try backend.fromDevice($0) }
+      }
+    }
+  }
+
+  static func ireeEndToEndCase() -> BenchCase {
+    let inner = endToEndCase(backend: IREEBackend(), label: "iree")
+    return BenchCase(name: inner.name, kind: inner.kind, ops: inner.ops) {
+      try requireIREECompiler()
+      return try await inner.make()
+    }
+  }
+}
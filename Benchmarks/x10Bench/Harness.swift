@@ -0,0 +1,195 @@
+import Foundation
+import x10Diagnostics
+
+/// Signals that a case cannot run here (e.g. IREE tools missing).
+struct BenchSkip: Error {
+  let reason: String
+}
+
+enum BenchKind: String, Codable {
+  case micro
+  case macro
+}
+
+/// One benchmark. `make` does the setup and returns the timed body; the
+/// body runs `ops` operations per call and the harness reports ns/op.
+/// Cases that move data set `bytes` (per op) to also get GB/s.
+struct BenchCase {
+  let name: String
+  let kind: BenchKind
+  let ops: Int
+  var bytes: Int? = nil
+  let make: () async throws -> () async throws -> Void
+}
+
+struct BenchStats: Codable, Equatable {
+  var mean: Double
+  var stddev: Double
+  var min: Double
+  var p50: Double
+  var p90: Double
+  var p99: Double
+  var max: Double
+
+  init(_ samples: [Double]) {
+    let sorted = samples.sorted()
+    let n = Double(sorted.count)
+    mean = sorted.reduce(0, +) / n
+    let m = mean
+    stddev = sorted.count > 1 ? (sorted.reduce(0) { $0 + ($1 - m) * ($1 - m) } / (n - 1)).squareRoot() : 0
+    min = sorted.first ?? 0
+    max = sorted.last ?? 0
+    func pct(_ q: Double) -> Double { sorted[Swift.min(sorted.count - 1, Int((q * (n - 1)).rounded()))] }
+    p50 = pct(0.5)
+    p90 = pct(0.9)
+    p99 = pct(0.99)
+  }
+}
+
+struct BenchResult: Codable {
+  var name: String
+  var kind: BenchKind
+  var unit: String
+  var status: String          // "ok" | "skipped" | "failed"
+  var note: String?
+  var samples: Int
+  var stats: BenchStats?
+  var bytesPerOp: Int?
+}
+
+struct BenchReport: Codable {
+  var schema: Int
+  var timestamp: String
+  var host: [String: String]
+  var results: [BenchResult]
+}
+
+struct BenchConfig {
+  var filter: String?
+  var samples = 20
+  var minSampleNanos: UInt64 = 5_000_000
+  var warmup = 2
+}
+
+enum BenchRunner {
+  static func run(_ cases: [BenchCase], config: BenchConfig) async -> BenchReport {
+    var results: [BenchResult] = []
+    for bench in cases where config.filter.map({ bench.name.contains($0) }) ?? true {
+      let result = await run(bench, config: config)
+      results.append(result)
+      print(line(for: result))
+    }
+    return BenchReport(
+      schema: 1,
+      timestamp: ISO8601DateFormatter().string(from: Date()),
+      host: hostInfo(),
+      results: results)
+  }
+
+  private static func run(_ bench: BenchCase, config: BenchConfig) async -> BenchResult {
+    var result = BenchResult(name: bench.name, kind: bench.kind, unit: "ns/op", status: "ok", note: nil, samples: 0,
+                             stats: nil, bytesPerOp: bench.bytes)
+    do {
+      let body = try await bench.make()
+      for _ in 0..<config.warmup { try await body() }
+
+      // Micro cases repeat the body until a sample is long enough to time
+      // reliably; macro cases time single calls.
+      var repeats = 1
+      if bench.kind == .micro {
+        let t0 = Metrics.nowNanos()
+        try await body()
+        let once = max(1, Metrics.nowNanos() - t0)
+        repeats = max(1, Int(config.minSampleNanos / once))
+      }
+
+      var samples: [Double] = []
+      samples.reserveCapacity(config.samples)
+      for _ in 0..<config.samples {
+        let start = Metrics.nowNanos()
+        for _ in 0..<repeats { try await body() }
+        let elapsed = Double(Metrics.nowNanos() - start)
+        samples.append(elapsed / Double(repeats * bench.ops))
+      }
+      result.samples = samples.count
+      result.stats = BenchStats(samples)
+    } catch let skip as BenchSkip {
+      result.status = "skipped"
+      result.note = skip.reason
+    } catch {
+      result.status = "failed"
+      result.note = "\(error)"
+    }
+    return result
+  }
+
+  static func line(for r: BenchResult) -> String {
+    let name = r.name.padding(toLength: 44, withPad: " ", startingAt: 0)
+    guard let s = r.stats else { return "\(name) \(r.status): \(r.note ?? "")" }
+    let rate = r.bytesPerOp.map { String(format: "  %.2f GB/s", Double($0) / s.p50) } ?? ""
+    return "\(name) p50 \(format(s.p50))  mean \(format(s.mean)) ±\(format(s.stddev))  p99 \(format(s.p99))\(rate)"
+  }
+
+  static func format(_ ns: Double) -> String {
+    switch ns {
+    case ..<1_000: return String(format: "%.1fns", ns)
+    case ..<1_000_000: return String(format: "%.2fus", ns / 1_000)
+    case ..<1_000_000_000: return String(format: "%.2fms", ns / 1_000_000)
+    default: return String(format: "%.2fs", ns / 1_000_000_000)
+    }
+  }
+
+  private static func hostInfo() -> [String: String] {
+    let info = ProcessInfo.processInfo
+    var host = [
+      "os": info.operatingSystemVersionString,
+      "cpus": "\(info.activeProcessorCount)",
+      "memory": "\(info.physicalMemory)",
+    ]
+    #if DEBUG
+    host["build"] = "debug"
+    #else
+    host["build"] = "release"
+    #endif
+    return host
+  }
+}
+
+// MARK: - Regression comparison
+
+struct BenchComparison {
+  struct Row {
+    let name: String
+    let baseline: Double
+    let current: Double
+    var ratio: Double { current / baseline }
+    let regressed: Bool
+  }
+
+  let rows: [Row]
+  var regressions: [Row] { rows.filter(\.regressed) }
+
+  /// A case regresses when its median is more than `threshold` slower than
+  /// the baseline and the gap exceeds both runs' noise (2σ).
+  static func compare(current: BenchReport, baseline: BenchReport, threshold: Double) -> BenchComparison {
+    let base = Dictionary(baseline.results.map { ($0.name, $0) }, uniquingKeysWith: { a, _ in a })
+    var rows: [Row] = []
+    for r in current.results {
+      guard let now = r.stats, let before = base[r.name]?.stats, before.p50 > 0 else { continue }
+      let noise = 2 * max(now.stddev, before.stddev)
+      let regressed = now.p50 > before.p50 * (1 + threshold) && now.p50 - before.p50 > noise
+      rows.append(Row(name: r.name, baseline: before.p50, current: now.p50, regressed: regressed))
+    }
+    return BenchComparison(rows: rows)
+  }
+
+  func printTable() {
+    print("\n== compare (p50, ns/op) ==")
+    for row in rows {
+      let name = row.name.padding(toLength: 44, withPad: " ", startingAt: 0)
+      let flag = row.regressed ? "  REGRESSION" : ""
+      print("\(name) \(BenchRunner.format(row.baseline)) -> \(BenchRunner.format(row.current))  " +
+            String(format: "x%.2f", row.ratio) + flag)
+    }
+  }
+}
@@ -0,0 +1,72 @@
+import Foundation
+
+/// x10Bench — micro/macro benchmarks for the runtime and backends.
+///
+///   swift run -c release x10Bench [--filter S] [--samples N] [--out FILE]
+///                                 [--compare BASELINE.json] [--threshold 0.10] [--list]
+///
+/// Results are printed and, with --out, written as JSON. --compare flags
+/// cases whose median regressed past the threshold and exits non-zero.
+@main
+struct X10Bench {
+  static func main() async {
+    var config = BenchConfig()
+    var outPath: String?
+    var baselinePath: String?
+    var threshold = 0.10
+    var listOnly = false
+
+    var args = CommandLine.arguments.dropFirst().makeIterator()
+    while let arg = args.next() {
+      switch arg {
+      case "--filter": config.filter = args.next()
+      case "--samples": config.samples = max(2, args.next().flatMap(Int.init) ?? config.samples)
+      case "--out": outPath = args.next()
+      case "--compare": baselinePath = args.next()
+      case "--threshold": threshold = args.next().flatMap(Double.init) ?? threshold
+      case "--list": listOnly = true
+      default:
+        FileHandle.standardError.write(Data("unknown argument: \(arg)\n".utf8))
+        exit(2)
+      }
+    }
+
+    let cases = BenchCases.all()
+    if listOnly {
+      for c in cases { print("\(c.kind.rawValue)\t\(c.name)") }
+      return
+    }
+
+    let report = await BenchRunner.run(cases, config: config)
+
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+    if let outPath {
+      do {
+        try encoder.encode(report).write(to: URL(fileURLWithPath: outPath), options: .atomic)
+        print("wrote \(outPath)")
+      } catch {
+        FileHandle.standardError.write(Data("failed to write \(outPath): \(error)\n".utf8))
+        exit(1)
+      }
+    }
+
+    if let baselinePath {
+      do {
+        let data = try Data(contentsOf: URL(fileURLWithPath: baselinePath))
+        let baseline = try JSONDecoder().decode(BenchReport.self, from: data)
+        let comparison = BenchComparison.compare(current: report, baseline: baseline, threshold: threshold)
+        comparison.printTable()
+        if !comparison.regressions.isEmpty {
+          print("\(comparison.regressions.count) regression(s) beyond \(Int(threshold * 100))%")
+          exit(1)
+        }
+      } catch {
+        FileHandle.standardError.write(Data("failed to read baseline \(baselinePath): \(error)\n".utf8))
+        exit(1)
+      }
+    }
+
+    if report.results.contains(where: { $0.status == "failed" }) { exit(1) }
+  }
+}
@@ -18,6 +18,8 @@ let package = Package(
     .library(name: "x10AdaptersTFEager", targets: ["x10AdaptersTFEager"]),
     .executable(name: "x10ExampleBasics", targets: ["x10ExampleBasics"]),
     .executable(name: "x10ExampleIREEAdd", targets: ["x10ExampleIREEAdd"]),
+    .executable(name: "x10Bench", targets: ["x10Bench"]),
+    .executable(name: "x10Bundle", targets: ["x10Bundle"]),
 
   ],
   dependencies: [
@@ -60,13 +62,21 @@ let package = Package(
       path: "Sources/x10InteropDLPack"
     ),
 
+    // SIMD host kernels (f32 <-> f16/bf16), dispatched on the running CPU
+    .target(
+      name: "x10KernelsC",
+      path: "Sources/x10KernelsC",
+      sources: ["x10_half.c", "x10_fp8.c"],
+      publicHeadersPath: "include"
+    ),
+
     .target(
       name: "x10Runtime",
-      dependencies: ["x10Core", "x10Diagnostics"],
+      dependencies: ["x10Core", "x10Diagnostics", "x10KernelsC"],
       path: "Sources/x10Runtime"),
     .target(
       name: "x10BackendsPJRT",
-      dependencies: ["x10Core", "x10Runtime", "PJRTC", "x10InteropDLPack"],
+      dependencies: ["x10Core", "x10Runtime", "x10Diagnostics", "PJRTC", "x10InteropDLPack"],
       path: "Sources/x10Backends/PJRT"
     ),
 
@@ -102,6 +112,7 @@ let package = Package(
       dependencies: [
         "x10Core",
         "x10Runtime",
+        "x10Diagnostics",
         "X10IREEC",
         "x10InteropDLPackC",
         "x10InteropIREEC"
@@ -110,13 +121,21 @@ let package = Package(
 
     .target(
       name: "x10BackendsSelect",
-      dependencies: ["x10Core", "x10Runtime", "x10BackendsPJRT", "x10BackendsIREE"],
+      dependencies: ["x10Core", "x10Runtime", "x10Diagnostics", "x10BackendsPJRT", "x10BackendsIREE"],
       path: "Sources/x10BackendsSelect"
     ),
 
+    // Lock-free metric cells (sharded counters, gauges, histograms) + span tracer
+    .target(
+      name: "x10DiagnosticsC",
+      path: "Sources/x10DiagnosticsC",
+      sources: ["x10_metrics.c", "x10_trace.c"],
+      publicHeadersPath: "include"
+    ),
+
     .target(
       name: "x10Diagnostics",
-      dependencies: ["x10Core"],
+      dependencies: ["x10Core", "x10DiagnosticsC"],
       path: "Sources/x10Diagnostics"),
     
     .target(
@@ -182,6 +201,26 @@ let package = Package(
       path: "Tests/x10InteropDLPackTests"
     ),
 
+    .executableTarget(
+      name: "x10Bench",
+      dependencies: [
+        "x10Core",
+        "x10Runtime",
+        "x10Diagnostics",
+        "x10InteropDLPack",
+        "x10BackendsIREE",
+        "x10BackendsPJRT"
+      ],
+      path: "Benchmarks/x10Bench"
+    ),
+
+    // Offline AOT compiler: modules + shape buckets -> one mmap-able IREE bundle
+    .executableTarget(
+      name: "x10Bundle",
+      dependencies: ["x10Core", "x10Runtime", "x10BackendsIREE"],
+      path: "Tools/x10Bundle"
+    ),
+
     .executableTarget(
       name: "x10ExampleIREEAdd",
       dependencies: [
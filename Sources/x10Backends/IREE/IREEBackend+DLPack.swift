@@ -0,0 +1,39 @@
+import Foundation
+import x10Core
+import x10Runtime
+import x10InteropDLPack
+
+extension IREEBackend {
+  /// Import a host DLPack capsule as a zero-copy alias. The buffer holds its
+  /// own reference, so the caller may dispose `cap` right away; dense inputs
+  /// are read in place by the in-process runtime.
+  public func importDLPack(_ cap: DLPackCapsule) throws -> IREEDeviceBuffer {
+    guard let info = DLPack.basicInfo(cap), info.deviceType == DLPackDeviceType.cpu.rawValue,
+          let shape = DLPack.shape(cap) else {
+      throw NSError(domain: "IREE", code: 7120,
+                    userInfo: [NSLocalizedDescriptionKey: "cannot import DLPack capsule (null or not in host memory)"])
+    }
+    let types: [DType] = [.f16, .bf16, .f32, .f64, .i32, .i64, .f8E4M3FN, .f8E5M2]
+    guard let dtype = types.first(where: { t in
+      dlType(for: t).map { ($0.code, $0.bits) == (info.code, info.bits) } ?? false
+    }), max(info.lanes, 1) == 1 else {
+      throw NSError(domain: "IREE", code: 7120,
+                    userInfo: [NSLocalizedDescriptionKey: "cannot import DLPack capsule (unsupported dtype)"])
+    }
+    return IREEDeviceBuffer(shape: shape, dtype: dtype,
+                            storage: .dlcap(DLPackCapsuleReference(adopting: DLPack.retain(cap))))
+  }
+
+  /// Export an IREE buffer to DLPack: the imported capsule itself when the
+  /// buffer is an alias, otherwise a copy of its host mirror.
+  public func exportDLPack(_ buf: IREEDeviceBuffer) throws -> DLPackCapsule {
+    switch buf.storage {
+    case .dlcap(let ref):
+      return DLPack.retain(ref.capsule)
+    case .host(let mirror):
+      return try mirror.data.withUnsafeBytes { raw in
+        try DLPackHost.wrapHostCopy(bytes: raw, shape: buf.shape, dtype: buf.dtype, device: .cpu(0))
+      }
+    }
+  }
+}
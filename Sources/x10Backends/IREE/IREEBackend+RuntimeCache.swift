@@ -9,17 +9,49 @@ extension IREEBackend {
       return vmfb.count
     }
 
+    ExecutableLifecycle.registerReleaseHandler { exec in
+      IREEExecutableRegistry.shared.release(id: exec.id)
+    }
+
     BackendVersioning.register { backend in
       guard backend is IREEBackend else { return nil }
       return BackendVersionInfo(kind: "iree", version: Self.cliVersionString())
     }
+
+    // Tuned flags change the artifact, so a module tuned after its first
+    // compile gets a new key and is recompiled with them. With nothing tuned
+    // for the target, the module is never printed or hashed.
+    BackendVersioning.registerModuleSalt { backend, options, program in
+      guard let db = (backend as? IREEBackend)?.tuningDB else { return nil }
+      let target = Self.target(options)
+      guard db.hasRecords(target: target),
+            let flags = db.flags(for: IREETuningDB.key(text: program().textual(), target: target))
+      else { return nil }
+      return "tuned=" + flags.joined(separator: " ")
+    }
   }()
 
   static func ensureCacheRegistration() {
     _ = _cacheRegistration
   }
 
-  private static func cliVersionString() -> String {
+  private static let adoptedVersionLock = NSLock()
+  private static var adoptedVersion: String?
+
+  /// Makes `cliVersionString()` report `version` (the compiler a loaded
+  /// bundle was built with) on hosts without iree-compile, so cache keys
+  /// computed here match the ones stored in the bundle.
+  static func adoptCompilerVersion(_ version: String) {
+    guard IREECompileCLI.find() == nil else { return }
+    adoptedVersionLock.lock(); defer { adoptedVersionLock.unlock() }
+    adoptedVersion = version
+  }
+
+  static func cliVersionString() -> String {
+    adoptedVersionLock.lock()
+    let adopted = adoptedVersion
+    adoptedVersionLock.unlock()
+    if let adopted { return adopted }
     struct Holder {
       static let value: String = {
         guard let tool = IREECompileCLI.find()?.url else { return "unavailable" }
@@ -11,12 +11,21 @@ import x10InteropDLPack   // for DLPack copy-out in fromDevice
 public struct IREEBackend: Backend {
   // MARK: - Device model
 
-  public struct Dev: Hashable, Sendable {
+  public struct Dev: Hashable, Sendable, OrdinalDevice {
     public let ordinal: Int
     public init(ordinal: Int) { self.ordinal = ordinal }
   }
 
-  public init() { Self.ensureCacheRegistration() }
+  /// Tuned compile flags for this backend's compiles and cache keys.
+  public let tuningDB: IREETuningDB
+
+  public init(tuningDB: IREETuningDB = .shared) {
+    self.tuningDB = tuningDB
+    Self.ensureCacheRegistration()
+  }
+
+  /// Whether the in-process runtime shim can be loaded (X10_IREE_RUNTIME_LIB).
+  public static var isRuntimeAvailable: Bool { IREEVM.isRuntimeReady() }
 
   public func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
   public func deviceDescription(_ d: Dev) -> String { "cpu:\(d.ordinal) (iree-cli)" }
@@ -25,8 +34,12 @@ public struct IREEBackend: Backend {
 
   @inline(__always) private func _numElements(_ dims: [Int]) -> Int { dims.reduce(1, *) }
 
+  /// Host-mirror storage for `ordinal` comes from its pool in `Memory`.
+  @inline(__always) private func _pool(_ ordinal: Int) -> MemoryPool { Memory.pool(for: "iree:\(ordinal)") }
+
   @inline(__always) private func _byteCount(of dtype: DType) -> Int {
     switch dtype {
+    case .f8E4M3FN, .f8E5M2: return 1
     case .f16, .bf16: return 2
     case .f32, .i32:  return 4
     case .i64, .f64:  return 8
@@ -41,6 +54,8 @@ public struct IREEBackend: Backend {
     case .f64:  return "f64"
     case .i32:  return "i32"
     case .i64:  return "i64"
+    case .f8E4M3FN: return "f8E4M3FN"
+    case .f8E5M2:   return "f8E5M2"
     }
   }
 
@@ -52,6 +67,8 @@ public struct IREEBackend: Backend {
     case "f64": return .f64
     case "i32": return .i32
     case "i64": return .i64
+    case "f8E4M3FN": return .f8E4M3FN
+    case "f8E5M2": return .f8E5M2
     default: return nil
     }
   }
@@ -60,30 +77,61 @@ public struct IREEBackend: Backend {
 
   public func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
     let n = _numElements(shape) * _byteCount(of: dtype)
-    return IREEDeviceBuffer(shape: shape, dtype: dtype, host: Data(count: n))
+    return IREEDeviceBuffer(shape: shape, dtype: dtype, host: _pool(on.ordinal).makeData(byteCount: n))
   }
 
   public func toDevice(_ host: UnsafeRawBufferPointer,
                        shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
     let n = _numElements(shape) * _byteCount(of: dtype)
     let count = min(n, host.count)
-    let data = Data(bytes: host.baseAddress!, count: count)
+    let data = Trace.span("IREE.toDevice", arg: UInt64(count)) {
+      _pool(on.ordinal).makeData(copying: UnsafeRawBufferPointer(rebasing: host.prefix(count)))
+    }
+    Diagnostics.bytesToDevice.inc(UInt64(count))
+    Diagnostics.transferBytes.record(UInt64(count))
     return IREEDeviceBuffer(shape: shape, dtype: dtype, host: data)
   }
 
   public func fromDevice(_ buffer: Buffer) throws -> [UInt8] {
+    let traceStart = Trace.begin()
+    let bytes = try _fromDevice(buffer)
+    Trace.end("IREE.fromDevice", since: traceStart, arg: UInt64(bytes.count))
+    Diagnostics.bytesFromDevice.inc(UInt64(bytes.count))
+    Diagnostics.transferBytes.record(UInt64(bytes.count))
+    return bytes
+  }
+
+  public func fromDevice(_ buffer: Buffer, into destination: UnsafeMutableRawBufferPointer) throws -> Int {
+    guard let b = buffer as? IREEDeviceBuffer, let dst = destination.baseAddress else { return 0 }
+    let traceStart = Trace.begin()
+    var written = 0
+    switch b.storage {
+    case .host(let mirror):
+      let data = mirror.data
+      written = min(data.count, destination.count)
+      if written > 0 { data.withUnsafeBytes { x10_dlpack_copy_bytes(dst, $0.baseAddress, written) } }
+    case .dlcap(let ref):
+      if x10_dlpack_to_host_copy(ref.capsule.raw, dst, destination.count, &written) != 1 { written = 0 }
+    }
+    Trace.end("IREE.fromDevice", since: traceStart, arg: UInt64(written))
+    Diagnostics.bytesFromDevice.inc(UInt64(written))
+    Diagnostics.transferBytes.record(UInt64(written))
+    return written
+  }
+
+  private func _fromDevice(_ buffer: Buffer) throws -> [UInt8] {
     guard let b = buffer as? IREEDeviceBuffer else { return [] }
     switch b.storage {
-    case .host(let data):
-      return Array(data)
+    case .host(let mirror):
+      return Array(mirror.data)
 
-    case .dlcap(let cap):
+    case .dlcap(let ref):
       // Copy out via DLPack shim (alias stays zero-copy internally; copy is for host inspection).
-      var written32: Int32 = 0
-      guard x10_dlpack_to_host_copy(cap.raw, nil, 0, &written32) == 1 else { return [] }
-      var out = Data(count: Int(written32))
+      var written = 0
+      guard x10_dlpack_to_host_copy(ref.capsule.raw, nil, 0, &written) == 1 else { return [] }
+      var out = Data(count: written)
       let _ = out.withUnsafeMutableBytes { mb in
-        x10_dlpack_to_host_copy(cap.raw, mb.baseAddress, mb.count, &written32)
+        x10_dlpack_to_host_copy(ref.capsule.raw, mb.baseAddress, mb.count, &written)
       }
       return Array(out)
     }
@@ -92,10 +140,24 @@ public struct IREEBackend: Backend {
   // MARK: - Compile (StableHLO -> VMFB via IREE CLI)
 
   public func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable {
-    // Backend target: explicit flag → env → default
-    let target: String = options.flags["iree_target"]
-      ?? ProcessInfo.processInfo.environment["X10_IREE_TARGET"]
-      ?? "llvm-cpu" // default to CPU; set env/flag to "metal" or "vulkan-spirv" as desired
+    let target = Self.target(options)
+    // Compile with the flags autotuning found for this module, if any; when
+    // enabled, untuned modules are tuned in the background for later compiles
+    // (by `IREEAutotuner.shared`, so only for backends sharing its DB).
+    let tuned = tuningDB.hasRecords(target: target)
+      ? tuningDB.flags(for: IREETuningDB.key(text: stablehlo.textual(), target: target)) : nil
+    if tuned == nil && IREEAutotuner.isEnabled(options) && tuningDB === IREEAutotuner.shared.db {
+      IREEAutotuner.shared.schedule(stablehlo, target: target)
+    }
+    return try compile(stablehlo: stablehlo, options: options, flags: tuned ?? [], environmentFlags: true)
+  }
+
+  /// Compiles with exactly `flags` on top of the base ones: no tuned flags,
+  /// no autotuning and, unless `environmentFlags`, no X10_IREE_EXTRA_FLAGS.
+  /// `IREEBundleBuilder` uses it so bundles don't inherit host tuning.
+  func compile(stablehlo: StableHLOModule, options: CompileOptions, flags: [String],
+               environmentFlags: Bool) throws -> Executable {
+    let target = Self.target(options)
 
     // StableHLO textual; should be a proper MLIR module with `func.func @main`
     let text = stablehlo.textual()
@@ -107,13 +169,18 @@ public struct IREEBackend: Backend {
                       "iree-compile not available (set X10_IREE_PREFIX / X10_IREE_BIN)"])
     }
 
-    // Compile
-    let vmfb = try IREECompileCLI.compileStableHLO(text, target: target)
+    let vmfb = try Trace.span("IREE.compile") {
+      try IREECompileCLI.compileStableHLO(text, target: target, extraFlags: flags,
+                                          environmentFlags: environmentFlags)
+    }
 
     // Cache artifact for the executable
     let exec = Executable()
-    let preferRuntime = Self.runtimeFlagEnabled(options.flags["iree_runtime"])
-    IREEExecutableRegistry.shared.put(id: exec.id, vmfb: vmfb, defaultDeviceOrdinal: 0, preferRuntime: preferRuntime)
+    let preferRuntime = Self.prefersRuntime(options)
+    let requireCLI = Self.runtimeFlagEnabled(options.flags["iree_cli"])
+    let aliases = stablehlo.functions.first(where: { $0.name == "main" })?.validInputOutputAliases ?? []
+    IREEExecutableRegistry.shared.put(id: exec.id, vmfb: vmfb, defaultDeviceOrdinal: 0,
+                                      preferRuntime: preferRuntime, requireCLI: requireCLI, aliases: aliases)
     return exec
   }
 
@@ -124,16 +191,45 @@ public struct IREEBackend: Backend {
     inputs: [Buffer],
     stream: x10Runtime.Stream?   // <— fully-qualified to avoid Foundation.Stream clash
   ) async throws -> [Buffer] {
-    // Retrieve cached VMFB
-    guard let vmfb = IREEExecutableRegistry.shared.getVMFB(id: exec.id) else {
+    try await execute(exec, inputs: inputs, donating: [], stream: stream)
+  }
+
+  /// Aliased results take over the host mirror of the donated input they
+  /// alias, which is left empty, and are written into it in place. Aliases
+  /// are not passed to the IREE compiler, so this saves a host allocation,
+  /// not a device one (see `IREEDonation`).
+  public func execute(
+    _ exec: Executable,
+    inputs: [Buffer],
+    donating: Set<Int>,
+    stream: x10Runtime.Stream?
+  ) async throws -> [Buffer] {
+    let start = Metrics.nowNanos()
+    let traceStart = Trace.isEnabled ? start : 0
+    defer {
+      Diagnostics.executeLatency.record(Metrics.nowNanos() &- start)
+      Trace.end("IREE.execute", since: traceStart)
+    }
+
+    // Retrieve cached VMFB and pin it so eviction can't free it mid-run.
+    let registry = IREEExecutableRegistry.shared
+    guard let vmfb = registry.acquire(id: exec.id) else {
       throw NSError(domain: "IREE", code: 7101,
                     userInfo: [NSLocalizedDescriptionKey:
                       "VMFB not found for exec \(exec.id). Did you call compile()?"])
     }
+    defer { registry.relinquish(id: exec.id) }
 
+    let ordinal = registry.getDeviceOrdinal(id: exec.id) ?? 0
+    var reuse: [Int: IREEHostStorage] = [:]
+    if !donating.isEmpty {
+      for (output, input) in registry.aliases(id: exec.id).donationPlan(donating: donating) {
+        if let b = inputs[input] as? IREEDeviceBuffer, case .host(let mirror) = b.storage { reuse[output] = mirror }
+      }
+    }
     let env = ProcessInfo.processInfo.environment
-    if env["X10_IREE_DISABLE"] == "1" {
-      return try cliExecute(vmfb: vmfb, inputs: inputs)
+    if env["X10_IREE_DISABLE"] == "1" || registry.requiresCLI(id: exec.id) {
+      return try cliExecute(vmfb: vmfb, inputs: inputs, ordinal: ordinal, reuse: reuse)
     }
 
     let runtimeRequested = Self.runtimeFlagEnabled(env["X10_IREE_RUNTIME"]) ||
@@ -141,7 +237,7 @@ public struct IREEBackend: Backend {
 
     if runtimeRequested {
       do {
-        return try runtimeExecute(vmfb: vmfb, entry: "main", inputs: inputs)
+        return try runtimeExecute(exec: exec, entry: "main", inputs: inputs, ordinal: ordinal, reuse: reuse)
       } catch let error as NSError where error.domain == "IREE" && error.code == 7110 {
         if env["X10_IREE_VERBOSE"] == "1" {
           let message = "[IREE] runtime unavailable (\(error.localizedDescription)); falling back to CLI\n"
@@ -150,10 +246,13 @@ public struct IREEBackend: Backend {
       }
     }
 
-    return try cliExecute(vmfb: vmfb, inputs: inputs)
+    return try cliExecute(vmfb: vmfb, inputs: inputs, ordinal: ordinal, reuse: reuse)
   }
 
-  private func cliExecute(vmfb: Data, inputs: [Buffer]) throws -> [Buffer] {
+  private func cliExecute(vmfb: Data, inputs: [Buffer], ordinal: Int, reuse: [Int: IREEHostStorage] = [:]) throws -> [Buffer] {
+    let traceStart = Trace.begin()
+    defer { Trace.end("IREE.cliExecute", since: traceStart) }
+
     // Ensure runner exists
     guard IREEExecuteCLI.find() != nil else {
       throw NSError(domain: "IREE", code: 7102,
@@ -192,9 +291,13 @@ public struct IREEBackend: Backend {
         case .i64:
           return IREEExecuteCLI.formatInput(shape: shape, dtypeToken: "i64", scalars: scalars(Int64.self))
         case .f16, .bf16:
-          // For CLI input we don't serialize half scalars yet; fill zeros of correct length.
+          let vals = raw.withUnsafeBytes { HalfPrecision.widen($0, from: dtype) }
           return IREEExecuteCLI.formatInput(shape: shape, dtypeToken: _token(for: dtype),
-                                            scalars: Array(repeating: "0", count: _numElements(shape)))
+                                            scalars: vals.map { String(format: "%.9g", $0) })
+        case .f8E4M3FN, .f8E5M2:
+          let vals = raw.withUnsafeBytes { FP8.dequantize($0, from: dtype) }
+          return IREEExecuteCLI.formatInput(shape: shape, dtypeToken: _token(for: dtype),
+                                            scalars: vals.map { String(format: "%.9g", $0) })
         }
       }
     }
@@ -209,23 +312,25 @@ public struct IREEBackend: Backend {
     }
 
     // Pack scalars back into bytes
+    let pool = _pool(ordinal)
+    let store = { (bytes: UnsafeRawBufferPointer) in
+      IREEDonation.write(bytes, into: reuse[0]) ?? pool.makeData(copying: bytes)
+    }
     let outData: Data
     switch outDType {
     case .f32:
-      var arr = res.scalars.map { Float($0) }
-      outData = Data(bytes: &arr, count: arr.count * MemoryLayout<Float>.stride)
+      outData = res.scalars.map { Float($0) }.withUnsafeBytes(store)
     case .f64:
-      var arr = res.scalars.map { Double($0) }
-      outData = Data(bytes: &arr, count: arr.count * MemoryLayout<Double>.stride)
+      outData = res.scalars.map { Double($0) }.withUnsafeBytes(store)
     case .i32:
-      var arr = res.scalars.map { Int32($0) }
-      outData = Data(bytes: &arr, count: arr.count * MemoryLayout<Int32>.stride)
+      outData = res.scalars.map { Int32($0) }.withUnsafeBytes(store)
     case .i64:
-      var arr = res.scalars.map { Int64($0) }
-      outData = Data(bytes: &arr, count: arr.count * MemoryLayout<Int64>.stride)
+      outData = res.scalars.map { Int64($0) }.withUnsafeBytes(store)
     case .f16, .bf16:
-      // CLI path: we don't parse half textual scalars yet—return zeroed bytes with correct size.
-      outData = Data(count: _numElements(res.shape) * 2)
+      // The CLI prints half results as decimals; narrowing them back is exact.
+      outData = HalfPrecision.narrow(res.scalars.map { Float($0) }, to: outDType).withUnsafeBytes(store)
+    case .f8E4M3FN, .f8E5M2:
+      outData = FP8.quantize(res.scalars.map { Float($0) }, to: outDType, scale: 1).data.withUnsafeBytes(store)
     }
 
     let outBuf = IREEDeviceBuffer(shape: res.shape, dtype: outDType, host: outData)
@@ -233,12 +338,33 @@ public struct IREEBackend: Backend {
     return [outBuf]
   }
 
-  public func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
-  public func stream(device: Dev) throws -> x10Runtime.Stream { x10Runtime.Stream() }  // fully-qualified
+  /// In-process all-reduce over the host mirrors of `group`'s members.
+  public func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer {
+    guard group.size > 1, let ib = b as? IREEDeviceBuffer else { return b }
+    let host: Data
+    switch ib.storage {
+    case .host(let mirror): host = mirror.data
+    case .dlcap: host = Data(try _fromDevice(b))
+    }
+    let reduced = try await group.allReduce(host, dtype: ib.dtype, op: op)
+    return IREEDeviceBuffer(shape: ib.shape, dtype: ib.dtype, host: reduced)
+  }
+  public func stream(device: Dev) throws -> x10Runtime.Stream { x10Runtime.Stream(label: "iree:\(device.ordinal)") }  // fully-qualified
   public func event(device: Dev) throws -> x10Runtime.Event { x10Runtime.Event() }     // fully-qualified
 }
 
-private extension IREEBackend {
+extension IREEBackend {
+  /// Backend target: explicit flag → env → "llvm-cpu" (set "metal" or
+  /// "vulkan-spirv" as desired).
+  static func target(_ options: CompileOptions) -> String {
+    options.flags["iree_target"] ?? ProcessInfo.processInfo.environment["X10_IREE_TARGET"] ?? "llvm-cpu"
+  }
+
+  /// `options.flags["iree_runtime"]`, else X10_IREE_RUNTIME.
+  static func prefersRuntime(_ options: CompileOptions) -> Bool {
+    runtimeFlagEnabled(options.flags["iree_runtime"] ?? ProcessInfo.processInfo.environment["X10_IREE_RUNTIME"])
+  }
+
   static func runtimeFlagEnabled(_ value: String?) -> Bool {
     guard let value = value else { return false }
     switch value.lowercased() {
@@ -246,17 +372,24 @@ private extension IREEBackend {
     default: return false
     }
   }
+}
 
-  func runtimeExecute(vmfb: Data, entry: String, inputs: [Buffer]) throws -> [Buffer] {
+private extension IREEBackend {
+  func runtimeExecute(exec: Executable, entry: String, inputs: [Buffer], ordinal: Int,
+                      reuse: [Int: IREEHostStorage]) throws -> [Buffer] {
     guard IREEVM.isRuntimeReady() else {
       throw NSError(domain: "IREE", code: 7110,
                     userInfo: [NSLocalizedDescriptionKey:
                       "IREE runtime shim not available (set X10_IREE_RUNTIME_LIB)"])
     }
 
-    let vm = try IREEVM(vmfb: vmfb)
-    let prepared = try inputs.map { try runtimeInput(from: $0) }
-    let outputs = try vm.invoke(entry: entry, inputs: prepared)
+    // Sessions are cached per executable and released with it on eviction.
+    let vm = try Trace.span("IREE.session") {
+      try IREEExecutableRegistry.shared.session(id: exec.id) { try IREEVM(vmfb: $0) }
+    }
+    var prepared = try Trace.span("IREE.marshalInputs") { try inputs.map { try runtimeInput(from: $0) } }
+    let outputs = try vm.invoke(entry: entry, inputs: &prepared, pool: Memory.pool(for: "iree:\(ordinal)"),
+                                reusing: reuse)
     Diagnostics.executeCallsIreeRuntime.inc()
     return outputs.map { IREEDeviceBuffer(shape: $0.shape, dtype: $0.dtype, host: $0.data) }
   }
@@ -269,11 +402,16 @@ private extension IREEBackend {
 
     let data: Data
     switch ib.storage {
-    case .host(let hostData):
-      data = hostData
-    case .dlcap:
-      let raw = try fromDevice(buffer)
-      data = Data(raw)
+    case .host(let mirror):
+      data = mirror.data
+    case .dlcap(let ref):
+      if DLPack.isContiguous(ref.capsule), let ptr = DLPack.dataPointer(ref.capsule) {
+        // Dense imports (e.g. mapped weights) are read in place; the Data keeps the capsule alive.
+        let count = ib.shape.reduce(1, *) * _byteCount(of: ib.dtype)
+        data = Data(bytesNoCopy: ptr, count: count, deallocator: .custom { _, _ in withExtendedLifetime(ref) {} })
+      } else {
+        data = Data(try fromDevice(buffer))
+      }
     }
 
     return IREEVM.TensorInput(shape: ib.shape, dtype: ib.dtype, data: data)
@@ -1,6 +1,7 @@
 import Foundation
 import x10Core
 import x10Runtime
+import x10Diagnostics
 import x10InteropDLPack
 
 /// Backend-specific device buffer for IREE backend.
@@ -10,8 +11,8 @@ public struct IREEDeviceBuffer: Buffer, Sendable {
   public let dtype: DType
 
   enum Storage: @unchecked Sendable {
-    case host(Data)                 // host mirror
-    case dlcap(DLPackCapsule)       // zero-copy alias via DLPack (future in-process path)
+    case host(IREEHostStorage)      // host mirror
+    case dlcap(DLPackCapsuleReference) // zero-copy alias via DLPack (imported host tensors)
   }
   let storage: Storage
 
@@ -24,25 +25,26 @@ public struct IREEDeviceBuffer: Buffer, Sendable {
 
   // Convenience for host data.
   init(shape: [Int], dtype: DType, host: Data) {
-    self.init(shape: shape, dtype: dtype, storage: .host(host))
+    self.init(shape: shape, dtype: dtype, storage: .host(IREEHostStorage(host)))
   }
 
   // Convert host storage to the textual scalar list iree-run-module expects.
   // e.g. ["1","2","3","4","5","6"]
   func asScalarStringsForCLI() -> [String]? {
     switch storage {
-    case .host(let data):
+    case .host(let mirror):
+      let data = mirror.data
       switch dtype {
       case .f32:
         return data.withUnsafeBytes { buf in
           Array(buf.bindMemory(to: Float.self)).map { String(format: "%g", $0) }
         }
       case .f16, .bf16:
-        // For CLI demos we usually upcast half to f32 textual values.
-        return data.withUnsafeBytes { buf -> [String] in
-          let words = Array(buf.bindMemory(to: UInt16.self))
-          return words.map { _ in "0" } // simple placeholder if you aren't feeding half yet
-        }
+        // iree-run-module parses half inputs from decimal text; widen exactly to f32 first.
+        return data.withUnsafeBytes { HalfPrecision.widen($0, from: dtype) }.map { String(format: "%.9g", $0) }
+      case .f8E4M3FN, .f8E5M2:
+        // Unscaled FP8 values, printed exactly like the half types.
+        return data.withUnsafeBytes { FP8.dequantize($0, from: dtype) }.map { String(format: "%.9g", $0) }
       case .i32:
         return data.withUnsafeBytes { buf in
           Array(buf.bindMemory(to: Int32.self)).map { String($0) }
@@ -61,3 +63,51 @@ public struct IREEDeviceBuffer: Buffer, Sendable {
     }
   }
 }
+
+/// Host mirror shared by every copy of an `IREEDeviceBuffer`, so donating a
+/// buffer hands its block to `execute` rather than a second reference to it.
+final class IREEHostStorage: @unchecked Sendable {
+  private let lock = NSLock()
+  private var bytes: Data
+
+  init(_ data: Data) { bytes = data }
+
+  var data: Data {
+    lock.lock(); defer { lock.unlock() }
+    return bytes
+  }
+
+  /// Moves the block out when it holds exactly `count` bytes, leaving the
+  /// mirror empty.
+  func take(count: Int) -> Data? {
+    lock.lock(); defer { lock.unlock() }
+    guard bytes.count == count else { return nil }
+    let taken = bytes
+    bytes = Data()
+    return taken
+  }
+}
+
+/// Writes an execute result into a donated input's host mirror.
+///
+/// This is a host-side copy, not an IREE alias: the compiled module carries
+/// no tied operands, so the runtime still allocates the result and donation
+/// only saves the host mirror's allocation. The block is taken out of the
+/// donor, which is empty afterwards, so the bytes land in place unless
+/// something outside the buffer (e.g. `Data` read from it earlier) still
+/// shares the block; then copy-on-write gives the result fresh storage.
+enum IREEDonation {
+  static func write(_ bytes: UnsafeRawBufferPointer, into donor: IREEHostStorage?) -> Data? {
+    // Tiny `Data` may be stored inline, where there is no block to reuse.
+    guard let donor, bytes.count >= Memory.alignment, let src = bytes.baseAddress,
+          var data = donor.take(count: bytes.count) else { return nil }
+    let block = data.withUnsafeBytes { $0.baseAddress }
+    var inPlace = false
+    data.withUnsafeMutableBytes { dst in
+      inPlace = dst.baseAddress == block
+      dst.baseAddress!.copyMemory(from: src, byteCount: bytes.count)
+    }
+    if inPlace { Diagnostics.donatedOutputs.inc() }
+    return data
+  }
+}
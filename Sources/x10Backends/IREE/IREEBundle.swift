@@ -0,0 +1,291 @@
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#else
+import Glibc
+#endif
+import x10Core
+import x10Runtime
+import x10Diagnostics
+
+/// One compiled executable in an `IREEBundle`: the `ShapeKey` it is cached
+/// under and where its VMFB sits in the file.
+public struct IREEBundleEntry: Sendable, Codable, Equatable {
+  public var fingerprint: String
+  public var versionSalt: String
+  public var deviceKey: String
+  public var backendKey: String
+  public var dimSpecs: [DimSpec]
+  public var aliases: [StableHLOModule.InputOutputAlias]
+  public var preferRuntime: Bool
+  /// iree-compile flags the VMFB was built with, beyond the target and input type.
+  public var compileFlags: [String]
+  /// Compile time measured when the bundle was built; weighs the entry in
+  /// cost-aware eviction like an on-demand compile would.
+  public var compileSeconds: Double
+  /// Byte range of the VMFB in the file; `offset` is page-aligned.
+  public var offset: UInt64
+  public var length: UInt64
+
+  public var key: ShapeKey {
+    ShapeKey(fingerprint: fingerprint, versionSalt: versionSalt, dimSpecs: dimSpecs,
+             deviceKey: deviceKey, backendKey: backendKey)
+  }
+}
+
+/// Ahead-of-time compiled IREE executables in one file, for hosts that must
+/// not compile (no iree-compile, no startup latency).
+///
+/// Layout (little-endian):
+///   [0, 32)       header: magic "X10BNDL1", format version (u32), entry
+///                 count (u32), index offset (u64), index length (u64)
+///   page-aligned  VMFBs, each starting on a `pageAlignment` boundary;
+///                 identical artifacts are stored once
+///   index         JSON: compiler version and `IREEBundleEntry` per key
+///
+/// Opening a bundle maps the file read-only; `install` registers every entry
+/// with `IREEExecutableRegistry` and `ExecutableCache` so `JIT.compileCached`
+/// hits without compiling. The registered VMFBs alias the mapping, which
+/// stays alive until the last of them is released.
+public final class IREEBundle: @unchecked Sendable {
+  static let magic = "X10BNDL1"
+  static let formatVersion: UInt32 = 1
+  static let headerSize = 32
+  /// Artifact alignment; 16 KiB covers both 4 KiB and 16 KiB pages.
+  public static let pageAlignment = 16384
+
+  struct Index: Codable {
+    var compilerVersion: String
+    var entries: [IREEBundleEntry]
+  }
+
+  public let url: URL
+  /// `iree-compile --version` of the compiler that built the bundle.
+  public let compilerVersion: String
+  public let entries: [IREEBundleEntry]
+  private let base: UnsafeMutableRawPointer
+  private let size: Int
+
+  /// Maps `url` and validates the header and index.
+  public init(contentsOf url: URL) throws {
+    let fd = open(url.path, O_RDONLY)
+    guard fd >= 0 else {
+      throw Self.error(7201, "cannot open bundle \(url.path): \(String(cString: strerror(errno)))")
+    }
+    defer { close(fd) }
+    var st = stat()
+    guard fstat(fd, &st) == 0, Int(st.st_size) >= Self.headerSize else {
+      throw Self.error(7202, "\(url.path) is not an x10 bundle")
+    }
+    let size = Int(st.st_size)
+    let mapped: UnsafeMutableRawPointer? = mmap(nil, size, PROT_READ, MAP_PRIVATE, fd, 0)
+    guard let base = mapped, base != UnsafeMutableRawPointer(bitPattern: -1) else {
+      throw Self.error(7203, "mmap of \(url.path) failed: \(String(cString: strerror(errno)))")
+    }
+
+    let index: Index
+    do {
+      index = try Self.readIndex(base, size: size, path: url.path)
+    } catch {
+      munmap(base, size)
+      throw error
+    }
+    self.url = url
+    self.compilerVersion = index.compilerVersion
+    self.entries = index.entries
+    self.base = base
+    self.size = size
+  }
+
+  deinit { munmap(base, size) }
+
+  /// The VMFB of `entry`, aliasing the mapping (no copy).
+  public func artifact(_ entry: IREEBundleEntry) -> Data {
+    // The deallocator holds the bundle, so the mapping outlives every artifact.
+    Data(bytesNoCopy: base + Int(entry.offset), count: Int(entry.length),
+         deallocator: .custom { [self] _, _ in withExtendedLifetime(self) {} })
+  }
+
+  /// Registers every entry and returns their executables (in `entries`
+  /// order). On a host without iree-compile the bundle's compiler version is
+  /// adopted, so keys computed at runtime match; with a different local
+  /// compiler nothing is installed (the keys could never hit).
+  ///
+  /// `cache` evicts as usual: size X10_CACHE_MAX_BYTES / X10_CACHE_MAX_ENTRIES
+  /// to hold the whole bundle when nothing can be recompiled.
+  @discardableResult
+  public func install(into cache: ExecutableCache = .shared) async -> [Executable] {
+    IREEBackend.ensureCacheRegistration()
+    IREEBackend.adoptCompilerVersion(compilerVersion)
+    guard IREEBackend.cliVersionString() == compilerVersion else { return [] }
+
+    let registry = IREEExecutableRegistry.shared
+    var execs: [Executable] = []
+    execs.reserveCapacity(entries.count)
+    for entry in entries {
+      let exec = Executable()
+      registry.put(id: exec.id, vmfb: artifact(entry), defaultDeviceOrdinal: 0,
+                   preferRuntime: entry.preferRuntime, aliases: entry.aliases)
+      await cache.put(exec, for: entry.key, compileSeconds: entry.compileSeconds, warmed: true)
+      execs.append(exec)
+    }
+    return execs
+  }
+
+  private static func readIndex(_ base: UnsafeMutableRawPointer, size: Int, path: String) throws -> Index {
+    let magicBytes = UnsafeRawBufferPointer(start: base, count: magic.utf8.count)
+    guard String(decoding: magicBytes, as: UTF8.self) == magic else {
+      throw error(7202, "\(path) is not an x10 bundle")
+    }
+    let version = UInt32(littleEndian: base.loadUnaligned(fromByteOffset: 8, as: UInt32.self))
+    guard version == formatVersion else {
+      throw error(7204, "\(path): unsupported bundle format \(version)")
+    }
+    let count = Int(UInt32(littleEndian: base.loadUnaligned(fromByteOffset: 12, as: UInt32.self)))
+    let indexOffset = UInt64(littleEndian: base.loadUnaligned(fromByteOffset: 16, as: UInt64.self))
+    let indexLength = UInt64(littleEndian: base.loadUnaligned(fromByteOffset: 24, as: UInt64.self))
+    guard indexOffset <= UInt64(size), indexLength <= UInt64(size) - indexOffset else {
+      throw error(7205, "\(path): index out of bounds")
+    }
+
+    let json = Data(bytesNoCopy: base + Int(indexOffset), count: Int(indexLength), deallocator: .none)
+    let index: Index
+    do {
+      index = try JSONDecoder().decode(Index.self, from: json)
+    } catch {
+      throw Self.error(7205, "\(path): unreadable index (\(error))")
+    }
+    guard index.entries.count == count, index.entries.allSatisfy({ e in
+      e.offset <= UInt64(size) && e.length <= UInt64(size) - e.offset && e.offset % UInt64(pageAlignment) == 0
+    }) else {
+      throw error(7205, "\(path): index does not match the file")
+    }
+    return index
+  }
+
+  static func error(_ code: Int, _ message: String) -> NSError {
+    NSError(domain: "IREEBundle", code: code, userInfo: [NSLocalizedDescriptionKey: message])
+  }
+}
+
+/// Compiles modules for a set of shapes and writes them as an `IREEBundle`.
+public struct IREEBundleBuilder {
+  public private(set) var entries: [IREEBundleEntry] = []
+  /// Distinct VMFBs, and for each entry the blob it points at.
+  private var blobs: [Data] = []
+  private var blobIDs: [Data: Int] = [:]
+  private var entryBlobs: [Int] = []
+  private let backend: IREEBackend
+
+  /// `tuningDB` is the one the builder's backend is given; its flags are
+  /// never applied to bundle entries (see `add`).
+  public init(tuningDB: IREETuningDB = .shared) {
+    backend = IREEBackend(tuningDB: tuningDB)
+  }
+
+  /// Flags for executables that must run on any host of `target`: the
+  /// generic CPU model for llvm-cpu (never `host`), nothing for other targets.
+  public static func portableFlags(for target: String) -> [String] {
+    target == "llvm-cpu" ? ["--iree-llvmcpu-target-cpu=generic"] : []
+  }
+
+  /// Compiles `module` once per shape in `shapes` (concrete shapes of the
+  /// entry function's first argument, which `JIT.compileCached` keys on;
+  /// empty means `options.shapeHint` or the module's own shape), keyed
+  /// exactly as `JIT.compileCached(module, with: IREEBackend(), options:)`
+  /// would key it on a host with no tuned flags. `options` must match what
+  /// the deployment passes.
+  ///
+  /// The build host's tuning DB, autotuning and X10_IREE_EXTRA_FLAGS are
+  /// ignored: every entry is compiled with exactly `flags` (default
+  /// `portableFlags(for:)`), which are recorded in the entry. Computing the
+  /// keys has no side effects (`JIT.cacheKey` notes nothing in the shape
+  /// profile), so building a bundle does not skew adaptive bucketing.
+  public mutating func add(_ module: StableHLOModule, shapes: [[Int]] = [], options: CompileOptions = .init(),
+                           flags: [String]? = nil) throws {
+    let registry = IREEExecutableRegistry.shared
+    let compileFlags = flags ?? Self.portableFlags(for: IREEBackend.target(options))
+    for hint in shapes.isEmpty ? [options.shapeHint] : shapes.map(Optional.some) {
+      var opts = options
+      opts.shapeHint = hint
+      if opts.device == nil { opts.device = DeviceScope.current }
+      let key = JIT.cacheKey(for: module, with: backend, options: opts, moduleSalts: false).key
+      let program = try opts.precision.inputCastType.map { try module.castingInputs(to: $0) } ?? module
+
+      let start = Metrics.nowNanos()
+      let exec = try backend.compile(stablehlo: program, options: opts, flags: compileFlags, environmentFlags: false)
+      let seconds = Double(Metrics.nowNanos() &- start) / 1e9
+      defer { registry.release(id: exec.id) }
+      guard let vmfb = registry.getVMFB(id: exec.id), !vmfb.isEmpty else {
+        throw IREEBundle.error(7206, "iree-compile produced no artifact")
+      }
+
+      let blob: Int
+      if let existing = blobIDs[vmfb] {
+        blob = existing
+      } else {
+        blob = blobs.count
+        blobs.append(vmfb)
+        blobIDs[vmfb] = blob
+      }
+      entries.append(IREEBundleEntry(
+        fingerprint: key.fingerprint, versionSalt: key.versionSalt, deviceKey: key.deviceKey,
+        backendKey: key.backendKey, dimSpecs: key.dimSpecs, aliases: registry.aliases(id: exec.id),
+        preferRuntime: registry.shouldPreferRuntime(id: exec.id), compileFlags: compileFlags,
+        compileSeconds: seconds,
+        offset: 0, length: UInt64(vmfb.count)))
+      entryBlobs.append(blob)
+    }
+  }
+
+  /// Writes the bundle to `url` (replacing it). Returns the file size.
+  @discardableResult
+  public func write(to url: URL) throws -> UInt64 {
+    let align = UInt64(IREEBundle.pageAlignment)
+    func aligned(_ n: UInt64) -> UInt64 { (n + align - 1) / align * align }
+
+    let tmp = url.appendingPathExtension("tmp-\(UUID().uuidString)")
+    guard FileManager.default.createFile(atPath: tmp.path, contents: nil) else {
+      throw IREEBundle.error(7207, "cannot create \(tmp.path)")
+    }
+    do {
+      let out = try FileHandle(forWritingTo: tmp)
+      defer { try? out.close() }
+
+      // Artifacts first, each on a page boundary (the gaps stay holes).
+      var offsets: [UInt64] = []
+      var cursor = aligned(UInt64(IREEBundle.headerSize))
+      for blob in blobs {
+        offsets.append(cursor)
+        try out.seek(toOffset: cursor)
+        try out.write(contentsOf: blob)
+        cursor = aligned(cursor + UInt64(blob.count))
+      }
+
+      var index = IREEBundle.Index(compilerVersion: IREEBackend.cliVersionString(), entries: entries)
+      for i in index.entries.indices { index.entries[i].offset = offsets[entryBlobs[i]] }
+      let encoder = JSONEncoder()
+      encoder.outputFormatting = [.sortedKeys]
+      let json = try encoder.encode(index)
+      try out.seek(toOffset: cursor)
+      try out.write(contentsOf: json)
+
+      var header = Data(IREEBundle.magic.utf8)
+      func append<T: FixedWidthInteger>(_ v: T) { withUnsafeBytes(of: v.littleEndian) { header.append(contentsOf: $0) } }
+      append(IREEBundle.formatVersion)
+      append(UInt32(entries.count))
+      append(cursor)
+      append(UInt64(json.count))
+      try out.seek(toOffset: 0)
+      try out.write(contentsOf: header)
+      try out.synchronize()
+
+      if FileManager.default.fileExists(atPath: url.path) { try FileManager.default.removeItem(at: url) }
+      try FileManager.default.moveItem(at: tmp, to: url)
+      return cursor + UInt64(json.count)
+    } catch {
+      try? FileManager.default.removeItem(at: tmp)
+      throw error
+    }
+  }
+}
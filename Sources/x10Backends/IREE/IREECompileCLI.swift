@@ -51,7 +51,11 @@ public enum IREECompileCLI {
   // MARK: - Public compile entry
 
   /// Compiles StableHLO text (either full MLIR module **or** x10‑textual) into a VMFB.
-  public static func compileStableHLO(_ text: String, target: String) throws -> Data {
+  /// `extraFlags` (e.g. tuned flags from `IREETuningDB`) come after
+  /// X10_IREE_EXTRA_FLAGS and replace any of its flags with the same name;
+  /// `environmentFlags` false ignores the env var.
+  public static func compileStableHLO(_ text: String, target: String, extraFlags: [String] = [],
+                                      environmentFlags: Bool = true) throws -> Data {
     guard let tool = find() else {
       throw error("iree-compile not found; set X10_IREE_PREFIX or X10_IREE_BIN")
     }
@@ -78,9 +82,10 @@ public enum IREECompileCLI {
     }
 
     // Allow caller to extend args via env (e.g., tuning flags).
-    if let extra = ProcessInfo.processInfo.environment["X10_IREE_EXTRA_FLAGS"], !extra.isEmpty {
-      args.insert(contentsOf: extra.split(separator: " ").map(String.init), at: 0)
-    }
+    let envExtra = environmentFlags
+      ? (ProcessInfo.processInfo.environment["X10_IREE_EXTRA_FLAGS"] ?? "").split(separator: " ").map(String.init)
+      : []
+    args.insert(contentsOf: mergeFlags(envExtra, extraFlags), at: 0)
 
     // Run with safe draining & timeout.
     let timeout = (ProcessInfo.processInfo.environment["X10_IREE_TIMEOUT_SEC"]).flatMap(Int.init) ?? 20
@@ -109,6 +114,14 @@ public enum IREECompileCLI {
 
   // MARK: - Flag detection
 
+  /// `base` followed by `overrides`, dropping flags of `base` that
+  /// `overrides` sets again (iree-compile rejects most repeated options).
+  static func mergeFlags(_ base: [String], _ overrides: [String]) -> [String] {
+    func name(_ flag: String) -> Substring { flag.split(separator: "=", maxSplits: 1).first ?? Substring(flag) }
+    let replaced = Set(overrides.map(name))
+    return base.filter { !replaced.contains(name($0)) } + overrides
+  }
+
   private static func supportsFlag(_ tool: URL, flag: String) -> Bool {
     let env = ProcessInfo.processInfo.environment
     if env["X10_IREE_FORCE_OLD_FLAGS"] == "1" { return true }
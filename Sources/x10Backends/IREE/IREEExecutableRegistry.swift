@@ -1,39 +1,158 @@
 import Foundation
 import x10Core
+import x10Diagnostics
 
 /// Minimal in-process store for compiled IREE artifacts keyed by Executable.id.
 /// This mirrors the PJRT registry shape and keeps the Swift surface stable.
+///
+/// Entries are released once `ExecutableCache` has evicted their executable
+/// and no caller holds it any more (see `ExecutableLifecycle`). An
+/// entry that is mid-execution (see `acquire`/`relinquish`) is only marked and
+/// freed by the last `relinquish`, so eviction never pulls a VMFB or runtime
+/// session out from under a running call.
 public final class IREEExecutableRegistry {
   public static let shared = IREEExecutableRegistry()
+
+  private struct Entry {
+    var vmfb: Data
+    var deviceOrdinal: Int
+    var prefersRuntime: Bool
+    var requiresCLI = false
+    var aliases: [StableHLOModule.InputOutputAlias]
+    var session: IREEVM?
+    var inFlight: Int = 0
+    var releasePending = false
+
+    /// VMFB bytes plus the copy an in-process session keeps.
+    var liveBytes: Int64 { Int64(vmfb.count) * (session == nil ? 1 : 2) }
+  }
+
   private let lock = NSLock()
-  private var blobs: [UUID: Data] = [:]
-  private var device: [UUID: Int] = [:]
-  private var prefersRuntime: [UUID: Bool] = [:]
+  private var entries: [UUID: Entry] = [:]
 
-  public func put(id: UUID, vmfb: Data, defaultDeviceOrdinal: Int, preferRuntime: Bool = false) {
+  public func put(id: UUID, vmfb: Data, defaultDeviceOrdinal: Int, preferRuntime: Bool = false,
+                  requireCLI: Bool = false, aliases: [StableHLOModule.InputOutputAlias] = []) {
     lock.lock(); defer { lock.unlock() }
-    blobs[id] = vmfb
-    device[id] = defaultDeviceOrdinal
-    prefersRuntime[id] = preferRuntime
+    if let old = entries[id] {
+      Diagnostics.liveArtifactBytes.sub(old.liveBytes)
+    }
+    let entry = Entry(vmfb: vmfb, deviceOrdinal: defaultDeviceOrdinal, prefersRuntime: preferRuntime,
+                      requiresCLI: requireCLI, aliases: aliases)
+    entries[id] = entry
+    Diagnostics.liveArtifactBytes.add(entry.liveBytes)
   }
 
   public func getVMFB(id: UUID) -> Data? {
     lock.lock(); defer { lock.unlock() }
-    return blobs[id]
+    return entries[id]?.vmfb
   }
 
   public func getDeviceOrdinal(id: UUID) -> Int? {
     lock.lock(); defer { lock.unlock() }
-    return device[id]
+    return entries[id]?.deviceOrdinal
+  }
+
+  /// Input/output aliases of the compiled entry function.
+  public func aliases(id: UUID) -> [StableHLOModule.InputOutputAlias] {
+    lock.lock(); defer { lock.unlock() }
+    return entries[id]?.aliases ?? []
   }
 
   public func shouldPreferRuntime(id: UUID) -> Bool {
     lock.lock(); defer { lock.unlock() }
-    return prefersRuntime[id] ?? false
+    return entries[id]?.prefersRuntime ?? false
+  }
+
+  /// Compiled with `flags["iree_cli"]`: always executed through iree-run-module.
+  public func requiresCLI(id: UUID) -> Bool {
+    lock.lock(); defer { lock.unlock() }
+    return entries[id]?.requiresCLI ?? false
+  }
+
+  /// Number of artifacts currently held (pending releases included).
+  public var count: Int {
+    lock.lock(); defer { lock.unlock() }
+    return entries.count
+  }
+
+  /// Frees the VMFB and runtime session for `id`, or defers until the last
+  /// in-flight execution finishes.
+  public func release(id: UUID) {
+    lock.lock(); defer { lock.unlock() }
+    guard var entry = entries[id] else { return }
+    if entry.inFlight > 0 {
+      entry.releasePending = true
+      entries[id] = entry
+      return
+    }
+    drop(id, entry)
   }
 
+  /// Releases every entry; entries mid-execution go with their last `relinquish`.
   public func clear() {
     lock.lock(); defer { lock.unlock() }
-    blobs.removeAll(); device.removeAll(); prefersRuntime.removeAll()
+    for (id, var entry) in entries {
+      if entry.inFlight > 0 {
+        entry.releasePending = true
+        entries[id] = entry
+      } else {
+        drop(id, entry)
+      }
+    }
+  }
+
+  // MARK: - Execution leases
+
+  /// Pins the artifact for the duration of an execute; pair with `relinquish`.
+  func acquire(id: UUID) -> Data? {
+    lock.lock(); defer { lock.unlock() }
+    guard var entry = entries[id] else { return nil }
+    entry.inFlight += 1
+    entries[id] = entry
+    return entry.vmfb
+  }
+
+  func relinquish(id: UUID) {
+    lock.lock(); defer { lock.unlock() }
+    guard var entry = entries[id] else { return }
+    entry.inFlight -= 1
+    if entry.inFlight == 0 && entry.releasePending {
+      drop(id, entry)
+    } else {
+      entries[id] = entry
+    }
+  }
+
+  /// Returns the cached runtime session for `id`, creating it on first use.
+  /// Creation runs outside the lock; a racing creator's session is discarded.
+  func session(id: UUID, create: (Data) throws -> IREEVM) throws -> IREEVM {
+    lock.lock()
+    guard let entry = entries[id] else {
+      lock.unlock()
+      throw IREEVMError.runtime("no VMFB registered for \(id)")
+    }
+    if let existing = entry.session {
+      lock.unlock()
+      return existing
+    }
+    lock.unlock()
+
+    let created = try create(entry.vmfb)
+
+    lock.lock(); defer { lock.unlock() }
+    guard var current = entries[id] else { return created }
+    if let existing = current.session { return existing }
+    Diagnostics.liveArtifactBytes.sub(current.liveBytes)
+    current.session = created
+    entries[id] = current
+    Diagnostics.liveArtifactBytes.add(current.liveBytes)
+    return created
+  }
+
+  // Caller holds `lock`.
+  private func drop(_ id: UUID, _ entry: Entry) {
+    entries.removeValue(forKey: id)
+    Diagnostics.liveArtifactBytes.sub(entry.liveBytes)
+    Diagnostics.releasedArtifacts.inc()
   }
 }
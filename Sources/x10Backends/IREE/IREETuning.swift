@@ -0,0 +1,283 @@
+import Foundation
+import x10Core
+import x10Runtime
+import x10Diagnostics
+
+/// Result of autotuning one (module, target).
+public struct IREETuningRecord: Sendable, Codable, Equatable {
+  public struct Trial: Sendable, Codable, Equatable {
+    public var flags: [String]
+    /// Median execute latency (ns), or nil when the configuration failed.
+    public var nanos: UInt64?
+    public var error: String?
+
+    public init(flags: [String], nanos: UInt64? = nil, error: String? = nil) {
+      self.flags = flags
+      self.nanos = nanos
+      self.error = error
+    }
+  }
+
+  public var key: String
+  public var target: String
+  /// Flags of the fastest trial; empty when the defaults won.
+  public var flags: [String]
+  public var trials: [Trial]
+  /// False when the time budget ran out before every candidate was tried.
+  public var complete: Bool
+
+  public init(key: String, target: String, flags: [String], trials: [Trial], complete: Bool) {
+    self.key = key
+    self.target = target
+    self.flags = flags
+    self.trials = trials
+    self.complete = complete
+  }
+}
+
+/// Persistent map from tuning key (`key(text:target:)`) to the fastest
+/// compile flags found for it; `IREEBackend.compile` applies them.
+/// Stored as JSON at X10_IREE_TUNING_DB, else `<cache dir>/iree-tuning.json`.
+public final class IREETuningDB: @unchecked Sendable {
+  public static let shared = IREETuningDB(url: defaultURL())
+
+  public let url: URL?
+  private let lock = NSLock()
+  private var table: [String: IREETuningRecord] = [:]
+  /// Records per target, so untuned targets are answered without hashing.
+  private var perTarget: [String: Int] = [:]
+
+  private struct File: Codable {
+    var version: Int
+    var records: [IREETuningRecord]
+  }
+
+  /// `url` nil keeps records in memory only.
+  public init(url: URL?) {
+    self.url = url
+    if let url, let data = try? Data(contentsOf: url),
+       let file = try? JSONDecoder().decode(File.self, from: data) {
+      for r in file.records { storeLocked(r) }
+    }
+  }
+
+  public static func defaultURL() -> URL {
+    if let override = ProcessInfo.processInfo.environment["X10_IREE_TUNING_DB"], !override.isEmpty {
+      return URL(fileURLWithPath: override)
+    }
+    return JIT.cacheDirectory.appendingPathComponent("iree-tuning.json")
+  }
+
+  /// Hash of the module text, target and iree-compile version: tuned flags
+  /// are only reused for the same graph, shapes and compiler.
+  public static func key(text: String, target: String) -> String {
+    var hash: UInt64 = 0xcbf29ce484222325
+    for b in "\(target)|\(IREEBackend.cliVersionString())|\(text)".utf8 {
+      hash ^= UInt64(b)
+      hash &*= 0x100000001b3
+    }
+    return String(hash, radix: 16)
+  }
+
+  public func record(for key: String) -> IREETuningRecord? {
+    lock.lock(); defer { lock.unlock() }
+    return table[key]
+  }
+
+  /// Tuned flags for `key`, or nil if it was never tuned.
+  public func flags(for key: String) -> [String]? { record(for: key)?.flags }
+
+  /// Whether any module has been tuned for `target`.
+  public func hasRecords(target: String) -> Bool {
+    lock.lock(); defer { lock.unlock() }
+    return perTarget[target, default: 0] > 0
+  }
+
+  public func put(_ record: IREETuningRecord) {
+    lock.lock(); defer { lock.unlock() }
+    storeLocked(record)
+    persistLocked()
+  }
+
+  public func remove(_ key: String) {
+    lock.lock(); defer { lock.unlock() }
+    guard let old = table.removeValue(forKey: key) else { return }
+    perTarget[old.target, default: 1] -= 1
+    persistLocked()
+  }
+
+  public func records() -> [IREETuningRecord] {
+    lock.lock(); defer { lock.unlock() }
+    return table.values.sorted { $0.key < $1.key }
+  }
+
+  public func removeAll() {
+    lock.lock(); defer { lock.unlock() }
+    table.removeAll()
+    perTarget.removeAll()
+    persistLocked()
+  }
+
+  private func storeLocked(_ record: IREETuningRecord) {
+    if let old = table.updateValue(record, forKey: record.key) { perTarget[old.target, default: 1] -= 1 }
+    perTarget[record.target, default: 0] += 1
+  }
+
+  private func persistLocked() {
+    guard let url else { return }
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = [.sortedKeys]
+    guard let data = try? encoder.encode(File(version: 1, records: table.values.sorted { $0.key < $1.key })) else { return }
+    try? FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+    try? data.write(to: url, options: .atomic)
+  }
+}
+
+/// Searches iree-compile flag configurations for the fastest executable.
+///
+/// Each candidate is compiled and executed in-process through the IREE
+/// runtime on deterministic inputs shaped like the entry function's
+/// arguments (one warm-up, then `runs` timed executes); the fastest median
+/// wins and is written to the tuning DB. Without the runtime shim nothing is
+/// tuned: `iree-run-module` timings are dominated by process start-up.
+/// Failing candidates (e.g. flags this iree-compile doesn't know) are recorded
+/// and skipped. Candidates are tried in order until the time budget is spent.
+public final class IREEAutotuner: @unchecked Sendable {
+  public static let shared = IREEAutotuner()
+
+  public let db: IREETuningDB
+  /// Timed executes per candidate.
+  public let runs: Int
+  private let lock = NSLock()
+  private var inFlight: [String: Task<IREETuningRecord?, Never>] = [:]
+
+  public init(db: IREETuningDB = .shared, runs: Int = 3) {
+    self.db = db
+    self.runs = max(1, runs)
+  }
+
+  /// Whether compiles should schedule tuning: `options.flags["iree_autotune"]`,
+  /// else X10_IREE_AUTOTUNE, and only for executables that will run in-process
+  /// (`IREEBackend.prefersRuntime`), since that is what trials measure.
+  public static func isEnabled(_ options: CompileOptions) -> Bool {
+    IREEBackend.runtimeFlagEnabled(options.flags["iree_autotune"] ?? ProcessInfo.processInfo.environment["X10_IREE_AUTOTUNE"])
+      && IREEBackend.prefersRuntime(options) && IREEBackend.isRuntimeAvailable
+  }
+
+  /// Seconds one tuning run may take (X10_IREE_AUTOTUNE_BUDGET_SEC, default 30).
+  public static var defaultBudget: TimeInterval {
+    ProcessInfo.processInfo.environment["X10_IREE_AUTOTUNE_BUDGET_SEC"].flatMap(TimeInterval.init) ?? 30
+  }
+
+  /// Flag configurations tried for `target`, defaults first.
+  /// X10_IREE_TUNE_CANDIDATES replaces them: configurations separated by
+  /// `;`, flags within one by spaces.
+  public static func candidates(for target: String) -> [[String]] {
+    if let raw = ProcessInfo.processInfo.environment["X10_IREE_TUNE_CANDIDATES"], !raw.isEmpty {
+      return [[]] + raw.split(separator: ";").map { $0.split(separator: " ").map(String.init) }.filter { !$0.isEmpty }
+    }
+    guard target == "llvm-cpu" else { return [[], ["--iree-opt-level=O3"]] }
+    let host = "--iree-llvmcpu-target-cpu=host"
+    return [
+      [],
+      [host],
+      [host, "--iree-opt-data-tiling"],
+      [host, "--iree-llvmcpu-enable-ukernels=all"],
+      [host, "--iree-opt-data-tiling", "--iree-llvmcpu-enable-ukernels=all"],
+      [host, "--iree-opt-level=O3"],
+    ]
+  }
+
+  /// Tunes `module` in a background task unless its key is already tuned or
+  /// being tuned; returns that task, or nil when there is nothing to do.
+  @discardableResult
+  public func schedule(_ module: StableHLOModule, target: String,
+                       budget: TimeInterval = IREEAutotuner.defaultBudget) -> Task<IREETuningRecord?, Never>? {
+    let key = IREETuningDB.key(text: module.textual(), target: target)
+    lock.lock(); defer { lock.unlock() }
+    guard db.record(for: key) == nil, inFlight[key] == nil else { return nil }
+    let task = Task.detached(priority: .utility) { [self] () -> IREETuningRecord? in
+      let record = await tune(module, target: target, budget: budget)
+      lock.lock(); inFlight[key] = nil; lock.unlock()
+      return record
+    }
+    inFlight[key] = task
+    return task
+  }
+
+  /// Compiles and times the candidates for `module` within `budget` seconds
+  /// and stores the result; nil if no candidate ran, the entry function has
+  /// dynamic shapes or the runtime shim is not loaded.
+  public func tune(_ module: StableHLOModule, target: String,
+                   budget: TimeInterval = IREEAutotuner.defaultBudget,
+                   candidates: [[String]]? = nil) async -> IREETuningRecord? {
+    let text = module.textual()
+    let key = IREETuningDB.key(text: text, target: target)
+    let backend = IREEBackend(tuningDB: db)
+    guard IREEBackend.isRuntimeAvailable,
+          let inputs = try? Self.representativeInputs(module, backend: backend) else { return nil }
+
+    let deadline = Date().addingTimeInterval(budget)
+    let configs = candidates ?? Self.candidates(for: target)
+    var trials: [IREETuningRecord.Trial] = []
+    for flags in configs {
+      guard Date() < deadline else { break }
+      trials.append(await trial(text, target: target, flags: flags, inputs: inputs, backend: backend))
+    }
+
+    let timed = trials.compactMap { t in t.nanos.map { (t.flags, $0) } }
+    guard let best = timed.min(by: { $0.1 < $1.1 }) else { return nil }
+    let record = IREETuningRecord(key: key, target: target, flags: best.0, trials: trials,
+                                  complete: trials.count == configs.count)
+    db.put(record)
+    return record
+  }
+
+  private func trial(_ text: String, target: String, flags: [String], inputs: [Buffer],
+                     backend: IREEBackend) async -> IREETuningRecord.Trial {
+    let registry = IREEExecutableRegistry.shared
+    let exec = Executable()
+    defer { registry.release(id: exec.id) }
+    do {
+      let vmfb = try Trace.span("IREE.autotune.compile") {
+        try IREECompileCLI.compileStableHLO(text, target: target, extraFlags: flags)
+      }
+      registry.put(id: exec.id, vmfb: vmfb, defaultDeviceOrdinal: 0, preferRuntime: true)
+      var samples: [UInt64] = []
+      for run in 0...runs {
+        let start = Metrics.nowNanos()
+        _ = try await backend.execute(exec, inputs: inputs, stream: nil)
+        if run > 0 { samples.append(Metrics.nowNanos() &- start) }   // run 0 warms up
+      }
+      samples.sort()
+      return .init(flags: flags, nanos: samples[samples.count / 2])
+    } catch {
+      return .init(flags: flags, error: "\(error)")
+    }
+  }
+
+  /// Deterministic, non-trivial data for every argument of the entry function.
+  static func representativeInputs(_ module: StableHLOModule, backend: IREEBackend) throws -> [Buffer]? {
+    guard let fn = module.functions.first(where: { $0.name == "main" }) ?? module.functions.first else { return nil }
+    var inputs: [Buffer] = []
+    for arg in fn.args {
+      let dims = arg.shape.compactMap { $0 }
+      guard dims.count == arg.shape.count else { return nil }
+      let count = dims.reduce(1, *)
+      let values = (0..<count).map { Float(($0 * 7919) % 97) / 97 - 0.5 }
+      let data: Data
+      switch arg.dtype {
+      case .f32: data = values.withUnsafeBytes { Data($0) }
+      case .f64: data = values.map(Double.init).withUnsafeBytes { Data($0) }
+      case .i32: data = (0..<count).map { Int32($0 % 17) }.withUnsafeBytes { Data($0) }
+      case .i64: data = (0..<count).map { Int64($0 % 17) }.withUnsafeBytes { Data($0) }
+      case .f16, .bf16: data = HalfPrecision.narrow(values, to: arg.dtype)
+      case .f8E4M3FN, .f8E5M2: data = FP8.quantize(values, to: arg.dtype, scale: 1).data
+      }
+      inputs.append(try data.withUnsafeBytes {
+        try backend.toDevice($0, shape: dims, dtype: arg.dtype, on: .init(ordinal: 0))
+      })
+    }
+    return inputs
+  }
+}
@@ -1,5 +1,7 @@
 import Foundation
 import x10Core
+import x10Runtime
+import x10Diagnostics
 import x10InteropIREEC
 
 enum IREEVMError: Error, LocalizedError {
@@ -12,8 +14,8 @@ enum IREEVMError: Error, LocalizedError {
   }
 }
 
-/// Thin Swift wrapper over the C runtime shim. Not thread-safe yet but keeps the
-/// lifetime and memory management ergonomic for the backend.
+/// Thin Swift wrapper over the C runtime shim. Sessions are cached per
+/// executable, so `invoke` serializes calls on the same handle.
 final class IREEVM {
   struct TensorInput {
     let shape: [Int]
@@ -47,6 +49,7 @@ final class IREEVM {
   }
 
   private var handle: OpaquePointer?
+  private let invokeLock = NSLock()
 
   init(vmfb: Data) throws {
     guard Self.ensureRuntimeLoaded() else {
@@ -68,7 +71,14 @@ final class IREEVM {
     if let handle { x10_iree_vm_destroy(handle) }
   }
 
-  func invoke(entry: String, inputs: [TensorInput]) throws -> [TensorOutput] {
+  /// Output tensors are copied out of the shim into blocks from `pool` when
+  /// given, or into `reusing[i]` (a donated input's storage, see
+  /// `IREEDonation`) for result `i`. `inputs` is emptied once marshalled so
+  /// it no longer shares a donated block when results are written.
+  func invoke(entry: String, inputs: inout [TensorInput], pool: MemoryPool? = nil,
+              reusing: [Int: IREEHostStorage] = [:]) throws -> [TensorOutput] {
+    let traceStart = Trace.begin()
+    defer { Trace.end("IREEVM.invoke", since: traceStart) }
     guard let handle else {
       throw IREEVMError.runtime("runtime handle released")
     }
@@ -130,9 +140,12 @@ final class IREEVM {
         byte_length: byteCount)
       cInputs.append(cTensor)
     }
+    inputs.removeAll()
 
     var resultsPtr: UnsafeMutablePointer<x10_iree_runtime_result_t>? = nil
     var resultCount: Int32 = 0
+    invokeLock.lock()
+    defer { invokeLock.unlock() }
     let ok = entry.withCString { fnName in
       cInputs.withUnsafeMutableBufferPointer { buffer in
         x10_iree_vm_invoke(handle, fnName, buffer.baseAddress, Int32(buffer.count),
@@ -144,6 +157,8 @@ final class IREEVM {
       throw IREEVMError.runtime(Self.lastErrorOr("x10_iree_vm_invoke failed"))
     }
 
+    let readbackStart = Trace.begin()
+    defer { Trace.end("IREEVM.readback", since: readbackStart) }
     var outputs: [TensorOutput] = []
     outputs.reserveCapacity(Int(resultCount))
 
@@ -165,7 +180,8 @@ final class IREEVM {
 
       let data: Data
       if let dataPtr = result.data, result.byte_length > 0 {
-        data = Data(bytes: dataPtr, count: Int(result.byte_length))
+        let bytes = UnsafeRawBufferPointer(start: dataPtr, count: Int(result.byte_length))
+        data = IREEDonation.write(bytes, into: reusing[idx]) ?? pool?.makeData(copying: bytes) ?? Data(bytes)
       } else {
         data = Data()
       }
@@ -191,6 +207,8 @@ final class IREEVM {
     case .f64:  return X10_IREE_DTYPE_F64
     case .i32:  return X10_IREE_DTYPE_I32
     case .i64:  return X10_IREE_DTYPE_I64
+    case .f8E4M3FN: return X10_IREE_DTYPE_F8E4M3FN
+    case .f8E5M2:   return X10_IREE_DTYPE_F8E5M2
     }
   }
 
@@ -202,6 +220,8 @@ final class IREEVM {
     case X10_IREE_DTYPE_F64: return .f64
     case X10_IREE_DTYPE_I32: return .i32
     case X10_IREE_DTYPE_I64: return .i64
+    case X10_IREE_DTYPE_F8E4M3FN: return .f8E4M3FN
+    case X10_IREE_DTYPE_F8E5M2: return .f8E5M2
     default: return nil
     }
   }
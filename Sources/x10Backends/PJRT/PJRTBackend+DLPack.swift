@@ -12,23 +12,27 @@ extension PJRTBackend {
 
   /// Export a PJRT buffer to DLPack.
   /// - Zero-copy if the buffer is already a DLPack alias (returns a retained capsule).
-  /// - Copying fallback if the buffer is a host Data mirror.
+  /// - Copying fallback if the buffer is a host Data mirror or a device-resident PJRT_Buffer.
   public func exportDLPack(_ buf: PJRTDeviceBuffer, device: Device = .cpu(0)) throws -> DLPackCapsule {
     switch buf.storage {
-    case .dlcap(let cap):
-      return DLPack.retain(cap) // zero-copy
+    case .dlcap(let ref):
+      return DLPack.retain(ref.capsule) // zero-copy
     case .stub(let data):
-      // Fallback: allocate and copy (not zero-copy).
-      let nbytes = data.count
-      let ptr = UnsafeMutableRawPointer.allocate(byteCount: nbytes, alignment: MemoryLayout<UInt8>.alignment)
-      _ = data.withUnsafeBytes { src in
-        memcpy(ptr, src.baseAddress!, nbytes)
-      }
-      return try DLPack.wrapHostBufferFree(ptr: ptr, shape: buf.shape, dtype: buf.dtype)
-    case .handle(_):
-      throw NSError(domain: "PJRT", code: 2, userInfo: [NSLocalizedDescriptionKey: "export from device handle not implemented yet"])
+      return try copyToCapsule(data, shape: buf.shape, dtype: buf.dtype)
+    case .handle(let h):
+      return try copyToCapsule(Data(try PJRTClient.download(h)), shape: buf.shape, dtype: buf.dtype)
     }
   }
 
+  // Fallback: allocate and copy (not zero-copy).
+  private func copyToCapsule(_ data: Data, shape: [Int], dtype: DType) throws -> DLPackCapsule {
+    let nbytes = data.count
+    let ptr = UnsafeMutableRawPointer.allocate(byteCount: nbytes, alignment: MemoryLayout<UInt8>.alignment)
+    _ = data.withUnsafeBytes { src in
+      memcpy(ptr, src.baseAddress!, nbytes)
+    }
+    return try DLPack.wrapHostBufferFree(ptr: ptr, shape: shape, dtype: dtype)
+  }
+
 
 }
@@ -0,0 +1,16 @@
+import Foundation
+import x10Core
+import x10Runtime
+
+extension PJRTBackend {
+  /// Frees PJRT executable handles when `ExecutableCache` drops their executable.
+  private static let _cacheRegistration: Void = {
+    ExecutableLifecycle.registerReleaseHandler { exec in
+      PJRTExecutableRegistry.shared.remove(exec.id)
+    }
+  }()
+
+  static func ensureCacheRegistration() {
+    _ = _cacheRegistration
+  }
+}
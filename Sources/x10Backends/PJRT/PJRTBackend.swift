@@ -1,11 +1,12 @@
 import Foundation
 import x10Core
 import x10Runtime
+import x10Diagnostics
 import PJRTC
 import x10InteropDLPack   // NEW
 
 public struct PJRTBackend: Backend {
-  public struct Dev: Hashable, Sendable {
+  public struct Dev: Hashable, Sendable, OrdinalDevice {
     public let ordinal: Int
     public init(ordinal: Int) { self.ordinal = ordinal }
   }
@@ -22,6 +23,7 @@ public struct PJRTBackend: Backend {
   // Helpers
   @inline(__always) fileprivate func _byteCount(of dtype: DType) -> Int {
     switch dtype {
+    case .f8E4M3FN, .f8E5M2: return 1
     case .f16, .bf16: return 2
     case .f32, .i32:  return 4
     case .i64:        return 8
@@ -30,12 +32,17 @@ public struct PJRTBackend: Backend {
   }
 
 
-  // === memory / transfer stubs (satisfy Backend protocol) ===
-    // === memory / transfer (stub today) ===
+  // === memory / transfer (PJRT_Buffer with a real plugin, pooled host mirror otherwise) ===
 
   public func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
     let nbytes = _numElements(shape) * _byteCount(of: dtype)
-    let data = Data(count: nbytes)
+    let data = Memory.pool(for: "pjrt:\(on.ordinal)").makeData(byteCount: nbytes)
+    if PJRTClient.isReal {
+      let handle = try data.withUnsafeBytes {
+        try PJRTClient.upload($0, shape: shape, dtype: dtype, device: on.ordinal)
+      }
+      return PJRTDeviceBuffer(shape: shape, dtype: dtype, storage: .handle(handle))
+    }
     return PJRTDeviceBuffer(shape: shape, dtype: dtype, storage: .stub(data))
   }
 
@@ -43,30 +50,69 @@ public struct PJRTBackend: Backend {
                        shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
     let expected = _numElements(shape) * _byteCount(of: dtype)
     let count = min(expected, host.count)
-    let data = Data(bytes: host.baseAddress!, count: count)
-    return PJRTDeviceBuffer(shape: shape, dtype: dtype, storage: .stub(data))
+    let bytes = UnsafeRawBufferPointer(rebasing: host.prefix(count))
+    let storage: PJRTDeviceBuffer.Storage = try Trace.span("PJRT.toDevice", arg: UInt64(count)) {
+      if PJRTClient.isReal {
+        return .handle(try PJRTClient.upload(bytes, shape: shape, dtype: dtype, device: on.ordinal))
+      }
+      return .stub(Memory.pool(for: "pjrt:\(on.ordinal)").makeData(copying: bytes))
+    }
+    Diagnostics.bytesToDevice.inc(UInt64(count))
+    Diagnostics.transferBytes.record(UInt64(count))
+    return PJRTDeviceBuffer(shape: shape, dtype: dtype, storage: storage)
   }
 
   public func fromDevice(_ buffer: Buffer) throws -> [UInt8] {
+    let traceStart = Trace.begin()
+    let bytes = try _fromDevice(buffer)
+    Trace.end("PJRT.fromDevice", since: traceStart, arg: UInt64(bytes.count))
+    Diagnostics.bytesFromDevice.inc(UInt64(bytes.count))
+    Diagnostics.transferBytes.record(UInt64(bytes.count))
+    return bytes
+  }
+
+  public func fromDevice(_ buffer: Buffer, into destination: UnsafeMutableRawBufferPointer) throws -> Int {
+    guard let b = buffer as? PJRTDeviceBuffer, let dst = destination.baseAddress else { return 0 }
+    let traceStart = Trace.begin()
+    var written = 0
+    switch b.storage {
+    case .stub(let data):
+      written = min(data.count, destination.count)
+      if written > 0 { data.withUnsafeBytes { x10_dlpack_copy_bytes(dst, $0.baseAddress, written) } }
+    case .dlcap(let ref):
+      if x10_dlpack_to_host_copy(ref.capsule.raw, dst, destination.count, &written) != 1 { written = 0 }
+    case .handle(let h):
+      let bytes = try PJRTClient.download(h)
+      written = min(bytes.count, destination.count)
+      if written > 0 { bytes.withUnsafeBytes { x10_dlpack_copy_bytes(dst, $0.baseAddress, written) } }
+    }
+    Trace.end("PJRT.fromDevice", since: traceStart, arg: UInt64(written))
+    Diagnostics.bytesFromDevice.inc(UInt64(written))
+    Diagnostics.transferBytes.record(UInt64(written))
+    return written
+  }
+
+  private func _fromDevice(_ buffer: Buffer) throws -> [UInt8] {
     if let b = buffer as? PJRTDeviceBuffer {
       switch b.storage {
       case .stub(let data):
         return Array(data)
-      case .dlcap(let cap):
-        // Copy out via shim (still zero-copy alias internally; copy only for host inspection)
+      case .dlcap(let ref):
+        // Copy out via shim (still zero-copy alias internally; copy only for host
+        // inspection). Strided views come back dense.
         let n = _numElements(b.shape) * _byteCount(of: b.dtype)
         var out = Data(count: n)
-        var written32: Int32 = 0
+        var written = 0
         let ok = out.withUnsafeMutableBytes { mb -> Int32 in
-          x10_dlpack_to_host_copy(cap.raw, mb.baseAddress, mb.count, &written32)
+          x10_dlpack_to_host_copy(ref.capsule.raw, mb.baseAddress, mb.count, &written)
         }
-        guard ok == 1, Int(written32) == n else {
-          return Array(out.prefix(max(0, Int(written32))))
+        guard ok == 1, written == n else {
+          return Array(out.prefix(written))
         }
         return Array(out)
 
-      case .handle(_):
-        return [] // not implemented yet
+      case .handle(let h):
+        return try PJRTClient.download(h)
       }
     }
     return []
@@ -76,14 +122,16 @@ public struct PJRTBackend: Backend {
   
 
 
-  public init() {}
+  public init() {
+    Self.ensureCacheRegistration()
+  }
 
-  public func devices() throws -> [Dev] {
-    _ = x10_pjrt_load(nil as UnsafePointer<CChar>?)
+  /// True when a PJRT plugin is loaded (X10_PJRT_LIB); otherwise the shim is
+  /// a stub whose executes pass their inputs through.
+  public static var isPluginLoaded: Bool { PJRTClient.isReal }
 
-    var client: x10_pjrt_client_t? = nil
-    guard x10_pjrt_client_create(&client) == 1, let c = client else { return [] }
-    defer { x10_pjrt_client_destroy(c) }
+  public func devices() throws -> [Dev] {
+    guard let c = PJRTClient.shared else { return [] }
 
     var count: Int32 = 0
     guard x10_pjrt_client_device_count(c, &count) == 1 else { return [] }
@@ -101,16 +149,12 @@ public struct PJRTBackend: Backend {
   }
 
   // === compile/execute via shim (stub or real) ===
-    public func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable {
-    _ = x10_pjrt_load(nil as UnsafePointer<CChar>?)
-
-    var client: x10_pjrt_client_t? = nil
-    guard x10_pjrt_client_create(&client) == 1, let c = client else {
+  public func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable {
+    guard let c = PJRTClient.shared else {
       return Executable()
     }
-    defer { x10_pjrt_client_destroy(c) }
 
-    let text = stablehlo.textual()
+    let text = stablehlo.pjrtMLIR()
     let optsJSON = options.toJSON()
 
     var execHandle: x10_pjrt_executable_t? = nil
@@ -124,6 +168,9 @@ public struct PJRTBackend: Backend {
       }
     }
 
+    if ok != 1 && PJRTClient.isReal {
+      throw PJRTClient.error("PJRT compile failed")
+    }
     let exec = Executable()
     if ok == 1, let eh = execHandle {
       let ord = deviceOrdinal(options.device)
@@ -135,14 +182,119 @@ public struct PJRTBackend: Backend {
 
 
   public func execute(_ exec: Executable, inputs: [Buffer], stream: x10Runtime.Stream?) async throws -> [Buffer] {
-    if let entry = PJRTExecutableRegistry.shared.getEntry(exec.id) {
+    try await execute(exec, inputs: inputs, donating: [], stream: stream)
+  }
+
+  /// With a real plugin, inputs stay on device: `.handle` buffers are passed
+  /// straight to PJRT and outputs come back as new `.handle` buffers, so
+  /// chained executes never touch the host. The executable runs on the
+  /// device of its first resident input. Host-backed inputs are uploaded
+  /// first. Inputs outside `donating` are marked non-donatable. Stub mode
+  /// passes the inputs through.
+  public func execute(_ exec: Executable, inputs: [Buffer], donating: Set<Int>,
+                      stream: x10Runtime.Stream?) async throws -> [Buffer] {
+    let start = Metrics.nowNanos()
+    let traceStart = Trace.isEnabled ? start : 0
+    defer {
+      Diagnostics.executeLatency.record(Metrics.nowNanos() &- start)
+      Trace.end("PJRT.execute", since: traceStart)
+    }
+    guard let entry = PJRTExecutableRegistry.shared.acquire(exec.id) else {
+      return inputs
+    }
+    defer { PJRTExecutableRegistry.shared.relinquish(exec.id, handle: entry.handle) }
+    guard PJRTClient.isReal else {
       _ = x10_pjrt_execute(entry.handle, entry.defaultDeviceOrdinal)
+      return inputs // stub passthrough
     }
-    return inputs // stub passthrough for now
+
+    let device = executionDevice(inputs, fallback: Int(entry.defaultDeviceOrdinal))
+    let handle = entry.handle
+    // Uploads and the execute itself block until the device is done.
+    return try await Self.offCooperativePool {
+      let args = try inputs.map { try self.deviceHandle($0, device: device) }
+      let nonDonatable = inputs.indices.filter { !donating.contains($0) }.map(Int64.init)
+      var outs = [x10_pjrt_buffer_t?](repeating: nil, count: x10_pjrt_executable_num_outputs(handle))
+      var produced = 0
+      let ok = withExtendedLifetime(args) {
+        args.map { Optional($0.raw) }.withUnsafeBufferPointer { a in
+          nonDonatable.withUnsafeBufferPointer { nd in
+            outs.withUnsafeMutableBufferPointer { o in
+              x10_pjrt_execute_buffers(handle, Int32(device),
+                                       a.baseAddress, a.count, nd.baseAddress, nd.count,
+                                       o.baseAddress, o.count, &produced)
+            }
+          }
+        }
+      }
+      guard ok == 1 else { throw PJRTClient.error("PJRT execute failed") }
+      return try outs.prefix(produced).map { raw in
+        let handle = PJRTBufferHandle(raw!)
+        guard let dtype = handle.dtype else { throw PJRTClient.error("unsupported PJRT output type") }
+        return PJRTDeviceBuffer(shape: handle.shape, dtype: dtype, storage: .handle(handle))
+      }
+    }
+  }
+
+  /// Runs where the first device-resident input lives, so resident arguments
+  /// never round-trip through the host; `fallback` (the compile-time device)
+  /// when every input is host-backed. Inputs on other devices are copied over.
+  private func executionDevice(_ inputs: [Buffer], fallback: Int) -> Int {
+    for case let b as PJRTDeviceBuffer in inputs {
+      if case .handle(let h) = b.storage { return h.deviceOrdinal }
+    }
+    return fallback
   }
 
+  /// PJRT calls that await device events block their thread; they run on
+  /// this queue so they never pin a thread of the cooperative pool.
+  private static let blockingQueue = DispatchQueue(label: "x10.pjrt.blocking", qos: .userInitiated,
+                                                   attributes: .concurrent)
+
+  private static func offCooperativePool<T>(_ body: @escaping () throws -> T) async throws -> T {
+    try await withCheckedThrowingContinuation { continuation in
+      blockingQueue.async { continuation.resume(with: Result { try body() }) }
+    }
+  }
 
-  public func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
-  public func stream(device: Dev) throws -> x10Runtime.Stream { x10Runtime.Stream() }
+  /// The `PJRT_Buffer` behind `buffer` on `device`, uploading host-backed storage.
+  private func deviceHandle(_ buffer: Buffer, device: Int) throws -> PJRTBufferHandle {
+    guard let b = buffer as? PJRTDeviceBuffer else {
+      throw NSError(domain: "PJRT", code: 4, userInfo: [NSLocalizedDescriptionKey: "not a PJRT buffer: \(type(of: buffer))"])
+    }
+    if case .handle(let h) = b.storage, h.deviceOrdinal == device { return h }
+    // Strided host views (slices, transposes) upload without a host gather.
+    if case .dlcap(let ref) = b.storage, let base = DLPack.dataPointer(ref.capsule),
+       let strides = DLPack.strides(ref.capsule), strides.allSatisfy({ $0 > 0 }) {
+      let elementSize = _byteCount(of: b.dtype)
+      Diagnostics.bytesToDevice.inc(UInt64(_numElements(b.shape) * elementSize))
+      return try PJRTClient.upload(strided: base, shape: b.shape, byteStrides: strides.map { $0 * elementSize },
+                                   dtype: b.dtype, device: device)
+    }
+    let host = try _fromDevice(b)
+    Diagnostics.bytesToDevice.inc(UInt64(host.count))
+    return try host.withUnsafeBytes { try PJRTClient.upload($0, shape: b.shape, dtype: b.dtype, device: device) }
+  }
+
+
+  /// In-process all-reduce over the host mirrors of `group`'s members (the
+  /// stub devices from X10_PJRT_STUB_DEVICE_COUNT share one address space).
+  public func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer {
+    guard group.size > 1, let pb = b as? PJRTDeviceBuffer else { return b }
+    let host: Data
+    switch pb.storage {
+    case .stub(let data): host = data
+    case .dlcap, .handle: host = Data(try _fromDevice(b))
+    }
+    let reduced = try await group.allReduce(host, dtype: pb.dtype, op: op)
+    if case .handle(let h) = pb.storage {
+      let back = try reduced.withUnsafeBytes {
+        try PJRTClient.upload($0, shape: pb.shape, dtype: pb.dtype, device: h.deviceOrdinal)
+      }
+      return PJRTDeviceBuffer(shape: pb.shape, dtype: pb.dtype, storage: .handle(back))
+    }
+    return PJRTDeviceBuffer(shape: pb.shape, dtype: pb.dtype, storage: .stub(reduced))
+  }
+  public func stream(device: Dev) throws -> x10Runtime.Stream { x10Runtime.Stream(label: "pjrt:\(device.ordinal)") }
   public func event(device: Dev) throws -> x10Runtime.Event { x10Runtime.Event() }
 }
@@ -4,15 +4,16 @@ import x10Runtime
 import x10InteropDLPack
 
 /// Backend-specific device buffer for PJRT backend.
-/// In stub mode, this can be a host alias (DLPack) or a host mirror (Data).
+/// With a real plugin loaded it is a device-resident `PJRT_Buffer`; in stub
+/// mode it is a host alias (DLPack) or a host mirror (Data).
 public struct PJRTDeviceBuffer: Buffer, Sendable {
   public let shape: [Int]
   public let dtype: DType
 
   enum Storage: @unchecked Sendable {
     case stub(Data)                 // host mirror (copy-based)
-    case dlcap(DLPackCapsule)       // zero-copy alias to host memory via DLPack
-    case handle(OpaquePointer)      // placeholder for a future PJRT_Buffer
+    case dlcap(DLPackCapsuleReference) // zero-copy alias to host memory via DLPack
+    case handle(PJRTBufferHandle)   // device-resident PJRT_Buffer
   }
   let storage: Storage
 
@@ -23,7 +24,8 @@ public struct PJRTDeviceBuffer: Buffer, Sendable {
     self.storage = storage
   }
 
-  // Public convenience for zero-copy import from a DLPack capsule.
+  // Public convenience for zero-copy import from a DLPack capsule. Strided
+  // views are kept as views: host reads gather, device uploads pass strides.
   public init?(fromDLPack cap: DLPackCapsule) {
     guard let info = DLPack.basicInfo(cap), info.deviceType == 1 /*kDLCPU*/ else { return nil }
     guard let shp = DLPack.shape(cap) else { return nil }
@@ -31,15 +33,18 @@ public struct PJRTDeviceBuffer: Buffer, Sendable {
     let dt: DType
     switch (info.code, info.bits) {
     case (2, 32): dt = .f32
+    case (2, 64): dt = .f64
     case (2, 16): dt = .f16
     case (4, 16): dt = .bf16
     case (0, 32): dt = .i32
     case (0, 64): dt = .i64
+    case (10, 8): dt = .f8E4M3FN
+    case (12, 8): dt = .f8E5M2
     default: return nil
     }
     self.shape = shp
     self.dtype = dt
-    self.storage = .dlcap(DLPack.retain(cap))
+    self.storage = .dlcap(DLPackCapsuleReference(adopting: DLPack.retain(cap)))
   }
 }
 
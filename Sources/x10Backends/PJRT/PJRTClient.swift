@@ -0,0 +1,109 @@
+import Foundation
+import x10Core
+import PJRTC
+
+/// The plugin's long-lived client. The shim creates it on first use and keeps
+/// it until `x10_pjrt_unload`, so devices, compiles and buffers all share one
+/// `PJRT_Client` instead of paying client setup per call.
+enum PJRTClient {
+  static var shared: x10_pjrt_client_t? {
+    _ = x10_pjrt_load(nil as UnsafePointer<CChar>?)
+    var client: x10_pjrt_client_t? = nil
+    guard x10_pjrt_client_shared(&client) == 1 else { return nil }
+    return client
+  }
+
+  /// True when a plugin is loaded; buffers are then real `PJRT_Buffer`s.
+  static var isReal: Bool { x10_pjrt_is_real() == 1 }
+
+  static func error(_ what: String) -> NSError {
+    let detail = String(cString: x10_pjrt_last_error())
+    return NSError(domain: "PJRT", code: 3, userInfo: [NSLocalizedDescriptionKey: "\(what): \(detail)"])
+  }
+
+  static func typeCode(_ dtype: DType) -> Int32 {
+    switch dtype {
+    case .f16:  return Int32(X10_PJRT_TYPE_F16)
+    case .bf16: return Int32(X10_PJRT_TYPE_BF16)
+    case .f32:  return Int32(X10_PJRT_TYPE_F32)
+    case .f64:  return Int32(X10_PJRT_TYPE_F64)
+    case .i32:  return Int32(X10_PJRT_TYPE_S32)
+    case .i64:  return Int32(X10_PJRT_TYPE_S64)
+    case .f8E4M3FN: return Int32(X10_PJRT_TYPE_F8E4M3FN)
+    case .f8E5M2:   return Int32(X10_PJRT_TYPE_F8E5M2)
+    }
+  }
+
+  static func dtype(typeCode: Int32) -> DType? {
+    switch Int(typeCode) {
+    case X10_PJRT_TYPE_F16:  return .f16
+    case X10_PJRT_TYPE_BF16: return .bf16
+    case X10_PJRT_TYPE_F32:  return .f32
+    case X10_PJRT_TYPE_F64:  return .f64
+    case X10_PJRT_TYPE_S32:  return .i32
+    case X10_PJRT_TYPE_S64:  return .i64
+    case X10_PJRT_TYPE_F8E4M3FN: return .f8E4M3FN
+    case X10_PJRT_TYPE_F8E5M2:   return .f8E5M2
+    default: return nil
+    }
+  }
+
+  /// Copies `host` into a new buffer on `device`.
+  static func upload(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, device: Int) throws -> PJRTBufferHandle {
+    guard let client = shared else { throw error("no PJRT client") }
+    let dims = shape.map(Int64.init)
+    var raw: x10_pjrt_buffer_t? = nil
+    let ok = dims.withUnsafeBufferPointer { d in
+      x10_pjrt_buffer_from_host(client, Int32(device), host.baseAddress, host.count,
+                                typeCode(dtype), d.baseAddress, d.count, &raw)
+    }
+    guard ok == 1, let raw else { throw error("PJRT buffer upload failed") }
+    return PJRTBufferHandle(raw)
+  }
+
+  /// Uploads a strided host array straight from `base`; `byteStrides` must
+  /// be positive. Real plugins only.
+  static func upload(strided base: UnsafeRawPointer, shape: [Int], byteStrides: [Int], dtype: DType,
+                     device: Int) throws -> PJRTBufferHandle {
+    guard let client = shared else { throw error("no PJRT client") }
+    let dims = shape.map(Int64.init), strides = byteStrides.map(Int64.init)
+    var raw: x10_pjrt_buffer_t? = nil
+    let ok = dims.withUnsafeBufferPointer { d in
+      strides.withUnsafeBufferPointer { s in
+        x10_pjrt_buffer_from_host_strided(client, Int32(device), base, typeCode(dtype),
+                                          d.baseAddress, s.baseAddress, d.count, &raw)
+      }
+    }
+    guard ok == 1, let raw else { throw error("PJRT strided upload failed") }
+    return PJRTBufferHandle(raw)
+  }
+
+  static func download(_ handle: PJRTBufferHandle) throws -> [UInt8] {
+    var size = 0
+    guard x10_pjrt_buffer_to_host(handle.raw, nil, 0, &size) == 1 else {
+      throw error("PJRT buffer size query failed")
+    }
+    var out = [UInt8](repeating: 0, count: size)
+    let ok = out.withUnsafeMutableBytes { x10_pjrt_buffer_to_host(handle.raw, $0.baseAddress, $0.count, &size) }
+    guard ok == 1 else { throw error("PJRT buffer download failed") }
+    return out
+  }
+}
+
+/// Owns one shim buffer; the `PJRT_Buffer` is destroyed with the last reference.
+final class PJRTBufferHandle: @unchecked Sendable {
+  let raw: x10_pjrt_buffer_t
+
+  init(_ raw: x10_pjrt_buffer_t) { self.raw = raw }
+  deinit { x10_pjrt_buffer_destroy(raw) }
+
+  var deviceOrdinal: Int { Int(x10_pjrt_buffer_device(raw)) }
+
+  var shape: [Int] {
+    var dims = [Int64](repeating: 0, count: X10_PJRT_MAX_RANK)
+    let rank = dims.withUnsafeMutableBufferPointer { x10_pjrt_buffer_dims(raw, $0.baseAddress, $0.count) }
+    return dims.prefix(rank).map(Int.init)
+  }
+
+  var dtype: DType? { PJRTClient.dtype(typeCode: x10_pjrt_buffer_type(raw)) }
+}
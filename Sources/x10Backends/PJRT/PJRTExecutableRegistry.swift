@@ -1,21 +1,33 @@
 import Foundation
 import x10Core
+import x10Diagnostics
 import PJRTC
 
 /// Thread-safe table mapping public Executable.id -> PJRT executable handle + default device ordinal.
+/// Handles are destroyed when `ExecutableCache` evicts the executable; a handle
+/// that is mid-execution is destroyed by the last `relinquish` instead.
 final class PJRTExecutableRegistry {
   static let shared = PJRTExecutableRegistry()
 
   struct Entry {
     let handle: x10_pjrt_executable_t
     let defaultDeviceOrdinal: Int32
+    var inFlight: Int = 0
+    var releasePending = false
   }
 
   private let q = DispatchQueue(label: "x10.pjrt.exec.registry")
   private var table: [UUID: Entry] = [:]
+  /// Replaced handles still running, with their in-flight count.
+  private var retired: [x10_pjrt_executable_t: Int] = [:]
 
   func put(id: UUID, handle: x10_pjrt_executable_t, defaultDeviceOrdinal: Int32) {
-    q.sync { table[id] = Entry(handle: handle, defaultDeviceOrdinal: defaultDeviceOrdinal) }
+    q.sync {
+      if let old = table[id], old.handle != handle {
+        if old.inFlight > 0 { retired[old.handle] = old.inFlight } else { destroy(old.handle) }
+      }
+      table[id] = Entry(handle: handle, defaultDeviceOrdinal: defaultDeviceOrdinal)
+    }
   }
 
   func getEntry(_ id: UUID) -> Entry? {
@@ -26,17 +38,64 @@ final class PJRTExecutableRegistry {
     q.sync { table[id]?.handle }
   }
 
+  var count: Int {
+    q.sync { table.count }
+  }
+
+  /// Pins the handle for one execute; pair with `relinquish`.
+  func acquire(_ id: UUID) -> Entry? {
+    q.sync {
+      guard var e = table[id] else { return nil }
+      e.inFlight += 1
+      table[id] = e
+      return e
+    }
+  }
+
+  /// Ends the execute that acquired `handle` (which may have been replaced since).
+  func relinquish(_ id: UUID, handle: x10_pjrt_executable_t) {
+    q.sync {
+      if let n = retired[handle] {
+        if n > 1 { retired[handle] = n - 1 } else { retired.removeValue(forKey: handle); destroy(handle) }
+        return
+      }
+      guard var e = table[id], e.handle == handle else { return }
+      e.inFlight -= 1
+      if e.inFlight == 0 && e.releasePending {
+        table.removeValue(forKey: id)
+        destroy(e.handle)
+      } else {
+        table[id] = e
+      }
+    }
+  }
+
+  /// Destroys the handle now, or after the last in-flight execute.
   func remove(_ id: UUID) {
     q.sync {
-      if let e = table.removeValue(forKey: id) { x10_pjrt_executable_destroy(e.handle) }
+      guard var e = table[id] else { return }
+      if e.inFlight > 0 {
+        e.releasePending = true
+        table[id] = e
+        return
+      }
+      table.removeValue(forKey: id)
+      destroy(e.handle)
     }
   }
 
-  /// For tests/debugging.
+  /// For tests/debugging. Handles mid-execution go with their last `relinquish`.
   func clear() {
     q.sync {
-      for (_, e) in table { x10_pjrt_executable_destroy(e.handle) }
+      for (_, e) in table {
+        if e.inFlight > 0 { retired[e.handle, default: 0] += e.inFlight } else { destroy(e.handle) }
+      }
       table.removeAll()
     }
   }
+
+  private func destroy(_ handle: x10_pjrt_executable_t) {
+    x10_pjrt_executable_destroy(handle)
+    Diagnostics.releasedArtifacts.inc()
+  }
 }
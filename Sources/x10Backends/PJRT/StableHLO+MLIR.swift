@@ -0,0 +1,77 @@
+import Foundation
+import x10Core
+
+extension StableHLOModule {
+  /// MLIR text for `PJRT_Client_Compile` (program format "mlir").
+  ///
+  /// XLA takes `@main` as the entry, so the function named `main` (else the
+  /// first one) is emitted under that name and the rest as private helpers.
+  /// Input/output aliases become `tf.aliasing_output` argument attributes.
+  func pjrtMLIR() -> String {
+    let entry = functions.firstIndex { $0.name == "main" } ?? 0
+    var out = ["module {"]
+    for (i, f) in functions.enumerated() {
+      out.append(contentsOf: Self.mlir(f, name: i == entry ? "main" : f.name, isPrivate: i != entry))
+    }
+    out.append("}")
+    return out.joined(separator: "\n")
+  }
+
+  private static func mlir(_ f: Function, name: String, isPrivate: Bool) -> [String] {
+    let aliasOf = Dictionary(f.validInputOutputAliases.map { ($0.parameter, $0.output) }, uniquingKeysWith: { a, _ in a })
+    var ssa: [String: String] = [:]
+    for (i, a) in f.args.enumerated() { ssa[a.name] = "%arg\(i)" }
+    var next = 0
+    func define(_ v: Value) -> String {
+      let id = "%\(next)"
+      next += 1
+      ssa[v.name] = id
+      return id
+    }
+    func use(_ v: Value) -> String { ssa[v.name] ?? "%\(v.name)" }
+
+    let params = f.args.enumerated().map { i, a in
+      "%arg\(i): \(tensorType(a))" + (aliasOf[i].map { " {tf.aliasing_output = \($0) : i32}" } ?? "")
+    }
+    let results = f.results.map(tensorType).joined(separator: ", ")
+    var lines = ["  func.func \(isPrivate ? "private " : "")@\(name)(\(params.joined(separator: ", "))) -> (\(results)) {"]
+    for op in f.ops {
+      switch op {
+      case .parameter(let index, let v):
+        if f.args.indices.contains(index) { ssa[v.name] = "%arg\(index)" }
+      case .add(let a, let b, let r):
+        let (x, y) = (use(a), use(b))
+        lines.append("    \(define(r)) = stablehlo.add \(x), \(y) : \(tensorType(r))")
+      case .multiply(let a, let b, let r):
+        let (x, y) = (use(a), use(b))
+        lines.append("    \(define(r)) = stablehlo.multiply \(x), \(y) : \(tensorType(r))")
+      case .dotGeneral(let a, let b, let r, let (lc, rc)):
+        let (x, y) = (use(a), use(b))
+        lines.append("    \(define(r)) = stablehlo.dot_general \(x), \(y), contracting_dims = \(lc) x \(rc) : " +
+                     "(\(tensorType(a)), \(tensorType(b))) -> \(tensorType(r))")
+      case .convert(let a, let r):
+        let x = use(a)
+        lines.append("    \(define(r)) = stablehlo.convert \(x) : (\(tensorType(a))) -> \(tensorType(r))")
+      case .returnValues(let vs):
+        lines.append("    func.return \(vs.map(use).joined(separator: ", ")) : \(vs.map(tensorType).joined(separator: ", "))")
+      }
+    }
+    lines.append("  }")
+    return lines
+  }
+
+  private static func tensorType(_ v: Value) -> String {
+    let elt: String
+    switch v.dtype {
+    case .f16:  elt = "f16"
+    case .bf16: elt = "bf16"
+    case .f32:  elt = "f32"
+    case .f64:  elt = "f64"
+    case .i32:  elt = "i32"
+    case .i64:  elt = "i64"
+    case .f8E4M3FN: elt = "f8E4M3FN"
+    case .f8E5M2:   elt = "f8E5M2"
+    }
+    return "tensor<" + (v.shape.map { $0.map(String.init) ?? "?" } + [elt]).joined(separator: "x") + ">"
+  }
+}
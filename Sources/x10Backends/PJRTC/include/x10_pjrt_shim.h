@@ -20,7 +20,7 @@ extern "C"
   // **NEW**: 1 if a real PJRT C API is loaded (not just the stub)
   int x10_pjrt_is_real(void);
 
-  // ===== Simple device enumeration (stub for now) =====
+  // ===== Simple device enumeration (shared client's devices when real) =====
   int32_t x10_pjrt_device_count(void);
   size_t x10_pjrt_device_description(int32_t index, char *buffer, size_t capacity);
 
@@ -32,6 +32,10 @@ extern "C"
   void x10_pjrt_client_destroy(x10_pjrt_client_t client);
   int x10_pjrt_client_device_count(x10_pjrt_client_t client, int32_t *out_count);
 
+  // Process-wide client, created on first call and kept until x10_pjrt_unload.
+  // x10_pjrt_client_destroy ignores it.
+  int x10_pjrt_client_shared(x10_pjrt_client_t *out_client);
+
   // ===== Opaque executable handle =====
   typedef struct x10_pjrt_executable x10_pjrt_executable;
   typedef x10_pjrt_executable *x10_pjrt_executable_t;
@@ -43,6 +47,56 @@ extern "C"
                                  x10_pjrt_executable_t *out_exec);
   void x10_pjrt_executable_destroy(x10_pjrt_executable_t exec);
   int x10_pjrt_execute(x10_pjrt_executable_t exec, int32_t device_ordinal);
+  size_t x10_pjrt_executable_num_outputs(x10_pjrt_executable_t exec);
+
+  // ===== Opaque buffer handle (a PJRT_Buffer when real, host copy in stub mode) =====
+  typedef struct x10_pjrt_buffer x10_pjrt_buffer;
+  typedef x10_pjrt_buffer *x10_pjrt_buffer_t;
+
+  // Element types; values match PJRT_Buffer_Type.
+  enum
+  {
+    X10_PJRT_TYPE_S32 = 4,
+    X10_PJRT_TYPE_S64 = 5,
+    X10_PJRT_TYPE_F16 = 10,
+    X10_PJRT_TYPE_F32 = 11,
+    X10_PJRT_TYPE_F64 = 12,
+    X10_PJRT_TYPE_BF16 = 13,
+    X10_PJRT_TYPE_F8E5M2 = 16,
+    X10_PJRT_TYPE_F8E4M3FN = 17,
+  };
+  enum
+  {
+    X10_PJRT_MAX_RANK = 16
+  };
+
+  // Copies `nbytes` from `data`; the host memory may be reused on return.
+  int x10_pjrt_buffer_from_host(x10_pjrt_client_t client, int32_t device_ordinal,
+                                const void *data, size_t nbytes, int32_t type,
+                                const int64_t *dims, size_t num_dims,
+                                x10_pjrt_buffer_t *out_buffer);
+  // Like x10_pjrt_buffer_from_host for a strided host array: `byte_strides`
+  // (positive, one per dim) describe `data`. Real PJRT only.
+  int x10_pjrt_buffer_from_host_strided(x10_pjrt_client_t client, int32_t device_ordinal,
+                                        const void *data, int32_t type,
+                                        const int64_t *dims, const int64_t *byte_strides, size_t num_dims,
+                                        x10_pjrt_buffer_t *out_buffer);
+  // With dst == NULL only reports the size in *out_written.
+  int x10_pjrt_buffer_to_host(x10_pjrt_buffer_t buffer, void *dst, size_t capacity, size_t *out_written);
+  void x10_pjrt_buffer_destroy(x10_pjrt_buffer_t buffer);
+  int32_t x10_pjrt_buffer_type(x10_pjrt_buffer_t buffer);
+  int32_t x10_pjrt_buffer_device(x10_pjrt_buffer_t buffer);
+  // Returns the rank; copies min(rank, capacity) dims.
+  size_t x10_pjrt_buffer_dims(x10_pjrt_buffer_t buffer, int64_t *dims, size_t capacity);
+
+  // Runs `exec` on one device with device-resident arguments and waits for
+  // completion. Inputs not listed in `non_donatable` may be consumed by
+  // aliased outputs. Writes up to `out_capacity` new buffers (caller owns).
+  // Real PJRT only; stub executables fail.
+  int x10_pjrt_execute_buffers(x10_pjrt_executable_t exec, int32_t device_ordinal,
+                               const x10_pjrt_buffer_t *args, size_t num_args,
+                               const int64_t *non_donatable, size_t num_non_donatable,
+                               x10_pjrt_buffer_t *outs, size_t out_capacity, size_t *out_count);
 
 #ifdef __cplusplus
 } // extern "C"
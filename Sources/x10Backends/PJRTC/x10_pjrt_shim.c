@@ -5,12 +5,16 @@
 #include <string.h>
 #include <strings.h> // strcasecmp on POSIX
 
+#include <pthread.h>
+
 #ifdef X10_PJRT_DLOPEN
 #include <dlfcn.h>
 #endif
 
 // If real headers are present, we can hold a typed API table; otherwise we just
-// check symbol presence and run in stub mode when needed.
+// check symbol presence and run in stub mode when needed. The package does not
+// vendor pjrt_c_api.h or define X10_PJRT_HAVE_HEADERS, so the real-plugin code
+// below is not compiled by the in-tree build and is untested here.
 #if defined(X10_PJRT_HAVE_HEADERS)
 // x10_pjrt_c_api_inc.h included from the header may pull pjrt_c_api.h
 static const PJRT_Api *s_api = NULL;
@@ -73,14 +77,61 @@ static int s_loaded = -1; // -1 unknown, 0 not loaded, 1 loaded (real PJRT prese
 static void *s_handle = NULL;
 #endif
 
-static const char *s_last_err = "";
+// Per-thread, so concurrent compiles/executes don't clobber each other's message.
+static _Thread_local const char *s_last_err = "";
 static void set_last_error(const char *msg)
 {
-  static char buf[256];
+  static _Thread_local char buf[256];
   copy_trunc(buf, sizeof(buf), msg ? msg : "");
   s_last_err = buf;
 }
 
+#if defined(X10_PJRT_HAVE_HEADERS)
+// Records the PJRT message as the last error and destroys `err`.
+// Returns 1 when there was no error.
+static int check(PJRT_Error *err)
+{
+  if (!err)
+    return 1;
+  PJRT_Error_Message_Args m;
+  memset(&m, 0, sizeof(m));
+  m.struct_size = PJRT_Error_Message_Args_STRUCT_SIZE;
+  m.error = err;
+  s_api->PJRT_Error_Message(&m);
+  char msg[256];
+  size_t n = m.message_size < sizeof(msg) - 1 ? m.message_size : sizeof(msg) - 1;
+  memcpy(msg, m.message ? m.message : "", m.message ? n : 0);
+  msg[m.message ? n : 0] = '\0';
+  set_last_error(msg);
+
+  PJRT_Error_Destroy_Args d;
+  memset(&d, 0, sizeof(d));
+  d.struct_size = PJRT_Error_Destroy_Args_STRUCT_SIZE;
+  d.error = err;
+  s_api->PJRT_Error_Destroy(&d);
+  return 0;
+}
+
+// Waits for and destroys `ev` (NULL is fine).
+static int await_event(PJRT_Event *ev)
+{
+  if (!ev)
+    return 1;
+  PJRT_Event_Await_Args a;
+  memset(&a, 0, sizeof(a));
+  a.struct_size = PJRT_Event_Await_Args_STRUCT_SIZE;
+  a.event = ev;
+  int ok = check(s_api->PJRT_Event_Await(&a));
+
+  PJRT_Event_Destroy_Args d;
+  memset(&d, 0, sizeof(d));
+  d.struct_size = PJRT_Event_Destroy_Args_STRUCT_SIZE;
+  d.event = ev;
+  (void)check(s_api->PJRT_Event_Destroy(&d));
+  return ok;
+}
+#endif
+
 int x10_pjrt_load(const char *explicit_path)
 {
   if (s_loaded == 1)
@@ -126,9 +177,22 @@ int x10_pjrt_load(const char *explicit_path)
       const PJRT_Api *api = sym();
       if (api)
       {
+        s_api = api;
+        if (api->PJRT_Plugin_Initialize)
+        {
+          PJRT_Plugin_Initialize_Args init;
+          memset(&init, 0, sizeof(init));
+          init.struct_size = PJRT_Plugin_Initialize_Args_STRUCT_SIZE;
+          if (!check(api->PJRT_Plugin_Initialize(&init)))
+          {
+            s_api = NULL;
+            dlclose(s_handle);
+            s_handle = NULL;
+            continue;
+          }
+        }
         s_loaded = 1;
         s_last_err = "";
-        s_api = api;
         return 1;
       }
 #else
@@ -151,8 +215,11 @@ int x10_pjrt_load(const char *explicit_path)
 #endif
 }
 
+static void destroy_shared_client(void);
+
 void x10_pjrt_unload(void)
 {
+  destroy_shared_client();
 #ifdef X10_PJRT_DLOPEN
   if (s_handle)
   {
@@ -180,33 +247,60 @@ int x10_pjrt_is_available(void)
   return (s_loaded == 1) || 1;
 }
 
-// ---------- Stubbed device enumeration (no client) ----------
+// ---------- Client API (real PJRT_Client when headers + plugin are present) ----------
 
-int32_t x10_pjrt_device_count(void)
+// Opaque body (private to C side)
+struct x10_pjrt_client
 {
-  int n = getenv_int("X10_PJRT_STUB_DEVICE_COUNT", 1);
-  if (n < 0)
-    n = 0;
-  return (int32_t)n;
-}
+  int stub;
+#if defined(X10_PJRT_HAVE_HEADERS)
+  PJRT_Client *client;
+  PJRT_Device *const *devices; // addressable devices, owned by the client
+  size_t num_devices;
+#endif
+};
 
-size_t x10_pjrt_device_description(int32_t index, char *buffer, size_t capacity)
+static pthread_mutex_t s_client_mu = PTHREAD_MUTEX_INITIALIZER;
+static x10_pjrt_client_t s_shared_client = NULL;
+
+#if defined(X10_PJRT_HAVE_HEADERS)
+static int client_create_real(x10_pjrt_client_t c)
 {
-  char tmp[64];
-  snprintf(tmp, sizeof(tmp), "gpu:%d (stub%s)", (int)index, (s_loaded == 1 ? "+pjrt" : ""));
-  size_t need = strlen(tmp);
-  if (capacity > 0 && buffer)
-    copy_trunc(buffer, capacity, tmp);
-  return need;
-}
+  PJRT_Client_Create_Args a;
+  memset(&a, 0, sizeof(a));
+  a.struct_size = PJRT_Client_Create_Args_STRUCT_SIZE;
+  if (!check(s_api->PJRT_Client_Create(&a)))
+    return 0;
 
-// ---------- Client API (stub now; real path when headers present) ----------
+  PJRT_Client_AddressableDevices_Args d;
+  memset(&d, 0, sizeof(d));
+  d.struct_size = PJRT_Client_AddressableDevices_Args_STRUCT_SIZE;
+  d.client = a.client;
+  if (!check(s_api->PJRT_Client_AddressableDevices(&d)))
+  {
+    PJRT_Client_Destroy_Args x;
+    memset(&x, 0, sizeof(x));
+    x.struct_size = PJRT_Client_Destroy_Args_STRUCT_SIZE;
+    x.client = a.client;
+    (void)check(s_api->PJRT_Client_Destroy(&x));
+    return 0;
+  }
+  c->client = a.client;
+  c->devices = d.addressable_devices;
+  c->num_devices = d.num_addressable_devices;
+  return 1;
+}
 
-// Opaque body (private to C side)
-struct x10_pjrt_client
+static PJRT_Device *client_device(x10_pjrt_client_t c, int32_t ordinal)
 {
-  int stub;
-};
+  if (!c || c->stub || ordinal < 0 || (size_t)ordinal >= c->num_devices)
+  {
+    set_last_error("device ordinal out of range");
+    return NULL;
+  }
+  return c->devices[ordinal];
+}
+#endif
 
 int x10_pjrt_client_create(x10_pjrt_client_t *out_client)
 {
@@ -216,41 +310,87 @@ int x10_pjrt_client_create(x10_pjrt_client_t *out_client)
     return 0;
   }
 
+  // Allocate the underlying struct and return a typed pointer.
+  x10_pjrt_client_t c = (x10_pjrt_client_t)calloc(1, sizeof(struct x10_pjrt_client));
+  if (!c)
+  {
+    set_last_error("malloc failed");
+    return 0;
+  }
+  c->stub = 1;
+
 #if defined(X10_PJRT_HAVE_HEADERS)
   if (s_loaded != 1)
     (void)x10_pjrt_load(NULL);
   if (s_loaded == 1 && s_api)
   {
-    // TODO: wire PJRT_Client_Create once headers are vendored.
-    // For now fall through to stub.
+    if (!client_create_real(c))
+    {
+      free(c);
+      return 0;
+    }
+    c->stub = 0;
   }
 #endif
 
-  // Allocate the underlying struct and return a typed pointer.
-  x10_pjrt_client_t c = (x10_pjrt_client_t)malloc(sizeof(struct x10_pjrt_client));
-  if (!c)
-  {
-    set_last_error("malloc failed");
-    return 0;
-  }
-  c->stub = 1;
   *out_client = c;
   return 1;
 }
 
-void x10_pjrt_client_destroy(x10_pjrt_client_t client)
+static void client_free(x10_pjrt_client_t client)
 {
-  if (!client)
-    return;
 #if defined(X10_PJRT_HAVE_HEADERS)
-  if (s_loaded == 1 && s_api)
+  if (!client->stub && s_api)
   {
-    // TODO: PJRT_Client_Destroy when real client is used.
+    PJRT_Client_Destroy_Args a;
+    memset(&a, 0, sizeof(a));
+    a.struct_size = PJRT_Client_Destroy_Args_STRUCT_SIZE;
+    a.client = client->client;
+    (void)check(s_api->PJRT_Client_Destroy(&a));
   }
 #endif
   free(client);
 }
 
+void x10_pjrt_client_destroy(x10_pjrt_client_t client)
+{
+  if (!client)
+    return;
+  pthread_mutex_lock(&s_client_mu);
+  int shared = (client == s_shared_client);
+  pthread_mutex_unlock(&s_client_mu);
+  if (!shared)
+    client_free(client);
+}
+
+int x10_pjrt_client_shared(x10_pjrt_client_t *out_client)
+{
+  if (!out_client)
+  {
+    set_last_error("null out_client");
+    return 0;
+  }
+  pthread_mutex_lock(&s_client_mu);
+  int ok = 1;
+  if (!s_shared_client)
+    ok = x10_pjrt_client_create(&s_shared_client);
+  *out_client = s_shared_client;
+  pthread_mutex_unlock(&s_client_mu);
+  return ok;
+}
+
+// Called by x10_pjrt_unload; every executable and buffer made from the
+// shared client must be gone by then.
+static void destroy_shared_client(void)
+{
+  pthread_mutex_lock(&s_client_mu);
+  x10_pjrt_client_t c = s_shared_client;
+  s_shared_client = NULL;
+  pthread_mutex_unlock(&s_client_mu);
+  if (c)
+    client_free(c);
+}
+
 int x10_pjrt_client_device_count(x10_pjrt_client_t client, int32_t *out_count)
 {
   if (!client || !out_count)
@@ -260,9 +400,10 @@ int x10_pjrt_client_device_count(x10_pjrt_client_t client, int32_t *out_count)
   }
 
 #if defined(X10_PJRT_HAVE_HEADERS)
-  if (s_loaded == 1 && s_api)
+  if (!client->stub)
   {
-    // TODO: query real devices; fall through to stub for now.
+    *out_count = (int32_t)client->num_devices;
+    return 1;
   }
 #endif
 
@@ -270,47 +411,162 @@ int x10_pjrt_client_device_count(x10_pjrt_client_t client, int32_t *out_count)
   return 1;
 }
 
-// ... keep your existing includes, helpers, loader and client code ...
+// ---------- Device enumeration ----------
 
-// ---------- Executable (stub now; real path when headers present) ----------
+int32_t x10_pjrt_device_count(void)
+{
+#if defined(X10_PJRT_HAVE_HEADERS)
+  x10_pjrt_client_t c = NULL;
+  if (x10_pjrt_is_real() && x10_pjrt_client_shared(&c) && c && !c->stub)
+    return (int32_t)c->num_devices;
+#endif
+  int n = getenv_int("X10_PJRT_STUB_DEVICE_COUNT", 1);
+  if (n < 0)
+    n = 0;
+  return (int32_t)n;
+}
+
+size_t x10_pjrt_device_description(int32_t index, char *buffer, size_t capacity)
+{
+  char tmp[128];
+  snprintf(tmp, sizeof(tmp), "gpu:%d (stub%s)", (int)index, (s_loaded == 1 ? "+pjrt" : ""));
+
+#if defined(X10_PJRT_HAVE_HEADERS)
+  x10_pjrt_client_t c = NULL;
+  if (x10_pjrt_is_real() && x10_pjrt_client_shared(&c) && c && !c->stub &&
+      index >= 0 && (size_t)index < c->num_devices)
+  {
+    PJRT_Device_GetDescription_Args g;
+    memset(&g, 0, sizeof(g));
+    g.struct_size = PJRT_Device_GetDescription_Args_STRUCT_SIZE;
+    g.device = c->devices[index];
+    if (check(s_api->PJRT_Device_GetDescription(&g)))
+    {
+      PJRT_DeviceDescription_ToString_Args t;
+      memset(&t, 0, sizeof(t));
+      t.struct_size = PJRT_DeviceDescription_ToString_Args_STRUCT_SIZE;
+      t.device_description = g.device_description;
+      if (check(s_api->PJRT_DeviceDescription_ToString(&t)) && t.to_string)
+      {
+        size_t n = t.to_string_size < sizeof(tmp) - 1 ? t.to_string_size : sizeof(tmp) - 1;
+        memcpy(tmp, t.to_string, n);
+        tmp[n] = '\0';
+      }
+    }
+  }
+#endif
+
+  size_t need = strlen(tmp);
+  if (capacity > 0 && buffer)
+    copy_trunc(buffer, capacity, tmp);
+  return need;
+}
+
+// ---------- Executable (real PJRT_LoadedExecutable when the client is real) ----------
 
 struct x10_pjrt_executable
 {
   int stub;
   int id;
+  size_t num_outputs;
+#if defined(X10_PJRT_HAVE_HEADERS)
+  x10_pjrt_client_t client;
+  PJRT_LoadedExecutable *loaded;
+#endif
 };
 static int s_next_exec_id = 1;
 
+#if defined(X10_PJRT_HAVE_HEADERS)
+// Serialized xla.CompileOptionsProto: executable_build_options
+// { num_replicas: 1, num_partitions: 1 }, compile_portable_executable: true.
+// Portable executables can run on any addressable device via execute_device.
+static const char k_compile_options[] = {0x1A, 0x04, 0x20, 0x01, 0x28, 0x01, 0x20, 0x01};
+
+static int compile_real(x10_pjrt_client_t client, const char *text, size_t text_len,
+                        x10_pjrt_executable_t e)
+{
+  PJRT_Program prog;
+  memset(&prog, 0, sizeof(prog));
+  prog.struct_size = PJRT_Program_STRUCT_SIZE;
+  prog.code = (char *)text;
+  prog.code_size = text_len;
+  prog.format = "mlir";
+  prog.format_size = 4;
+
+  PJRT_Client_Compile_Args a;
+  memset(&a, 0, sizeof(a));
+  a.struct_size = PJRT_Client_Compile_Args_STRUCT_SIZE;
+  a.client = client->client;
+  a.program = &prog;
+  a.compile_options = k_compile_options;
+  a.compile_options_size = sizeof(k_compile_options);
+  if (!check(s_api->PJRT_Client_Compile(&a)))
+    return 0;
+
+  PJRT_LoadedExecutable_GetExecutable_Args g;
+  memset(&g, 0, sizeof(g));
+  g.struct_size = PJRT_LoadedExecutable_GetExecutable_Args_STRUCT_SIZE;
+  g.loaded_executable = a.executable;
+  size_t num_outputs = 0;
+  if (check(s_api->PJRT_LoadedExecutable_GetExecutable(&g)))
+  {
+    PJRT_Executable_NumOutputs_Args n;
+    memset(&n, 0, sizeof(n));
+    n.struct_size = PJRT_Executable_NumOutputs_Args_STRUCT_SIZE;
+    n.executable = g.executable;
+    if (check(s_api->PJRT_Executable_NumOutputs(&n)))
+      num_outputs = n.num_outputs;
+    PJRT_Executable_Destroy_Args d;
+    memset(&d, 0, sizeof(d));
+    d.struct_size = PJRT_Executable_Destroy_Args_STRUCT_SIZE;
+    d.executable = g.executable;
+    (void)check(s_api->PJRT_Executable_Destroy(&d));
+  }
+
+  e->stub = 0;
+  e->client = client;
+  e->loaded = a.executable;
+  e->num_outputs = num_outputs;
+  return 1;
+}
+#endif
+
+// `options_json` is informational; the real path always compiles a
+// single-replica portable executable (see k_compile_options).
 int x10_pjrt_compile_stablehlo(x10_pjrt_client_t client,
                                const char *stablehlo_text,
                                size_t text_len,
                                const char *options_json,
                                x10_pjrt_executable_t *out_exec)
 {
+  (void)options_json;
   if (!client || !out_exec || !stablehlo_text)
   {
     set_last_error("null arg");
     return 0;
   }
 
-#if defined(X10_PJRT_HAVE_HEADERS)
-  if (s_loaded != 1)
-    (void)x10_pjrt_load(NULL);
-  if (s_loaded == 1 && s_api)
-  {
-    // TODO: call real PJRT compile here (guarded)
-    // For now, fall through to stub so code runs everywhere.
-  }
-#endif
-
-  x10_pjrt_executable_t e = (x10_pjrt_executable_t)malloc(sizeof(struct x10_pjrt_executable));
+  x10_pjrt_executable_t e = (x10_pjrt_executable_t)calloc(1, sizeof(struct x10_pjrt_executable));
   if (!e)
   {
     set_last_error("malloc failed");
     return 0;
   }
   e->stub = 1;
+
+#if defined(X10_PJRT_HAVE_HEADERS)
+  if (!client->stub && s_api && !compile_real(client, stablehlo_text, text_len, e))
+  {
+    free(e);
+    return 0;
+  }
+#else
+  (void)text_len;
+#endif
+
+  pthread_mutex_lock(&s_client_mu);
   e->id = s_next_exec_id++;
+  pthread_mutex_unlock(&s_client_mu);
   *out_exec = e;
   return 1;
 }
@@ -320,14 +576,24 @@ void x10_pjrt_executable_destroy(x10_pjrt_executable_t exec)
   if (!exec)
     return;
 #if defined(X10_PJRT_HAVE_HEADERS)
-  if (s_loaded == 1 && s_api)
+  if (!exec->stub && s_api)
   {
-    // TODO: destroy real PJRT executable when used.
+    PJRT_LoadedExecutable_Destroy_Args a;
+    memset(&a, 0, sizeof(a));
+    a.struct_size = PJRT_LoadedExecutable_Destroy_Args_STRUCT_SIZE;
+    a.executable = exec->loaded;
+    (void)check(s_api->PJRT_LoadedExecutable_Destroy(&a));
   }
 #endif
   free(exec);
 }
 
+size_t x10_pjrt_executable_num_outputs(x10_pjrt_executable_t exec)
+{
+  return exec ? exec->num_outputs : 0;
+}
+
+// Stub executables do nothing; real ones are run with x10_pjrt_execute_buffers.
 int x10_pjrt_execute(x10_pjrt_executable_t exec, int32_t device_ordinal)
 {
   if (!exec)
@@ -335,33 +601,393 @@ int x10_pjrt_execute(x10_pjrt_executable_t exec, int32_t device_ordinal)
     set_last_error("null exec");
     return 0;
   }
+  (void)device_ordinal;
+  return 1; // stub success
+}
+
+// ---------- Buffers ----------
+
+struct x10_pjrt_buffer
+{
+  int32_t device;
+  int32_t type;
+  size_t num_dims;
+  int64_t dims[X10_PJRT_MAX_RANK];
+  void *host; // stub storage
+  size_t host_size;
 #if defined(X10_PJRT_HAVE_HEADERS)
-  if (s_loaded == 1 && s_api)
+  PJRT_Buffer *buffer;
+#endif
+};
+
+static x10_pjrt_buffer_t buffer_new(int32_t device, int32_t type, const int64_t *dims, size_t num_dims)
+{
+  if (num_dims > X10_PJRT_MAX_RANK)
   {
-    // TODO: real enqueue/execute via PJRT (streams/events later).
-    // For now, fall through to stub.
+    set_last_error("rank exceeds X10_PJRT_MAX_RANK");
+    return NULL;
   }
+  x10_pjrt_buffer_t b = (x10_pjrt_buffer_t)calloc(1, sizeof(struct x10_pjrt_buffer));
+  if (!b)
+  {
+    set_last_error("malloc failed");
+    return NULL;
+  }
+  b->device = device;
+  b->type = type;
+  b->num_dims = num_dims;
+  if (num_dims)
+    memcpy(b->dims, dims, num_dims * sizeof(int64_t));
+  return b;
+}
+
+#if defined(X10_PJRT_HAVE_HEADERS)
+// Wraps an output PJRT_Buffer, reading its type and dims back from PJRT.
+static x10_pjrt_buffer_t buffer_wrap(PJRT_Buffer *pb, int32_t device)
+{
+  PJRT_Buffer_ElementType_Args t;
+  memset(&t, 0, sizeof(t));
+  t.struct_size = PJRT_Buffer_ElementType_Args_STRUCT_SIZE;
+  t.buffer = pb;
+  (void)check(s_api->PJRT_Buffer_ElementType(&t));
+
+  PJRT_Buffer_Dimensions_Args d;
+  memset(&d, 0, sizeof(d));
+  d.struct_size = PJRT_Buffer_Dimensions_Args_STRUCT_SIZE;
+  d.buffer = pb;
+  if (!check(s_api->PJRT_Buffer_Dimensions(&d)))
+    d.num_dims = 0;
+
+  x10_pjrt_buffer_t b = buffer_new(device, (int32_t)t.type, d.dims, d.num_dims);
+  if (b)
+    b->buffer = pb;
+  return b;
+}
+
+static void pjrt_buffer_destroy(PJRT_Buffer *pb)
+{
+  PJRT_Buffer_Destroy_Args a;
+  memset(&a, 0, sizeof(a));
+  a.struct_size = PJRT_Buffer_Destroy_Args_STRUCT_SIZE;
+  a.buffer = pb;
+  (void)check(s_api->PJRT_Buffer_Destroy(&a));
+}
 #endif
-  (void)device_ordinal;
-  return 1; // stub success
+
+int x10_pjrt_buffer_from_host(x10_pjrt_client_t client, int32_t device_ordinal,
+                              const void *data, size_t nbytes, int32_t type,
+                              const int64_t *dims, size_t num_dims,
+                              x10_pjrt_buffer_t *out_buffer)
+{
+  if (!client || !out_buffer || (!data && nbytes) || (!dims && num_dims))
+  {
+    set_last_error("null arg");
+    return 0;
+  }
+  x10_pjrt_buffer_t b = buffer_new(device_ordinal, type, dims, num_dims);
+  if (!b)
+    return 0;
+
+#if defined(X10_PJRT_HAVE_HEADERS)
+  if (!client->stub && s_api)
+  {
+    PJRT_Device *dev = client_device(client, device_ordinal);
+    if (!dev)
+    {
+      free(b);
+      return 0;
+    }
+    PJRT_Client_BufferFromHostBuffer_Args a;
+    memset(&a, 0, sizeof(a));
+    a.struct_size = PJRT_Client_BufferFromHostBuffer_Args_STRUCT_SIZE;
+    a.client = client->client;
+    a.data = data;
+    a.type = (PJRT_Buffer_Type)type;
+    a.dims = dims;
+    a.num_dims = num_dims;
+    a.host_buffer_semantics = PJRT_HostBufferSemantics_kImmutableOnlyDuringCall;
+    a.device = dev;
+    if (!check(s_api->PJRT_Client_BufferFromHostBuffer(&a)))
+    {
+      free(b);
+      return 0;
+    }
+    if (!await_event(a.done_with_host_buffer))
+    {
+      pjrt_buffer_destroy(a.buffer);
+      free(b);
+      return 0;
+    }
+    b->buffer = a.buffer;
+    *out_buffer = b;
+    return 1;
+  }
+#endif
+
+  b->host = malloc(nbytes ? nbytes : 1);
+  if (!b->host)
+  {
+    free(b);
+    set_last_error("malloc failed");
+    return 0;
+  }
+  if (nbytes)
+    memcpy(b->host, data, nbytes);
+  b->host_size = nbytes;
+  *out_buffer = b;
+  return 1;
 }
 
-int x10_pjrt_is_real(void)
+int x10_pjrt_buffer_from_host_strided(x10_pjrt_client_t client, int32_t device_ordinal,
+                                      const void *data, int32_t type,
+                                      const int64_t *dims, const int64_t *byte_strides, size_t num_dims,
+                                      x10_pjrt_buffer_t *out_buffer)
 {
+  if (!client || !out_buffer || !data || !byte_strides || (!dims && num_dims))
+  {
+    set_last_error("null arg");
+    return 0;
+  }
 #if defined(X10_PJRT_HAVE_HEADERS)
-  if (s_loaded == -1)
-    (void)x10_pjrt_load(NULL);
+  if (!client->stub && s_api)
+  {
+    PJRT_Device *dev = client_device(client, device_ordinal);
+    x10_pjrt_buffer_t b = dev ? buffer_new(device_ordinal, type, dims, num_dims) : NULL;
+    if (!b)
+      return 0;
+    PJRT_Client_BufferFromHostBuffer_Args a;
+    memset(&a, 0, sizeof(a));
+    a.struct_size = PJRT_Client_BufferFromHostBuffer_Args_STRUCT_SIZE;
+    a.client = client->client;
+    a.data = data;
+    a.type = (PJRT_Buffer_Type)type;
+    a.dims = dims;
+    a.num_dims = num_dims;
+    a.byte_strides = byte_strides;
+    a.num_byte_strides = num_dims;
+    a.host_buffer_semantics = PJRT_HostBufferSemantics_kImmutableOnlyDuringCall;
+    a.device = dev;
+    if (!check(s_api->PJRT_Client_BufferFromHostBuffer(&a)))
+    {
+      free(b);
+      return 0;
+    }
+    if (!await_event(a.done_with_host_buffer))
+    {
+      pjrt_buffer_destroy(a.buffer);
+      free(b);
+      return 0;
+    }
+    b->buffer = a.buffer;
+    *out_buffer = b;
+    return 1;
+  }
+#else
+  (void)device_ordinal;
+  (void)type;
+#endif
+  set_last_error("strided upload needs a real PJRT client");
+  return 0;
+}
+
+int x10_pjrt_buffer_to_host(x10_pjrt_buffer_t buffer, void *dst, size_t capacity, size_t *out_written)
+{
+  if (!buffer || !out_written)
+  {
+    set_last_error("null arg");
+    return 0;
+  }
+
 #if defined(X10_PJRT_HAVE_HEADERS)
-  return (s_loaded == 1
+  if (buffer->buffer)
+  {
+    // A NULL dst asks PJRT for the required size.
+    PJRT_Buffer_ToHostBuffer_Args q;
+    memset(&q, 0, sizeof(q));
+    q.struct_size = PJRT_Buffer_ToHostBuffer_Args_STRUCT_SIZE;
+    q.src = buffer->buffer;
+    if (!check(s_api->PJRT_Buffer_ToHostBuffer(&q)))
+      return 0;
+    *out_written = q.dst_size;
+    if (!dst)
+      return 1;
+    if (capacity < q.dst_size)
+    {
+      set_last_error("destination too small");
+      return 0;
+    }
+
+    PJRT_Buffer_ToHostBuffer_Args a;
+    memset(&a, 0, sizeof(a));
+    a.struct_size = PJRT_Buffer_ToHostBuffer_Args_STRUCT_SIZE;
+    a.src = buffer->buffer;
+    a.dst = dst;
+    a.dst_size = q.dst_size;
+    if (!check(s_api->PJRT_Buffer_ToHostBuffer(&a)))
+      return 0;
+    return await_event(a.event);
+  }
+#endif
+
+  *out_written = buffer->host_size;
+  if (!dst)
+    return 1;
+  if (capacity < buffer->host_size)
+  {
+    set_last_error("destination too small");
+    return 0;
+  }
+  if (buffer->host_size)
+    memcpy(dst, buffer->host, buffer->host_size);
+  return 1;
+}
+
+void x10_pjrt_buffer_destroy(x10_pjrt_buffer_t buffer)
+{
+  if (!buffer)
+    return;
 #if defined(X10_PJRT_HAVE_HEADERS)
-          && s_api != NULL
+  if (buffer->buffer && s_api)
+    pjrt_buffer_destroy(buffer->buffer);
 #endif
-          )
-             ? 1
-             : 0;
+  free(buffer->host);
+  free(buffer);
+}
+
+int32_t x10_pjrt_buffer_type(x10_pjrt_buffer_t buffer)
+{
+  return buffer ? buffer->type : 0;
+}
+
+int32_t x10_pjrt_buffer_device(x10_pjrt_buffer_t buffer)
+{
+  return buffer ? buffer->device : -1;
+}
+
+size_t x10_pjrt_buffer_dims(x10_pjrt_buffer_t buffer, int64_t *dims, size_t capacity)
+{
+  if (!buffer)
+    return 0;
+  size_t n = buffer->num_dims < capacity ? buffer->num_dims : capacity;
+  if (dims && n)
+    memcpy(dims, buffer->dims, n * sizeof(int64_t));
+  return buffer->num_dims;
+}
+
+// ---------- Execute on device-resident buffers ----------
+
+int x10_pjrt_execute_buffers(x10_pjrt_executable_t exec, int32_t device_ordinal,
+                             const x10_pjrt_buffer_t *args, size_t num_args,
+                             const int64_t *non_donatable, size_t num_non_donatable,
+                             x10_pjrt_buffer_t *outs, size_t out_capacity, size_t *out_count)
+{
+  if (!exec || !out_count || (!args && num_args) || (!outs && out_capacity))
+  {
+    set_last_error("null arg");
+    return 0;
+  }
+  *out_count = 0;
+
+#if defined(X10_PJRT_HAVE_HEADERS)
+  if (!exec->stub && s_api)
+  {
+    PJRT_Device *dev = client_device(exec->client, device_ordinal);
+    if (!dev)
+      return 0;
+    if (out_capacity < exec->num_outputs)
+    {
+      set_last_error("output array too small");
+      return 0;
+    }
+
+    PJRT_Buffer **argv = (PJRT_Buffer **)calloc(num_args ? num_args : 1, sizeof(PJRT_Buffer *));
+    PJRT_Buffer **outv = (PJRT_Buffer **)calloc(exec->num_outputs ? exec->num_outputs : 1, sizeof(PJRT_Buffer *));
+    if (!argv || !outv)
+    {
+      free(argv);
+      free(outv);
+      set_last_error("malloc failed");
+      return 0;
+    }
+    for (size_t i = 0; i < num_args; ++i)
+    {
+      if (!args[i] || !args[i]->buffer)
+      {
+        free(argv);
+        free(outv);
+        set_last_error("argument is not a device buffer");
+        return 0;
+      }
+      argv[i] = args[i]->buffer;
+    }
+
+    PJRT_ExecuteOptions opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.struct_size = PJRT_ExecuteOptions_STRUCT_SIZE;
+    opts.non_donatable_input_indices = non_donatable;
+    opts.num_non_donatable_input_indices = num_non_donatable;
+
+    PJRT_Buffer *const *arg_lists[1] = {argv};
+    PJRT_Buffer **out_lists[1] = {outv};
+    PJRT_Event *done[1] = {NULL};
+
+    PJRT_LoadedExecutable_Execute_Args a;
+    memset(&a, 0, sizeof(a));
+    a.struct_size = PJRT_LoadedExecutable_Execute_Args_STRUCT_SIZE;
+    a.executable = exec->loaded;
+    a.options = &opts;
+    a.argument_lists = arg_lists;
+    a.num_devices = 1;
+    a.num_args = num_args;
+    a.output_lists = out_lists;
+    a.device_complete_events = done;
+    a.execute_device = dev;
+
+    int ok = check(s_api->PJRT_LoadedExecutable_Execute(&a));
+    if (ok)
+      ok = await_event(done[0]);
+
+    size_t n = 0;
+    for (size_t i = 0; i < exec->num_outputs; ++i)
+    {
+      if (!outv[i])
+        continue;
+      x10_pjrt_buffer_t b = ok ? buffer_wrap(outv[i], device_ordinal) : NULL;
+      if (!b)
+      {
+        pjrt_buffer_destroy(outv[i]);
+        ok = 0;
+        continue;
+      }
+      outs[n++] = b;
+    }
+    if (!ok)
+    {
+      for (size_t i = 0; i < n; ++i)
+        x10_pjrt_buffer_destroy(outs[i]);
+      n = 0;
+    }
+    free(argv);
+    free(outv);
+    *out_count = n;
+    return ok;
+  }
 #else
-  return 0;
+  (void)device_ordinal;
+  (void)non_donatable;
+  (void)num_non_donatable;
 #endif
+
+  set_last_error("stub executable cannot run device buffers");
+  return 0;
+}
+
+int x10_pjrt_is_real(void)
+{
+#if defined(X10_PJRT_HAVE_HEADERS)
+  if (s_loaded == -1)
+    (void)x10_pjrt_load(NULL);
+  return (s_loaded == 1 && s_api != NULL) ? 1 : 0;
 #else
   (void)s_loaded;
   return 0;
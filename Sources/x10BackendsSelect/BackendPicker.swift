@@ -2,7 +2,7 @@ import Foundation
 import x10BackendsPJRT
 import x10BackendsIREE
 
-public enum BackendKind: String {
+public enum BackendKind: String, Sendable {
   case pjrt, iree
 }
 
@@ -13,6 +13,8 @@ public enum SelectedBackend {
 
 public enum BackendPicker {
   /// Decide from (1) options.flags["backend"], (2) env X10_BACKEND, (3) availability.
+  /// `auto` is an alias of the availability default; per-executable routing
+  /// by latency is opt-in through `BackendRouter`.
   public static func choose(kindOverride: String? = nil) -> BackendKind {
     let env = ProcessInfo.processInfo.environment
     let raw = kindOverride?.lowercased()
@@ -23,7 +25,7 @@ public enum BackendPicker {
     switch raw {
     case "iree": return .iree
     case "pjrt": return .pjrt
-    case .none:
+    case .none, "auto":
       if runtimeRequested { return .iree }
       // Heuristic default: prefer IREE when available (for edge/AOT), else PJRT.
       return IREEBackend.isAvailable ? .iree : .pjrt
@@ -32,6 +34,15 @@ public enum BackendPicker {
     }
   }
 
+  /// Backends that can really execute here: PJRT with a plugin loaded, IREE
+  /// with its tools or runtime. Falls back to `choose()` when neither can.
+  public static func availableKinds() -> [BackendKind] {
+    var kinds: [BackendKind] = []
+    if PJRTBackend.isPluginLoaded { kinds.append(.pjrt) }
+    if IREEBackend.isAvailable || IREEBackend.isReal { kinds.append(.iree) }
+    return kinds.isEmpty ? [choose()] : kinds
+  }
+
   /// Construct a backend instance of the chosen kind.
   public static func make(_ kind: BackendKind? = nil) -> SelectedBackend {
     switch kind ?? choose() {
@@ -0,0 +1,115 @@
+import Foundation
+import x10Core
+import x10Runtime
+import x10Diagnostics
+import x10BackendsPJRT
+import x10BackendsIREE
+
+/// One argument of a routed call, as host bytes.
+public struct RoutedInput: Sendable {
+  public var data: Data
+  public var shape: [Int]
+  public var dtype: DType
+
+  public init(_ data: Data, shape: [Int], dtype: DType) {
+    self.data = data
+    self.shape = shape
+    self.dtype = dtype
+  }
+}
+
+/// Runs each executable on whichever backend has measured fastest for it.
+///
+/// Calls are keyed by `JIT.routeKey` (IR, shape bucket, device, precision and
+/// flags, without the backend), and a `LatencyRouter` explores every
+/// candidate backend per key before settling on the winner. The timed span
+/// is upload + execute + readback, since that is what a caller of `run`
+/// waits for; compilation happens before the clock starts. Each backend
+/// compiles through `JIT.compileCached`, so explored executables stay cached.
+/// A backend whose compile or run throws is reported to the router, which
+/// stops choosing it for that key, and the call falls back to the next one.
+public final class BackendRouter: Sendable {
+  /// Routes over `BackendPicker.availableKinds()` with decisions in
+  /// `LatencyRouter.defaultStoreURL()`.
+  public static let shared = BackendRouter()
+
+  public let candidates: [BackendKind]
+  public let latency: LatencyRouter
+  private let pjrt = PJRTBackend()
+  private let iree = IREEBackend()
+
+  public init(candidates: [BackendKind] = BackendPicker.availableKinds(), latency: LatencyRouter = LatencyRouter()) {
+    precondition(!candidates.isEmpty, "BackendRouter needs at least one candidate")
+    self.candidates = candidates
+    self.latency = latency
+  }
+
+  /// Backend the next `run` of `module` under `options` would use.
+  public func choose(_ module: StableHLOModule, options: CompileOptions = .init()) -> BackendKind {
+    choose(key: JIT.routeKey(for: module, options: options))
+  }
+
+  /// Compiles `module` for the chosen backend (cached), runs it on
+  /// `options.device` (else `DeviceScope.current`, as in the key) and returns
+  /// every output's host bytes. Rethrows the last error once every
+  /// candidate has failed.
+  public func run(_ module: StableHLOModule, inputs: [RoutedInput],
+                  options: CompileOptions = .init()) async throws -> [Data] {
+    var opts = options
+    if opts.device == nil { opts.device = DeviceScope.current }
+    let key = JIT.routeKey(for: module, options: opts)
+    var tried: Set<BackendKind> = []
+    while true {
+      let kind = choose(key: key)
+      do {
+        switch kind {
+        case .pjrt: return try await run(module, inputs: inputs, options: opts, on: pjrt, kind: .pjrt, key: key)
+        case .iree: return try await run(module, inputs: inputs, options: opts, on: iree, kind: .iree, key: key)
+        }
+      } catch is CancellationError {
+        throw CancellationError()
+      } catch {
+        latency.recordFailure(key, candidate: kind.rawValue)
+        tried.insert(kind)
+        guard candidates.contains(where: { !tried.contains($0) }) else { throw error }
+      }
+    }
+  }
+
+  /// Per-key decisions and measured latencies.
+  public func routes() -> [LatencyRoute] { latency.routes() }
+
+  private var names: [String] { candidates.map(\.rawValue) }
+
+  private func choose(key: String) -> BackendKind {
+    BackendKind(rawValue: latency.choose(key, among: names)) ?? candidates[0]
+  }
+
+  private func run<B: Backend>(_ module: StableHLOModule, inputs: [RoutedInput], options: CompileOptions,
+                               on backend: B, kind: BackendKind, key: String) async throws -> [Data] {
+    let exec = try await JIT.compileCached(module, with: backend, options: options)
+    // Both backends list their devices by ordinal.
+    let ordinal: Int
+    switch options.device ?? DeviceScope.current {
+    case .cpu(let n), .gpu(let n): ordinal = n
+    }
+    let devices = try backend.devices()
+    guard devices.indices.contains(ordinal) else {
+      throw NSError(domain: "BackendRouter", code: 1,
+                    userInfo: [NSLocalizedDescriptionKey: "\(kind.rawValue) has no device \(ordinal) (\(devices.count) available)"])
+    }
+    let device = devices[ordinal]
+
+    let start = Metrics.nowNanos()
+    let buffers = try inputs.map { input in
+      try input.data.withUnsafeBytes {
+        try backend.toDevice($0, shape: input.shape, dtype: input.dtype, on: device, precision: options.precision)
+      }
+    }
+    // The uploads are private to this call, so all of them can be donated.
+    let outputs = try await backend.execute(exec, inputs: buffers, donating: Set(buffers.indices), stream: nil)
+    let host = try outputs.map { Data(try backend.fromDevice($0)) }
+    latency.record(key, candidate: kind.rawValue, nanos: Metrics.nowNanos() &- start, among: names)
+    return host
+  }
+}
@@ -9,6 +9,8 @@ public extension DType {
     case .f64: return "f64"
     case .i32: return "i32"
     case .i64: return "i64"
+    case .f8E4M3FN: return "f8E4M3FN"
+    case .f8E5M2: return "f8E5M2"
     }
   }
 
@@ -20,12 +22,15 @@ public extension DType {
     case "f64": return .f64
     case "i32": return .i32
     case "i64": return .i64
+    case "f8E4M3FN": return .f8E4M3FN
+    case "f8E5M2": return .f8E5M2
     default: return nil
     }
   }
 
   var byteWidth: Int {
     switch self {
+    case .f8E4M3FN, .f8E5M2: return 1
     case .f16, .bf16: return 2
     case .f32, .i32:  return 4
     case .i64, .f64:  return 8
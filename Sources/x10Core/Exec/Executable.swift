@@ -2,6 +2,65 @@ import Foundation
 
 public struct Executable: Sendable, Equatable {
   public let id: UUID
-  public init(id: UUID = UUID()) { self.id = id }
+  /// Shared by every copy of this value; counts as one live handle on `id`.
+  private let handle: ExecutableHandles.Token
+
+  public init(id: UUID = UUID()) {
+    self.id = id
+    self.handle = ExecutableHandles.Token(id)
+  }
+
   public static func == (lhs: Executable, rhs: Executable) -> Bool { lhs.id == rhs.id }
 }
+
+/// Counts live `Executable` values per id, so backend artifacts can be freed
+/// once nothing (cache or caller) can execute them any more.
+public enum ExecutableHandles {
+  private static let lock = NSLock()
+  private static var counts: [UUID: Int] = [:]
+  private static var waiters: [UUID: [@Sendable () -> Void]] = [:]
+
+  final class Token: @unchecked Sendable {
+    let id: UUID
+    init(_ id: UUID) {
+      self.id = id
+      ExecutableHandles.lock.lock()
+      ExecutableHandles.counts[id, default: 0] += 1
+      ExecutableHandles.lock.unlock()
+    }
+    deinit { ExecutableHandles.drop(id) }
+  }
+
+  /// Number of live `Executable` values (copies share one) with `id`.
+  public static func liveCount(_ id: UUID) -> Int {
+    lock.lock(); defer { lock.unlock() }
+    return counts[id] ?? 0
+  }
+
+  /// Runs `body` once no `Executable` with `id` is alive: immediately if
+  /// none is, otherwise when the last one goes away (on that thread).
+  public static func whenUnreferenced(_ id: UUID, _ body: @escaping @Sendable () -> Void) {
+    lock.lock()
+    guard counts[id] != nil else {
+      lock.unlock()
+      body()
+      return
+    }
+    waiters[id, default: []].append(body)
+    lock.unlock()
+  }
+
+  private static func drop(_ id: UUID) {
+    lock.lock()
+    let remaining = (counts[id] ?? 1) - 1
+    var ready: [@Sendable () -> Void] = []
+    if remaining == 0 {
+      counts.removeValue(forKey: id)
+      ready = waiters.removeValue(forKey: id) ?? []
+    } else {
+      counts[id] = remaining
+    }
+    lock.unlock()
+    for body in ready { body() }
+  }
+}
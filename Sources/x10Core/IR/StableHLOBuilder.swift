@@ -2,15 +2,45 @@
 
 public struct StableHLOModule: Sendable {
   public var functions: [Function] = []
+  /// Module text as given (e.g. a `.stablehlo` dump read back from disk);
+  /// when set, `textual()` returns it unchanged and `functions` is empty.
+  public var verbatim: String?
   public init(functions: [Function] = []) { self.functions = functions }
+  public init(text: String) { self.verbatim = text }
 
   public struct Function: Sendable {
     public var name: String
     public var args: [Value]
     public var results: [Value]
     public var ops: [Op]
-    public init(name: String, args: [Value], results: [Value], ops: [Op]) {
+    /// Results that may be written into the storage of a donated argument.
+    public var inputOutputAliases: [InputOutputAlias]
+    public init(name: String, args: [Value], results: [Value], ops: [Op],
+                inputOutputAliases: [InputOutputAlias] = []) {
       self.name = name; self.args = args; self.results = results; self.ops = ops
+      self.inputOutputAliases = inputOutputAliases
+    }
+
+    /// Aliases whose result and argument agree on static shape and dtype, at
+    /// most one per result and per argument; the rest are dropped.
+    public var validInputOutputAliases: [InputOutputAlias] {
+      var usedOutputs = Set<Int>(), usedParams = Set<Int>()
+      return inputOutputAliases.filter { a in
+        guard results.indices.contains(a.output), args.indices.contains(a.parameter) else { return false }
+        let r = results[a.output], p = args[a.parameter]
+        guard r.dtype == p.dtype, r.shape == p.shape, !r.shape.contains(where: { $0 == nil }) else { return false }
+        return usedOutputs.insert(a.output).inserted && usedParams.insert(a.parameter).inserted
+      }
+    }
+  }
+
+  /// Result `output` may reuse argument `parameter`'s buffer when the caller
+  /// donates it (XLA's input_output_alias).
+  public struct InputOutputAlias: Sendable, Hashable, Codable {
+    public var output: Int
+    public var parameter: Int
+    public init(output: Int, parameter: Int) {
+      self.output = output; self.parameter = parameter
     }
   }
 
@@ -29,11 +59,14 @@ public struct StableHLOModule: Sendable {
     case multiply(lhs: Value, rhs: Value, into: Value)
     case dotGeneral(lhs: Value, rhs: Value, into: Value,
                     contractingDims: ([Int],[Int]))
+    /// Elementwise element-type conversion; `into` has `operand`'s shape.
+    case convert(operand: Value, into: Value)
     case returnValues([Value])
   }
 
   // Textual printer (StableHLO-ish)
   public func textual() -> String {
+    if let verbatim { return verbatim }
     var out: [String] = []
     for f in functions {
       out.append("func @\(f.name)(" +
@@ -52,6 +85,9 @@ public struct StableHLOModule: Sendable {
         case .dotGeneral(let a, let b, let r, let (lc, rc)):
           out.append("  %\(r.name) = stablehlo.dot_general %\(a.name), %\(b.name) " +
                      "contracting_dims=\(lc):\(rc) : \(r.dtype.render())\(r.renderShape())")
+        case .convert(let a, let r):
+          out.append("  %\(r.name) = stablehlo.convert %\(a.name) : " +
+                     "\(a.dtype.render())\(a.renderShape()) -> \(r.dtype.render())\(r.renderShape())")
         case .returnValues(let vs):
           let names = vs.map { "%\($0.name)" }.joined(separator: ", ")
           out.append("  return \(names)")
@@ -79,6 +115,8 @@ fileprivate extension DType {
     case .f64: return "f64"
     case .i32: return "i32"
     case .i64: return "i64"
+    case .f8E4M3FN: return "f8E4M3FN"
+    case .f8E5M2: return "f8E5M2"
     }
   }
 }
@@ -92,13 +130,15 @@ public struct IRBuilder: Sendable {
     var fn = FnBuilder(args: args.map { StableHLOModule.Value($0.0, $0.1, $0.2) },
                        results: results.map { StableHLOModule.Value($0.0, $0.1, $0.2) })
     build(&fn)
-    return StableHLOModule.Function(name: name, args: fn.args, results: fn.results, ops: fn.ops)
+    return StableHLOModule.Function(name: name, args: fn.args, results: fn.results, ops: fn.ops,
+                                    inputOutputAliases: fn.aliases)
   }
 
   public struct FnBuilder: Sendable {
     public var args: [StableHLOModule.Value]
     public var results: [StableHLOModule.Value]
     public var ops: [StableHLOModule.Op] = []
+    public var aliases: [StableHLOModule.InputOutputAlias] = []
 
     public mutating func parameter(_ index: Int, into v: StableHLOModule.Value) {
       ops.append(.parameter(index: index, into: v))
@@ -113,8 +153,15 @@ public struct IRBuilder: Sendable {
                                     contractingDims: ([Int],[Int])) {
       ops.append(.dotGeneral(lhs: a, rhs: b, into: r, contractingDims: contractingDims))
     }
+    public mutating func convert(_ a: StableHLOModule.Value, into r: StableHLOModule.Value) {
+      ops.append(.convert(operand: a, into: r))
+    }
     public mutating func returnValues(_ vs: [StableHLOModule.Value]) {
       ops.append(.returnValues(vs))
     }
+    /// Lets result `output` be written in place of argument `parameter` when donated.
+    public mutating func alias(output: Int, parameter: Int) {
+      aliases.append(.init(output: output, parameter: parameter))
+    }
   }
 }
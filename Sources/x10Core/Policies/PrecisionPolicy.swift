@@ -6,14 +6,21 @@ public struct PrecisionPolicy: Sendable {
   public var activations: Precision
   public var matmul: Precision
   public var accumulators: Precision
+  /// Narrow f32 program inputs to `activations` (f16/bf16) on the host before
+  /// upload; the compiled program takes them at that width and converts back
+  /// to f32 on entry. Halves host-to-device bytes for those inputs. fp8
+  /// activations are refused, as they would need a per-tensor scale.
+  public var castInputs: Bool
 
   public init(
     activations: Precision = .bf16,
     matmul: Precision      = .bf16,
-    accumulators: Precision = .fp32
+    accumulators: Precision = .fp32,
+    castInputs: Bool = false
   ) {
     self.activations = activations
     self.matmul = matmul
     self.accumulators = accumulators
+    self.castInputs = castInputs
   }
 }
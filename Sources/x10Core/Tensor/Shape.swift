@@ -1,4 +1,4 @@
-public enum DimSpec: Equatable, Hashable, Sendable {
+public enum DimSpec: Equatable, Hashable, Sendable, Codable {
   case exact(Int)
   case any
   case bucket(lo: Int, hi: Int)
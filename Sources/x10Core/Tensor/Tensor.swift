@@ -39,34 +39,119 @@ public enum Device: Sendable, Equatable, CustomStringConvertible {
 
 // MARK: - Tensor
 
-public struct Tensor<Scalar>: Sendable, CustomStringConvertible {
+/// Element types a `Tensor` can hold.
+public protocol TensorScalar: Numeric, Sendable {
+  static var dtype: DType { get }
+}
+
+extension Float: TensorScalar { public static var dtype: DType { .f32 } }
+extension Double: TensorScalar { public static var dtype: DType { .f64 } }
+extension Int32: TensorScalar { public static var dtype: DType { .i32 } }
+extension Int64: TensorScalar { public static var dtype: DType { .i64 } }
+
+/// Dense row-major host tensor backed by a shared `TensorStorage`.
+///
+/// Copies share storage; mutation copies it first unless this tensor is the
+/// only reference (copy-on-write). Owned storage is 64-byte aligned, and
+/// `withUnsafeBytes` hands it to `toDevice` or DLPack without staging.
+public struct Tensor<Scalar: TensorScalar>: Sendable, CustomStringConvertible {
   public let shape: [Int]
   public let device: Device
+  public private(set) var storage: TensorStorage
 
-  // Placeholder handle — in a real system this would be a device buffer.
-  @usableFromInline
-  var _id: UUID = UUID()
-
+  /// Zero-filled tensor.
   public init(shape: [Int], on device: Device = .default) {
+    self.init(shape: shape, on: device) { $0.initialize(repeating: 0) }
+  }
+
+  /// Copies `scalars` (row-major, `shape.product` of them).
+  public init(shape: [Int], scalars: [Scalar], on device: Device = .default) {
+    precondition(scalars.count == Self.count(of: shape), "Tensor: \(scalars.count) scalars for shape \(shape)")
+    self.init(shape: shape, on: device) { dst in _ = dst.initialize(from: scalars) }
+  }
+
+  /// Lets `body` write every element in place, with no intermediate array.
+  public init(shape: [Int], on device: Device = .default,
+              initializingWith body: (UnsafeMutableBufferPointer<Scalar>) throws -> Void) rethrows {
+    let storage = TensorStorage(uninitializedByteCount: Self.byteCount(for: shape))
+    try body(UnsafeMutableBufferPointer(start: storage.data.bindMemory(to: Scalar.self, capacity: Self.count(of: shape)),
+                                        count: Self.count(of: shape)))
+    self.init(shape: shape, storage: storage, on: device)
+  }
+
+  /// Views `storage` (at least `shape.product * MemoryLayout<Scalar>.stride`
+  /// bytes) without copying.
+  public init(shape: [Int], storage: TensorStorage, on device: Device = .default) {
+    precondition(storage.byteCount >= Self.byteCount(for: shape), "Tensor: storage too small for shape \(shape)")
     self.shape = shape
     self.device = device
+    self.storage = storage
   }
 
-  /// Convenience constructors (host-side placeholders for now).
   public static func zeros(shape: [Int], on device: Device = .default) -> Tensor<Scalar> {
     Tensor(shape: shape, on: device)
   }
   public static func ones(shape: [Int], on device: Device = .default) -> Tensor<Scalar> {
-    Tensor(shape: shape, on: device)
+    Tensor(shape: shape, on: device) { $0.initialize(repeating: 1) }
+  }
+
+  public static var dtype: DType { Scalar.dtype }
+  public var dtype: DType { Scalar.dtype }
+  public var scalarCount: Int { Self.count(of: shape) }
+  public var byteCount: Int { scalarCount * MemoryLayout<Scalar>.stride }
+
+  /// Elements in row-major order (copied out).
+  public var scalars: [Scalar] { withUnsafeBufferPointer { Array($0) } }
+
+  /// Element at `indices` (one per dimension, row-major).
+  public subscript(_ indices: Int...) -> Scalar {
+    get { withUnsafeBufferPointer { $0[offset(indices)] } }
+    set {
+      let i = offset(indices)
+      withUnsafeMutableBufferPointer { $0[i] = newValue }
+    }
+  }
+
+  public func withUnsafeBufferPointer<R>(_ body: (UnsafeBufferPointer<Scalar>) throws -> R) rethrows -> R {
+    try body(UnsafeBufferPointer(start: storage.data.assumingMemoryBound(to: Scalar.self), count: scalarCount))
+  }
+
+  public func withUnsafeBytes<R>(_ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+    try body(UnsafeRawBufferPointer(start: storage.data, count: byteCount))
+  }
+
+  /// Mutable access; copies the storage first if it is shared or read-only.
+  public mutating func withUnsafeMutableBufferPointer<R>(
+    _ body: (UnsafeMutableBufferPointer<Scalar>) throws -> R
+  ) rethrows -> R {
+    if !isKnownUniquelyReferenced(&storage) || !storage.isWritable { storage = storage.copy() }
+    return try body(UnsafeMutableBufferPointer(start: storage.data.assumingMemoryBound(to: Scalar.self),
+                                               count: scalarCount))
   }
 
   public var description: String {
     "Tensor<\(Scalar.self)>(shape: \(shape), device: \(device))"
   }
+
+  private func offset(_ indices: [Int]) -> Int {
+    precondition(indices.count == shape.count, "Tensor: \(indices.count) indices for rank \(shape.count)")
+    var flat = 0
+    for (i, d) in zip(indices, shape) {
+      precondition(i >= 0 && i < d, "Tensor: index \(indices) out of bounds for shape \(shape)")
+      flat = flat * d + i
+    }
+    return flat
+  }
+
+  static func count(of shape: [Int]) -> Int { shape.reduce(1, *) }
+  static func byteCount(for shape: [Int]) -> Int { count(of: shape) * MemoryLayout<Scalar>.stride }
 }
 
 // MARK: - DType
 
 public enum DType: Sendable {
   case f16, bf16, f32, f64, i32, i64
+  /// OCP 8-bit floats: 4 exponent / 3 mantissa bits with no infinities
+  /// (max 448), and 5 / 2 bits with IEEE infinities (max 57344).
+  case f8E4M3FN, f8E5M2
 }
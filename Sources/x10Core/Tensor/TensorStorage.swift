@@ -0,0 +1,51 @@
+import Foundation
+
+/// Refcounted host memory behind a `Tensor`.
+///
+/// Either owns a `TensorStorage.alignment`-aligned allocation or borrows
+/// memory owned elsewhere (a DLPack capsule, a mapped file), in which case
+/// `release` runs when the storage dies. `Tensor` shares storages between
+/// copies and only writes to one it references uniquely and that
+/// `isWritable`; otherwise it copies first.
+public final class TensorStorage: @unchecked Sendable {
+  /// Alignment of owned allocations: a cache line, and enough for any SIMD load.
+  public static let alignment = 64
+
+  public let data: UnsafeMutableRawPointer
+  public let byteCount: Int
+  /// False for borrowed memory that must not be written (e.g. a read-only
+  /// DLPack export or a private file mapping).
+  public let isWritable: Bool
+  private let release: (() -> Void)?
+
+  /// Owned allocation whose bytes the caller initializes.
+  public init(uninitializedByteCount byteCount: Int) {
+    self.byteCount = max(0, byteCount)
+    // Never allocate 0 bytes, so `data` is always a valid aligned pointer.
+    self.data = UnsafeMutableRawPointer.allocate(byteCount: max(1, byteCount), alignment: Self.alignment)
+    self.isWritable = true
+    self.release = nil
+  }
+
+  /// Borrows `byteCount` bytes at `data`; `release` runs on deinit.
+  public init(borrowing data: UnsafeMutableRawPointer, byteCount: Int, writable: Bool,
+              release: @escaping () -> Void) {
+    self.data = data
+    self.byteCount = byteCount
+    self.isWritable = writable
+    self.release = release
+  }
+
+  deinit {
+    if let release { release() } else { data.deallocate() }
+  }
+
+  /// An owned, writable copy of the bytes.
+  public func copy() -> TensorStorage {
+    let out = TensorStorage(uninitializedByteCount: byteCount)
+    out.data.copyMemory(from: data, byteCount: byteCount)
+    return out
+  }
+
+  public var bytes: UnsafeRawBufferPointer { UnsafeRawBufferPointer(start: data, count: byteCount) }
+}
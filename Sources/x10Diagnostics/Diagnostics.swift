@@ -1,21 +1,183 @@
 import Foundation
+import x10DiagnosticsC
 
-public struct Counter: Sendable {
+/// Monotonic counter. Increments go to a per-thread shard with a relaxed
+/// atomic add, so concurrent tasks never lose counts or contend on one
+/// cache line; `value` sums the shards.
+public final class Counter: @unchecked Sendable {
   public let name: String
-  public private(set) var value: UInt64 = 0
+  public let help: String
+  private let cell: OpaquePointer
 
-  public init(_ name: String) { self.name = name }
-  public mutating func inc(_ v: UInt64 = 1) { value &+= v }
-  public mutating func reset() { value = 0 }
+  public init(_ name: String, help: String = "") {
+    self.name = name
+    self.help = help
+    self.cell = x10_counter_create()
+    Metrics.register(self)
+  }
+
+  deinit {
+    Metrics.unregister(self)
+    x10_counter_destroy(cell)
+  }
+
+  public var value: UInt64 { x10_counter_value(cell) }
+  @inline(__always) public func inc(_ v: UInt64 = 1) { x10_counter_add(cell, v) }
+  public func reset() { x10_counter_reset(cell) }
+}
+
+/// Point-in-time value that moves both ways (e.g. live bytes).
+public final class Gauge: @unchecked Sendable {
+  public let name: String
+  public let help: String
+  private let cell: OpaquePointer
+
+  public init(_ name: String, help: String = "") {
+    self.name = name
+    self.help = help
+    self.cell = x10_gauge_create()
+    Metrics.register(self)
+  }
+
+  deinit {
+    Metrics.unregister(self)
+    x10_gauge_destroy(cell)
+  }
+
+  public var value: Int64 { x10_gauge_value(cell) }
+  @inline(__always) public func add(_ v: Int64) { x10_gauge_add(cell, v) }
+  @inline(__always) public func sub(_ v: Int64) { x10_gauge_add(cell, 0 &- v) }
+  public func set(_ v: Int64) { x10_gauge_set(cell, v) }
+}
+
+/// Log-linear (HDR-style) histogram: 16 linear sub-buckets per power of two,
+/// so any recorded value is reported within ~6% of its true value. Records
+/// go to a per-thread shard like `Counter` increments; reads merge them.
+public final class Histogram: @unchecked Sendable {
+  public enum Unit: String, Sendable, Codable {
+    case nanoseconds
+    case bytes
+  }
+
+  public let name: String
+  public let help: String
+  public let unit: Unit
+  private let cell: OpaquePointer
+
+  public init(_ name: String, unit: Unit, help: String = "") {
+    self.name = name
+    self.help = help
+    self.unit = unit
+    self.cell = x10_histogram_create()
+    Metrics.register(self)
+  }
+
+  deinit {
+    Metrics.unregister(self)
+    x10_histogram_destroy(cell)
+  }
+
+  @inline(__always) public func record(_ v: UInt64) { x10_histogram_record(cell, v) }
+
+  /// Records the elapsed nanoseconds of `body`.
+  @inline(__always)
+  public func time<T>(_ body: () throws -> T) rethrows -> T {
+    let start = x10_metrics_now_ns()
+    defer { record(x10_metrics_now_ns() &- start) }
+    return try body()
+  }
+
+  @inline(__always)
+  public func time<T>(_ body: () async throws -> T) async rethrows -> T {
+    let start = x10_metrics_now_ns()
+    defer { record(x10_metrics_now_ns() &- start) }
+    return try await body()
+  }
+
+  public func reset() { x10_histogram_reset(cell) }
+
+  public var count: UInt64 { x10_histogram_count(cell) }
+
+  /// Bucket upper bound at quantile `q` (0...1), clamped to the max seen.
+  public func quantile(_ q: Double) -> UInt64 { x10_histogram_quantile(cell, q) }
+
+  public func snapshot() -> HistogramSnapshot {
+    var raw = [UInt64](repeating: 0, count: Int(x10_histogram_bucket_count()))
+    raw.withUnsafeMutableBufferPointer { x10_histogram_buckets(cell, $0.baseAddress) }
+    let buckets = raw.enumerated()
+      .filter { $0.element > 0 }
+      .map { HistogramSnapshot.Bucket(upperBound: x10_histogram_bucket_upper(UInt32($0.offset)), count: $0.element) }
+    return HistogramSnapshot(
+      count: x10_histogram_count(cell),
+      sum: x10_histogram_sum(cell),
+      min: x10_histogram_min(cell),
+      max: x10_histogram_max(cell),
+      p50: quantile(0.5),
+      p90: quantile(0.9),
+      p99: quantile(0.99),
+      p999: quantile(0.999),
+      buckets: buckets)
+  }
 }
 
 public enum Diagnostics {
   // Counters highlighted in the deep-dive (barrier & uncached compiles).
-  public static var forcedEvaluations = Counter("forced_evaluations")
-  public static var uncachedCompiles = Counter("uncached_compiles")
-  public static var executeCallsIreeRuntime = Counter("execute_calls_iree_runtime")
-  public static var executeCallsIreeCLI = Counter("execute_calls_iree_cli")
-  public static var strictBarrierViolations = Counter("strict_barrier_violations")
+  public static let forcedEvaluations = Counter("forced_evaluations")
+  public static let uncachedCompiles = Counter("uncached_compiles")
+  public static let executeCallsIreeRuntime = Counter("execute_calls_iree_runtime")
+  public static let executeCallsIreeCLI = Counter("execute_calls_iree_cli")
+  public static let strictBarrierViolations = Counter("strict_barrier_violations")
+  public static let releasedArtifacts = Counter("released_artifacts")
+  // Startup warm-up progress (`CacheWarmer.prewarm`) and its payoff.
+  public static let warmupScheduled = Counter("warmup_scheduled")
+  public static let warmupCompleted = Counter("warmup_completed")
+  public static let warmupFailed = Counter("warmup_failed")
+  public static let warmupDropped = Counter("warmup_dropped")
+  public static let warmedHits = Counter("warmed_hits")
+  public static let donatedOutputs = Counter("donated_outputs")
+  // Dynamic batching: fill rate = batched_requests / batch_slots.
+  public static let batchedRequests = Counter("batched_requests")
+  public static let batchSlots = Counter("batch_slots")
+  public static let collectiveBytes = Counter("collective_bytes")
+  // Host <-> device traffic.
+  public static let bytesToDevice = Counter("bytes_to_device")
+  public static let bytesFromDevice = Counter("bytes_from_device")
+  // Latency routing (`LatencyRouter`): explorations finished per key.
+  public static let routeDecisions = Counter("route_decisions")
+
+  // Gauges track live state and are intentionally not touched by `resetAll()`.
+  public static let liveArtifactBytes = Gauge("live_artifact_bytes")
+  public static let warmupPending = Gauge("warmup_pending")
+  public static let shapeProfilerBytes = Gauge("shape_profiler_bytes")
+  // Summed over every device memory pool.
+  public static let poolLiveBytes = Gauge("pool_live_bytes")
+  public static let poolCachedBytes = Gauge("pool_cached_bytes")
+
+  // Latency (ns) and size (bytes) distributions.
+  public static let compileLatency = Histogram("compile_latency_ns", unit: .nanoseconds,
+                                               help: "Backend compile time on cache misses")
+  public static let executeLatency = Histogram("execute_latency_ns", unit: .nanoseconds,
+                                               help: "Backend execute time")
+  public static let cacheLookupLatency = Histogram("cache_lookup_latency_ns", unit: .nanoseconds,
+                                                   help: "ExecutableCache lookup time, actor hop included")
+  public static let transferBytes = Histogram("transfer_bytes", unit: .bytes,
+                                              help: "Size of each host<->device copy")
+  public static let collectiveLatency = Histogram("collective_latency_ns", unit: .nanoseconds,
+                                                  help: "In-process collective time per rank")
+
+  /// Forces every metric above into the `Metrics` registry (static lets are
+  /// lazy, so untouched ones would otherwise be missing from exports).
+  static let registered: Void = {
+    let all: [AnyObject] = [
+      forcedEvaluations, uncachedCompiles, executeCallsIreeRuntime, executeCallsIreeCLI,
+      strictBarrierViolations, releasedArtifacts, warmupScheduled, warmupCompleted,
+      warmupFailed, warmupDropped, warmedHits, donatedOutputs,
+      batchedRequests, batchSlots, collectiveBytes, bytesToDevice, bytesFromDevice, routeDecisions,
+      liveArtifactBytes, warmupPending, shapeProfilerBytes, poolLiveBytes, poolCachedBytes,
+      compileLatency, executeLatency, cacheLookupLatency, transferBytes, collectiveLatency,
+    ]
+    _ = all
+  }()
 
   @inlinable
   public static func resetAll() {
@@ -24,5 +186,23 @@ public enum Diagnostics {
     executeCallsIreeRuntime.reset()
     executeCallsIreeCLI.reset()
     strictBarrierViolations.reset()
+    releasedArtifacts.reset()
+    donatedOutputs.reset()
+    batchedRequests.reset()
+    batchSlots.reset()
+    collectiveBytes.reset()
+    warmupScheduled.reset()
+    warmupCompleted.reset()
+    warmupFailed.reset()
+    warmupDropped.reset()
+    warmedHits.reset()
+    bytesToDevice.reset()
+    bytesFromDevice.reset()
+    routeDecisions.reset()
+    compileLatency.reset()
+    executeLatency.reset()
+    cacheLookupLatency.reset()
+    transferBytes.reset()
+    collectiveLatency.reset()
   }
 }
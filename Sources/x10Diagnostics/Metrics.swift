@@ -0,0 +1,115 @@
+import Foundation
+import x10DiagnosticsC
+
+public struct HistogramSnapshot: Sendable, Codable, Equatable {
+  public struct Bucket: Sendable, Codable, Equatable {
+    /// Inclusive upper bound of the bucket.
+    public var upperBound: UInt64
+    public var count: UInt64
+  }
+
+  public var count: UInt64
+  public var sum: UInt64
+  public var min: UInt64
+  public var max: UInt64
+  public var p50: UInt64
+  public var p90: UInt64
+  public var p99: UInt64
+  public var p999: UInt64
+  /// Non-empty buckets only, ascending.
+  public var buckets: [Bucket]
+
+  public var mean: Double { count == 0 ? 0 : Double(sum) / Double(count) }
+}
+
+/// Point-in-time copy of every registered metric.
+public struct MetricsSnapshot: Sendable, Codable, Equatable {
+  public var timestampNanos: UInt64
+  public var counters: [String: UInt64]
+  public var gauges: [String: Int64]
+  public var histograms: [String: HistogramSnapshot]
+}
+
+/// Registry of every live `Counter`, `Gauge` and `Histogram` plus the
+/// exporters. Metrics register themselves on creation and leave (freeing
+/// their cells) when the last reference goes; the registry holds them weakly.
+public enum Metrics {
+  private struct Weak<T: AnyObject> {
+    weak var value: T?
+  }
+
+  private static let lock = NSLock()
+  private static var counters: [ObjectIdentifier: Weak<Counter>] = [:]
+  private static var gauges: [ObjectIdentifier: Weak<Gauge>] = [:]
+  private static var histograms: [ObjectIdentifier: Weak<Histogram>] = [:]
+
+  /// Prefix for exported metric names.
+  public static let namespace = "x10"
+
+  static func register(_ c: Counter) { lock.lock(); counters[ObjectIdentifier(c)] = Weak(value: c); lock.unlock() }
+  static func register(_ g: Gauge) { lock.lock(); gauges[ObjectIdentifier(g)] = Weak(value: g); lock.unlock() }
+  static func register(_ h: Histogram) { lock.lock(); histograms[ObjectIdentifier(h)] = Weak(value: h); lock.unlock() }
+
+  static func unregister(_ c: Counter) { lock.lock(); counters.removeValue(forKey: ObjectIdentifier(c)); lock.unlock() }
+  static func unregister(_ g: Gauge) { lock.lock(); gauges.removeValue(forKey: ObjectIdentifier(g)); lock.unlock() }
+  static func unregister(_ h: Histogram) { lock.lock(); histograms.removeValue(forKey: ObjectIdentifier(h)); lock.unlock() }
+
+  /// Strong references to the metrics alive right now.
+  private static func live() -> ([Counter], [Gauge], [Histogram]) {
+    lock.lock(); defer { lock.unlock() }
+    return (counters.values.compactMap(\.value), gauges.values.compactMap(\.value),
+            histograms.values.compactMap(\.value))
+  }
+
+  /// Monotonic clock used by the histograms, in nanoseconds.
+  @inline(__always)
+  public static func nowNanos() -> UInt64 { x10_metrics_now_ns() }
+
+  public static func snapshot() -> MetricsSnapshot {
+    _ = Diagnostics.registered
+    let (cs, gs, hs) = live()
+    return MetricsSnapshot(
+      timestampNanos: nowNanos(),
+      counters: Dictionary(cs.map { ($0.name, $0.value) }, uniquingKeysWith: +),
+      gauges: Dictionary(gs.map { ($0.name, $0.value) }, uniquingKeysWith: +),
+      histograms: Dictionary(hs.map { ($0.name, $0.snapshot()) }, uniquingKeysWith: { a, _ in a }))
+  }
+
+  public static func jsonSnapshot() throws -> Data {
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = [.sortedKeys]
+    return try encoder.encode(snapshot())
+  }
+
+  /// Prometheus text exposition format (version 0.0.4).
+  public static func prometheusText() -> String {
+    _ = Diagnostics.registered
+    let (cs, gs, hs) = live()
+
+    var out = ""
+    for c in cs.sorted(by: { $0.name < $1.name }) {
+      let name = "\(namespace)_\(c.name)_total"
+      if !c.help.isEmpty { out += "# HELP \(name) \(c.help)\n" }
+      out += "# TYPE \(name) counter\n\(name) \(c.value)\n"
+    }
+    for g in gs.sorted(by: { $0.name < $1.name }) {
+      let name = "\(namespace)_\(g.name)"
+      if !g.help.isEmpty { out += "# HELP \(name) \(g.help)\n" }
+      out += "# TYPE \(name) gauge\n\(name) \(g.value)\n"
+    }
+    for h in hs.sorted(by: { $0.name < $1.name }) {
+      let name = "\(namespace)_\(h.name)"
+      let snap = h.snapshot()
+      if !h.help.isEmpty { out += "# HELP \(name) \(h.help)\n" }
+      out += "# TYPE \(name) histogram\n"
+      var cumulative: UInt64 = 0
+      for bucket in snap.buckets {
+        cumulative += bucket.count
+        out += "\(name)_bucket{le=\"\(bucket.upperBound)\"} \(cumulative)\n"
+      }
+      out += "\(name)_bucket{le=\"+Inf\"} \(snap.count)\n"
+      out += "\(name)_sum \(snap.sum)\n\(name)_count \(snap.count)\n"
+    }
+    return out
+  }
+}
@@ -0,0 +1,131 @@
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#else
+import Glibc
+#endif
+
+public enum MetricsEndpointError: Error {
+  case socket(String)
+}
+
+/// Minimal loopback HTTP server exposing `Metrics`:
+///   GET /metrics       Prometheus text
+///   GET /metrics.json  `MetricsSnapshot` as JSON
+/// One background thread, one request per connection; meant for scraping,
+/// not for serving traffic.
+public final class MetricsEndpoint: @unchecked Sendable {
+  public let port: UInt16
+  private let fd: Int32
+  private let thread: Thread
+
+  /// Starts on 127.0.0.1:`port` (0 picks a free port; see `port`).
+  public static func start(port: UInt16 = 0) throws -> MetricsEndpoint {
+    try MetricsEndpoint(port: port)
+  }
+
+  /// Starts on X10_METRICS_PORT if set; nil otherwise or if binding fails.
+  public static func startFromEnvironment(
+    _ env: [String: String] = ProcessInfo.processInfo.environment
+  ) -> MetricsEndpoint? {
+    guard let port = env["X10_METRICS_PORT"].flatMap(UInt16.init) else { return nil }
+    return try? start(port: port)
+  }
+
+  private init(port requested: UInt16) throws {
+    #if canImport(Darwin)
+    let fd = socket(AF_INET, SOCK_STREAM, 0)
+    #else
+    let fd = socket(AF_INET, Int32(SOCK_STREAM.rawValue), 0)
+    #endif
+    guard fd >= 0 else { throw MetricsEndpointError.socket("socket: \(errno)") }
+
+    var yes: Int32 = 1
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, socklen_t(MemoryLayout<Int32>.size))
+
+    var addr = sockaddr_in()
+    #if canImport(Darwin)
+    addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+    #endif
+    addr.sin_family = sa_family_t(AF_INET)
+    addr.sin_port = requested.bigEndian
+    addr.sin_addr = in_addr(s_addr: UInt32(0x7f00_0001).bigEndian)
+
+    let len = socklen_t(MemoryLayout<sockaddr_in>.size)
+    let bound = withUnsafePointer(to: &addr) {
+      $0.withMemoryRebound(to: sockaddr.self, capacity: 1) { bind(fd, $0, len) }
+    }
+    guard bound == 0, listen(fd, 16) == 0 else {
+      let err = errno
+      close(fd)
+      throw MetricsEndpointError.socket("bind/listen on port \(requested): \(err)")
+    }
+
+    var actual = sockaddr_in()
+    var actualLen = len
+    _ = withUnsafeMutablePointer(to: &actual) {
+      $0.withMemoryRebound(to: sockaddr.self, capacity: 1) { getsockname(fd, $0, &actualLen) }
+    }
+
+    self.fd = fd
+    self.port = UInt16(bigEndian: actual.sin_port)
+    self.thread = Thread { MetricsEndpoint.serve(fd) }
+    thread.name = "x10.metrics"
+    thread.start()
+  }
+
+  /// Stops accepting connections.
+  public func stop() {
+    shutdown(fd, Int32(SHUT_RDWR))
+    close(fd)
+  }
+
+  /// Status line, content type and body for a request line such as
+  /// "GET /metrics HTTP/1.1".
+  static func response(forRequestLine line: String) -> (status: String, contentType: String, body: Data) {
+    let parts = line.split(separator: " ")
+    let path = parts.count > 1 ? String(parts[1]) : ""
+    switch path {
+    case "/metrics":
+      return ("200 OK", "text/plain; version=0.0.4", Data(Metrics.prometheusText().utf8))
+    case "/metrics.json":
+      let body = (try? Metrics.jsonSnapshot()) ?? Data("{}".utf8)
+      return ("200 OK", "application/json", body)
+    default:
+      return ("404 Not Found", "text/plain", Data("not found\n".utf8))
+    }
+  }
+
+  private static func serve(_ fd: Int32) {
+    while true {
+      let client = accept(fd, nil, nil)
+      if client < 0 {
+        if errno == EINTR { continue }
+        return  // listener closed by stop()
+      }
+      handle(client)
+      close(client)
+    }
+  }
+
+  private static func handle(_ client: Int32) {
+    var buffer = [UInt8](repeating: 0, count: 4096)
+    let n = buffer.withUnsafeMutableBytes { read(client, $0.baseAddress, $0.count) }
+    guard n > 0 else { return }
+    let request = String(decoding: buffer[0..<n], as: UTF8.self)
+    let line = request.split(separator: "\r\n", maxSplits: 1).first.map(String.init) ?? ""
+    let (status, contentType, body) = response(forRequestLine: line)
+
+    var payload = Data(
+      "HTTP/1.1 \(status)\r\nContent-Type: \(contentType)\r\nContent-Length: \(body.count)\r\nConnection: close\r\n\r\n".utf8)
+    payload.append(body)
+    payload.withUnsafeBytes { raw in
+      var offset = 0
+      while offset < raw.count {
+        let w = write(client, raw.baseAddress! + offset, raw.count - offset)
+        if w <= 0 { return }
+        offset += w
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+import Foundation
+import x10DiagnosticsC
+
+public enum TraceError: Error {
+  case dumpFailed(String)
+}
+
+/// Low-overhead span tracer that dumps Chrome trace-event JSON.
+///
+/// Spans are appended to a per-thread ring buffer (see x10_trace.h), so
+/// recording never takes a lock. When tracing is off, `span`/`begin` cost a
+/// single load and branch. Enable with `Trace.enable()` or, for whole runs,
+/// `Trace.enableFromEnvironment()` (X10_TRACE=1; X10_TRACE_FILE=path dumps at
+/// exit). Open the dump in chrome://tracing or ui.perfetto.dev.
+public enum Trace {
+  public static var isEnabled: Bool {
+    @inline(__always) get { x10_trace_enabled() != 0 }
+  }
+
+  /// Starts recording. `ringCapacity` bounds spans kept per thread (rounded
+  /// up to a power of two; default 65536) and applies to threads that have
+  /// not traced yet.
+  public static func enable(ringCapacity: Int? = nil) {
+    if let ringCapacity { x10_trace_set_ring_capacity(UInt32(clamping: ringCapacity)) }
+    x10_trace_set_enabled(1)
+  }
+
+  public static func disable() {
+    x10_trace_set_enabled(0)
+  }
+
+  /// Enables tracing when X10_TRACE=1. With X10_TRACE_FILE set, the trace is
+  /// also written there when the process exits.
+  @discardableResult
+  public static func enableFromEnvironment(
+    _ env: [String: String] = ProcessInfo.processInfo.environment
+  ) -> Bool {
+    guard env["X10_TRACE"] == "1" else { return false }
+    enable(ringCapacity: env["X10_TRACE_RING"].flatMap(Int.init))
+    if env["X10_TRACE_FILE"] != nil {
+      atexit {
+        guard let path = ProcessInfo.processInfo.environment["X10_TRACE_FILE"] else { return }
+        _ = x10_trace_dump(path)
+      }
+    }
+    return true
+  }
+
+  /// Drops recorded spans.
+  public static func clear() {
+    x10_trace_clear()
+  }
+
+  /// Spans currently retained across all threads.
+  public static var eventCount: Int { Int(x10_trace_event_count()) }
+
+  /// Writes the retained spans as Chrome trace-event JSON.
+  public static func dump(to url: URL) throws {
+    guard x10_trace_dump(url.path) == 1 else {
+      throw TraceError.dumpFailed(url.path)
+    }
+  }
+
+  // MARK: - Recording
+
+  /// Start timestamp for a manual span, or 0 when tracing is off.
+  @inline(__always)
+  public static func begin() -> UInt64 {
+    x10_trace_enabled() != 0 ? x10_metrics_now_ns() : 0
+  }
+
+  /// Closes a span opened with `begin()`; no-op if it returned 0.
+  @inline(__always)
+  public static func end(_ name: StaticString, category: StaticString = "x10", since start: UInt64, arg: UInt64 = 0) {
+    guard start != 0 else { return }
+    x10_trace_record(cString(name), cString(category), start, x10_metrics_now_ns(), arg)
+  }
+
+  @inline(__always)
+  public static func span<T>(
+    _ name: StaticString, category: StaticString = "x10", arg: UInt64 = 0, _ body: () throws -> T
+  ) rethrows -> T {
+    let start = begin()
+    defer { end(name, category: category, since: start, arg: arg) }
+    return try body()
+  }
+
+  @inline(__always)
+  public static func span<T>(
+    _ name: StaticString, category: StaticString = "x10", arg: UInt64 = 0, _ body: () async throws -> T
+  ) async rethrows -> T {
+    let start = begin()
+    defer { end(name, category: category, since: start, arg: arg) }
+    return try await body()
+  }
+
+  /// Static strings are stored by pointer; single-scalar literals have no
+  /// pointer form and are reported as "?".
+  @inline(__always)
+  private static func cString(_ s: StaticString) -> UnsafePointer<CChar> {
+    guard s.hasPointerRepresentation else { return unknownName }
+    return UnsafeRawPointer(s.utf8Start).assumingMemoryBound(to: CChar.self)
+  }
+
+  private static let unknownName: UnsafePointer<CChar> = {
+    let p = UnsafeMutablePointer<CChar>.allocate(capacity: 2)
+    p[0] = CChar(UInt8(ascii: "?")); p[1] = 0
+    return UnsafePointer(p)
+  }()
+}
@@ -0,0 +1,75 @@
+#ifndef X10_METRICS_H
+#define X10_METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  // Lock-free metric cells backing x10Diagnostics. All updates are relaxed
+  // atomics; reads sum/scan without stopping writers, so snapshots are
+  // consistent per cell, not across cells.
+
+  // ===== Clock =====
+  // Monotonic nanoseconds (CLOCK_MONOTONIC / mach_absolute_time).
+  uint64_t x10_metrics_now_ns(void);
+
+  // ===== Sharded counter =====
+  // Each thread increments its own cache-line-sized shard, so concurrent
+  // increments never contend on one line.
+  typedef struct x10_counter x10_counter;
+
+  x10_counter *x10_counter_create(void);
+  void x10_counter_destroy(x10_counter *c);
+  void x10_counter_add(x10_counter *c, uint64_t v);
+  uint64_t x10_counter_value(const x10_counter *c);
+  void x10_counter_reset(x10_counter *c);
+
+  // ===== Gauge =====
+  typedef struct x10_gauge x10_gauge;
+
+  x10_gauge *x10_gauge_create(void);
+  void x10_gauge_destroy(x10_gauge *g);
+  void x10_gauge_add(x10_gauge *g, int64_t v);
+  void x10_gauge_set(x10_gauge *g, int64_t v);
+  int64_t x10_gauge_value(const x10_gauge *g);
+
+  // ===== Log-linear (HDR-style) histogram =====
+  // Values are bucketed by power of two with X10_HIST_SUB_BUCKETS linear
+  // sub-buckets each, bounding relative error to 1/X10_HIST_SUB_BUCKETS.
+  // Like counters, each thread records into its own shard (X10_HIST_SHARDS
+  // of them, ~8 KiB each); readers merge the shards.
+#define X10_HIST_SUB_BITS 4
+#define X10_HIST_SUB_BUCKETS (1u << X10_HIST_SUB_BITS)
+#define X10_HIST_BUCKETS ((64 - X10_HIST_SUB_BITS + 1) * X10_HIST_SUB_BUCKETS)
+
+  typedef struct x10_histogram x10_histogram;
+
+  x10_histogram *x10_histogram_create(void);
+  void x10_histogram_destroy(x10_histogram *h);
+  void x10_histogram_record(x10_histogram *h, uint64_t v);
+  void x10_histogram_reset(x10_histogram *h);
+
+  uint64_t x10_histogram_count(const x10_histogram *h);
+  uint64_t x10_histogram_sum(const x10_histogram *h);
+  uint64_t x10_histogram_min(const x10_histogram *h);
+  uint64_t x10_histogram_max(const x10_histogram *h);
+  // Upper bound of the bucket holding quantile q in [0, 1]; 0 when empty.
+  uint64_t x10_histogram_quantile(const x10_histogram *h, double q);
+
+  // X10_HIST_BUCKETS, for callers that cannot see the macro.
+  uint32_t x10_histogram_bucket_count(void);
+  // Copies per-bucket counts into out (X10_HIST_BUCKETS entries).
+  void x10_histogram_buckets(const x10_histogram *h, uint64_t *out);
+  // Inclusive upper bound of bucket index i.
+  uint64_t x10_histogram_bucket_upper(uint32_t i);
+  uint32_t x10_histogram_bucket_index(uint64_t v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // X10_METRICS_H
@@ -0,0 +1,53 @@
+#ifndef X10_TRACE_H
+#define X10_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  // Span tracer backing x10Diagnostics.Trace. Each thread appends completed
+  // spans to its own fixed-size ring (single producer, no locks); when a
+  // ring wraps, the oldest spans are overwritten. x10_trace_dump walks all
+  // rings and writes Chrome trace-event JSON (chrome://tracing, Perfetto).
+  // Rings are never freed: a thread's ring is kept (and dumped) after it
+  // exits and reused by the next thread that starts tracing.
+
+  // Non-zero while tracing; change it only via x10_trace_set_enabled.
+  extern _Atomic int x10_trace_enabled_flag;
+
+  // Relaxed load, so a disabled tracer costs one load and branch.
+  static inline int x10_trace_enabled(void)
+  {
+    return atomic_load_explicit(&x10_trace_enabled_flag, memory_order_relaxed);
+  }
+
+  void x10_trace_set_enabled(int enabled);
+
+  // Spans per thread ring; takes effect for rings created afterwards.
+  void x10_trace_set_ring_capacity(uint32_t events);
+
+  // Records a completed span. `name` and `category` must outlive the
+  // tracer (string literals / StaticString). `arg` is exported as
+  // args.value when non-zero (e.g. a byte count).
+  void x10_trace_record(const char *name, const char *category,
+                        uint64_t start_ns, uint64_t end_ns, uint64_t arg);
+
+  // Drops all recorded spans (rings are kept).
+  void x10_trace_clear(void);
+
+  // Spans currently retained across all rings.
+  uint64_t x10_trace_event_count(void);
+
+  // Writes {"traceEvents":[...]} to `path`. Returns 1 on success.
+  int x10_trace_dump(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // X10_TRACE_H
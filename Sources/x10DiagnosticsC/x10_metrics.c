@@ -0,0 +1,299 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // clock_gettime / posix_memalign under strict -std=c11
+#endif
+
+#include "x10_metrics.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#endif
+
+#define X10_CACHE_LINE 64
+#define X10_COUNTER_SHARDS 16
+#define X10_HIST_SHARDS 8
+
+// ---------- Clock ----------
+
+uint64_t x10_metrics_now_ns(void)
+{
+#if defined(__APPLE__)
+  static mach_timebase_info_data_t tb;
+  if (tb.denom == 0)
+    mach_timebase_info(&tb);
+  return mach_absolute_time() * tb.numer / tb.denom;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void *alloc_aligned(size_t size)
+{
+  void *p = NULL;
+  size_t rounded = (size + X10_CACHE_LINE - 1) / X10_CACHE_LINE * X10_CACHE_LINE;
+  if (posix_memalign(&p, X10_CACHE_LINE, rounded) != 0)
+    return NULL;
+  memset(p, 0, rounded);
+  return p;
+}
+
+// ---------- Shard selection ----------
+
+static atomic_uint s_next_shard;
+static _Thread_local unsigned s_shard = UINT32_MAX;
+
+static inline unsigned shard_index(void)
+{
+  if (s_shard == UINT32_MAX)
+    s_shard = atomic_fetch_add_explicit(&s_next_shard, 1, memory_order_relaxed) % X10_COUNTER_SHARDS;
+  return s_shard;
+}
+
+// ---------- Counter ----------
+
+struct x10_counter_shard
+{
+  _Atomic uint64_t value;
+  char pad[X10_CACHE_LINE - sizeof(uint64_t)];
+};
+
+struct x10_counter
+{
+  struct x10_counter_shard shards[X10_COUNTER_SHARDS];
+};
+
+x10_counter *x10_counter_create(void)
+{
+  return (x10_counter *)alloc_aligned(sizeof(x10_counter));
+}
+
+void x10_counter_add(x10_counter *c, uint64_t v)
+{
+  atomic_fetch_add_explicit(&c->shards[shard_index()].value, v, memory_order_relaxed);
+}
+
+void x10_counter_destroy(x10_counter *c)
+{
+  free(c);
+}
+
+uint64_t x10_counter_value(const x10_counter *c)
+{
+  uint64_t total = 0;
+  for (int i = 0; i < X10_COUNTER_SHARDS; ++i)
+    total += atomic_load_explicit((_Atomic uint64_t *)&c->shards[i].value, memory_order_relaxed);
+  return total;
+}
+
+void x10_counter_reset(x10_counter *c)
+{
+  for (int i = 0; i < X10_COUNTER_SHARDS; ++i)
+    atomic_store_explicit(&c->shards[i].value, 0, memory_order_relaxed);
+}
+
+// ---------- Gauge ----------
+
+struct x10_gauge
+{
+  _Atomic int64_t value;
+};
+
+x10_gauge *x10_gauge_create(void)
+{
+  return (x10_gauge *)alloc_aligned(sizeof(x10_gauge));
+}
+
+void x10_gauge_destroy(x10_gauge *g)
+{
+  free(g);
+}
+
+void x10_gauge_add(x10_gauge *g, int64_t v)
+{
+  atomic_fetch_add_explicit(&g->value, v, memory_order_relaxed);
+}
+
+void x10_gauge_set(x10_gauge *g, int64_t v)
+{
+  atomic_store_explicit(&g->value, v, memory_order_relaxed);
+}
+
+int64_t x10_gauge_value(const x10_gauge *g)
+{
+  return atomic_load_explicit((_Atomic int64_t *)&g->value, memory_order_relaxed);
+}
+
+// ---------- Histogram ----------
+
+// Threads share shards round-robin like counter shards; _Alignas pads each
+// shard to whole cache lines.
+struct x10_histogram_shard
+{
+  _Alignas(X10_CACHE_LINE) _Atomic uint64_t count;
+  _Atomic uint64_t sum;
+  _Atomic uint64_t min;
+  _Atomic uint64_t max;
+  _Atomic uint64_t buckets[X10_HIST_BUCKETS];
+};
+
+struct x10_histogram
+{
+  struct x10_histogram_shard shards[X10_HIST_SHARDS];
+};
+
+uint32_t x10_histogram_bucket_index(uint64_t v)
+{
+  if (v < X10_HIST_SUB_BUCKETS)
+    return (uint32_t)v;
+  // Position of the highest set bit; v >= SUB_BUCKETS so msb >= SUB_BITS.
+  unsigned msb = 63u - (unsigned)__builtin_clzll(v);
+  unsigned shift = msb - X10_HIST_SUB_BITS;
+  uint32_t sub = (uint32_t)(v >> shift) & (X10_HIST_SUB_BUCKETS - 1);
+  return (shift + 1) * X10_HIST_SUB_BUCKETS + sub;
+}
+
+uint64_t x10_histogram_bucket_upper(uint32_t i)
+{
+  if (i < X10_HIST_SUB_BUCKETS)
+    return i;
+  unsigned shift = i / X10_HIST_SUB_BUCKETS - 1;
+  uint64_t sub = i % X10_HIST_SUB_BUCKETS;
+  uint64_t lo = (X10_HIST_SUB_BUCKETS + sub) << shift;
+  uint64_t width = 1ull << shift;
+  // The top bucket's bound would overflow.
+  return lo > UINT64_MAX - width ? UINT64_MAX : lo + width - 1;
+}
+
+x10_histogram *x10_histogram_create(void)
+{
+  x10_histogram *h = (x10_histogram *)alloc_aligned(sizeof(x10_histogram));
+  if (h)
+    for (int i = 0; i < X10_HIST_SHARDS; ++i)
+      atomic_store_explicit(&h->shards[i].min, UINT64_MAX, memory_order_relaxed);
+  return h;
+}
+
+void x10_histogram_destroy(x10_histogram *h)
+{
+  free(h);
+}
+
+void x10_histogram_record(x10_histogram *h, uint64_t v)
+{
+  struct x10_histogram_shard *s = &h->shards[shard_index() % X10_HIST_SHARDS];
+  atomic_fetch_add_explicit(&s->buckets[x10_histogram_bucket_index(v)], 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&s->count, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&s->sum, v, memory_order_relaxed);
+
+  uint64_t cur = atomic_load_explicit(&s->min, memory_order_relaxed);
+  while (v < cur && !atomic_compare_exchange_weak_explicit(&s->min, &cur, v, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+  cur = atomic_load_explicit(&s->max, memory_order_relaxed);
+  while (v > cur && !atomic_compare_exchange_weak_explicit(&s->max, &cur, v, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+}
+
+void x10_histogram_reset(x10_histogram *h)
+{
+  for (int s = 0; s < X10_HIST_SHARDS; ++s)
+  {
+    struct x10_histogram_shard *shard = &h->shards[s];
+    for (uint32_t i = 0; i < X10_HIST_BUCKETS; ++i)
+      atomic_store_explicit(&shard->buckets[i], 0, memory_order_relaxed);
+    atomic_store_explicit(&shard->count, 0, memory_order_relaxed);
+    atomic_store_explicit(&shard->sum, 0, memory_order_relaxed);
+    atomic_store_explicit(&shard->min, UINT64_MAX, memory_order_relaxed);
+    atomic_store_explicit(&shard->max, 0, memory_order_relaxed);
+  }
+}
+
+#define X10_LOAD(field) atomic_load_explicit((_Atomic uint64_t *)&(field), memory_order_relaxed)
+
+uint64_t x10_histogram_count(const x10_histogram *h)
+{
+  uint64_t total = 0;
+  for (int s = 0; s < X10_HIST_SHARDS; ++s)
+    total += X10_LOAD(h->shards[s].count);
+  return total;
+}
+
+uint64_t x10_histogram_sum(const x10_histogram *h)
+{
+  uint64_t total = 0;
+  for (int s = 0; s < X10_HIST_SHARDS; ++s)
+    total += X10_LOAD(h->shards[s].sum);
+  return total;
+}
+
+uint64_t x10_histogram_min(const x10_histogram *h)
+{
+  uint64_t v = UINT64_MAX;
+  for (int s = 0; s < X10_HIST_SHARDS; ++s)
+  {
+    uint64_t m = X10_LOAD(h->shards[s].min);
+    if (m < v)
+      v = m;
+  }
+  return v == UINT64_MAX ? 0 : v;
+}
+
+uint64_t x10_histogram_max(const x10_histogram *h)
+{
+  uint64_t v = 0;
+  for (int s = 0; s < X10_HIST_SHARDS; ++s)
+  {
+    uint64_t m = X10_LOAD(h->shards[s].max);
+    if (m > v)
+      v = m;
+  }
+  return v;
+}
+
+uint32_t x10_histogram_bucket_count(void)
+{
+  return X10_HIST_BUCKETS;
+}
+
+void x10_histogram_buckets(const x10_histogram *h, uint64_t *out)
+{
+  memset(out, 0, sizeof(uint64_t) * X10_HIST_BUCKETS);
+  for (int s = 0; s < X10_HIST_SHARDS; ++s)
+    for (uint32_t i = 0; i < X10_HIST_BUCKETS; ++i)
+      out[i] += X10_LOAD(h->shards[s].buckets[i]);
+}
+
+uint64_t x10_histogram_quantile(const x10_histogram *h, double q)
+{
+  uint64_t counts[X10_HIST_BUCKETS];
+  x10_histogram_buckets(h, counts);
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < X10_HIST_BUCKETS; ++i)
+    total += counts[i];
+  if (total == 0)
+    return 0;
+  if (q < 0)
+    q = 0;
+  if (q > 1)
+    q = 1;
+  uint64_t rank = (uint64_t)(q * (double)(total - 1)) + 1;
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < X10_HIST_BUCKETS; ++i)
+  {
+    seen += counts[i];
+    if (seen >= rank)
+    {
+      uint64_t upper = x10_histogram_bucket_upper(i);
+      uint64_t mx = x10_histogram_max(h);
+      return upper < mx ? upper : mx;
+    }
+  }
+  return x10_histogram_max(h);
+}
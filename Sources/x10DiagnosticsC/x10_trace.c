@@ -0,0 +1,237 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall(SYS_gettid) under strict -std=c11
+#endif
+
+#include "x10_trace.h"
+#include "x10_metrics.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+_Atomic int x10_trace_enabled_flag = 0;
+
+typedef struct
+{
+  const char *name;
+  const char *category;
+  uint64_t start_ns;
+  uint64_t dur_ns;
+  uint64_t arg;
+} x10_trace_event;
+
+typedef struct x10_trace_ring
+{
+  struct x10_trace_ring *next; // global list, push-only
+  _Atomic uint64_t tid;
+  _Atomic int in_use;           // 0 once the owning thread has exited
+  uint32_t capacity;            // power of two
+  _Atomic uint64_t head;        // total events ever written
+  _Atomic uint64_t cleared_at;  // head value at the last clear
+  x10_trace_event events[];
+} x10_trace_ring;
+
+static _Atomic(x10_trace_ring *) s_rings = NULL;
+static _Atomic uint32_t s_ring_capacity = 1u << 16;
+static _Thread_local x10_trace_ring *s_ring = NULL;
+static _Atomic uint64_t s_origin_ns = 0;
+static pthread_key_t s_ring_key;
+static pthread_once_t s_ring_key_once = PTHREAD_ONCE_INIT;
+
+static uint64_t current_tid(void)
+{
+#if defined(__APPLE__)
+  uint64_t tid = 0;
+  pthread_threadid_np(NULL, &tid);
+  return tid;
+#elif defined(__linux__)
+  return (uint64_t)syscall(SYS_gettid);
+#else
+  static _Atomic uint64_t next = 1;
+  return atomic_fetch_add(&next, 1);
+#endif
+}
+
+static uint32_t round_pow2(uint32_t v)
+{
+  uint32_t p = 1;
+  while (p < v && p < (1u << 30))
+    p <<= 1;
+  return p;
+}
+
+// Thread exit hands the ring back; it stays listed (and dumpable) until
+// a new thread adopts it.
+static void ring_release(void *p)
+{
+  atomic_store_explicit(&((x10_trace_ring *)p)->in_use, 0, memory_order_release);
+}
+
+static void ring_key_init(void)
+{
+  pthread_key_create(&s_ring_key, ring_release);
+}
+
+// An abandoned ring of `cap` events, claimed for the calling thread.
+static x10_trace_ring *adopt_ring(uint32_t cap)
+{
+  for (x10_trace_ring *r = atomic_load_explicit(&s_rings, memory_order_acquire); r; r = r->next)
+  {
+    int idle = 0;
+    if (r->capacity == cap &&
+        atomic_compare_exchange_strong_explicit(&r->in_use, &idle, 1, memory_order_acquire, memory_order_relaxed))
+    {
+      // The exited thread's spans would be labelled with the new tid.
+      atomic_store_explicit(&r->cleared_at, atomic_load_explicit(&r->head, memory_order_relaxed), memory_order_relaxed);
+      atomic_store_explicit(&r->tid, current_tid(), memory_order_relaxed);
+      return r;
+    }
+  }
+  return NULL;
+}
+
+static x10_trace_ring *ring_for_thread(void)
+{
+  if (s_ring)
+    return s_ring;
+  pthread_once(&s_ring_key_once, ring_key_init);
+  uint32_t cap = atomic_load_explicit(&s_ring_capacity, memory_order_relaxed);
+  x10_trace_ring *r = adopt_ring(cap);
+  if (!r)
+  {
+    r = (x10_trace_ring *)calloc(1, sizeof(x10_trace_ring) + (size_t)cap * sizeof(x10_trace_event));
+    if (!r)
+      return NULL;
+    atomic_init(&r->tid, current_tid());
+    atomic_init(&r->in_use, 1);
+    r->capacity = cap;
+    // Lock-free push; rings are never freed, so readers can walk the list
+    // without locks. Rings of exited threads are reused instead, which
+    // bounds memory by the peak number of tracing threads.
+    x10_trace_ring *head = atomic_load_explicit(&s_rings, memory_order_relaxed);
+    do
+    {
+      r->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&s_rings, &head, r, memory_order_release, memory_order_relaxed));
+  }
+  pthread_setspecific(s_ring_key, r);
+  s_ring = r;
+  return r;
+}
+
+void x10_trace_set_enabled(int enabled)
+{
+  uint64_t unset = 0;
+  if (enabled)
+    atomic_compare_exchange_strong(&s_origin_ns, &unset, x10_metrics_now_ns()); // first enabler wins
+  atomic_store(&x10_trace_enabled_flag, enabled ? 1 : 0);
+}
+
+void x10_trace_set_ring_capacity(uint32_t events)
+{
+  atomic_store_explicit(&s_ring_capacity, round_pow2(events ? events : 1), memory_order_relaxed);
+}
+
+void x10_trace_record(const char *name, const char *category,
+                      uint64_t start_ns, uint64_t end_ns, uint64_t arg)
+{
+  x10_trace_ring *r = ring_for_thread();
+  if (!r)
+    return;
+  uint64_t h = atomic_load_explicit(&r->head, memory_order_relaxed);
+  x10_trace_event *e = &r->events[h & (r->capacity - 1)];
+  e->name = name;
+  e->category = category;
+  e->start_ns = start_ns;
+  e->dur_ns = end_ns >= start_ns ? end_ns - start_ns : 0;
+  e->arg = arg;
+  atomic_store_explicit(&r->head, h + 1, memory_order_release);
+}
+
+// First retained index and count for a ring.
+static void ring_window(x10_trace_ring *r, uint64_t *first, uint64_t *end)
+{
+  uint64_t h = atomic_load_explicit(&r->head, memory_order_acquire);
+  uint64_t lo = atomic_load_explicit(&r->cleared_at, memory_order_relaxed);
+  if (h - lo > r->capacity)
+    lo = h - r->capacity;
+  *first = lo;
+  *end = h;
+}
+
+void x10_trace_clear(void)
+{
+  for (x10_trace_ring *r = atomic_load_explicit(&s_rings, memory_order_acquire); r; r = r->next)
+    atomic_store_explicit(&r->cleared_at, atomic_load_explicit(&r->head, memory_order_acquire), memory_order_relaxed);
+}
+
+uint64_t x10_trace_event_count(void)
+{
+  uint64_t total = 0;
+  for (x10_trace_ring *r = atomic_load_explicit(&s_rings, memory_order_acquire); r; r = r->next)
+  {
+    uint64_t first, end;
+    ring_window(r, &first, &end);
+    total += end - first;
+  }
+  return total;
+}
+
+static void write_json_string(FILE *f, const char *s)
+{
+  fputc('"', f);
+  for (; s && *s; ++s)
+  {
+    unsigned char c = (unsigned char)*s;
+    if (c == '"' || c == '\\')
+      fprintf(f, "\\%c", c);
+    else if (c < 0x20)
+      fprintf(f, "\\u%04x", c);
+    else
+      fputc(c, f);
+  }
+  fputc('"', f);
+}
+
+int x10_trace_dump(const char *path)
+{
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return 0;
+  fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", f);
+  uint64_t origin = atomic_load_explicit(&s_origin_ns, memory_order_relaxed);
+  int first_event = 1;
+  for (x10_trace_ring *r = atomic_load_explicit(&s_rings, memory_order_acquire); r; r = r->next)
+  {
+    uint64_t i, end;
+    ring_window(r, &i, &end);
+    for (; i < end; ++i)
+    {
+      // Copy out; a live writer may overwrite the slot mid-read, which can
+      // only garble that one event.
+      x10_trace_event e = r->events[i & (r->capacity - 1)];
+      if (!first_event)
+        fputc(',', f);
+      first_event = 0;
+      fputs("\n{\"name\":", f);
+      write_json_string(f, e.name);
+      fputs(",\"cat\":", f);
+      write_json_string(f, e.category);
+      uint64_t ts = e.start_ns >= origin ? e.start_ns - origin : 0;
+      fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f",
+              (unsigned long long)atomic_load_explicit(&r->tid, memory_order_relaxed), (double)ts / 1000.0, (double)e.dur_ns / 1000.0);
+      if (e.arg)
+        fprintf(f, ",\"args\":{\"value\":%llu}", (unsigned long long)e.arg);
+      fputc('}', f);
+    }
+  }
+  fputs("\n]}\n", f);
+  return fclose(f) == 0 ? 1 : 0;
+}
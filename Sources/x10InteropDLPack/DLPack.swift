@@ -12,9 +12,22 @@ public struct DLPackCapsule: Equatable, @unchecked Sendable {
   public static func == (lhs: DLPackCapsule, rhs: DLPackCapsule) -> Bool { lhs.raw == rhs.raw }
 }
 
+/// Owns one reference to a capsule and disposes it on deinit, so value types
+/// (device buffers) can hold a capsule and release it with their last copy.
+public final class DLPackCapsuleReference: @unchecked Sendable {
+  public let capsule: DLPackCapsule
+  /// Takes over a reference the caller already holds.
+  public init(adopting cap: DLPackCapsule) { capsule = cap }
+  deinit { DLPack.dispose(capsule) }
+}
+
 // MARK: - Type & device mapping utilities
 
-public enum DLPackTypeCode: Int32 { case int = 0, uint = 1, float = 2, bfloat = 4 }
+public enum DLPackTypeCode: Int32 {
+  case int = 0, uint = 1, float = 2, bfloat = 4
+  /// FP8 codes from DLPack 1.1 (`kDLFloat8_e4m3fn`, `kDLFloat8_e5m2`).
+  case float8_e4m3fn = 10, float8_e5m2 = 12
+}
 
 /// Map Swift `DType` → DLPack (code/bits/lanes).
 @inlinable public func dlType(for dtype: DType) -> (code: Int32, bits: Int32, lanes: Int32)? {
@@ -25,6 +38,8 @@ public enum DLPackTypeCode: Int32 { case int = 0, uint = 1, float = 2, bfloat =
   case .bf16: return (DLPackTypeCode.bfloat.rawValue, 16, 1)
   case .f32:  return (DLPackTypeCode.float.rawValue,  32, 1)
   case .f64:  return (DLPackTypeCode.float.rawValue,  64, 1)
+  case .f8E4M3FN: return (DLPackTypeCode.float8_e4m3fn.rawValue, 8, 1)
+  case .f8E5M2:   return (DLPackTypeCode.float8_e5m2.rawValue,   8, 1)
   }
 }
 
@@ -69,6 +84,7 @@ public enum DLPack {
   }
 
   /// Increase the capsule's internal refcount and return a handle to the same capsule.
+  /// The refcount is atomic, so retain/dispose may be called from any thread.
   @discardableResult
   public static func retain(_ cap: DLPackCapsule) -> DLPackCapsule {
     guard let p = cap.raw else { return cap }
@@ -102,6 +118,40 @@ public enum DLPack {
     return DLPackCapsule(raw: c)
   }
 
+  /// Hands the capsule to a DLPack consumer as a `DLManagedTensorVersioned*`
+  /// holding its own reference; the consumer releases it via its `deleter`.
+  public static func exportVersioned(_ cap: DLPackCapsule) throws -> UnsafeMutableRawPointer {
+    guard let raw = cap.raw, let m = x10_dlpack_export_versioned(raw) else {
+      throw DLPackError.invalid("null capsule")
+    }
+    return m
+  }
+
+  /// Takes ownership of a producer's `DLManagedTensorVersioned*`.
+  public static func importVersioned(_ managed: UnsafeMutableRawPointer) throws -> DLPackCapsule {
+    guard let c = x10_dlpack_import_versioned(managed) else {
+      throw DLPackError.cFailure(lastError ?? "importVersioned failed")
+    }
+    return DLPackCapsule(raw: c)
+  }
+
+  /// `DLPACK_FLAG_BITMASK_READ_ONLY` is set: consumers must not write through it.
+  public static func isReadOnly(_ cap: DLPackCapsule) -> Bool {
+    guard let raw = cap.raw else { return false }
+    return x10_dlpack_is_read_only(raw) == 1
+  }
+
+  /// New capsule over `cap`'s data with the read-only flag set, for handing
+  /// to one consumer. `cap` keeps its own flags (other holders may still
+  /// write through it) and stays valid; dispose both independently.
+  public static func readOnlyView(_ cap: DLPackCapsule) throws -> DLPackCapsule {
+    guard let raw = cap.raw else { throw DLPackError.invalid("null capsule") }
+    guard let v = x10_dlpack_read_only_view(raw) else {
+      throw DLPackError.cFailure(lastError ?? "read-only view failed")
+    }
+    return DLPackCapsule(raw: v)
+  }
+
   /// Minimal metadata about the tensor.
   public struct Info: Sendable {
     public let deviceType: Int32, deviceId: Int32
@@ -127,12 +177,118 @@ public enum DLPack {
   }
 
   /// Borrow the data pointer from the capsule (zero-copy read access).
+  /// Already advanced by the byte offset; for strided views, pair it with `strides`.
   public static func dataPointer(_ cap: DLPackCapsule) -> UnsafeMutableRawPointer? {
     guard let raw = cap.raw else { return nil }
     var ptr: UnsafeMutableRawPointer?
     guard x10_dlpack_data_ptr(raw, &ptr, nil) == 1 else { return nil }
     return ptr
   }
+
+  /// Byte offset of the first element from the underlying data pointer.
+  public static func byteOffset(_ cap: DLPackCapsule) -> Int? {
+    guard let raw = cap.raw else { return nil }
+    var ptr: UnsafeMutableRawPointer?
+    var offset = 0
+    guard x10_dlpack_data_ptr(raw, &ptr, &offset) == 1 else { return nil }
+    return offset
+  }
+
+  /// Element strides (dense row-major strides when the capsule carries none).
+  public static func strides(_ cap: DLPackCapsule) -> [Int]? {
+    guard let inf = basicInfo(cap), let raw = cap.raw else { return nil }
+    var tmp = [Int64](repeating: 0, count: Int(inf.ndim))
+    guard x10_dlpack_strides(raw, &tmp, Int32(tmp.count)) == inf.ndim else { return nil }
+    return tmp.map { Int($0) }
+  }
+
+  /// True when the tensor is dense row-major, i.e. `dataPointer` addresses
+  /// `shape.product` packed elements.
+  public static func isContiguous(_ cap: DLPackCapsule) -> Bool {
+    guard let raw = cap.raw else { return false }
+    return x10_dlpack_is_contiguous(raw) == 1
+  }
+
+  // MARK: Strided views
+
+  /// Zero-copy view over `cap`'s data. `strides` are in elements and
+  /// `byteOffset` is relative to the underlying data pointer (DLTensor
+  /// semantics). The view retains `cap`, so either may be disposed first.
+  public static func view(
+    _ cap: DLPackCapsule,
+    shape: [Int],
+    strides: [Int],
+    byteOffset: Int
+  ) throws -> DLPackCapsule {
+    guard let raw = cap.raw else { throw DLPackError.invalid("null capsule") }
+    guard shape.count == strides.count, !shape.isEmpty else {
+      throw DLPackError.invalid("view needs matching, non-empty shape and strides")
+    }
+    guard byteOffset >= 0 else { throw DLPackError.invalid("negative byte offset") }
+    let shp = shape.map(Int64.init), str = strides.map(Int64.init)
+    let v = shp.withUnsafeBufferPointer { sp in
+      str.withUnsafeBufferPointer { tp in
+        x10_dlpack_make_view(raw, sp.baseAddress, tp.baseAddress, Int32(shp.count), UInt64(byteOffset))
+      }
+    }
+    guard let v else { throw DLPackError.cFailure(lastError ?? "view failed") }
+    return DLPackCapsule(raw: v)
+  }
+
+  /// `cap[..., range by step, ...]` along `axis`, without copying.
+  public static func slice(
+    _ cap: DLPackCapsule,
+    axis: Int,
+    _ range: Range<Int>,
+    step: Int = 1
+  ) throws -> DLPackCapsule {
+    let l = try layout(cap)
+    guard l.shape.indices.contains(axis) else { throw DLPackError.invalid("axis \(axis) out of range") }
+    guard step > 0, range.lowerBound >= 0, range.upperBound <= l.shape[axis] else {
+      throw DLPackError.invalid("slice \(range) by \(step) outside dimension \(l.shape[axis])")
+    }
+    var shape = l.shape, strides = l.strides
+    shape[axis] = (range.count + step - 1) / step
+    strides[axis] *= step
+    return try view(cap, shape: shape, strides: strides,
+                    byteOffset: l.byteOffset + range.lowerBound * l.strides[axis] * l.elementSize)
+  }
+
+  /// Axes reordered so that result axis `i` is input axis `permutation[i]`.
+  public static func transpose(_ cap: DLPackCapsule, permutation: [Int]) throws -> DLPackCapsule {
+    let l = try layout(cap)
+    guard permutation.sorted() == Array(l.shape.indices) else {
+      throw DLPackError.invalid("\(permutation) is not a permutation of \(l.shape.count) axes")
+    }
+    return try view(cap, shape: permutation.map { l.shape[$0] }, strides: permutation.map { l.strides[$0] },
+                    byteOffset: l.byteOffset)
+  }
+
+  /// Broadcasts to `shape` (NumPy rules: new leading axes and size-1 axes
+  /// repeat with stride 0).
+  public static func expand(_ cap: DLPackCapsule, to shape: [Int]) throws -> DLPackCapsule {
+    let l = try layout(cap)
+    let lead = shape.count - l.shape.count
+    guard lead >= 0 else { throw DLPackError.invalid("cannot expand \(l.shape) to lower rank \(shape)") }
+    let strides = try shape.indices.map { i -> Int in
+      guard i >= lead else { return 0 }
+      let d = l.shape[i - lead]
+      if d == shape[i] { return l.strides[i - lead] }
+      guard d == 1 else { throw DLPackError.invalid("cannot expand \(l.shape) to \(shape)") }
+      return 0
+    }
+    return try view(cap, shape: shape, strides: strides, byteOffset: l.byteOffset)
+  }
+
+  private static func layout(_ cap: DLPackCapsule) throws
+    -> (shape: [Int], strides: [Int], byteOffset: Int, elementSize: Int)
+  {
+    guard let inf = basicInfo(cap), let shape = Self.shape(cap), let strides = Self.strides(cap),
+          let offset = byteOffset(cap) else {
+      throw DLPackError.invalid("null capsule")
+    }
+    return (shape, strides, offset, Int(inf.bits / 8 * max(inf.lanes, 1)))
+  }
 }
 
 // MARK: - Copy helpers (portable, for when zero-copy isn’t possible)
@@ -164,26 +320,33 @@ public enum DLPackHost {
     return DLPackCapsule(raw: c)
   }
 
+  /// Dense row-major copy; strided views are gathered.
   public static func toHostData(_ cap: DLPackCapsule) throws -> Data {
     guard DLPack.isAvailable else { throw DLPackError.notAvailable(DLPack.lastError ?? "") }
     guard let ptr = cap.raw else { throw DLPackError.invalid("null capsule") }
 
-    // Probe required size (C wants Int32*).
-    var written32: Int32 = 0
-    guard x10_dlpack_to_host_copy(ptr, nil, 0, &written32) == 1 else {
+    // Probe required size.
+    var need = 0
+    guard x10_dlpack_to_host_copy(ptr, nil, 0, &need) == 1 else {
       throw DLPackError.cFailure(DLPack.lastError ?? "probe failed")
     }
-    let need = Int(written32)
 
     var out = Data(count: need)
-    var writtenAgain32: Int32 = 0
+    var written = 0
     let ok = out.withUnsafeMutableBytes { mb -> Int32 in
-      x10_dlpack_to_host_copy(ptr, mb.baseAddress, mb.count, &writtenAgain32)
+      x10_dlpack_to_host_copy(ptr, mb.baseAddress, mb.count, &written)
     }
-    guard ok == 1, Int(writtenAgain32) == need else {
-      throw DLPackError.cFailure(DLPack.lastError ?? "copy failed (wrote \(writtenAgain32), need \(need))")
+    guard ok == 1, written == need else {
+      throw DLPackError.cFailure(DLPack.lastError ?? "copy failed (wrote \(written), need \(need))")
     }
     return out
   }
 
+  /// Host-to-host copy through the shim's copy engine: split across threads
+  /// for large buffers, streaming stores for buffers far beyond cache size.
+  /// `src` and `dst` must not overlap.
+  public static func copyBytes(from src: UnsafeRawPointer, to dst: UnsafeMutableRawPointer, count: Int) {
+    x10_dlpack_copy_bytes(dst, src, count)
+  }
+
 }
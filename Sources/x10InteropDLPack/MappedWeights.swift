@@ -0,0 +1,263 @@
+import Foundation
+import x10Core
+import x10InteropDLPackC
+
+/// Tensors stored in a safetensors or `.npy` file, read through one shared,
+/// read-only mapping of the file.
+///
+/// Opening parses only the header; tensor bytes are paged in on first touch,
+/// and processes that map the same file share its page cache. `capsule(_:)`
+/// returns read-only DLPack capsules aliasing the mapping, which feed
+/// `PJRTBackend.importDLPack`, `IREEBackend.importDLPack` and
+/// `Tensor(dlpack:)` without a copy. The file stays mapped until this object
+/// and every capsule from it are gone.
+public final class MappedWeights: @unchecked Sendable {
+  public struct Entry: Sendable, Equatable {
+    public let name: String
+    public let dtype: DType
+    public let shape: [Int]
+    /// Element strides; nil for dense row-major. Fortran-ordered `.npy`
+    /// arrays are column-major.
+    public let strides: [Int]?
+    /// Offset of the first element from the start of the file.
+    public let byteOffset: Int
+    public let byteCount: Int
+  }
+
+  public let url: URL
+  /// Tensors in file order.
+  public let entries: [Entry]
+  /// The safetensors `__metadata__` map (empty for `.npy`).
+  public let metadata: [String: String]
+  /// Tensors that cannot be exposed (a dtype without a `DType`, or rank 0),
+  /// with the reason.
+  public let skipped: [String: String]
+  private let mapping: x10_dl_mapping_t
+  private let index: [String: Int]
+
+  /// Maps `url`, reading it as `.npy` for that extension and as safetensors
+  /// otherwise.
+  public convenience init(contentsOf url: URL) throws {
+    try self.init(url, npy: url.pathExtension.lowercased() == "npy")
+  }
+
+  public static func safetensors(_ url: URL) throws -> MappedWeights { try MappedWeights(url, npy: false) }
+  public static func npy(_ url: URL) throws -> MappedWeights { try MappedWeights(url, npy: true) }
+
+  private init(_ url: URL, npy: Bool) throws {
+    guard DLPack.isAvailable else { throw DLPackError.notAvailable(DLPack.lastError ?? "") }
+    guard let mapping = x10_dlpack_map_file(url.path) else {
+      throw DLPackError.cFailure("\(url.path): \(DLPack.lastError ?? "map failed")")
+    }
+    let base = UnsafeRawPointer(x10_dlpack_mapping_data(mapping)!)
+    let size = x10_dlpack_mapping_size(mapping)
+    let header: Header
+    do {
+      header = npy ? try Self.readNPY(base, size: size, url: url)
+                   : try Self.readSafetensors(base, size: size, path: url.path)
+    } catch {
+      x10_dlpack_mapping_release(mapping)
+      throw error
+    }
+    self.url = url
+    self.mapping = mapping
+    self.entries = header.entries
+    self.metadata = header.metadata
+    self.skipped = header.skipped
+    self.index = Dictionary(uniqueKeysWithValues: header.entries.enumerated().map { ($1.name, $0) })
+  }
+
+  deinit { x10_dlpack_mapping_release(mapping) }
+
+  public var names: [String] { entries.map(\.name) }
+
+  public subscript(name: String) -> Entry? { index[name].map { entries[$0] } }
+
+  /// Read-only CPU capsule aliasing `name`'s bytes in the mapping; dispose it
+  /// when done (importing retains it, so that may be right away).
+  public func capsule(_ name: String) throws -> DLPackCapsule {
+    guard let entry = self[name] else { throw DLPackError.invalid("\(url.lastPathComponent) has no tensor \"\(name)\"") }
+    guard let t = dlType(for: entry.dtype) else { throw DLPackError.invalid("unsupported dtype") }
+    let shape = entry.shape.map(Int64.init)
+    let strides = entry.strides?.map(Int64.init)
+    let cap = shape.withUnsafeBufferPointer { sp in
+      withOptionalBuffer(strides) { stp in
+        x10_dlpack_wrap_mapped(mapping, UInt64(entry.byteOffset), sp.baseAddress, stp, Int32(shape.count),
+                               t.code, t.bits, t.lanes)
+      }
+    }
+    guard let cap else { throw DLPackError.cFailure(DLPack.lastError ?? "wrap_mapped failed") }
+    return DLPackCapsule(raw: cap)
+  }
+
+  /// A capsule per entry, keyed by name; the caller disposes each.
+  public func capsules() throws -> [String: DLPackCapsule] {
+    var out: [String: DLPackCapsule] = [:]
+    do {
+      for entry in entries { out[entry.name] = try capsule(entry.name) }
+    } catch {
+      out.values.forEach(DLPack.dispose)
+      throw error
+    }
+    return out
+  }
+
+  /// `name` as a host tensor borrowing the mapping (dense entries) or
+  /// copied from it (column-major `.npy`, or an entry whose offset is not
+  /// aligned for `Scalar`, which safetensors allows).
+  public func tensor<Scalar: TensorScalar>(_ name: String, as _: Scalar.Type = Scalar.self) throws -> Tensor<Scalar> {
+    let cap = try capsule(name)
+    defer { DLPack.dispose(cap) }
+    return try Tensor<Scalar>(dlpack: cap)
+  }
+
+  // MARK: - Headers
+
+  private struct Header {
+    var entries: [Entry] = []
+    var metadata: [String: String] = [:]
+    var skipped: [String: String] = [:]
+  }
+
+  /// Bytes of a dense `shape` tensor, nil on overflow (a corrupt header).
+  private static func byteCount(_ shape: [Int], _ dtype: DType) -> Int? {
+    var n = Int(dlType(for: dtype)!.bits) / 8
+    for d in shape {
+      let (product, overflow) = n.multipliedReportingOverflow(by: d)
+      if overflow { return nil }
+      n = product
+    }
+    return n
+  }
+
+  private static let safetensorsDTypes: [String: DType] = [
+    "F64": .f64, "F32": .f32, "F16": .f16, "BF16": .bf16, "I64": .i64, "I32": .i32,
+    "F8_E4M3": .f8E4M3FN, "F8_E5M2": .f8E5M2,
+  ]
+
+  /// Layout: u64 little-endian header length N, N bytes of JSON
+  /// (`{"name": {"dtype", "shape", "data_offsets": [begin, end]}, "__metadata__": {...}}`),
+  /// then the data; offsets are relative to the end of the header.
+  private static func readSafetensors(_ base: UnsafeRawPointer, size: Int, path: String) throws -> Header {
+    guard size >= 8 else { throw DLPackError.invalid("\(path) is not a safetensors file") }
+    let headerLength = UInt64(littleEndian: base.loadUnaligned(as: UInt64.self))
+    guard headerLength <= UInt64(size - 8) else { throw DLPackError.invalid("\(path): header out of bounds") }
+    let dataStart = 8 + Int(headerLength)
+    let json = Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: base + 8), count: Int(headerLength), deallocator: .none)
+    guard let object = try? JSONSerialization.jsonObject(with: json), let fields = object as? [String: Any] else {
+      throw DLPackError.invalid("\(path): unreadable safetensors header")
+    }
+
+    var header = Header()
+    for (name, value) in fields {
+      if name == "__metadata__" {
+        header.metadata = value as? [String: String] ?? [:]
+        continue
+      }
+      guard let info = value as? [String: Any], let dtypeName = info["dtype"] as? String,
+            let shape = info["shape"] as? [Int], shape.allSatisfy({ $0 >= 0 }),
+            let offsets = info["data_offsets"] as? [Int], offsets.count == 2 else {
+        throw DLPackError.invalid("\(path): malformed entry \"\(name)\"")
+      }
+      let (begin, end) = (offsets[0], offsets[1])
+      guard begin >= 0, begin <= end, end <= size - dataStart else {
+        throw DLPackError.invalid("\(path): \"\(name)\" lies outside the file")
+      }
+      guard let dtype = safetensorsDTypes[dtypeName] else { header.skipped[name] = "dtype \(dtypeName)"; continue }
+      guard !shape.isEmpty else { header.skipped[name] = "rank 0"; continue }
+      guard end - begin == byteCount(shape, dtype) else {
+        throw DLPackError.invalid("\(path): \"\(name)\" has \(end - begin) bytes for shape \(shape) of \(dtypeName)")
+      }
+      header.entries.append(Entry(name: name, dtype: dtype, shape: shape, strides: nil,
+                                  byteOffset: dataStart + begin, byteCount: end - begin))
+    }
+    header.entries.sort { $0.byteOffset < $1.byteOffset }
+    return header
+  }
+
+  /// Layout: "\x93NUMPY", major and minor version bytes, header length (u16
+  /// for version 1, u32 after), a Python dict literal with `descr`,
+  /// `fortran_order` and `shape`, then the data. The tensor is named after
+  /// the file.
+  private static func readNPY(_ base: UnsafeRawPointer, size: Int, url: URL) throws -> Header {
+    let path = url.path
+    let magic: [UInt8] = [0x93, 0x4E, 0x55, 0x4D, 0x50, 0x59] // \x93NUMPY
+    guard size >= 10, Array(UnsafeRawBufferPointer(start: base, count: 6)) == magic else {
+      throw DLPackError.invalid("\(path) is not an .npy file")
+    }
+    let major = base.load(fromByteOffset: 6, as: UInt8.self)
+    let lengthStart: Int, headerStart: Int
+    switch major {
+    case 1: (lengthStart, headerStart) = (8, 10)
+    case 2, 3: (lengthStart, headerStart) = (8, 12)
+    default: throw DLPackError.invalid("\(path): unsupported .npy version \(major)")
+    }
+    guard size >= headerStart else { throw DLPackError.invalid("\(path): truncated header") }
+    let headerLength = major == 1
+      ? Int(UInt16(littleEndian: base.loadUnaligned(fromByteOffset: lengthStart, as: UInt16.self)))
+      : Int(UInt32(littleEndian: base.loadUnaligned(fromByteOffset: lengthStart, as: UInt32.self)))
+    guard headerLength <= size - headerStart else { throw DLPackError.invalid("\(path): truncated header") }
+    let dict = String(decoding: UnsafeRawBufferPointer(start: base + headerStart, count: headerLength), as: UTF8.self)
+
+    guard let descr = npyField(dict, "descr").flatMap(npyQuoted),
+          let fortran = npyField(dict, "fortran_order").map({ $0.hasPrefix("True") }),
+          let shapeText = npyField(dict, "shape"), shapeText.hasPrefix("("),
+          let close = shapeText.firstIndex(of: ")") else {
+      throw DLPackError.invalid("\(path): unreadable .npy header")
+    }
+    let dims = shapeText[shapeText.index(after: shapeText.startIndex)..<close]
+      .split(separator: ",").map { $0.trimmingCharacters(in: .whitespaces) }.filter { !$0.isEmpty }
+    let shape = dims.compactMap { Int($0) }
+    guard shape.count == dims.count, shape.allSatisfy({ $0 >= 0 }) else {
+      throw DLPackError.invalid("\(path): bad shape \(shapeText[...close])")
+    }
+
+    let name = url.deletingPathExtension().lastPathComponent
+    var header = Header()
+    guard let dtype = npyDType(descr) else { header.skipped[name] = "dtype \(descr)"; return header }
+    guard !shape.isEmpty else { header.skipped[name] = "rank 0"; return header }
+    let dataStart = headerStart + headerLength
+    guard let count = byteCount(shape, dtype), count <= size - dataStart else {
+      throw DLPackError.invalid("\(path): data is truncated")
+    }
+
+    var strides: [Int]?
+    if fortran && shape.count > 1 {
+      var s = 1
+      strides = shape.map { d in defer { s *= d }; return s }
+    }
+    header.entries = [Entry(name: name, dtype: dtype, shape: shape, strides: strides,
+                            byteOffset: dataStart, byteCount: count)]
+    return header
+  }
+
+  /// Text after `'key':` in the header dict, leading spaces trimmed.
+  private static func npyField(_ dict: String, _ key: String) -> Substring? {
+    guard let r = dict.range(of: "'\(key)':") ?? dict.range(of: "\"\(key)\":") else { return nil }
+    return dict[r.upperBound...].drop { $0 == " " }
+  }
+
+  private static func npyQuoted(_ text: Substring) -> String? {
+    guard let quote = text.first, quote == "'" || quote == "\"" else { return nil }
+    let body = text.dropFirst()
+    return body.firstIndex(of: quote).map { String(body[..<$0]) }
+  }
+
+  /// Little-endian or native numeric descriptors only (`<f4`, `=i8`, ...).
+  private static func npyDType(_ descr: String) -> DType? {
+    guard descr.count == 3, let order = descr.first, "<=|".contains(order) else { return nil }
+    switch descr.dropFirst() {
+    case "f2": return .f16
+    case "f4": return .f32
+    case "f8": return .f64
+    case "i4": return .i32
+    case "i8": return .i64
+    default: return nil
+    }
+  }
+}
+
+private func withOptionalBuffer<R>(_ values: [Int64]?, _ body: (UnsafePointer<Int64>?) -> R) -> R {
+  guard let values else { return body(nil) }
+  return values.withUnsafeBufferPointer { body($0.baseAddress) }
+}
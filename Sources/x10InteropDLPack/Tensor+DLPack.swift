@@ -0,0 +1,71 @@
+import Foundation
+import x10Core
+import x10InteropDLPackC
+
+extension DLPack {
+  /// Zero-copy CPU capsule over `storage`; the capsule holds a reference to
+  /// `storage` until its last dispose.
+  public static func wrap(_ storage: TensorStorage, shape: [Int], dtype: DType) throws -> DLPackCapsule {
+    guard isAvailable else { throw DLPackError.notAvailable(lastError ?? "") }
+    guard let t = dlType(for: dtype) else { throw DLPackError.invalid("unsupported dtype") }
+    guard !shape.isEmpty else { throw DLPackError.invalid("rank-0 tensors cannot be wrapped") }
+    let owner = Unmanaged.passRetained(storage)
+    let dims64 = shape.map(Int64.init)
+    let cap = dims64.withUnsafeBufferPointer { sp in
+      x10_dlpack_wrap_host_buffer_ctx(
+        storage.data, sp.baseAddress, Int32(dims64.count), t.code, t.bits, t.lanes,
+        { ctx in Unmanaged<TensorStorage>.fromOpaque(ctx!).release() },
+        owner.toOpaque())
+    }
+    guard let cap else {
+      owner.release()
+      throw DLPackError.cFailure(lastError ?? "wrap failed")
+    }
+    return DLPackCapsule(raw: cap)
+  }
+}
+
+extension Tensor {
+  /// Read-only capsule aliasing this tensor's storage (no copy). Writes to
+  /// the tensor afterwards copy its storage first, so the capsule keeps
+  /// seeing the values it was exported with.
+  public func dlpackCapsule() throws -> DLPackCapsule {
+    let cap = try DLPack.wrap(storage, shape: shape, dtype: Scalar.dtype)
+    defer { DLPack.dispose(cap) }
+    return try DLPack.readOnlyView(cap)
+  }
+
+  /// Tensor over a CPU capsule's data. Dense capsules are borrowed without
+  /// copying (the tensor retains the capsule and copies on first write);
+  /// strided views and data not aligned for `Scalar` (e.g. a safetensors
+  /// entry at an odd offset) are copied into new storage.
+  public init(dlpack cap: DLPackCapsule, on device: Device = .cpu(0)) throws {
+    guard let info = DLPack.basicInfo(cap), let shape = DLPack.shape(cap) else {
+      throw DLPackError.invalid("null capsule")
+    }
+    guard info.deviceType == DLPackDeviceType.cpu.rawValue else {
+      throw DLPackError.invalid("capsule is not in host memory (device type \(info.deviceType))")
+    }
+    guard let t = dlType(for: Scalar.dtype), (info.code, info.bits, max(info.lanes, 1)) == (t.code, t.bits, t.lanes) else {
+      throw DLPackError.invalid("capsule dtype (\(info.code), \(info.bits)) is not \(Scalar.dtype)")
+    }
+    let byteCount = shape.reduce(1, *) * MemoryLayout<Scalar>.stride
+
+    if DLPack.isContiguous(cap), let data = DLPack.dataPointer(cap),
+       Int(bitPattern: data) % MemoryLayout<Scalar>.alignment == 0 {
+      let retained = DLPack.retain(cap)
+      let storage = TensorStorage(borrowing: data, byteCount: byteCount, writable: false) {
+        DLPack.dispose(retained)
+      }
+      self.init(shape: shape, storage: storage, on: device)
+      return
+    }
+
+    let storage = TensorStorage(uninitializedByteCount: byteCount)
+    var written = 0
+    guard x10_dlpack_to_host_copy(cap.raw, storage.data, byteCount, &written) == 1, written == byteCount else {
+      throw DLPackError.cFailure(DLPack.lastError ?? "gather failed")
+    }
+    self.init(shape: shape, storage: storage, on: device)
+  }
+}
@@ -12,6 +12,9 @@ extern "C"
   // Opaque capsule handle
   typedef struct x10_dl_capsule x10_dl_capsule;
   typedef x10_dl_capsule *x10_dl_capsule_t;
+  // Opaque, refcounted read-only file mapping
+  typedef struct x10_dl_mapping x10_dl_mapping;
+  typedef x10_dl_mapping *x10_dl_mapping_t;
 
   // Availability/probe and last error string
   int x10_dlpack_is_available(void); // returns 1 if shim is compiled in
@@ -24,6 +27,34 @@ extern "C"
       const int64_t *shape, int32_t ndim,
       int32_t dtype_code, int32_t dtype_bits, int32_t dtype_lanes);
 
+  // ---- Zero-copy host alias (borrowed data) ----
+  // Wrap `data` without taking ownership; `release(ctx)` runs once, when the
+  // last reference is disposed (e.g. to drop the owner's refcount). On
+  // failure NULL is returned and `release` is not called.
+  x10_dl_capsule_t x10_dlpack_wrap_host_buffer_ctx(
+      void *data,
+      const int64_t *shape, int32_t ndim,
+      int32_t dtype_code, int32_t dtype_bits, int32_t dtype_lanes,
+      void (*release)(void *ctx), void *ctx);
+
+  // ---- Memory-mapped files (zero-copy) ----
+  // Maps `path` read-only with MAP_SHARED, so processes mapping the same file
+  // share its page cache. Returns a mapping holding one reference, or NULL.
+  x10_dl_mapping_t x10_dlpack_map_file(const char *path);
+  const void *x10_dlpack_mapping_data(x10_dl_mapping_t m);
+  size_t x10_dlpack_mapping_size(x10_dl_mapping_t m);
+  // Drops a reference; the file is unmapped when the last one goes, whether
+  // that is the caller's or a capsule's.
+  void x10_dlpack_mapping_release(x10_dl_mapping_t m);
+  // Read-only CPU capsule over the mapping at `byte_offset` (any alignment;
+  // the DLTensor's data is the mapping base). `strides` are in elements,
+  // NULL for dense row-major. The capsule holds a reference on the mapping
+  // until its last dispose. Fails if the tensor reaches outside the file.
+  x10_dl_capsule_t x10_dlpack_wrap_mapped(
+      x10_dl_mapping_t m, uint64_t byte_offset,
+      const int64_t *shape, const int64_t *strides, int32_t ndim,
+      int32_t dtype_code, int32_t dtype_bits, int32_t dtype_lanes);
+
   // ---- Copy-based helpers (portable) ----
   // Copy `nbytes` from `bytes` into a newly-allocated tensor and return a capsule.
   // The device metadata is recorded (CPU, METAL, VULKAN, etc.), but data lives on host.
@@ -34,17 +65,42 @@ extern "C"
       int32_t device_type, int32_t device_id,
       x10_dl_capsule_t *out_cap);
 
-  // Copy tensor bytes into caller buffer. If `out==NULL` or `out_capacity==0`,
+  // Copy tensor bytes into caller buffer as a dense row-major array (strided
+  // views are gathered). If `out==NULL` or `out_capacity==0`,
   // `*out_written` receives required number of bytes. Returns 1 on success.
   int x10_dlpack_to_host_copy(
       x10_dl_capsule_t cap,
       void *out, size_t out_capacity,
-      int *out_written);
+      size_t *out_written);
+
+  // memcpy for large host buffers: split across a persistent worker pool, with
+  // non-temporal stores for copies far larger than the caches. Small copies
+  // are a plain memcpy. Buffers must not overlap.
+  void x10_dlpack_copy_bytes(void *dst, const void *src, size_t nbytes);
+  // Worker cap used by x10_dlpack_copy_bytes (X10_COPY_THREADS, default min(cores, 8)).
+  int x10_dlpack_copy_threads(void);
 
   // ---- Lifetime and queries ----
+  // Atomic refcount: retain/dispose may race freely across threads. A
+  // capsule is one allocation, recycled through a per-thread freelist.
   x10_dl_capsule_t x10_dlpack_retain(x10_dl_capsule_t cap);
   void x10_dlpack_dispose(x10_dl_capsule_t cap);
 
+  // ---- DLManagedTensorVersioned exchange ----
+  // Returns the capsule's DLManagedTensorVersioned* with a new reference;
+  // the consumer releases it by calling its deleter.
+  void *x10_dlpack_export_versioned(x10_dl_capsule_t cap);
+  // Takes ownership of a DLManagedTensorVersioned* (its deleter runs when the
+  // capsule is disposed). Fails on a different DLPack major version.
+  x10_dl_capsule_t x10_dlpack_import_versioned(void *managed);
+
+  // DLPACK_FLAG_BITMASK_* bits (read-only = 1, copied = 2).
+  uint64_t x10_dlpack_flags(x10_dl_capsule_t cap);
+  int x10_dlpack_is_read_only(x10_dl_capsule_t cap);
+  // New capsule over `cap`'s data with the read-only flag set; it retains
+  // `cap`, whose own flags are left alone. Views made from it inherit the flag.
+  x10_dl_capsule_t x10_dlpack_read_only_view(x10_dl_capsule_t cap);
+
   // Fill out tensor basics (device/dtype/ndim); returns 1 on success.
   int x10_dlpack_basic_info(
       x10_dl_capsule_t cap,
@@ -60,6 +116,22 @@ extern "C"
   int x10_dlpack_data_ptr(
       x10_dl_capsule_t cap, void **out_ptr, size_t *out_byte_offset);
 
+  // ---- Strided views (zero-copy) ----
+  // New capsule over `base`'s data with its own shape, element strides and
+  // byte offset (relative to the data pointer, as in DLTensor). The view
+  // retains `base`; it fails if it could reach outside `base`'s extent.
+  x10_dl_capsule_t x10_dlpack_make_view(
+      x10_dl_capsule_t base,
+      const int64_t *shape, const int64_t *strides, int32_t ndim,
+      uint64_t byte_offset);
+
+  // Element strides (dense strides when the tensor has none); returns ndim or -1.
+  int x10_dlpack_strides(
+      x10_dl_capsule_t cap, int64_t *out_strides, int32_t capacity);
+
+  // 1 if the tensor is dense row-major (size-1 dims ignored).
+  int x10_dlpack_is_contiguous(x10_dl_capsule_t cap);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
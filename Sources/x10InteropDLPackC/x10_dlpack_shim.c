@@ -1,45 +1,135 @@
 #include "x10_dlpack_shim.h"
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <dlpack/dlpack.h>
 
+// One allocation per capsule: the versioned managed tensor, the refcount and
+// the shape/strides arrays live together. Capsules with up to
+// X10_DL_INLINE_DIMS dims share one size and are recycled through a
+// per-thread freelist; higher ranks are sized exactly and never cached.
+enum
+{
+  X10_DL_INLINE_DIMS = 8,
+  X10_DL_CACHE_MAX = 64
+};
+
+typedef enum
+{
+  X10_DL_OWN_NONE,    // views: `parent` owns the data
+  X10_DL_OWN_FREE,     // free(data) on release
+  X10_DL_OWN_EXTERNAL, // imported: call `external`'s deleter
+  X10_DL_OWN_CALLBACK  // borrowed: call `release(release_ctx)`
+} x10_dl_owner;
+
 struct x10_dl_capsule
 {
-  DLManagedTensor *mt;
-  int64_t *shape_copy;
-  int64_t *strides_copy;
-  int refcount;
-  int32_t device_type;
-  int32_t device_id;
+  DLManagedTensorVersioned mtv; // dl_tensor.shape/strides point into `dims`
+  atomic_int refcount;
+  int32_t dims_capacity;
+  uint8_t owner;
+  x10_dl_capsule_t parent;
+  DLManagedTensorVersioned *external;
+  void (*release)(void *);
+  void *release_ctx;
+  x10_dl_capsule_t next_free;
+  int64_t dims[]; // shape[dims_capacity], then strides[dims_capacity]
 };
 
-static const char *g_last_error = "";
+static _Thread_local const char *g_last_error = "";
 static void set_last_error(const char *msg) { g_last_error = msg ? msg : ""; }
 
 int x10_dlpack_is_available(void) { return 1; }
 const char *x10_dlpack_last_error(void) { return g_last_error; }
 
-// --- deleters ---
+// --- per-thread capsule freelist ---
+
+typedef struct
+{
+  x10_dl_capsule_t head;
+  int count;
+} x10_dl_cache;
+
+static _Thread_local x10_dl_cache t_cache;
+static _Thread_local int t_cache_registered;
+static pthread_key_t s_cache_key;
+static pthread_once_t s_cache_once = PTHREAD_ONCE_INIT;
+
+static void x10_dl_cache_flush(void *p)
+{
+  x10_dl_cache *c = (x10_dl_cache *)p;
+  while (c->head)
+  {
+    x10_dl_capsule_t next = c->head->next_free;
+    free(c->head);
+    c->head = next;
+  }
+  c->count = 0;
+}
+
+static void x10_dl_cache_key_init(void) { (void)pthread_key_create(&s_cache_key, x10_dl_cache_flush); }
+
+static x10_dl_capsule_t x10_dl_capsule_new(int32_t ndim)
+{
+  if (ndim <= X10_DL_INLINE_DIMS && t_cache.head)
+  {
+    x10_dl_capsule_t cap = t_cache.head;
+    t_cache.head = cap->next_free;
+    t_cache.count--;
+    return cap;
+  }
+  int32_t capacity = ndim <= X10_DL_INLINE_DIMS ? X10_DL_INLINE_DIMS : ndim;
+  x10_dl_capsule_t cap = (x10_dl_capsule_t)malloc(sizeof(struct x10_dl_capsule) +
+                                                  2 * sizeof(int64_t) * (size_t)capacity);
+  if (cap)
+    cap->dims_capacity = capacity;
+  return cap;
+}
 
-static void x10_dl_deleter_free_data(DLManagedTensor *self)
+static void x10_dl_capsule_recycle(x10_dl_capsule_t cap)
 {
-  if (!self)
+  if (cap->dims_capacity == X10_DL_INLINE_DIMS && t_cache.count < X10_DL_CACHE_MAX)
+  {
+    if (!t_cache_registered)
+    {
+      // Registers the thread-exit flush; the key's value is only a trigger.
+      pthread_once(&s_cache_once, x10_dl_cache_key_init);
+      (void)pthread_setspecific(s_cache_key, &t_cache);
+      t_cache_registered = 1;
+    }
+    cap->next_free = t_cache.head;
+    t_cache.head = cap;
+    t_cache.count++;
     return;
-  if (self->dl_tensor.data)
-    free(self->dl_tensor.data);
-  // DLManagedTensor freed by capsule dispose
+  }
+  free(cap);
 }
 
 // --- internal helpers ---
 
+static void x10_dl_versioned_deleter(DLManagedTensorVersioned *self)
+{
+  if (self)
+    x10_dlpack_dispose((x10_dl_capsule_t)self->manager_ctx);
+}
+
 static x10_dl_capsule_t x10_alloc_capsule(
     void *data,
-    const int64_t *shape, int32_t ndim,
+    const int64_t *shape, const int64_t *strides /*NULL == dense*/, int32_t ndim,
+    uint64_t byte_offset,
     DLDataType dtype,
     DLDevice device,
-    DLManagedTensor **out_mt /*optional*/,
-    void (*deleter)(DLManagedTensor *))
+    uint64_t flags,
+    x10_dl_owner owner)
 {
   set_last_error("");
   if (!data || !shape || ndim <= 0)
@@ -48,50 +138,40 @@ static x10_dl_capsule_t x10_alloc_capsule(
     return NULL;
   }
 
-  x10_dl_capsule_t cap = (x10_dl_capsule_t)calloc(1, sizeof(*cap));
+  x10_dl_capsule_t cap = x10_dl_capsule_new(ndim);
   if (!cap)
   {
     set_last_error("oom");
     return NULL;
   }
+  int64_t *shape_slot = cap->dims;
+  int64_t *strides_slot = cap->dims + cap->dims_capacity;
+  memcpy(shape_slot, shape, sizeof(int64_t) * (size_t)ndim);
+  if (strides)
+    memcpy(strides_slot, strides, sizeof(int64_t) * (size_t)ndim);
 
-  cap->mt = (DLManagedTensor *)calloc(1, sizeof(DLManagedTensor));
-  if (!cap->mt)
-  {
-    free(cap);
-    set_last_error("oom");
-    return NULL;
-  }
-
-  cap->shape_copy = (int64_t *)malloc(sizeof(int64_t) * (size_t)ndim);
-  if (!cap->shape_copy)
-  {
-    free(cap->mt);
-    free(cap);
-    set_last_error("oom");
-    return NULL;
-  }
-  memcpy(cap->shape_copy, shape, sizeof(int64_t) * (size_t)ndim);
+  atomic_init(&cap->refcount, 1);
+  cap->owner = (uint8_t)owner;
+  cap->parent = NULL;
+  cap->external = NULL;
+  cap->release = NULL;
+  cap->release_ctx = NULL;
+  cap->next_free = NULL;
 
-  cap->strides_copy = NULL; // dense
-  cap->refcount = 1;
-  cap->device_type = (int32_t)device.device_type;
-  cap->device_id = (int32_t)device.device_id;
+  cap->mtv.version.major = DLPACK_MAJOR_VERSION;
+  cap->mtv.version.minor = DLPACK_MINOR_VERSION;
+  cap->mtv.manager_ctx = cap;
+  cap->mtv.deleter = x10_dl_versioned_deleter;
+  cap->mtv.flags = flags;
 
-  DLTensor *t = &cap->mt->dl_tensor;
+  DLTensor *t = &cap->mtv.dl_tensor;
   t->data = data;
   t->device = device;
   t->ndim = ndim;
   t->dtype = dtype;
-  t->shape = cap->shape_copy;
-  t->strides = NULL;
-  t->byte_offset = 0;
-
-  cap->mt->manager_ctx = NULL;
-  cap->mt->deleter = deleter;
-
-  if (out_mt)
-    *out_mt = cap->mt;
+  t->shape = shape_slot;
+  t->strides = strides ? strides_slot : NULL;
+  t->byte_offset = byte_offset;
   return cap;
 }
 
@@ -104,7 +184,24 @@ x10_dl_capsule_t x10_dlpack_wrap_host_buffer_free(
 {
   DLDevice dev = {.device_type = kDLCPU, .device_id = 0};
   DLDataType dt = {.code = (uint8_t)dtype_code, .bits = (uint8_t)dtype_bits, .lanes = (uint16_t)dtype_lanes};
-  return x10_alloc_capsule(data, shape, ndim, dt, dev, NULL, x10_dl_deleter_free_data);
+  return x10_alloc_capsule(data, shape, NULL, ndim, 0, dt, dev, 0, X10_DL_OWN_FREE);
+}
+
+x10_dl_capsule_t x10_dlpack_wrap_host_buffer_ctx(
+    void *data,
+    const int64_t *shape, int32_t ndim,
+    int32_t dtype_code, int32_t dtype_bits, int32_t dtype_lanes,
+    void (*release)(void *ctx), void *ctx)
+{
+  DLDevice dev = {.device_type = kDLCPU, .device_id = 0};
+  DLDataType dt = {.code = (uint8_t)dtype_code, .bits = (uint8_t)dtype_bits, .lanes = (uint16_t)dtype_lanes};
+  x10_dl_capsule_t cap = x10_alloc_capsule(data, shape, NULL, ndim, 0, dt, dev, 0, X10_DL_OWN_CALLBACK);
+  if (cap)
+  {
+    cap->release = release;
+    cap->release_ctx = ctx;
+  }
+  return cap;
 }
 
 int x10_dlpack_wrap_host_copy(
@@ -126,11 +223,12 @@ int x10_dlpack_wrap_host_copy(
     set_last_error("oom");
     return 0;
   }
-  memcpy(data, bytes, nbytes);
+  x10_dlpack_copy_bytes(data, bytes, nbytes);
 
   DLDevice dev = {.device_type = (DLDeviceType)device_type, .device_id = device_id};
   DLDataType dt = {.code = (uint8_t)dtype_code, .bits = (uint8_t)dtype_bits, .lanes = (uint16_t)dtype_lanes};
-  x10_dl_capsule_t cap = x10_alloc_capsule(data, shape, ndim, dt, dev, NULL, x10_dl_deleter_free_data);
+  x10_dl_capsule_t cap = x10_alloc_capsule(data, shape, NULL, ndim, 0, dt, dev,
+                                           DLPACK_FLAG_BITMASK_IS_COPIED, X10_DL_OWN_FREE);
   if (!cap)
   {
     free(data);
@@ -143,7 +241,7 @@ int x10_dlpack_wrap_host_copy(
 x10_dl_capsule_t x10_dlpack_retain(x10_dl_capsule_t cap)
 {
   if (cap)
-    cap->refcount++;
+    atomic_fetch_add_explicit(&cap->refcount, 1, memory_order_relaxed);
   return cap;
 }
 
@@ -151,19 +249,98 @@ void x10_dlpack_dispose(x10_dl_capsule_t cap)
 {
   if (!cap)
     return;
-  if (--cap->refcount > 0)
+  if (atomic_fetch_sub_explicit(&cap->refcount, 1, memory_order_release) != 1)
     return;
-  if (cap->mt && cap->mt->deleter)
+  atomic_thread_fence(memory_order_acquire);
+
+  switch ((x10_dl_owner)cap->owner)
   {
-    cap->mt->deleter(cap->mt); // free data if owner
+  case X10_DL_OWN_FREE:
+    free(cap->mtv.dl_tensor.data);
+    break;
+  case X10_DL_OWN_EXTERNAL:
+    if (cap->external && cap->external->deleter)
+      cap->external->deleter(cap->external);
+    break;
+  case X10_DL_OWN_CALLBACK:
+    if (cap->release)
+      cap->release(cap->release_ctx);
+    break;
+  case X10_DL_OWN_NONE:
+    break;
   }
-  if (cap->shape_copy)
-    free(cap->shape_copy);
-  if (cap->strides_copy)
-    free(cap->strides_copy);
-  if (cap->mt)
-    free(cap->mt);
-  free(cap);
+  x10_dl_capsule_t parent = cap->parent;
+  x10_dl_capsule_recycle(cap);
+  x10_dlpack_dispose(parent); // views: the parent owns the data
+}
+
+// --- versioned exchange & flags ---
+
+void *x10_dlpack_export_versioned(x10_dl_capsule_t cap)
+{
+  set_last_error("");
+  if (!cap)
+  {
+    set_last_error("null cap");
+    return NULL;
+  }
+  // The consumer's deleter call drops the reference taken here.
+  return &x10_dlpack_retain(cap)->mtv;
+}
+
+x10_dl_capsule_t x10_dlpack_import_versioned(void *managed)
+{
+  set_last_error("");
+  DLManagedTensorVersioned *m = (DLManagedTensorVersioned *)managed;
+  if (!m)
+  {
+    set_last_error("null tensor");
+    return NULL;
+  }
+  if (m->deleter == x10_dl_versioned_deleter)
+    return (x10_dl_capsule_t)m->manager_ctx; // our own export: take over its reference
+  if (m->version.major != DLPACK_MAJOR_VERSION)
+  {
+    set_last_error("unsupported DLPack major version");
+    return NULL;
+  }
+  const DLTensor *t = &m->dl_tensor;
+  x10_dl_capsule_t cap = x10_alloc_capsule(t->data, t->shape, t->strides, t->ndim, t->byte_offset,
+                                           t->dtype, t->device, m->flags, X10_DL_OWN_EXTERNAL);
+  if (cap)
+    cap->external = m;
+  return cap;
+}
+
+uint64_t x10_dlpack_flags(x10_dl_capsule_t cap)
+{
+  return cap ? cap->mtv.flags : 0;
+}
+
+int x10_dlpack_is_read_only(x10_dl_capsule_t cap)
+{
+  return (x10_dlpack_flags(cap) & DLPACK_FLAG_BITMASK_READ_ONLY) ? 1 : 0;
+}
+
+x10_dl_capsule_t x10_dlpack_read_only_view(x10_dl_capsule_t cap)
+{
+  set_last_error("");
+  if (!cap)
+  {
+    set_last_error("invalid args");
+    return NULL;
+  }
+  // Other holders of `cap` keep its flags; only this view's consumers see
+  // the bit.
+  const DLTensor *t = &cap->mtv.dl_tensor;
+  x10_dl_capsule_t view = x10_alloc_capsule(t->data, t->shape, t->strides, t->ndim, t->byte_offset,
+                                            t->dtype, t->device,
+                                            cap->mtv.flags | DLPACK_FLAG_BITMASK_READ_ONLY,
+                                            X10_DL_OWN_NONE);
+  if (!view)
+    return NULL;
+  view->parent = x10_dlpack_retain(cap);
+  return view;
 }
 
 int x10_dlpack_basic_info(
@@ -173,12 +350,12 @@ int x10_dlpack_basic_info(
     int32_t *out_ndim)
 {
   set_last_error("");
-  if (!cap || !cap->mt)
+  if (!cap)
   {
     set_last_error("null cap");
     return 0;
   }
-  const DLTensor *t = &cap->mt->dl_tensor;
+  const DLTensor *t = &cap->mtv.dl_tensor;
   if (out_device_type)
     *out_device_type = (int32_t)t->device.device_type;
   if (out_device_id)
@@ -197,12 +374,12 @@ int x10_dlpack_basic_info(
 int x10_dlpack_shape(x10_dl_capsule_t cap, int64_t *out_shape, int32_t capacity)
 {
   set_last_error("");
-  if (!cap || !cap->mt)
+  if (!cap)
   {
     set_last_error("null cap");
     return -1;
   }
-  const DLTensor *t = &cap->mt->dl_tensor;
+  const DLTensor *t = &cap->mtv.dl_tensor;
   if (!out_shape || capacity < (int32_t)t->ndim)
   {
     set_last_error("capacity too small");
@@ -216,18 +393,560 @@ int x10_dlpack_shape(x10_dl_capsule_t cap, int64_t *out_shape, int32_t capacity)
 int x10_dlpack_data_ptr(x10_dl_capsule_t cap, void **out_ptr, size_t *out_byte_offset)
 {
   set_last_error("");
-  if (!cap || !cap->mt || !out_ptr)
+  if (!cap || !out_ptr)
   {
     set_last_error("null arg");
     return 0;
   }
-  const DLTensor *t = &cap->mt->dl_tensor;
+  const DLTensor *t = &cap->mtv.dl_tensor;
   *out_ptr = (void *)((char *)t->data + t->byte_offset);
   if (out_byte_offset)
     *out_byte_offset = (size_t)t->byte_offset;
   return 1;
 }
 
+// --- layout helpers ---
+
+static size_t x10_dlpack_elem_size(const DLTensor *t)
+{
+  return (size_t)(t->dtype.bits / 8u) * (size_t)(t->dtype.lanes ? t->dtype.lanes : 1);
+}
+
+// Element strides of `t`, derived from the shape when the tensor is dense.
+static void x10_dlpack_effective_strides(const DLTensor *t, int64_t *out)
+{
+  if (t->strides)
+  {
+    memcpy(out, t->strides, sizeof(int64_t) * (size_t)t->ndim);
+    return;
+  }
+  int64_t s = 1;
+  for (int i = t->ndim - 1; i >= 0; --i)
+  {
+    out[i] = s;
+    s *= t->shape[i];
+  }
+}
+
+// Lowest and one-past-highest byte touched relative to `data`; lo == hi when empty.
+static void x10_dlpack_extent(const DLTensor *t, const int64_t *strides, int64_t *lo, int64_t *hi)
+{
+  int64_t es = (int64_t)x10_dlpack_elem_size(t);
+  int64_t mn = 0, mx = 0;
+  for (int i = 0; i < t->ndim; ++i)
+  {
+    if (t->shape[i] == 0)
+    {
+      *lo = *hi = (int64_t)t->byte_offset;
+      return;
+    }
+    int64_t span = (t->shape[i] - 1) * strides[i];
+    if (span < 0)
+      mn += span;
+    else
+      mx += span;
+  }
+  *lo = (int64_t)t->byte_offset + mn * es;
+  *hi = (int64_t)t->byte_offset + (mx + 1) * es;
+}
+
+// Copies `n` elements of `es` bytes spaced `step` bytes apart into `dst`.
+static void x10_dlpack_copy_strided(char *dst, const char *src, int64_t n, int64_t step, size_t es)
+{
+  switch (es)
+  {
+  case 1:
+    for (int64_t i = 0; i < n; ++i)
+      dst[i] = src[i * step];
+    break;
+  case 2:
+  {
+    uint16_t *d = (uint16_t *)dst;
+    for (int64_t i = 0; i < n; ++i)
+      memcpy(&d[i], src + i * step, 2);
+    break;
+  }
+  case 4:
+  {
+    uint32_t *d = (uint32_t *)dst;
+    for (int64_t i = 0; i < n; ++i)
+      memcpy(&d[i], src + i * step, 4);
+    break;
+  }
+  case 8:
+  {
+    uint64_t *d = (uint64_t *)dst;
+    for (int64_t i = 0; i < n; ++i)
+      memcpy(&d[i], src + i * step, 8);
+    break;
+  }
+  default:
+    for (int64_t i = 0; i < n; ++i)
+      memcpy(dst + (size_t)i * es, src + i * step, es);
+  }
+}
+
+// Dense row-major copy of a strided tensor. Size-1 dims are dropped and
+// adjacent dims that are contiguous with each other are merged, so the
+// innermost loop runs over the longest possible span: a memcpy when that
+// span is unit-stride (slices, crops), a typed gather otherwise (transposes).
+static void x10_dlpack_gather(const DLTensor *t, char *out)
+{
+  size_t es = x10_dlpack_elem_size(t);
+  int nd = t->ndim;
+  int64_t strides[nd > 0 ? nd : 1];
+  x10_dlpack_effective_strides(t, strides);
+
+  int64_t shp[nd > 0 ? nd : 1], str[nd > 0 ? nd : 1];
+  int k = 0;
+  for (int i = 0; i < nd; ++i)
+  {
+    if (t->shape[i] == 0)
+      return;
+    if (t->shape[i] == 1)
+      continue;
+    if (k > 0 && str[k - 1] == strides[i] * t->shape[i])
+    {
+      shp[k - 1] *= t->shape[i];
+      str[k - 1] = strides[i];
+      continue;
+    }
+    shp[k] = t->shape[i];
+    str[k] = strides[i];
+    ++k;
+  }
+
+  const char *base = (const char *)t->data + t->byte_offset;
+  if (k == 0)
+  {
+    memcpy(out, base, es);
+    return;
+  }
+
+  int64_t inner = shp[k - 1];
+  int64_t inner_step = str[k - 1] * (int64_t)es;
+  size_t run = (size_t)inner * es;
+  int64_t idx[k];
+  memset(idx, 0, sizeof(idx));
+  int64_t off = 0; // element offset of the current run
+  for (;;)
+  {
+    if (str[k - 1] == 1)
+      memcpy(out, base + off * (int64_t)es, run);
+    else
+      x10_dlpack_copy_strided(out, base + off * (int64_t)es, inner, inner_step, es);
+    out += run;
+
+    int d = k - 2;
+    for (; d >= 0; --d)
+    {
+      off += str[d];
+      if (++idx[d] < shp[d])
+        break;
+      off -= str[d] * shp[d];
+      idx[d] = 0;
+    }
+    if (d < 0)
+      return;
+  }
+}
+
+// --- views ---
+
+x10_dl_capsule_t x10_dlpack_make_view(
+    x10_dl_capsule_t base,
+    const int64_t *shape, const int64_t *strides, int32_t ndim,
+    uint64_t byte_offset)
+{
+  set_last_error("");
+  if (!base || !shape || !strides || ndim <= 0)
+  {
+    set_last_error("invalid args");
+    return NULL;
+  }
+  const DLTensor *b = &base->mtv.dl_tensor;
+  for (int i = 0; i < ndim; ++i)
+  {
+    if (shape[i] < 0)
+    {
+      set_last_error("negative dimension");
+      return NULL;
+    }
+  }
+
+  // Everything the view can reach must lie inside what the base can reach.
+  int64_t base_strides[b->ndim];
+  x10_dlpack_effective_strides(b, base_strides);
+  int64_t blo, bhi, vlo, vhi;
+  x10_dlpack_extent(b, base_strides, &blo, &bhi);
+  DLTensor probe = *b;
+  probe.shape = (int64_t *)shape;
+  probe.ndim = ndim;
+  probe.byte_offset = byte_offset;
+  x10_dlpack_extent(&probe, strides, &vlo, &vhi);
+  if (vlo != vhi && (vlo < blo || vhi > bhi))
+  {
+    set_last_error("view out of bounds");
+    return NULL;
+  }
+
+  x10_dl_capsule_t cap = x10_alloc_capsule(b->data, shape, strides, ndim, byte_offset,
+                                           b->dtype, b->device, base->mtv.flags, X10_DL_OWN_NONE);
+  if (!cap)
+    return NULL;
+  cap->parent = x10_dlpack_retain(base);
+  return cap;
+}
+
+// --- file mappings ---
+
+struct x10_dl_mapping
+{
+  atomic_int refcount;
+  void *base;
+  size_t size;
+};
+
+x10_dl_mapping_t x10_dlpack_map_file(const char *path)
+{
+  set_last_error("");
+  if (!path)
+  {
+    set_last_error("invalid args");
+    return NULL;
+  }
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    set_last_error("cannot open file");
+    return NULL;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    close(fd);
+    set_last_error("empty or unreadable file");
+    return NULL;
+  }
+  // Shared and read-only: every process mapping the file reads the same
+  // page-cache pages, and nothing is copied until a page is touched.
+  void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // the mapping keeps its own reference to the file
+  if (base == MAP_FAILED)
+  {
+    set_last_error("mmap failed");
+    return NULL;
+  }
+  x10_dl_mapping_t m = malloc(sizeof *m);
+  if (!m)
+  {
+    munmap(base, (size_t)st.st_size);
+    set_last_error("oom");
+    return NULL;
+  }
+  atomic_init(&m->refcount, 1);
+  m->base = base;
+  m->size = (size_t)st.st_size;
+  return m;
+}
+
+const void *x10_dlpack_mapping_data(x10_dl_mapping_t m) { return m ? m->base : NULL; }
+size_t x10_dlpack_mapping_size(x10_dl_mapping_t m) { return m ? m->size : 0; }
+
+static x10_dl_mapping_t x10_dl_mapping_retain(x10_dl_mapping_t m)
+{
+  atomic_fetch_add_explicit(&m->refcount, 1, memory_order_relaxed);
+  return m;
+}
+
+void x10_dlpack_mapping_release(x10_dl_mapping_t m)
+{
+  if (!m)
+    return;
+  if (atomic_fetch_sub_explicit(&m->refcount, 1, memory_order_release) != 1)
+    return;
+  atomic_thread_fence(memory_order_acquire);
+  munmap(m->base, m->size);
+  free(m);
+}
+
+static void x10_dl_mapping_release_ctx(void *ctx) { x10_dlpack_mapping_release((x10_dl_mapping_t)ctx); }
+
+x10_dl_capsule_t x10_dlpack_wrap_mapped(
+    x10_dl_mapping_t m, uint64_t byte_offset,
+    const int64_t *shape, const int64_t *strides, int32_t ndim,
+    int32_t dtype_code, int32_t dtype_bits, int32_t dtype_lanes)
+{
+  set_last_error("");
+  if (!m || !shape || ndim <= 0)
+  {
+    set_last_error("invalid args");
+    return NULL;
+  }
+  for (int i = 0; i < ndim; ++i)
+  {
+    if (shape[i] < 0)
+    {
+      set_last_error("negative dimension");
+      return NULL;
+    }
+  }
+
+  DLDevice dev = {.device_type = kDLCPU, .device_id = 0};
+  DLDataType dt = {.code = (uint8_t)dtype_code, .bits = (uint8_t)dtype_bits, .lanes = (uint16_t)dtype_lanes};
+  DLTensor probe = {.data = m->base, .device = dev, .ndim = ndim, .dtype = dt,
+                    .shape = (int64_t *)shape, .strides = (int64_t *)strides, .byte_offset = byte_offset};
+  int64_t eff[ndim];
+  x10_dlpack_effective_strides(&probe, eff);
+  int64_t lo, hi;
+  x10_dlpack_extent(&probe, eff, &lo, &hi);
+  if (byte_offset > m->size || (lo != hi && (lo < 0 || (uint64_t)hi > m->size)))
+  {
+    set_last_error("tensor out of bounds of the mapping");
+    return NULL;
+  }
+
+  // data is the page-aligned mapping base; the tensor starts at byte_offset.
+  x10_dl_capsule_t cap = x10_alloc_capsule(m->base, shape, strides, ndim, byte_offset, dt, dev,
+                                           DLPACK_FLAG_BITMASK_READ_ONLY, X10_DL_OWN_CALLBACK);
+  if (!cap)
+    return NULL;
+  cap->release = x10_dl_mapping_release_ctx;
+  cap->release_ctx = x10_dl_mapping_retain(m);
+  return cap;
+}
+
+int x10_dlpack_strides(x10_dl_capsule_t cap, int64_t *out_strides, int32_t capacity)
+{
+  set_last_error("");
+  if (!cap)
+  {
+    set_last_error("null cap");
+    return -1;
+  }
+  const DLTensor *t = &cap->mtv.dl_tensor;
+  if (!out_strides || capacity < (int32_t)t->ndim)
+  {
+    set_last_error("capacity too small");
+    return -1;
+  }
+  x10_dlpack_effective_strides(t, out_strides);
+  return (int)t->ndim;
+}
+
+int x10_dlpack_is_contiguous(x10_dl_capsule_t cap)
+{
+  if (!cap)
+    return 0;
+  const DLTensor *t = &cap->mtv.dl_tensor;
+  if (!t->strides)
+    return 1;
+  int64_t s = 1;
+  for (int i = t->ndim - 1; i >= 0; --i)
+  {
+    if (t->shape[i] != 1 && t->strides[i] != s)
+      return 0;
+    s *= t->shape[i];
+  }
+  return 1;
+}
+
+// --- chunked host copy engine ---
+//
+// Copies of at least 2 * X10_COPY_MIN_CHUNK bytes are split into page-aligned
+// chunks, one per worker thread (the caller takes chunks too). The workers
+// are started once and parked between copies; a copy that arrives while
+// another one holds the pool runs on its own thread. Above
+// X10_COPY_STREAM_MIN a chunk is copied with non-temporal stores and software
+// prefetch, so a multi-GiB copy doesn't evict the caches for data nobody
+// reads back soon. X10_COPY_THREADS caps the workers (1 disables threading).
+
+static const size_t X10_COPY_MIN_CHUNK = (size_t)4 << 20;
+static const size_t X10_COPY_STREAM_MIN = (size_t)64 << 20;
+enum
+{
+  X10_COPY_MAX_THREADS = 16
+};
+
+static int s_copy_threads;
+static pthread_once_t s_copy_once = PTHREAD_ONCE_INIT;
+
+static void x10_copy_threads_init(void)
+{
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  // Host memory bandwidth saturates well before every core is busy.
+  int threads = n > 8 ? 8 : (n < 1 ? 1 : (int)n);
+  const char *env = getenv("X10_COPY_THREADS");
+  if (env && *env)
+  {
+    int v = atoi(env);
+    threads = v < 1 ? 1 : v;
+  }
+  s_copy_threads = threads > X10_COPY_MAX_THREADS ? X10_COPY_MAX_THREADS : threads;
+}
+
+int x10_dlpack_copy_threads(void)
+{
+  pthread_once(&s_copy_once, x10_copy_threads_init);
+  return s_copy_threads;
+}
+
+static void x10_copy_stream(char *dst, const char *src, size_t n)
+{
+#if defined(__SSE2__)
+  size_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+  if (head > n)
+    head = n;
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  n -= head;
+  for (size_t blocks = n / 64; blocks > 0; --blocks, dst += 64, src += 64)
+  {
+    __builtin_prefetch(src + 1024);
+    __m128i a = _mm_loadu_si128((const __m128i *)src);
+    __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+    __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+    _mm_stream_si128((__m128i *)dst, a);
+    _mm_stream_si128((__m128i *)(dst + 16), b);
+    _mm_stream_si128((__m128i *)(dst + 32), c);
+    _mm_stream_si128((__m128i *)(dst + 48), d);
+  }
+  _mm_sfence();
+  memcpy(dst, src, n & 63);
+#else
+  memcpy(dst, src, n);
+#endif
+}
+
+typedef struct
+{
+  char *dst;
+  const char *src;
+  size_t n;
+  int stream;
+} x10_copy_chunk;
+
+static void *x10_copy_worker(void *p)
+{
+  x10_copy_chunk *c = (x10_copy_chunk *)p;
+  if (c->stream)
+    x10_copy_stream(c->dst, c->src, c->n);
+  else
+    memcpy(c->dst, c->src, c->n);
+  return NULL;
+}
+
+// One job at a time; chunks are claimed under `lock` (each is megabytes, so
+// the lock is not contended) and `pending` counts chunks not yet finished.
+static struct
+{
+  pthread_mutex_t lock;
+  pthread_cond_t work, done;
+  const x10_copy_chunk *chunks;
+  int count, next, pending;
+  unsigned generation;
+  int busy, workers;
+} s_copy_pool = {.lock = PTHREAD_MUTEX_INITIALIZER,
+                 .work = PTHREAD_COND_INITIALIZER,
+                 .done = PTHREAD_COND_INITIALIZER};
+static pthread_once_t s_copy_pool_once = PTHREAD_ONCE_INIT;
+
+// Runs chunks of the current job until none are left. Called with the lock held.
+static void x10_copy_pool_drain(void)
+{
+  while (s_copy_pool.next < s_copy_pool.count)
+  {
+    x10_copy_chunk c = s_copy_pool.chunks[s_copy_pool.next++];
+    pthread_mutex_unlock(&s_copy_pool.lock);
+    x10_copy_worker(&c);
+    pthread_mutex_lock(&s_copy_pool.lock);
+    if (--s_copy_pool.pending == 0)
+      pthread_cond_signal(&s_copy_pool.done);
+  }
+}
+
+static void *x10_copy_pool_main(void *unused)
+{
+  (void)unused;
+  unsigned seen = 0;
+  pthread_mutex_lock(&s_copy_pool.lock);
+  for (;;)
+  {
+    while (s_copy_pool.generation == seen)
+      pthread_cond_wait(&s_copy_pool.work, &s_copy_pool.lock);
+    seen = s_copy_pool.generation;
+    x10_copy_pool_drain();
+  }
+  return NULL;
+}
+
+static void x10_copy_pool_init(void)
+{
+  int want = x10_dlpack_copy_threads() - 1;
+  for (int i = 0; i < want; ++i)
+  {
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, x10_copy_pool_main, NULL) != 0)
+      break;
+    pthread_detach(tid);
+    s_copy_pool.workers++;
+  }
+}
+
+void x10_dlpack_copy_bytes(void *dst, const void *src, size_t nbytes)
+{
+  int threads = x10_dlpack_copy_threads();
+  size_t by_size = nbytes / X10_COPY_MIN_CHUNK;
+  if ((size_t)threads > by_size)
+    threads = (int)by_size;
+  int stream = nbytes >= X10_COPY_STREAM_MIN;
+  x10_copy_chunk only = {(char *)dst, (const char *)src, nbytes, stream};
+  if (threads < 2)
+  {
+    x10_copy_worker(&only);
+    return;
+  }
+
+  pthread_once(&s_copy_pool_once, x10_copy_pool_init);
+  pthread_mutex_lock(&s_copy_pool.lock);
+  if (s_copy_pool.busy || s_copy_pool.workers == 0)
+  {
+    // Another copy already has the memory bus; splitting this one too
+    // would only oversubscribe it.
+    pthread_mutex_unlock(&s_copy_pool.lock);
+    x10_copy_worker(&only);
+    return;
+  }
+  if (threads > s_copy_pool.workers + 1)
+    threads = s_copy_pool.workers + 1;
+
+  size_t chunk = (nbytes / (size_t)threads + 4095) & ~(size_t)4095;
+  x10_copy_chunk chunks[X10_COPY_MAX_THREADS];
+  size_t off = 0;
+  int count = 0;
+  for (; count < threads && off < nbytes; ++count, off += chunk)
+  {
+    size_t n = nbytes - off < chunk ? nbytes - off : chunk;
+    chunks[count] = (x10_copy_chunk){(char *)dst + off, (const char *)src + off, n, stream};
+  }
+  s_copy_pool.busy = 1;
+  s_copy_pool.chunks = chunks;
+  s_copy_pool.count = count;
+  s_copy_pool.next = 0;
+  s_copy_pool.pending = count;
+  s_copy_pool.generation++;
+  pthread_cond_broadcast(&s_copy_pool.work);
+  x10_copy_pool_drain();
+  while (s_copy_pool.pending > 0)
+    pthread_cond_wait(&s_copy_pool.done, &s_copy_pool.lock);
+  s_copy_pool.chunks = NULL;
+  s_copy_pool.count = s_copy_pool.next = 0;
+  s_copy_pool.busy = 0;
+  pthread_mutex_unlock(&s_copy_pool.lock);
+}
+
 // Optional utility used by Swift for copying out
 static size_t x10_dlpack_nbytes(const DLTensor *t)
 {
@@ -236,26 +955,24 @@ static size_t x10_dlpack_nbytes(const DLTensor *t)
   size_t elems = 1;
   for (int i = 0; i < t->ndim; ++i)
     elems *= (size_t)t->shape[i];
-  size_t bytes_per_lane = (size_t)(t->dtype.bits / 8u);
-  size_t lanes = (size_t)(t->dtype.lanes ? t->dtype.lanes : 1);
-  return elems * bytes_per_lane * lanes;
+  return elems * x10_dlpack_elem_size(t);
 }
 
 int x10_dlpack_to_host_copy(
     x10_dl_capsule_t cap,
     void *out, size_t out_capacity,
-    int *out_written)
+    size_t *out_written)
 {
   set_last_error("");
-  if (!cap || !cap->mt)
+  if (!cap)
   {
     set_last_error("null cap");
     return 0;
   }
-  const DLTensor *t = &cap->mt->dl_tensor;
+  const DLTensor *t = &cap->mtv.dl_tensor;
   size_t need = x10_dlpack_nbytes(t);
   if (out_written)
-    *out_written = (int)need;
+    *out_written = need;
   if (!out || out_capacity == 0)
     return 1; // probe mode
   if (out_capacity < need)
@@ -263,6 +980,9 @@ int x10_dlpack_to_host_copy(
     set_last_error("buffer too small");
     return 0;
   }
-  memcpy(out, (const char *)t->data + t->byte_offset, need);
+  if (x10_dlpack_is_contiguous(cap))
+    x10_dlpack_copy_bytes(out, (const char *)t->data + t->byte_offset, need);
+  else
+    x10_dlpack_gather(t, (char *)out);
   return 1;
 }
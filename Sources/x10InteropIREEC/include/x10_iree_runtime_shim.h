@@ -21,6 +21,8 @@ typedef enum {
   X10_IREE_DTYPE_F64 = 3,
   X10_IREE_DTYPE_I32 = 4,
   X10_IREE_DTYPE_I64 = 5,
+  X10_IREE_DTYPE_F8E4M3FN = 6,
+  X10_IREE_DTYPE_F8E5M2 = 7,
 } x10_iree_dtype_t;
 
 // Simple tensor view used for passing host-backed buffers into the runtime.
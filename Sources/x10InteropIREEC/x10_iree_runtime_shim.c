@@ -320,6 +320,8 @@ static iree_hal_element_type_t map_dtype_to_element_type(x10_iree_dtype_t dtype)
     case X10_IREE_DTYPE_F64:  return IREE_HAL_ELEMENT_TYPE_FLOAT_64;
     case X10_IREE_DTYPE_I32:  return IREE_HAL_ELEMENT_TYPE_SINT_32;
     case X10_IREE_DTYPE_I64:  return IREE_HAL_ELEMENT_TYPE_SINT_64;
+    case X10_IREE_DTYPE_F8E4M3FN: return IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN;
+    case X10_IREE_DTYPE_F8E5M2:   return IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2;
   }
   return IREE_HAL_ELEMENT_TYPE_NONE;
 }
@@ -340,6 +342,10 @@ static int map_element_type_to_dtype(iree_hal_element_type_t element_type,
       *out_dtype = X10_IREE_DTYPE_I32; return 1;
     case IREE_HAL_ELEMENT_TYPE_SINT_64:
       *out_dtype = X10_IREE_DTYPE_I64; return 1;
+    case IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN:
+      *out_dtype = X10_IREE_DTYPE_F8E4M3FN; return 1;
+    case IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2:
+      *out_dtype = X10_IREE_DTYPE_F8E5M2; return 1;
     default:
       break;
   }
@@ -0,0 +1,43 @@
+#ifndef X10_FP8_H
+#define X10_FP8_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  // FP8 (OCP 8-bit float) quantization with a per-tensor scale.
+  //
+  //   E4M3FN: 4 exponent bits (bias 7), 3 mantissa bits, no infinities,
+  //           NaN = S.1111.111, largest finite 448.
+  //   E5M2:   5 exponent bits (bias 15), 2 mantissa bits, IEEE-style
+  //           infinities and NaNs, largest finite 57344.
+  //
+  // Quantizing computes src * (1 / scale), rounds to nearest even and
+  // saturates to the largest finite value (infinities included); NaN stays
+  // NaN. Dequantizing returns the decoded value * scale. Paths are picked
+  // like the half kernels (see x10_half.h) and give identical bits.
+
+  typedef enum
+  {
+    X10_FP8_E4M3FN = 0,
+    X10_FP8_E5M2 = 1,
+  } x10_fp8_format;
+
+#define X10_FP8_E4M3FN_MAX 448.0f
+#define X10_FP8_E5M2_MAX 57344.0f
+
+  void x10_f32_to_fp8(x10_fp8_format format, const float *src, uint8_t *dst, size_t n, float scale);
+  void x10_fp8_to_f32(x10_fp8_format format, const uint8_t *src, float *dst, size_t n, float scale);
+
+  // Largest finite-or-infinite |src[i]|, ignoring NaNs; 0 for n == 0.
+  float x10_f32_absmax(const float *src, size_t n);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // X10_FP8_H
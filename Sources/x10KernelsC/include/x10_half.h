@@ -0,0 +1,33 @@
+#ifndef X10_HALF_H
+#define X10_HALF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  // Bulk f32 <-> f16 / bf16 conversion. Narrowing rounds to nearest even,
+  // overflows to infinity, keeps subnormals, and turns NaNs into quiet NaNs
+  // of the same sign. Every ISA path produces identical bits.
+  //
+  // The implementation is picked once per process from the running CPU:
+  // AVX-512F, AVX2+F16C, NEON (aarch64), else scalar. X10_KERNELS_ISA=scalar|
+  // avx2|avx512|neon forces a path the CPU supports (for testing/benchmarks);
+  // the FP8 kernels (x10_fp8.h) read the same variable.
+
+  void x10_f32_to_f16(const float *src, uint16_t *dst, size_t n);
+  void x10_f16_to_f32(const uint16_t *src, float *dst, size_t n);
+  void x10_f32_to_bf16(const float *src, uint16_t *dst, size_t n);
+  void x10_bf16_to_f32(const uint16_t *src, float *dst, size_t n);
+
+  // Name of the selected path: "avx512", "avx2", "neon" or "scalar".
+  const char *x10_half_isa(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // X10_HALF_H
@@ -0,0 +1,230 @@
+#include "x10_fp8.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The kernels are written once over 8-lane GCC/Clang vector types and
+// instantiated per target: one ymm register on AVX2/AVX-512, two SSE2/NEON
+// registers otherwise. Wider types make GCC 12 scalarize the compares on
+// AVX2, and so do hand-splatted `(v8i){c, c, ...}` operands, so constants are
+// written as scalars. Everything is integer bit manipulation except the
+// subnormal rounding, which lets the FPU round to nearest even by adding a
+// magic constant whose ulp is the smallest subnormal.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define X10_FP8_X86 1
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+// The vector helpers are always inlined, so no 32-byte argument crosses an ABI boundary.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+typedef uint32_t v8u __attribute__((vector_size(32)));
+typedef int32_t v8i __attribute__((vector_size(32)));
+typedef float v8f __attribute__((vector_size(32)));
+typedef uint8_t v32b __attribute__((vector_size(32)));
+typedef uint8_t v8b __attribute__((vector_size(8)));
+
+#define X10_INLINE static inline __attribute__((always_inline))
+
+typedef struct
+{
+  uint32_t mbits;    // mantissa bits
+  uint32_t bias;     // exponent bias
+  uint32_t max_bits; // f32 bits of the largest finite value
+  int ieee_special;  // all-ones exponent means inf/NaN (E5M2) rather than only S.1111.111 = NaN (E4M3FN)
+} x10_fp8_fmt;
+
+static const x10_fp8_fmt k_e4m3fn = {3, 7, 0x43E00000u, 0};
+static const x10_fp8_fmt k_e5m2 = {2, 15, 0x47600000u, 1};
+
+X10_INLINE v8u select_u(v8u mask, v8u a, v8u b) { return (mask & a) | (~mask & b); }
+
+X10_INLINE float bits_f32(uint32_t x)
+{
+  float f;
+  memcpy(&f, &x, 4);
+  return f;
+}
+
+X10_INLINE v8b quantize_block(v8f x, x10_fp8_fmt f)
+{
+  v8u bits = (v8u)x;
+  v8u sign = (bits >> 24) & 0x80;
+  v8u a = bits & 0x7FFFFFFFu;
+  // |x| bits fit in 31 bits, so signed compares (native on AVX2/SSE2) are exact.
+  v8u nan = (v8u)((v8i)a > 0x7F800000);
+  a = select_u((v8u)((v8i)a > (int32_t)f.max_bits), (v8u){0} + f.max_bits, a);
+
+  // Normal range: round the f32 mantissa to `mbits` and rebias the exponent.
+  uint32_t shift = 23 - f.mbits;
+  v8u rounded = a + ((1u << (shift - 1)) - 1) + ((a >> shift) & 1);
+  v8u normal = (rounded >> shift) - ((127 - f.bias) << f.mbits);
+
+  // Subnormal range: after adding `magic` the low bits hold the rounded
+  // multiple of the smallest subnormal (possibly the smallest normal, whose
+  // encoding is the next integer).
+  uint32_t magic_bits = (127 + 1 - f.bias - f.mbits + 23) << 23;
+  v8u sub = (v8u)((v8f)a + bits_f32(magic_bits)) - magic_bits;
+  v8u is_sub = (v8u)((v8i)a < (int32_t)((127 + 1 - f.bias) << 23));
+
+  v8u r = select_u(is_sub, sub, normal);
+  r = select_u(nan, ((v8u){0} + 0x7Fu), r) | sign;
+  // Low byte of each lane; __builtin_convertvector narrows lane by lane.
+  return __builtin_shufflevector((v32b)r, (v32b)r, 0, 4, 8, 12, 16, 20, 24, 28);
+}
+
+X10_INLINE v8f dequantize_block(v8b q, x10_fp8_fmt f)
+{
+  v8u b = __builtin_convertvector(q, v8u);
+  v8u sign = (b & 0x80) << 24;
+  uint32_t emask = (1u << (7 - f.mbits)) - 1, mmask = (1u << f.mbits) - 1;
+  v8u e = (b >> f.mbits) & emask;
+  v8u m = b & mmask;
+
+  v8u normal = ((e + (127 - f.bias)) << 23) | (m << (23 - f.mbits));
+  v8f sub = __builtin_convertvector((v8i)m, v8f) * bits_f32((127 + 1 - f.bias - f.mbits) << 23);
+  v8u r = select_u((v8u)((v8i)e == 0), (v8u)sub, normal);
+
+  if (f.ieee_special)
+  {
+    v8u nonzero = (v8u)((v8i)m != 0);
+    v8u special = 0x7F800000u | (nonzero & (0x400000u | (m << (23 - f.mbits))));
+    r = select_u((v8u)((v8i)e == (int32_t)emask), special, r);
+  }
+  else
+  {
+    r = select_u((v8u)((v8i)(b & 0x7F) == 0x7F), (v8u){0} + 0x7FC00000u, r);
+  }
+  return (v8f)(r | sign);
+}
+
+X10_INLINE void quantize_loop(x10_fp8_fmt f, const float *src, uint8_t *dst, size_t n, float inv)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    v8f x;
+    memcpy(&x, src + i, sizeof x);
+    v8b q = quantize_block(x * inv, f);
+    memcpy(dst + i, &q, sizeof q);
+  }
+  if (i < n)
+  {
+    v8f x = {0};
+    memcpy(&x, src + i, (n - i) * sizeof(float));
+    v8b q = quantize_block(x * inv, f);
+    memcpy(dst + i, &q, n - i);
+  }
+}
+
+X10_INLINE void dequantize_loop(x10_fp8_fmt f, const uint8_t *src, float *dst, size_t n, float scale)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    v8b q;
+    memcpy(&q, src + i, sizeof q);
+    v8f x = dequantize_block(q, f) * scale;
+    memcpy(dst + i, &x, sizeof x);
+  }
+  if (i < n)
+  {
+    v8b q = {0};
+    memcpy(&q, src + i, n - i);
+    v8f x = dequantize_block(q, f) * scale;
+    memcpy(dst + i, &x, (n - i) * sizeof(float));
+  }
+}
+
+X10_INLINE float absmax_loop(const float *src, size_t n)
+{
+  // Non-negative floats (inf included) order like their bit patterns.
+  v8u acc = {0};
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    v8u a;
+    memcpy(&a, src + i, sizeof a);
+    a &= 0x7FFFFFFFu;
+    a &= (v8u)((v8i)a <= 0x7F800000);
+    acc = select_u((v8u)((v8i)a > (v8i)acc), a, acc);
+  }
+  uint32_t best = 0;
+  for (int l = 0; l < 8; ++l)
+    best = acc[l] > best ? acc[l] : best;
+  for (; i < n; ++i)
+  {
+    uint32_t a;
+    memcpy(&a, src + i, 4);
+    a &= 0x7FFFFFFFu;
+    if (a <= 0x7F800000u && a > best)
+      best = a;
+  }
+  return bits_f32(best);
+}
+
+typedef struct
+{
+  const char *name;
+  void (*quantize[2])(const float *, uint8_t *, size_t, float);
+  void (*dequantize[2])(const uint8_t *, float *, size_t, float);
+  float (*absmax)(const float *, size_t);
+} x10_fp8_impl;
+
+#define X10_FP8_KERNELS(ISA, ATTR)                                                                                     \
+  ATTR static void q_e4m3fn_##ISA(const float *s, uint8_t *d, size_t n, float inv) { quantize_loop(k_e4m3fn, s, d, n, inv); } \
+  ATTR static void q_e5m2_##ISA(const float *s, uint8_t *d, size_t n, float inv) { quantize_loop(k_e5m2, s, d, n, inv); }     \
+  ATTR static void dq_e4m3fn_##ISA(const uint8_t *s, float *d, size_t n, float k) { dequantize_loop(k_e4m3fn, s, d, n, k); }  \
+  ATTR static void dq_e5m2_##ISA(const uint8_t *s, float *d, size_t n, float k) { dequantize_loop(k_e5m2, s, d, n, k); }      \
+  ATTR static float absmax_##ISA(const float *s, size_t n) { return absmax_loop(s, n); }                                    \
+  static const x10_fp8_impl k_##ISA = {#ISA, {q_e4m3fn_##ISA, q_e5m2_##ISA}, {dq_e4m3fn_##ISA, dq_e5m2_##ISA}, absmax_##ISA};
+
+// "scalar" is the baseline target: SSE2 on x86-64, NEON on aarch64.
+X10_FP8_KERNELS(scalar, )
+#if X10_FP8_X86
+X10_FP8_KERNELS(avx2, __attribute__((target("avx2"))))
+X10_FP8_KERNELS(avx512, __attribute__((target("avx512f"))))
+#endif
+
+static const x10_fp8_impl *s_impl = &k_scalar;
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+
+static void x10_fp8_select(void)
+{
+  const x10_fp8_impl *supported[3];
+  int count = 0;
+#if X10_FP8_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    supported[count++] = &k_avx512;
+  if (__builtin_cpu_supports("avx2"))
+    supported[count++] = &k_avx2;
+#endif
+  supported[count++] = &k_scalar;
+
+  s_impl = supported[0];
+  const char *force = getenv("X10_KERNELS_ISA");
+  for (int i = 0; force && *force && i < count; ++i)
+    if (strcmp(force, supported[i]->name) == 0)
+      s_impl = supported[i];
+}
+
+static inline const x10_fp8_impl *impl(void)
+{
+  pthread_once(&s_once, x10_fp8_select);
+  return s_impl;
+}
+
+void x10_f32_to_fp8(x10_fp8_format format, const float *src, uint8_t *dst, size_t n, float scale)
+{
+  impl()->quantize[format == X10_FP8_E5M2](src, dst, n, 1.0f / scale);
+}
+
+void x10_fp8_to_f32(x10_fp8_format format, const uint8_t *src, float *dst, size_t n, float scale)
+{
+  impl()->dequantize[format == X10_FP8_E5M2](src, dst, n, scale);
+}
+
+float x10_f32_absmax(const float *src, size_t n) { return impl()->absmax(src, n); }
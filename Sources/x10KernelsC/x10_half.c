@@ -0,0 +1,322 @@
+#include "x10_half.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define X10_HALF_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define X10_HALF_NEON 1
+#endif
+
+// --- scalar reference (also handles every SIMD tail) ---
+
+static inline uint32_t f32_bits(float f)
+{
+  uint32_t x;
+  memcpy(&x, &f, 4);
+  return x;
+}
+
+static inline float bits_f32(uint32_t x)
+{
+  float f;
+  memcpy(&f, &x, 4);
+  return f;
+}
+
+static inline uint16_t f32_to_bf16_1(float f)
+{
+  uint32_t x = f32_bits(f);
+  if ((x & 0x7FFFFFFFu) > 0x7F800000u)
+    return (uint16_t)((x >> 16) | 0x0040);
+  return (uint16_t)((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+}
+
+static inline float bf16_to_f32_1(uint16_t h) { return bits_f32((uint32_t)h << 16); }
+
+static inline uint16_t f32_to_f16_1(float f)
+{
+  uint32_t x = f32_bits(f);
+  uint16_t sign = (uint16_t)((x >> 16) & 0x8000);
+  int32_t exp = (int32_t)((x >> 23) & 0xFF);
+  uint32_t mant = x & 0x7FFFFFu;
+  if (exp == 0xFF) // inf stays inf; NaN keeps its top payload bits, made quiet
+    return sign | 0x7C00 | (mant ? (uint16_t)(0x0200 | (mant >> 13)) : 0);
+  int32_t e = exp - 127 + 15;
+  if (e >= 0x1F)
+    return sign | 0x7C00;
+  if (e <= 0)
+  {
+    if (e < -10)
+      return sign;
+    uint32_t full = mant | 0x800000u;
+    uint32_t shift = (uint32_t)(14 - e);
+    uint32_t half = full >> shift;
+    uint32_t rem = full & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (rem > halfway || (rem == halfway && (half & 1)))
+      half += 1;
+    return sign | (uint16_t)half;
+  }
+  uint32_t half = ((uint32_t)e << 10) | (mant >> 13);
+  uint32_t rem = mant & 0x1FFF;
+  if (rem > 0x1000 || (rem == 0x1000 && (half & 1)))
+    half += 1; // may carry into the exponent, up to infinity: intended
+  return sign | (uint16_t)half;
+}
+
+static inline float f16_to_f32_1(uint16_t h)
+{
+  uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+  uint32_t exp = (h >> 10) & 0x1F;
+  uint32_t mant = h & 0x3FF;
+  if (exp == 0) // zero or subnormal: mant * 2^-24, exact in f32
+  {
+    float m = (float)mant * 5.9604644775390625e-8f;
+    return sign ? -m : m;
+  }
+  if (exp == 0x1F) // NaNs come back quiet, as F16C/FCVT do
+    return bits_f32(sign | 0x7F800000u | (mant ? 0x400000u | (mant << 13) : 0));
+  return bits_f32(sign | ((exp + 112) << 23) | (mant << 13));
+}
+
+static void f32_to_f16_scalar(const float *s, uint16_t *d, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    d[i] = f32_to_f16_1(s[i]);
+}
+
+static void f16_to_f32_scalar(const uint16_t *s, float *d, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    d[i] = f16_to_f32_1(s[i]);
+}
+
+static void f32_to_bf16_scalar(const float *s, uint16_t *d, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    d[i] = f32_to_bf16_1(s[i]);
+}
+
+static void bf16_to_f32_scalar(const uint16_t *s, float *d, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    d[i] = bf16_to_f32_1(s[i]);
+}
+
+// --- x86: AVX2 + F16C, AVX-512F ---
+
+#if X10_HALF_X86
+
+#define X10_AVX2 __attribute__((target("avx2,f16c")))
+#define X10_AVX512 __attribute__((target("avx512f")))
+
+X10_AVX2 static void f32_to_f16_avx2(const float *s, uint16_t *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm_storeu_si128((__m128i *)(d + i), _mm256_cvtps_ph(_mm256_loadu_ps(s + i), _MM_FROUND_TO_NEAREST_INT));
+  f32_to_f16_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX2 static void f16_to_f32_avx2(const uint16_t *s, float *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(d + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(s + i))));
+  f16_to_f32_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX2 static void f32_to_bf16_avx2(const float *s, uint16_t *d, size_t n)
+{
+  const __m256i one = _mm256_set1_epi32(1), bias = _mm256_set1_epi32(0x7FFF);
+  const __m256i abs_mask = _mm256_set1_epi32(0x7FFFFFFF), inf = _mm256_set1_epi32(0x7F800000);
+  const __m256i quiet = _mm256_set1_epi32(0x0040);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(s + i));
+    __m256i hi = _mm256_srli_epi32(x, 16);
+    __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(x, bias), _mm256_and_si256(hi, one)), 16);
+    __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, abs_mask), inf);
+    r = _mm256_blendv_epi8(r, _mm256_or_si256(hi, quiet), nan);
+    // packus works per 128-bit lane; gather qwords 0 and 2 into the low half.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0x08);
+    _mm_storeu_si128((__m128i *)(d + i), _mm256_castsi256_si128(packed));
+  }
+  f32_to_bf16_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX2 static void bf16_to_f32_avx2(const uint16_t *s, float *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i w = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(s + i)));
+    _mm256_storeu_si256((__m256i *)(d + i), _mm256_slli_epi32(w, 16));
+  }
+  bf16_to_f32_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX512 static void f32_to_f16_avx512(const float *s, uint16_t *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm256_storeu_si256((__m256i *)(d + i),
+                        _mm512_cvtps_ph(_mm512_loadu_ps(s + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  f32_to_f16_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX512 static void f16_to_f32_avx512(const uint16_t *s, float *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(d + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(s + i))));
+  f16_to_f32_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX512 static void f32_to_bf16_avx512(const float *s, uint16_t *d, size_t n)
+{
+  const __m512i one = _mm512_set1_epi32(1), bias = _mm512_set1_epi32(0x7FFF);
+  const __m512i abs_mask = _mm512_set1_epi32(0x7FFFFFFF), inf = _mm512_set1_epi32(0x7F800000);
+  const __m512i quiet = _mm512_set1_epi32(0x0040);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    __m512i x = _mm512_loadu_si512((const void *)(s + i));
+    __m512i hi = _mm512_srli_epi32(x, 16);
+    __m512i r = _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(x, bias), _mm512_and_si512(hi, one)), 16);
+    __mmask16 nan = _mm512_cmpgt_epu32_mask(_mm512_and_si512(x, abs_mask), inf);
+    r = _mm512_mask_blend_epi32(nan, r, _mm512_or_si512(hi, quiet));
+    _mm256_storeu_si256((__m256i *)(d + i), _mm512_cvtepi32_epi16(r));
+  }
+  f32_to_bf16_scalar(s + i, d + i, n - i);
+}
+
+X10_AVX512 static void bf16_to_f32_avx512(const uint16_t *s, float *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    __m512i w = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(s + i)));
+    _mm512_storeu_si512((void *)(d + i), _mm512_slli_epi32(w, 16));
+  }
+  bf16_to_f32_scalar(s + i, d + i, n - i);
+}
+
+#endif // X10_HALF_X86
+
+// --- aarch64: NEON (FCVT rounds to nearest even under the default FPCR) ---
+
+#if X10_HALF_NEON
+
+static void f32_to_f16_neon(const float *s, uint16_t *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    vst1_u16(d + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(s + i))));
+  f32_to_f16_scalar(s + i, d + i, n - i);
+}
+
+static void f16_to_f32_neon(const uint16_t *s, float *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    vst1q_f32(d + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(s + i))));
+  f16_to_f32_scalar(s + i, d + i, n - i);
+}
+
+static void f32_to_bf16_neon(const float *s, uint16_t *d, size_t n)
+{
+  const uint32x4_t one = vdupq_n_u32(1), bias = vdupq_n_u32(0x7FFF);
+  const uint32x4_t abs_mask = vdupq_n_u32(0x7FFFFFFF), inf = vdupq_n_u32(0x7F800000);
+  const uint32x4_t quiet = vdupq_n_u32(0x0040);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    uint32x4_t x = vld1q_u32((const uint32_t *)(s + i));
+    uint32x4_t hi = vshrq_n_u32(x, 16);
+    uint32x4_t r = vshrq_n_u32(vaddq_u32(vaddq_u32(x, bias), vandq_u32(hi, one)), 16);
+    uint32x4_t nan = vcgtq_u32(vandq_u32(x, abs_mask), inf);
+    r = vbslq_u32(nan, vorrq_u32(hi, quiet), r);
+    vst1_u16(d + i, vmovn_u32(r));
+  }
+  f32_to_bf16_scalar(s + i, d + i, n - i);
+}
+
+static void bf16_to_f32_neon(const uint16_t *s, float *d, size_t n)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    vst1q_u32((uint32_t *)(d + i), vshll_n_u16(vld1_u16(s + i), 16));
+  bf16_to_f32_scalar(s + i, d + i, n - i);
+}
+
+#endif // X10_HALF_NEON
+
+// --- dispatch ---
+
+typedef struct
+{
+  const char *name;
+  void (*f32_to_f16)(const float *, uint16_t *, size_t);
+  void (*f16_to_f32)(const uint16_t *, float *, size_t);
+  void (*f32_to_bf16)(const float *, uint16_t *, size_t);
+  void (*bf16_to_f32)(const uint16_t *, float *, size_t);
+} x10_half_impl;
+
+static const x10_half_impl k_scalar = {"scalar", f32_to_f16_scalar, f16_to_f32_scalar,
+                                       f32_to_bf16_scalar, bf16_to_f32_scalar};
+#if X10_HALF_X86
+static const x10_half_impl k_avx2 = {"avx2", f32_to_f16_avx2, f16_to_f32_avx2,
+                                     f32_to_bf16_avx2, bf16_to_f32_avx2};
+static const x10_half_impl k_avx512 = {"avx512", f32_to_f16_avx512, f16_to_f32_avx512,
+                                       f32_to_bf16_avx512, bf16_to_f32_avx512};
+#endif
+#if X10_HALF_NEON
+static const x10_half_impl k_neon = {"neon", f32_to_f16_neon, f16_to_f32_neon,
+                                     f32_to_bf16_neon, bf16_to_f32_neon};
+#endif
+
+static const x10_half_impl *s_impl = &k_scalar;
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+
+static void x10_half_select(void)
+{
+  // Candidates best-first; the first supported one wins unless X10_KERNELS_ISA
+  // names another supported one.
+  const x10_half_impl *supported[3];
+  int count = 0;
+#if X10_HALF_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    supported[count++] = &k_avx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c"))
+    supported[count++] = &k_avx2;
+#endif
+#if X10_HALF_NEON
+  supported[count++] = &k_neon;
+#endif
+  supported[count++] = &k_scalar;
+
+  s_impl = supported[0];
+  const char *force = getenv("X10_KERNELS_ISA");
+  for (int i = 0; force && *force && i < count; ++i)
+    if (strcmp(force, supported[i]->name) == 0)
+      s_impl = supported[i];
+}
+
+static inline const x10_half_impl *impl(void)
+{
+  pthread_once(&s_once, x10_half_select);
+  return s_impl;
+}
+
+void x10_f32_to_f16(const float *src, uint16_t *dst, size_t n) { impl()->f32_to_f16(src, dst, n); }
+void x10_f16_to_f32(const uint16_t *src, float *dst, size_t n) { impl()->f16_to_f32(src, dst, n); }
+void x10_f32_to_bf16(const float *src, uint16_t *dst, size_t n) { impl()->f32_to_bf16(src, dst, n); }
+void x10_bf16_to_f32(const uint16_t *src, float *dst, size_t n) { impl()->bf16_to_f32(src, dst, n); }
+const char *x10_half_isa(void) { return impl()->name; }
@@ -10,12 +10,7 @@ public protocol Buffer: Sendable {}
 /// Collective reduction operation kinds (extend as needed).
 public enum ReduceOp: Sendable { case sum, max, min }
 
-/// Communicator / device group descriptor for collectives.
-public struct CollectiveGroup: Sendable { public init() {} }
-
-// If you don't already have these in this file, keep them here:
-public struct Stream: Sendable { public init() {} }
-public struct Event: Sendable { public init() {} }
+// `CollectiveGroup` lives in Collectives.swift; `Stream` and `Event` in Stream.swift.
 
 /// Options that influence backend compilation (stable shape of API).
 public struct CompileOptions: Sendable {
@@ -64,6 +59,12 @@ public struct CompileOptions: Sendable {
   }
 }
 
+/// A backend device numbered by ordinal. Backends key their memory pools
+/// `"<kind>:<ordinal>"`, so code that only sees `Backend.Dev` can find them.
+public protocol OrdinalDevice {
+  var ordinal: Int { get }
+}
+
 /// Backends implement compile/execute and (optionally) collectives.
 public protocol Backend: Sendable {
   associatedtype Dev: Hashable & Sendable
@@ -73,12 +74,44 @@ public protocol Backend: Sendable {
   func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer
   func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer
   func fromDevice(_ buffer: Buffer) throws -> [UInt8]
+  /// Copies `buffer`'s bytes straight into `destination` and returns how
+  /// many were written (at most `destination.count`).
+  func fromDevice(_ buffer: Buffer, into destination: UnsafeMutableRawBufferPointer) throws -> Int
 
   func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable
   func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer]
+  /// `execute` where the caller hands over `inputs[i]` for every `i` in
+  /// `donating`. A backend may write an aliased result (see
+  /// `StableHLOModule.Function.inputOutputAliases`) into a donated input's
+  /// storage instead of allocating; donated buffers must not be read again.
+  func execute(_ exec: Executable, inputs: [Buffer], donating: Set<Int>, stream: Stream?) async throws -> [Buffer]
 
   func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer
 
   func stream(device: Dev) throws -> Stream
   func event(device: Dev) throws -> Event
 }
+
+public extension Backend {
+  /// Backends without a direct path stage through `fromDevice(_:)`.
+  func fromDevice(_ buffer: Buffer, into destination: UnsafeMutableRawBufferPointer) throws -> Int {
+    let bytes = try fromDevice(buffer)
+    let n = min(bytes.count, destination.count)
+    if n > 0 { bytes.withUnsafeBytes { destination.baseAddress!.copyMemory(from: $0.baseAddress!, byteCount: n) } }
+    return n
+  }
+
+  /// Backends without buffer reuse ignore donation.
+  func execute(_ exec: Executable, inputs: [Buffer], donating: Set<Int>, stream: Stream?) async throws -> [Buffer] {
+    try await execute(exec, inputs: inputs, stream: stream)
+  }
+}
+
+public extension Array where Element == StableHLOModule.InputOutputAlias {
+  /// Output index -> donated input index for aliases whose parameter is in `donating`.
+  func donationPlan(donating: Set<Int>) -> [Int: Int] {
+    var plan: [Int: Int] = [:]
+    for a in self where donating.contains(a.parameter) { plan[a.output] = a.parameter }
+    return plan
+  }
+}
@@ -1 +1,465 @@
-public enum Collectives {}
+import Foundation
+import x10Core
+import x10Diagnostics
+
+/// How an all-reduce is scheduled across ranks.
+public enum CollectiveAlgorithm: String, Sendable, CaseIterable {
+  /// Tree below `CollectiveConfig.treeThresholdBytes`, ring above.
+  case auto
+  /// Reduce-scatter then all-gather around a ring: each rank moves
+  /// 2(N-1)/N of the payload, so cost is flat in N. Best for large tensors.
+  case ring
+  /// Binary-tree reduce to rank 0 then broadcast: 2·log2(N) steps with
+  /// fewer handoffs. Best for small tensors.
+  case tree
+}
+
+public struct CollectiveConfig: Sendable, Equatable {
+  public var algorithm: CollectiveAlgorithm
+  /// Pipelining granularity: a rank hands each segment on as soon as it is
+  /// done, so neighbours work on consecutive segments concurrently.
+  public var segmentBytes: Int
+  public var treeThresholdBytes: Int
+
+  public init(algorithm: CollectiveAlgorithm = .auto, segmentBytes: Int = 256 << 10, treeThresholdBytes: Int = 64 << 10) {
+    self.algorithm = algorithm
+    self.segmentBytes = max(64, segmentBytes)
+    self.treeThresholdBytes = treeThresholdBytes
+  }
+
+  /// X10_COLLECTIVE_ALGO (auto|ring|tree) and X10_COLLECTIVE_SEGMENT (bytes).
+  public static func fromEnvironment(_ env: [String: String] = ProcessInfo.processInfo.environment) -> CollectiveConfig {
+    CollectiveConfig(
+      algorithm: env["X10_COLLECTIVE_ALGO"].flatMap { CollectiveAlgorithm(rawValue: $0.lowercased()) } ?? .auto,
+      segmentBytes: env["X10_COLLECTIVE_SEGMENT"].flatMap(Int.init) ?? 256 << 10)
+  }
+}
+
+public enum CollectiveError: Error, LocalizedError {
+  case mismatch(String)
+
+  public var errorDescription: String? {
+    switch self {
+    case .mismatch(let message): return message
+    }
+  }
+}
+
+/// One rank's handle on a set of devices in this process. Build the handles
+/// together with `make(members:)` and give one to each participant; every
+/// participant then calls the same collectives in the same order, and each
+/// call returns once all ranks have contributed.
+///
+/// `CollectiveGroup()` is the trivial single-member group: every collective
+/// returns its input.
+public struct CollectiveGroup: Sendable {
+  /// Device keys in rank order (e.g. "pjrt:0"); results are allocated from
+  /// each member's `Memory` pool.
+  public let members: [String]
+  public let rank: Int
+  let communicator: Communicator?
+
+  public init() {
+    self.members = ["cpu:0"]
+    self.rank = 0
+    self.communicator = nil
+  }
+
+  init(members: [String], rank: Int, communicator: Communicator) {
+    self.members = members
+    self.rank = rank
+    self.communicator = communicator
+  }
+
+  /// One handle per member, index == rank.
+  public static func make(members: [String], config: CollectiveConfig = .fromEnvironment()) -> [CollectiveGroup] {
+    precondition(!members.isEmpty, "CollectiveGroup needs at least one member")
+    let comm = Communicator(size: members.count, config: config)
+    return members.indices.map { CollectiveGroup(members: members, rank: $0, communicator: comm) }
+  }
+
+  public var size: Int { members.count }
+
+  private var pool: MemoryPool { Memory.pool(for: members[rank]) }
+
+  /// Every rank receives `op` over all ranks' `data` (same length and dtype on every rank).
+  public func allReduce(_ data: Data, dtype: DType, op: ReduceOp) async throws -> Data {
+    guard let comm = communicator, size > 1 else { return data }
+    let out = staged(data)
+    try await run("Collectives.allReduce", bytes: data.count, blocks: [out]) { abort in
+      try await comm.allReduce(rank: rank, buffer: out.base, byteCount: data.count, dtype: dtype, op: op,
+                               onAbort: abort)
+    }
+    return pool.makeData(adopting: out, count: data.count)
+  }
+
+  /// Every rank receives all ranks' `data` concatenated in rank order.
+  public func allGather(_ data: Data) async throws -> Data {
+    guard let comm = communicator, size > 1 else { return data }
+    let input = staged(data)
+    let out = pool.allocateBlock(byteCount: data.count * size)
+    try await run("Collectives.allGather", bytes: data.count * size, blocks: [input, out]) { abort in
+      try await comm.allGather(rank: rank, input: input.base, byteCount: data.count, output: out.base,
+                               onAbort: abort)
+    }
+    pool.release(input)
+    return pool.makeData(adopting: out, count: data.count * size)
+  }
+
+  /// Rank `r` receives chunk `r` of the reduction; chunks split the element
+  /// range as evenly as possible, earlier ranks taking the remainder.
+  public func reduceScatter(_ data: Data, dtype: DType, op: ReduceOp) async throws -> Data {
+    guard let comm = communicator, size > 1 else { return data }
+    let range = Communicator.chunk(rank, of: data.count / dtype.byteWidth, parts: size)
+    let input = staged(data)
+    let out = pool.allocateBlock(byteCount: range.count * dtype.byteWidth)
+    try await run("Collectives.reduceScatter", bytes: data.count, blocks: [input, out]) { abort in
+      try await comm.reduceScatter(rank: rank, input: input.base, byteCount: data.count,
+                                   output: out.base, dtype: dtype, op: op, onAbort: abort)
+    }
+    pool.release(input)
+    return pool.makeData(adopting: out, count: range.count * dtype.byteWidth)
+  }
+
+  /// Copy of `data` in a pooled block. Peers read each rank's buffer for the
+  /// whole call, and `Data` only lends a stable address inside
+  /// `withUnsafeBytes`, so every collective works on its own copy.
+  private func staged(_ data: Data) -> MemoryPool.Block {
+    let block = pool.allocateBlock(byteCount: data.count)
+    data.withUnsafeBytes { if let src = $0.baseAddress { block.base.copyMemory(from: src, byteCount: $0.count) } }
+    return block
+  }
+
+  /// Times `body` and hands it the abort path for `blocks`: on failure the
+  /// communicator calls it once no peer can still be reading them.
+  private func run(_ name: StaticString, bytes: Int, blocks: [MemoryPool.Block],
+                   _ body: (@escaping @Sendable () -> Void) async throws -> Void) async throws {
+    let start = Metrics.nowNanos()
+    let traceStart = Trace.isEnabled ? start : 0
+    defer {
+      Diagnostics.collectiveLatency.record(Metrics.nowNanos() &- start)
+      Diagnostics.collectiveBytes.inc(UInt64(bytes))
+      Trace.end(name, since: traceStart, arg: UInt64(bytes))
+    }
+    let pool = self.pool
+    try await body { blocks.forEach(pool.release) }
+  }
+}
+
+// MARK: - Engine
+
+/// Matches the k-th collective call of every rank and runs the schedule on
+/// the shared host buffers. Ranks synchronize per (step, segment) through
+/// `Rendezvous`, never through a global barrier between steps.
+final class Communicator: @unchecked Sendable {
+  let size: Int
+  let config: CollectiveConfig
+
+  private let lock = NSLock()
+  private var sequence: [Int]
+  private var open: [Int: Rendezvous] = [:]
+
+  init(size: Int, config: CollectiveConfig) {
+    self.size = size
+    self.config = config
+    self.sequence = Array(repeating: 0, count: size)
+  }
+
+  /// Element range of chunk `index` when `n` elements are split `parts` ways.
+  static func chunk(_ index: Int, of n: Int, parts: Int) -> Range<Int> {
+    let base = n / parts, extra = n % parts
+    let start = index * base + min(index, extra)
+    return start..<(start + base + (index < extra ? 1 : 0))
+  }
+
+  // MARK: Operations
+
+  // Each operation calls `onAbort` exactly once if it throws, when no other
+  // rank can still touch this rank's buffers; on success it never does.
+
+  func allReduce(rank: Int, buffer: UnsafeMutableRawPointer, byteCount: Int, dtype: DType, op: ReduceOp,
+                 onAbort: @escaping @Sendable () -> Void) async throws {
+    try await session(rank, signature: "allReduce/\(dtype)/\(op)/\(byteCount)", base: buffer,
+                      onAbort: onAbort) { rv in
+      let n = byteCount / dtype.byteWidth
+      let width = dtype.byteWidth
+      let useTree = config.algorithm == .tree ||
+        (config.algorithm == .auto && byteCount <= config.treeThresholdBytes)
+
+      if useTree {
+        try await treeAllReduce(rv, rank: rank, n: n, width: width, dtype: dtype, op: op)
+      } else {
+        try await ringAllReduce(rv, rank: rank, n: n, width: width, dtype: dtype, op: op)
+      }
+    }
+  }
+
+  func allGather(rank: Int, input: UnsafeRawPointer, byteCount: Int, output dst: UnsafeMutableRawPointer,
+                 onAbort: @escaping @Sendable () -> Void) async throws {
+    try await session(rank, signature: "allGather/\(byteCount)", base: input, onAbort: onAbort) { rv in
+      try await rv.waitAll(atLeast: 0)
+      for q in 0..<size where byteCount > 0 {
+        (dst + q * byteCount).copyMemory(from: rv.base(q), byteCount: byteCount)
+      }
+      try await rv.finish(rank, at: 1)
+    }
+  }
+
+  func reduceScatter(rank: Int, input: UnsafeRawPointer, byteCount: Int, output dst: UnsafeMutableRawPointer,
+                     dtype: DType, op: ReduceOp, onAbort: @escaping @Sendable () -> Void) async throws {
+    try await session(rank, signature: "reduceScatter/\(dtype)/\(op)/\(byteCount)", base: input,
+                      onAbort: onAbort) { rv in
+      try await rv.waitAll(atLeast: 0)
+      let width = dtype.byteWidth
+      let range = Self.chunk(rank, of: byteCount / width, parts: size)
+      let offset = range.lowerBound * width
+      dst.copyMemory(from: rv.base(0) + offset, byteCount: range.count * width)
+      for q in 1..<size {
+        ReductionKernels.reduce(dst, rv.base(q) + offset, count: range.count, dtype: dtype, op: op)
+      }
+      try await rv.finish(rank, at: 1)
+    }
+  }
+
+  /// Joins the next collective, runs `body`, and leaves. On failure the
+  /// rendezvous is failed so peers stop waiting, and `onAbort` is deferred
+  /// until every rank that arrived has left.
+  private func session(_ rank: Int, signature: String, base: UnsafeRawPointer,
+                       onAbort: @escaping @Sendable () -> Void,
+                       _ body: (Rendezvous) async throws -> Void) async throws {
+    let rv: Rendezvous
+    do {
+      rv = try join(rank, signature: signature, base: base)
+    } catch {
+      onAbort()
+      throw error
+    }
+    do {
+      try await body(rv)
+    } catch {
+      rv.fail(error)
+      rv.leave(then: onAbort)
+      throw error
+    }
+    rv.leave(then: nil)
+  }
+
+  // MARK: Schedules
+
+  /// Unit u = step·K + segment. Reduce-scatter steps 0..<N-1 then all-gather
+  /// steps N-1..<2(N-1); a unit only needs the left neighbour's same segment
+  /// from the previous step.
+  private func ringAllReduce(_ rv: Rendezvous, rank r: Int, n: Int, width: Int,
+                             dtype: DType, op: ReduceOp) async throws {
+    let N = size
+    let left = (r + N - 1) % N
+    let maxChunk = Self.chunk(0, of: n, parts: N).count
+    let K = max(1, (maxChunk * width + config.segmentBytes - 1) / config.segmentBytes)
+    let dst = rv.base(r), src = rv.base(left)
+
+    try await rv.wait(left, atLeast: 0)
+    for step in 0..<(2 * (N - 1)) {
+      let reducing = step < N - 1
+      let c = reducing ? (r - step - 1 + 2 * N) % N : (r - (step - (N - 1)) + N) % N
+      let chunk = Self.chunk(c, of: n, parts: N)
+      let segLen = (chunk.count + K - 1) / K
+      for k in 0..<K {
+        let u = step * K + k
+        if step > 0 { try await rv.wait(left, atLeast: u - K + 1) }
+        let lo = min(chunk.upperBound, chunk.lowerBound + k * segLen)
+        let hi = min(chunk.upperBound, lo + segLen)
+        if hi > lo {
+          let offset = lo * width
+          if reducing {
+            ReductionKernels.reduce(UnsafeMutableRawPointer(mutating: dst + offset), src + offset,
+                                    count: hi - lo, dtype: dtype, op: op)
+          } else {
+            UnsafeMutableRawPointer(mutating: dst + offset).copyMemory(from: src + offset, byteCount: (hi - lo) * width)
+          }
+        }
+        rv.advance(r, to: u + 1)
+      }
+    }
+    try await rv.finish(r, at: 2 * (N - 1) * K)
+  }
+
+  /// Rounds 0..<L reduce pairs at stride 2^j into the lower rank; rounds
+  /// L..<2L broadcast back down. Idle ranks advance through a unit at once.
+  private func treeAllReduce(_ rv: Rendezvous, rank r: Int, n: Int, width: Int,
+                             dtype: DType, op: ReduceOp) async throws {
+    let N = size
+    var L = 0
+    while (1 << L) < N { L += 1 }
+    let K = max(1, (n * width + config.segmentBytes - 1) / config.segmentBytes)
+    let segLen = (n + K - 1) / K
+    let dst = UnsafeMutableRawPointer(mutating: rv.base(r))
+
+    for round in 0..<(2 * L) {
+      let reducing = round < L
+      let stride = 1 << (reducing ? round : (2 * L - 1 - round))
+      let peer: Int?
+      if reducing {
+        peer = (r % (2 * stride) == 0 && r + stride < N) ? r + stride : nil
+      } else {
+        peer = (r % (2 * stride) == stride) ? r - stride : nil
+      }
+      for k in 0..<K {
+        let u = round * K + k
+        if let peer {
+          try await rv.wait(peer, atLeast: u)
+          let lo = min(n, k * segLen), hi = min(n, lo + segLen)
+          if hi > lo {
+            let offset = lo * width
+            if reducing {
+              ReductionKernels.reduce(dst + offset, rv.base(peer) + offset, count: hi - lo, dtype: dtype, op: op)
+            } else {
+              (dst + offset).copyMemory(from: rv.base(peer) + offset, byteCount: (hi - lo) * width)
+            }
+          }
+        }
+        rv.advance(r, to: u + 1)
+      }
+    }
+    try await rv.finish(r, at: 2 * L * K)
+  }
+
+  // MARK: Rendezvous
+
+  private func join(_ rank: Int, signature: String, base: UnsafeRawPointer) throws -> Rendezvous {
+    lock.lock()
+    let seq = sequence[rank]
+    sequence[rank] += 1
+    let rv: Rendezvous
+    if let existing = open[seq] {
+      rv = existing
+    } else {
+      rv = Rendezvous(size: size, signature: signature)
+      open[seq] = rv
+    }
+    rv.joined += 1
+    if rv.joined == size { open.removeValue(forKey: seq) }
+    lock.unlock()
+
+    guard rv.signature == signature else {
+      let error = CollectiveError.mismatch("rank \(rank) called \(signature), peers called \(rv.signature)")
+      rv.fail(error)
+      throw error
+    }
+    try rv.arrive(rank, base: base)
+    return rv
+  }
+}
+
+/// Per-call shared state: each rank's buffer address and a monotonic progress
+/// counter per rank (-1 until the rank arrives). Waiters suspend until a
+/// rank's counter reaches a target. Buffers are owned by the calling ranks,
+/// which stay inside the collective until every rank has finished. The first
+/// failure (including a waiter's task being cancelled) wakes every waiter
+/// with that error.
+final class Rendezvous: @unchecked Sendable {
+  let signature: String
+  var joined = 0   // guarded by the communicator's lock
+
+  private let lock = NSLock()
+  private var buffers: [UnsafeRawPointer?]
+  private var progress: [Int]
+  private var failure: Error?
+  /// Ranks that arrived and have not left, and work to run once none remain.
+  private var active = 0
+  private var drained: [@Sendable () -> Void] = []
+  private var waiters: [(rank: Int, target: Int, continuation: CheckedContinuation<Void, Error>)] = []
+
+  init(size: Int, signature: String) {
+    self.signature = signature
+    self.buffers = Array(repeating: nil, count: size)
+    self.progress = Array(repeating: -1, count: size)
+  }
+
+  func base(_ rank: Int) -> UnsafeRawPointer {
+    lock.lock(); defer { lock.unlock() }
+    return buffers[rank]!
+  }
+
+  /// Publishes `rank`'s buffer; throws instead if the call already failed,
+  /// so no peer is handed a buffer nobody will wait for.
+  func arrive(_ rank: Int, base: UnsafeRawPointer) throws {
+    lock.lock()
+    if let failure {
+      lock.unlock()
+      throw failure
+    }
+    buffers[rank] = base
+    active += 1
+    lock.unlock()
+    advance(rank, to: 0)
+  }
+
+  /// Marks an arrived rank as no longer touching peers' buffers. `release`,
+  /// if given, runs once no arrived rank remains inside (possibly now).
+  func leave(then release: (@Sendable () -> Void)?) {
+    lock.lock()
+    active -= 1
+    if let release { drained.append(release) }
+    var ready: [@Sendable () -> Void] = []
+    if active == 0 { swap(&ready, &drained) }
+    lock.unlock()
+    ready.forEach { $0() }
+  }
+
+  func advance(_ rank: Int, to value: Int) {
+    lock.lock()
+    progress[rank] = value
+    var ready: [CheckedContinuation<Void, Error>] = []
+    waiters.removeAll { w in
+      guard w.rank == rank, w.target <= value else { return false }
+      ready.append(w.continuation)
+      return true
+    }
+    lock.unlock()
+    ready.forEach { $0.resume() }
+  }
+
+  /// Cancelling the waiting task fails the whole call: the collective cannot
+  /// complete without this rank.
+  func wait(_ rank: Int, atLeast target: Int) async throws {
+    try await withTaskCancellationHandler {
+      try await withCheckedThrowingContinuation { (c: CheckedContinuation<Void, Error>) in
+        lock.lock()
+        if let failure {
+          lock.unlock()
+          c.resume(throwing: failure)
+        } else if progress[rank] >= target {
+          lock.unlock()
+          c.resume()
+        } else {
+          waiters.append((rank, target, c))
+          lock.unlock()
+        }
+      }
+    } onCancel: {
+      self.fail(CancellationError())
+    }
+  }
+
+  func waitAll(atLeast target: Int) async throws {
+    for rank in progress.indices { try await wait(rank, atLeast: target) }
+  }
+
+  /// Marks `rank` done at `value` and waits for everyone else, so no buffer
+  /// is handed back to its caller while a peer may still read it.
+  func finish(_ rank: Int, at value: Int) async throws {
+    advance(rank, to: value)
+    try await waitAll(atLeast: value)
+  }
+
+  /// Fails the call; the first error wins.
+  func fail(_ error: Error) {
+    lock.lock()
+    if failure == nil { failure = error }
+    let first = failure!
+    let pending = waiters
+    waiters.removeAll()
+    lock.unlock()
+    pending.forEach { $0.continuation.resume(throwing: first) }
+  }
+}
@@ -17,11 +17,38 @@ public struct BackendVersionInfo {
 public enum BackendVersioning {
   private static let queue = DispatchQueue(label: "x10.BackendVersioning")
   private static var resolvers: [(Any) -> BackendVersionInfo?] = []
+  private static var moduleSalts: [(Any, CompileOptions, () -> StableHLOModule) -> String?] = []
 
   public static func register(_ resolver: @escaping (Any) -> BackendVersionInfo?) {
     queue.sync { resolvers.append(resolver) }
   }
 
+  /// Registers a per-module cache key component for compile inputs a
+  /// backend reads from outside `CompileOptions` (IREE's tuned flags). The
+  /// resolver gets the program as compiled, after any input casting, as a
+  /// thunk so it can return nil for backends or modules it does not apply
+  /// to without building it; the program is built at most once per key.
+  public static func registerModuleSalt(
+    _ resolver: @escaping (_ backend: Any, _ options: CompileOptions, _ program: () -> StableHLOModule) -> String?
+  ) {
+    queue.sync { moduleSalts.append(resolver) }
+  }
+
+  static func moduleSalt(for backend: Any, options: CompileOptions,
+                         program: () -> StableHLOModule) -> String? {
+    let handlers = queue.sync { moduleSalts }
+    guard !handlers.isEmpty else { return nil }
+    var compiled: StableHLOModule?
+    func resolved() -> StableHLOModule {
+      if let compiled { return compiled }
+      let built = program()
+      compiled = built
+      return built
+    }
+    let salts = handlers.compactMap { $0(backend, options, resolved) }
+    return salts.isEmpty ? nil : salts.joined(separator: ";")
+  }
+
   static func info(for backend: Any) -> BackendVersionInfo {
     let handlers = queue.sync { resolvers }
     for resolver in handlers.reversed() {
@@ -55,51 +82,46 @@ public enum JIT {
     with backend: B,
     options: CompileOptions = .init()
   ) async throws -> Executable {
+    let traceStart = Trace.begin()
+    defer { Trace.end("JIT.compileCached", since: traceStart) }
+
     // Fill in default device if the caller didn’t specify one.
     var opts = options
     if opts.device == nil { opts.device = DeviceScope.current }
 
-    // Key the cache by IR+options+device/bucketing.
-    let info = BackendVersioning.info(for: backend)
-    let backendKey = info.kind
-    let packageVer = "dev"
-    let versionSalt = "\(info.kind):\(info.version):\(packageVer)"
-
-    let deviceKey = opts.device?.stableKey ?? "cpu:0"
-    let precisionSignature = "a:\(precCode(opts.precision.activations))," +
-                             "m:\(precCode(opts.precision.matmul))," +
-                             "acc:\(precCode(opts.precision.accumulators))"
-    let flagStr = opts.flags
-      .sorted { $0.key < $1.key }
-      .map { "\($0.key)=\($0.value)" }
-      .joined(separator: ";")
-
-    let extraComponents = ["precision=\(precisionSignature)", "flags=\(flagStr)"]
     let concreteShape = opts.shapeHint ?? canonicalConcreteShape(from: stablehlo)
+    let (key, irHash) = Trace.span("JIT.cacheKey") { cacheKey(for: stablehlo, with: backend, options: opts) }
 
-    let (key, irHash) = makeCacheKey(
-      module: stablehlo,
-      backendKey: backendKey,
-      deviceKey: deviceKey,
-      versionSalt: versionSalt,
-      concreteShape: concreteShape,
-      bucketing: opts.shapeBucketing,
-      extraComponents: extraComponents
-    )
-
-    await ShapeProfiler.shared.note(
-      irHash: irHash,
-      policy: opts.shapeBucketing,
-      concreteShape: concreteShape
-    )
+    // Warm-up compiles are not traffic; keep them out of the shape profile
+    // and away from adaptive bucketing, which re-tunes from that profile.
+    if !opts.isWarmup {
+      await ShapeProfiler.shared.note(
+        irHash: irHash,
+        policy: opts.shapeBucketing,
+        concreteShape: concreteShape
+      )
+      AdaptiveBucketing.noteExecution(irHash: irHash, policy: opts.shapeBucketing)
+    }
 
-    if let hit = await ExecutableCache.shared.get(key) {
-      return hit
+    let lookupStart = Metrics.nowNanos()
+    let cached = await ExecutableCache.shared.record(for: key)
+    Diagnostics.cacheLookupLatency.record(Metrics.nowNanos() &- lookupStart)
+    Trace.end("ExecutableCache.lookup", since: traceStart == 0 ? 0 : lookupStart)
+    if let hit = cached {
+      if hit.warmed && !opts.isWarmup { Diagnostics.warmedHits.inc() }
+      return hit.exec
     }
 
     Diagnostics.uncachedCompiles.inc()
-    let exec = try backend.compile(stablehlo: stablehlo, options: opts)
-    await ExecutableCache.shared.put(exec, for: key)
+    let compileStart = Metrics.nowNanos()
+    // Under `castInputs` the program takes f32 arguments at activation width.
+    let program = try opts.precision.inputCastType.map { try stablehlo.castingInputs(to: $0) } ?? stablehlo
+    let exec = try backend.compile(stablehlo: program, options: opts)
+    let compileNanos = Metrics.nowNanos() &- compileStart
+    Trace.end("Backend.compile", since: traceStart == 0 ? 0 : compileStart)
+    Diagnostics.compileLatency.record(compileNanos)
+    let compileSeconds = Double(compileNanos) / 1e9
+    await ExecutableCache.shared.put(exec, for: key, compileSeconds: compileSeconds, warmed: opts.isWarmup)
 
     if !opts.isWarmup && cacheWarmingEnabled() {
       let device = opts.device ?? Device.default
@@ -121,6 +143,85 @@ public enum JIT {
     return exec
   }
 
+  /// Root of x10's on-disk caches: X10_IR_CACHE_DIR, else `x10-swifty` in
+  /// the platform cache directory. Backends keep their own stores under it.
+  public static var cacheDirectory: URL { IRStore.baseDir() }
+
+  /// Cache key and irHash `compileCached` would use for these inputs.
+  /// The irHash ignores the concrete shape, so it names the shape profile
+  /// shared by every specialization of `stablehlo`. Pure: nothing is noted
+  /// in the shape profile. `moduleSalts` false leaves out the backend's
+  /// per-module components (see `BackendVersioning.registerModuleSalt`),
+  /// giving the key of a host with no such state.
+  public static func cacheKey<B: Backend>(
+    for stablehlo: StableHLOModule,
+    with backend: B,
+    options: CompileOptions = .init(),
+    moduleSalts: Bool = true
+  ) -> (key: ShapeKey, irHash: String) {
+    // Key the cache by IR+options+device/bucketing.
+    let info = BackendVersioning.info(for: backend)
+    let packageVer = "dev"
+    var opts = options
+    if opts.device == nil { opts.device = DeviceScope.current }
+    let salt = !moduleSalts ? nil : BackendVersioning.moduleSalt(for: backend, options: opts) {
+      (try? opts.precision.inputCastType).flatMap { try? stablehlo.castingInputs(to: $0) } ?? stablehlo
+    }
+    return cacheKey(for: stablehlo, backendKey: info.kind,
+                    versionSalt: "\(info.kind):\(info.version):\(packageVer)", options: opts,
+                    extra: salt.map { ["backend=\($0)"] } ?? [])
+  }
+
+  /// Backend-independent counterpart of `cacheKey`: the fingerprint of the
+  /// same IR, device, precision, flags and dims with no backend component,
+  /// so one call site maps to one key whichever backend runs it. Like
+  /// `cacheKey` it records nothing, so a routed call is counted once, by
+  /// `compileCached`. No backend profiles its irHash, so under an adaptive
+  /// policy route keys stay per concrete shape.
+  public static func routeKey(for stablehlo: StableHLOModule, options: CompileOptions = .init()) -> String {
+    cacheKey(for: stablehlo, backendKey: "any", versionSalt: "route", options: options).key.fingerprint
+  }
+
+  private static func cacheKey(
+    for stablehlo: StableHLOModule,
+    backendKey: String,
+    versionSalt: String,
+    options: CompileOptions,
+    extra: [String] = []
+  ) -> (key: ShapeKey, irHash: String) {
+    var opts = options
+    if opts.device == nil { opts.device = DeviceScope.current }
+
+    let deviceKey = opts.device?.stableKey ?? "cpu:0"
+    let precisionSignature = "a:\(precCode(opts.precision.activations))," +
+                             "m:\(precCode(opts.precision.matmul))," +
+                             "acc:\(precCode(opts.precision.accumulators))" +
+                             ((try? opts.precision.inputCastType).map { ",in:\($0)" } ?? "")
+    let flagStr = opts.flags
+      .sorted { $0.key < $1.key }
+      .map { "\($0.key)=\($0.value)" }
+      .joined(separator: ";")
+
+    var extraComponents = ["precision=\(precisionSignature)", "flags=\(flagStr)"] + extra
+    // Aliasing changes what the backend records per executable, so it is part of the key.
+    let aliases = stablehlo.functions.flatMap(\.validInputOutputAliases)
+    if !aliases.isEmpty {
+      extraComponents.append("aliases=" + aliases.map { "\($0.output)<-\($0.parameter)" }.joined(separator: ","))
+    }
+    let concreteShape = opts.shapeHint ?? canonicalConcreteShape(from: stablehlo)
+
+    let (key, irHash) = makeCacheKey(
+      module: stablehlo,
+      backendKey: backendKey,
+      deviceKey: deviceKey,
+      versionSalt: versionSalt,
+      concreteShape: concreteShape,
+      bucketing: opts.shapeBucketing,
+      extraComponents: extraComponents
+    )
+    return (key, irHash)
+  }
+
   // MARK: - Private helpers (kept inside the JIT type)
 
   /// Maps precision enums to short string codes used in the key.
@@ -168,9 +269,6 @@ public func makeCacheKey(
   bucketing: ShapeBucketingPolicy,
   extraComponents: [String] = []
 ) -> (ShapeKey, String) {
-  let dimSpecs = resolveDimSpecs(for: concreteShape, using: bucketing)
-  let dimSummary = dimSpecs.map(describeDimSpec).joined(separator: ",")
-
   var baseComponents: [String] = [
     "backend=\(backendKey)",
     "device=\(deviceKey)",
@@ -180,6 +278,9 @@ public func makeCacheKey(
   baseComponents.append(contentsOf: extraComponents)
   let irHash = fnv1a64(baseComponents.joined(separator: "|"))
 
+  let dimSpecs = resolveDimSpecs(for: concreteShape, using: bucketing, irHash: irHash)
+  let dimSummary = dimSpecs.map(describeDimSpec).joined(separator: ",")
+
   var fingerprintComponents = baseComponents
   fingerprintComponents.append("dims=\(dimSummary)")
   let fingerprint = fnv1a64(fingerprintComponents.joined(separator: "|"))
@@ -195,7 +296,11 @@ public func makeCacheKey(
   return (key, irHash)
 }
 
-private func resolveDimSpecs(for shape: [Int], using policy: ShapeBucketingPolicy) -> [DimSpec] {
+private func resolveDimSpecs(for shape: [Int], using policy: ShapeBucketingPolicy, irHash: String) -> [DimSpec] {
+  if policy.adaptive != nil {
+    return AdaptiveBucketing.dimSpecs(irHash: irHash, shape: shape, policy: policy)
+      ?? inferredDimSpecs(for: shape)
+  }
   if policy.dims.isEmpty {
     return inferredDimSpecs(for: shape)
   }
@@ -240,7 +345,7 @@ private func cacheWarmingEnabled() -> Bool {
   ProcessInfo.processInfo.environment["X10_CACHE_WARMING"] == "1"
 }
 
-private func cacheWarmingTopK() -> Int {
+func cacheWarmingTopK() -> Int {
   let env = ProcessInfo.processInfo.environment
   let raw = env["X10_CACHE_WARMING_TOPK"].flatMap(Int.init) ?? 3
   return max(1, raw)
@@ -30,7 +30,8 @@ extension CompileOptions {
       \"precision\":{\
       \"activations\":\"\(precCode(p.activations))\",\
       \"matmul\":\"\(precCode(p.matmul))\",\
-      \"accumulators\":\"\(precCode(p.accumulators))\"}
+      \"accumulators\":\"\(precCode(p.accumulators))\",\
+      \"castInputs\":\(p.castInputs ? "true" : "false")}
     """.replacingOccurrences(of: "\n", with: ""))
 
     parts.append(" \"debugIR\":\(debugIR ? "true" : "false")")
@@ -0,0 +1,236 @@
+import Foundation
+import x10Core
+import x10Diagnostics
+
+/// Knobs for `BatchScheduler`: larger `maxBatchSize`/`maxDelay` trade latency
+/// for throughput.
+public struct BatchingConfig: Sendable, Equatable {
+  /// Requests stacked into one execute at most.
+  public var maxBatchSize: Int
+  /// Seconds the first request of a batch may wait for company.
+  public var maxDelay: Double
+  /// Batch sizes that get compiled, ascending; a batch runs on the smallest
+  /// one that fits and the unused rows are zero padding.
+  public var batchSizes: [Int]
+
+  public init(maxBatchSize: Int = 32, maxDelay: Double = 0.002, batchSizes: [Int]? = nil) {
+    self.maxBatchSize = max(1, maxBatchSize)
+    self.maxDelay = max(0, maxDelay)
+    var sizes = batchSizes ?? Array(sequence(first: 1) { $0 * 2 }.prefix { $0 < self.maxBatchSize })
+    sizes = sizes.filter { $0 > 0 && $0 < self.maxBatchSize } + [self.maxBatchSize]
+    self.batchSizes = Array(Set(sizes)).sorted()
+  }
+
+  /// X10_BATCH_MAX_SIZE (default 32) and X10_BATCH_MAX_DELAY_US (default 2000).
+  public static func fromEnvironment(_ env: [String: String] = ProcessInfo.processInfo.environment) -> BatchingConfig {
+    let size = env["X10_BATCH_MAX_SIZE"].flatMap(Int.init) ?? 32
+    let delayMicros = env["X10_BATCH_MAX_DELAY_US"].flatMap(Double.init) ?? 2000
+    return BatchingConfig(maxBatchSize: size, maxDelay: delayMicros / 1e6)
+  }
+
+  /// Compiled batch size used for `n` requests.
+  public func bucket(for n: Int) -> Int {
+    batchSizes.first { $0 >= n } ?? maxBatchSize
+  }
+}
+
+public struct BatchingStats: Sendable, Equatable {
+  public var requests: Int
+  public var batches: Int
+  /// Rows executed, padding included.
+  public var slots: Int
+
+  /// Share of executed rows that carried a real request.
+  public var fillRate: Double { slots == 0 ? 0 : Double(requests) / Double(slots) }
+  public var meanBatchSize: Double { batches == 0 ? 0 : Double(requests) / Double(batches) }
+}
+
+public enum BatchingError: Error, LocalizedError {
+  case signature(String)
+  case output(String)
+
+  public var errorDescription: String? {
+    switch self {
+    case .signature(let message), .output(let message): return message
+    }
+  }
+}
+
+/// Dynamic batching for serving. Concurrent single-example `submit` calls
+/// against one executable family are stacked along a leading batch dimension
+/// and run as a single execute, then split back out to their callers.
+///
+/// `family(n)` must return the model compiled for batch size `n`: every
+/// argument and result has a leading dimension of `n`, and the rest of each
+/// shape is static and the same for every `n`. Each batch size is compiled
+/// once through `JIT.compileCached`.
+public actor BatchScheduler<B: Backend> {
+  private struct Pending {
+    let inputs: [Data]
+    let continuation: CheckedContinuation<[Data], Error>
+  }
+
+  private struct Slot: Sendable {
+    let shape: [Int]   // without the batch dimension
+    let dtype: DType
+    var bytes: Int { shape.reduce(1, *) * dtype.byteWidth }
+  }
+
+  public nonisolated let config: BatchingConfig
+  private let backend: B
+  private let device: B.Dev
+  private let options: CompileOptions
+  private let family: @Sendable (Int) -> StableHLOModule
+  private let inputSlots: [Slot]?
+
+  private var pending: [Pending] = []
+  private var timerGeneration = 0
+  private var timerArmed = false
+  private var totals = BatchingStats(requests: 0, batches: 0, slots: 0)
+
+  public init(
+    backend: B,
+    device: B.Dev,
+    config: BatchingConfig = .fromEnvironment(),
+    options: CompileOptions = .init(),
+    family: @escaping @Sendable (Int) -> StableHLOModule
+  ) {
+    self.backend = backend
+    self.device = device
+    self.config = config
+    self.options = options
+    self.family = family
+    self.inputSlots = family(1).functions.first.flatMap { fn in
+      let slots = fn.args.map { arg -> Slot? in
+        guard arg.shape.first == 1, !arg.shape.contains(where: { $0 == nil }) else { return nil }
+        return Slot(shape: arg.shape.dropFirst().map { $0! }, dtype: arg.dtype)
+      }
+      return slots.contains { $0 == nil } ? nil : slots.map { $0! }
+    }
+  }
+
+  /// Runs one example (one `Data` per model argument, without the batch
+  /// dimension) as part of the next batch and returns its outputs.
+  public func submit(_ inputs: [Data]) async throws -> [Data] {
+    guard let slots = inputSlots else {
+      throw BatchingError.signature("family(1) must take static arguments with leading batch dimension 1")
+    }
+    guard inputs.count == slots.count else {
+      throw BatchingError.signature("expected \(slots.count) inputs, got \(inputs.count)")
+    }
+    for (i, (data, slot)) in zip(inputs, slots).enumerated() where data.count != slot.bytes {
+      throw BatchingError.signature("input \(i): expected \(slot.bytes) bytes, got \(data.count)")
+    }
+    return try await withCheckedThrowingContinuation { continuation in
+      pending.append(Pending(inputs: inputs, continuation: continuation))
+      if pending.count >= config.maxBatchSize || config.maxDelay == 0 {
+        dispatch()
+      } else if !timerArmed {
+        armTimer()
+      }
+    }
+  }
+
+  /// Dispatches whatever is pending without waiting for the deadline.
+  public func flush() {
+    dispatch()
+  }
+
+  public func stats() -> BatchingStats {
+    totals
+  }
+
+  // MARK: - Private
+
+  private func armTimer() {
+    timerArmed = true
+    timerGeneration += 1
+    let generation = timerGeneration
+    let nanos = UInt64(config.maxDelay * 1e9)
+    Task {
+      try? await Task.sleep(nanoseconds: nanos)
+      await self.deadline(generation)
+    }
+  }
+
+  private func deadline(_ generation: Int) {
+    guard timerArmed, generation == timerGeneration else { return }
+    dispatch()
+  }
+
+  private func dispatch() {
+    timerArmed = false
+    while !pending.isEmpty {
+      let batch = Array(pending.prefix(config.maxBatchSize))
+      pending.removeFirst(batch.count)
+      let size = config.bucket(for: batch.count)
+      totals.requests += batch.count
+      totals.batches += 1
+      totals.slots += size
+      Diagnostics.batchedRequests.inc(UInt64(batch.count))
+      Diagnostics.batchSlots.inc(UInt64(size))
+
+      let work = BatchWork(backend: backend, device: device, options: options, family: family,
+                           slots: inputSlots ?? [], size: size)
+      Task {
+        do {
+          let outputs = try await work.run(batch.map(\.inputs))
+          for (request, result) in zip(batch, outputs) { request.continuation.resume(returning: result) }
+        } catch {
+          for request in batch { request.continuation.resume(throwing: error) }
+        }
+      }
+    }
+  }
+
+  /// Everything one batch needs, so it runs off the actor.
+  private struct BatchWork: Sendable {
+    let backend: B
+    let device: B.Dev
+    let options: CompileOptions
+    let family: @Sendable (Int) -> StableHLOModule
+    let slots: [Slot]
+    let size: Int
+
+    func run(_ requests: [[Data]]) async throws -> [[Data]] {
+      let traceStart = Trace.begin()
+      defer { Trace.end("BatchScheduler.run", since: traceStart, arg: UInt64(requests.count)) }
+
+      let exec = try await JIT.compileCached(family(size), with: backend, options: options)
+
+      // Stack each argument along the batch dimension; padding rows stay zero.
+      var buffers: [Buffer] = []
+      for (i, slot) in slots.enumerated() {
+        var stacked = Data(count: slot.bytes * size)
+        stacked.withUnsafeMutableBytes { dst in
+          for (row, request) in requests.enumerated() {
+            request[i].withUnsafeBytes { src in
+              dst.baseAddress!.advanced(by: row * slot.bytes).copyMemory(from: src.baseAddress!, byteCount: slot.bytes)
+            }
+          }
+        }
+        buffers.append(try stacked.withUnsafeBytes {
+          // Matches the argument types `compileCached` gave the program under `castInputs`.
+          try backend.toDevice($0, shape: [size] + slot.shape, dtype: slot.dtype, on: device,
+                               precision: options.precision)
+        })
+      }
+
+      let outputs = try await backend.execute(exec, inputs: buffers, donating: Set(buffers.indices), stream: nil)
+
+      // Split each output back into per-request rows.
+      var results = Array(repeating: [Data](), count: requests.count)
+      for (o, output) in outputs.enumerated() {
+        let bytes = try backend.fromDevice(output)
+        guard bytes.count % size == 0 else {
+          throw BatchingError.output("output \(o): \(bytes.count) bytes do not split into \(size) rows")
+        }
+        let rowBytes = bytes.count / size
+        for row in results.indices {
+          results[row].append(Data(bytes[(row * rowBytes)..<((row + 1) * rowBytes)]))
+        }
+      }
+      return results
+    }
+  }
+}
@@ -0,0 +1,119 @@
+import Foundation
+import x10Core
+
+/// One cache access in a replayable trace. Only identity fields of the key are
+/// kept, so traces can be written to disk and replayed in another process.
+public struct CacheTraceEvent: Sendable, Codable, Hashable {
+  public var fingerprint: String
+  public var versionSalt: String
+  public var deviceKey: String
+  public var backendKey: String
+  public var compileSeconds: Double
+  public var size: Int
+
+  public init(
+    fingerprint: String,
+    versionSalt: String = "",
+    deviceKey: String = "",
+    backendKey: String = "",
+    compileSeconds: Double,
+    size: Int = 1
+  ) {
+    self.fingerprint = fingerprint
+    self.versionSalt = versionSalt
+    self.deviceKey = deviceKey
+    self.backendKey = backendKey
+    self.compileSeconds = compileSeconds
+    self.size = size
+  }
+
+  public init(key: ShapeKey, compileSeconds: Double, size: Int) {
+    self.init(
+      fingerprint: key.fingerprint,
+      versionSalt: key.versionSalt,
+      deviceKey: key.deviceKey,
+      backendKey: key.backendKey,
+      compileSeconds: compileSeconds,
+      size: size)
+  }
+
+  public var key: ShapeKey {
+    ShapeKey(fingerprint: fingerprint, versionSalt: versionSalt, deviceKey: deviceKey, backendKey: backendKey)
+  }
+}
+
+/// Outcome of replaying a trace against one `CachePolicy`.
+public struct CacheSimulationResult: Sendable, CustomStringConvertible {
+  public let policyName: String
+  public let hits: Int
+  public let misses: Int
+  public let evictions: Int
+  /// Misses on keys that had been compiled before (i.e. caused by eviction).
+  public let recompiles: Int
+  /// Compile time spent on every miss, cold ones included.
+  public let totalCompileSeconds: Double
+  /// Compile time spent re-compiling evicted entries; the number to minimize.
+  public let totalRecompileSeconds: Double
+
+  public var hitRate: Double {
+    let total = hits + misses
+    return total == 0 ? 0 : Double(hits) / Double(total)
+  }
+
+  public var description: String {
+    "\(policyName): hits=\(hits) misses=\(misses) evictions=\(evictions) recompiles=\(recompiles) " +
+      String(format: "recompile=%.3fs compile=%.3fs", totalRecompileSeconds, totalCompileSeconds)
+  }
+}
+
+/// Offline replay of cache traces so eviction policies can be compared by
+/// total recompile time without touching a backend.
+public enum CacheSimulator {
+  public static func replay(_ trace: [CacheTraceEvent], policy: CachePolicy) -> CacheSimulationResult {
+    var ledger = EvictionLedger(policy: policy)
+    var seen = Set<ShapeKey>()
+    var hits = 0, misses = 0, evictions = 0, recompiles = 0
+    var compileSeconds = 0.0, recompileSeconds = 0.0
+
+    for event in trace {
+      let key = event.key
+      if ledger.access(key) != nil {
+        hits += 1
+        continue
+      }
+      misses += 1
+      compileSeconds += event.compileSeconds
+      if !seen.insert(key).inserted {
+        recompiles += 1
+        recompileSeconds += event.compileSeconds
+      }
+      let stats = CacheEntryStats(size: event.size, compileSeconds: event.compileSeconds)
+      evictions += ledger.insert(key, stats: stats).count
+    }
+
+    return CacheSimulationResult(
+      policyName: policy.eviction.description,
+      hits: hits,
+      misses: misses,
+      evictions: evictions,
+      recompiles: recompiles,
+      totalCompileSeconds: compileSeconds,
+      totalRecompileSeconds: recompileSeconds)
+  }
+
+  /// Replays the same trace under each policy, best (least recompile time) first.
+  public static func compare(_ trace: [CacheTraceEvent], policies: [CachePolicy]) -> [CacheSimulationResult] {
+    policies
+      .map { replay(trace, policy: $0) }
+      .sorted { $0.totalRecompileSeconds < $1.totalRecompileSeconds }
+  }
+
+  /// Loads a JSON array of `CacheTraceEvent` (as written by `save`).
+  public static func loadTrace(from url: URL) throws -> [CacheTraceEvent] {
+    try JSONDecoder().decode([CacheTraceEvent].self, from: Data(contentsOf: url))
+  }
+
+  public static func save(_ trace: [CacheTraceEvent], to url: URL) throws {
+    try JSONEncoder().encode(trace).write(to: url, options: .atomic)
+  }
+}
@@ -1,9 +1,41 @@
 import Foundation
 import x10Core
+import x10Diagnostics
+
+/// Snapshot of the startup warm-up queue.
+public struct WarmupProgress: Sendable, Equatable {
+  public var scheduled: Int
+  public var completed: Int
+  public var failed: Int
+  public var dropped: Int
+  public var pending: Int
+
+  public var isIdle: Bool { pending == 0 }
+}
 
 public actor CacheWarmer {
   public static let shared = CacheWarmer()
 
+  /// One queued warm-up compile; higher `priority` (observed count) runs
+  /// first, ties in arrival order.
+  private struct Job {
+    let priority: Double
+    let run: @Sendable () async -> Bool
+  }
+
+  private let capacity: Int
+  private var queue: [Job] = []   // sorted, highest priority first
+  private var draining = false
+  private var idleWaiters: [CheckedContinuation<Void, Never>] = []
+  private var progressState = WarmupProgress(scheduled: 0, completed: 0, failed: 0, dropped: 0, pending: 0)
+
+  /// `capacity` bounds the pending queue (X10_CACHE_PREWARM_QUEUE, default 64);
+  /// when full, the coldest job is dropped.
+  public init(capacity: Int? = nil) {
+    let env = ProcessInfo.processInfo.environment["X10_CACHE_PREWARM_QUEUE"].flatMap(Int.init)
+    self.capacity = max(1, capacity ?? env ?? 64)
+  }
+
   public func warm(
     module: StableHLOModule,
     backend: some Backend,
@@ -13,6 +45,8 @@ public actor CacheWarmer {
   ) async {
     let uniqueShapes = Array(Set(shapes))
     guard !uniqueShapes.isEmpty else { return }
+    let traceStart = Trace.begin()
+    defer { Trace.end("CacheWarmer.warm", since: traceStart, arg: UInt64(uniqueShapes.count)) }
     for shape in uniqueShapes {
       var options = CompileOptions(
         device: device,
@@ -24,4 +58,110 @@ public actor CacheWarmer {
       _ = try? await JIT.compileCached(module, with: backend, options: options)
     }
   }
+
+  // MARK: - Startup warm-up
+
+  /// Reads the persisted shape profile for `module` (see `ShapeProfiler.persist`)
+  /// and queues its `topK` hottest shapes for background compilation, hottest
+  /// first. Returns immediately with the number of jobs queued; poll
+  /// `progress()` or `waitUntilIdle()` to follow along. Jobs are compiled one
+  /// at a time so warm-up never competes with traffic for more than one core.
+  @discardableResult
+  public func prewarm<B: Backend>(
+    module: StableHLOModule,
+    backend: B,
+    options: CompileOptions = .init(),
+    topK: Int? = nil,
+    profileDirectory: URL? = nil
+  ) async -> Int {
+    var base = options
+    if base.device == nil { base.device = DeviceScope.current }
+    base.isWarmup = true
+    base.shapeHint = nil
+
+    let (_, irHash) = JIT.cacheKey(for: module, with: backend, options: base)
+    await ShapeProfiler.shared.restore(irHash: irHash, directory: profileDirectory)
+    let hottest = await ShapeProfiler.shared.topKWithCounts(
+      irHash: irHash,
+      policy: base.shapeBucketing,
+      k: topK ?? cacheWarmingTopK()
+    )
+
+    var queued = 0
+    for item in hottest {
+      var opts = base
+      opts.shapeHint = item.shape
+      let job = Job(priority: item.count) {
+        await Trace.span("CacheWarmer.prewarmJob") {
+          (try? await JIT.compileCached(module, with: backend, options: opts)) != nil
+        }
+      }
+      if enqueue(job) { queued += 1 }
+    }
+    startDrainingIfNeeded()
+    return queued
+  }
+
+  public func progress() -> WarmupProgress {
+    progressState
+  }
+
+  /// Suspends until every queued warm-up job has run.
+  public func waitUntilIdle() async {
+    guard draining || !queue.isEmpty else { return }
+    await withCheckedContinuation { idleWaiters.append($0) }
+  }
+
+  // MARK: - Queue
+
+  private func enqueue(_ job: Job) -> Bool {
+    if queue.count >= capacity {
+      guard let coldest = queue.last, coldest.priority < job.priority else {
+        noteDropped()
+        return false
+      }
+      queue.removeLast()
+      noteDropped()
+      progressState.pending -= 1
+      Diagnostics.warmupPending.sub(1)
+    }
+    let index = queue.firstIndex { $0.priority < job.priority } ?? queue.endIndex
+    queue.insert(job, at: index)
+    progressState.scheduled += 1
+    progressState.pending += 1
+    Diagnostics.warmupScheduled.inc()
+    Diagnostics.warmupPending.add(1)
+    return true
+  }
+
+  private func noteDropped() {
+    progressState.dropped += 1
+    Diagnostics.warmupDropped.inc()
+  }
+
+  private func startDrainingIfNeeded() {
+    guard !draining, !queue.isEmpty else { return }
+    draining = true
+    Task(priority: .utility) { await self.drain() }
+  }
+
+  private func drain() async {
+    while !queue.isEmpty {
+      let job = queue.removeFirst()
+      let ok = await job.run()
+      progressState.pending -= 1
+      Diagnostics.warmupPending.sub(1)
+      if ok {
+        progressState.completed += 1
+        Diagnostics.warmupCompleted.inc()
+      } else {
+        progressState.failed += 1
+        Diagnostics.warmupFailed.inc()
+      }
+    }
+    draining = false
+    let waiters = idleWaiters
+    idleWaiters.removeAll()
+    for waiter in waiters { waiter.resume() }
+  }
 }
@@ -0,0 +1,296 @@
+import Foundation
+import x10Core
+
+/// Per-entry bookkeeping handed to eviction strategies.
+public struct CacheEntryStats: Sendable, Equatable {
+  /// Cost charged against `CachePolicy.maxBytes` (VMFB bytes, or 1 when unknown).
+  public var size: Int
+  /// Measured backend compile latency for the entry.
+  public var compileSeconds: Double
+  /// Lookups served by the entry, counting the insert.
+  public var hits: Int
+
+  public init(size: Int, compileSeconds: Double = 0, hits: Int = 1) {
+    self.size = max(1, size)
+    self.compileSeconds = max(0, compileSeconds)
+    self.hits = max(1, hits)
+  }
+}
+
+/// Decides which entry `ExecutableCache` drops next.
+/// Strategies only track keys; the cache owns entries and budgets.
+public protocol EvictionStrategy {
+  mutating func didInsert(_ key: ShapeKey, stats: CacheEntryStats)
+  mutating func didAccess(_ key: ShapeKey, stats: CacheEntryStats)
+  mutating func didRemove(_ key: ShapeKey)
+  /// Pops the next victim (and stops tracking it); nil when nothing is tracked.
+  mutating func evict() -> ShapeKey?
+}
+
+/// Selects the eviction strategy used by a cache (see `CachePolicy.eviction`).
+public enum EvictionPolicy: Sendable, CustomStringConvertible {
+  /// Strict recency (the historical behavior).
+  case lru
+  /// GreedyDual-Size-Frequency: keeps entries that were slow to compile,
+  /// are hit often, and are small.
+  case gdsf
+  /// Caller-supplied strategy factory.
+  case custom(name: String, make: @Sendable () -> any EvictionStrategy)
+
+  public func makeStrategy() -> any EvictionStrategy {
+    switch self {
+    case .lru: return LRUEviction()
+    case .gdsf: return GDSFEviction()
+    case .custom(_, let make): return make()
+    }
+  }
+
+  /// Parses `X10_CACHE_EVICTION` values (`lru`, `gdsf`).
+  public init?(parse raw: String) {
+    switch raw.lowercased() {
+    case "lru": self = .lru
+    case "gdsf", "greedydual", "cost": self = .gdsf
+    default: return nil
+    }
+  }
+
+  public var description: String {
+    switch self {
+    case .lru: return "lru"
+    case .gdsf: return "gdsf"
+    case .custom(let name, _): return name
+    }
+  }
+}
+
+// MARK: - LRU
+
+/// Least-recently-used ordering kept as an intrusive doubly linked list.
+public struct LRUEviction: EvictionStrategy {
+  private struct Node {
+    var prev: ShapeKey?
+    var next: ShapeKey?
+  }
+
+  private var nodes: [ShapeKey: Node] = [:]
+  private var head: ShapeKey?
+  private var tail: ShapeKey?
+
+  public init() {}
+
+  public mutating func didInsert(_ key: ShapeKey, stats: CacheEntryStats) {
+    unlink(key)
+    pushFront(key)
+  }
+
+  public mutating func didAccess(_ key: ShapeKey, stats: CacheEntryStats) {
+    guard head != key, nodes[key] != nil else { return }
+    unlink(key)
+    pushFront(key)
+  }
+
+  public mutating func didRemove(_ key: ShapeKey) {
+    unlink(key)
+  }
+
+  public mutating func evict() -> ShapeKey? {
+    guard let victim = tail else { return nil }
+    unlink(victim)
+    return victim
+  }
+
+  private mutating func pushFront(_ key: ShapeKey) {
+    nodes[key] = Node(prev: nil, next: head)
+    if let headKey = head {
+      nodes[headKey]?.prev = key
+    }
+    head = key
+    if tail == nil {
+      tail = key
+    }
+  }
+
+  private mutating func unlink(_ key: ShapeKey) {
+    guard let node = nodes.removeValue(forKey: key) else { return }
+    if let prevKey = node.prev {
+      nodes[prevKey]?.next = node.next
+    } else {
+      head = node.next
+    }
+    if let nextKey = node.next {
+      nodes[nextKey]?.prev = node.prev
+    } else {
+      tail = node.prev
+    }
+  }
+}
+
+// MARK: - GreedyDual-Size-Frequency
+
+/// GDSF: priority = L + hits * compileSeconds / size, where L is the priority
+/// of the last victim ("inflation"), so long-idle entries eventually age out.
+/// Backed by a binary min-heap with lazy invalidation.
+public struct GDSFEviction: EvictionStrategy {
+  private struct HeapEntry {
+    let priority: Double
+    let seq: UInt64
+    let key: ShapeKey
+  }
+
+  /// Floor for compile latency so unmeasured entries still rank by hits/size.
+  public var minimumCompileSeconds: Double
+
+  private var inflation: Double = 0
+  private var nextSeq: UInt64 = 0
+  private var live: [ShapeKey: HeapEntry] = [:]
+  private var heap: [HeapEntry] = []
+
+  public init(minimumCompileSeconds: Double = 1e-3) {
+    self.minimumCompileSeconds = minimumCompileSeconds
+  }
+
+  /// Current inflation value `L` (exposed for tests and debugging).
+  public var currentInflation: Double { inflation }
+
+  public func priority(of key: ShapeKey) -> Double? { live[key]?.priority }
+
+  public mutating func didInsert(_ key: ShapeKey, stats: CacheEntryStats) {
+    push(key, stats: stats)
+  }
+
+  public mutating func didAccess(_ key: ShapeKey, stats: CacheEntryStats) {
+    guard live[key] != nil else { return }
+    push(key, stats: stats)
+  }
+
+  public mutating func didRemove(_ key: ShapeKey) {
+    live.removeValue(forKey: key)
+  }
+
+  public mutating func evict() -> ShapeKey? {
+    while let top = heap.first {
+      popMin()
+      guard let current = live[top.key], current.seq == top.seq else { continue }
+      live.removeValue(forKey: top.key)
+      inflation = top.priority
+      return top.key
+    }
+    return nil
+  }
+
+  private mutating func push(_ key: ShapeKey, stats: CacheEntryStats) {
+    let latency = max(stats.compileSeconds, minimumCompileSeconds)
+    let value = Double(stats.hits) * latency / Double(max(1, stats.size))
+    let entry = HeapEntry(priority: inflation + value, seq: nextSeq, key: key)
+    nextSeq &+= 1
+    live[key] = entry
+    heap.append(entry)
+    siftUp(heap.count - 1)
+    // Stale entries accumulate on every access; rebuild once they dominate.
+    if heap.count > 2 * live.count + 64 {
+      heap = Array(live.values)
+      for i in stride(from: heap.count / 2 - 1, through: 0, by: -1) { siftDown(i) }
+    }
+  }
+
+  @inline(__always)
+  private func less(_ a: HeapEntry, _ b: HeapEntry) -> Bool {
+    a.priority != b.priority ? a.priority < b.priority : a.seq < b.seq
+  }
+
+  private mutating func popMin() {
+    let last = heap.removeLast()
+    guard !heap.isEmpty else { return }
+    heap[0] = last
+    siftDown(0)
+  }
+
+  private mutating func siftUp(_ index: Int) {
+    var child = index
+    while child > 0 {
+      let parent = (child - 1) / 2
+      guard less(heap[child], heap[parent]) else { return }
+      heap.swapAt(child, parent)
+      child = parent
+    }
+  }
+
+  private mutating func siftDown(_ index: Int) {
+    var parent = index
+    while true {
+      let left = 2 * parent + 1
+      let right = left + 1
+      var smallest = parent
+      if left < heap.count && less(heap[left], heap[smallest]) { smallest = left }
+      if right < heap.count && less(heap[right], heap[smallest]) { smallest = right }
+      guard smallest != parent else { return }
+      heap.swapAt(parent, smallest)
+      parent = smallest
+    }
+  }
+}
+
+// MARK: - Shared bookkeeping
+
+/// Budget accounting + strategy driving shared by `ExecutableCache` and
+/// `CacheSimulator`, so offline replays evict exactly like the live cache.
+struct EvictionLedger {
+  private(set) var stats: [ShapeKey: CacheEntryStats] = [:]
+  private(set) var totalCost: Int = 0
+  private var strategy: any EvictionStrategy
+  let policy: CachePolicy
+
+  init(policy: CachePolicy) {
+    self.policy = policy
+    self.strategy = policy.eviction.makeStrategy()
+  }
+
+  var count: Int { stats.count }
+
+  /// Records a hit and returns the updated stats (nil if the key is unknown).
+  mutating func access(_ key: ShapeKey) -> CacheEntryStats? {
+    guard var entry = stats[key] else { return nil }
+    entry.hits += 1
+    stats[key] = entry
+    strategy.didAccess(key, stats: entry)
+    return entry
+  }
+
+  /// Inserts (or replaces) `key` and returns the keys evicted to get back
+  /// under budget. The key being inserted is never evicted by its own insert.
+  mutating func insert(_ key: ShapeKey, stats entry: CacheEntryStats) -> [ShapeKey] {
+    remove(key)
+    stats[key] = entry
+    totalCost += entry.size
+    strategy.didInsert(key, stats: entry)
+
+    var evicted: [ShapeKey] = []
+    var sparedSelf = false
+    while stats.count > policy.maxEntries || totalCost > policy.maxBytes {
+      guard let victim = strategy.evict() else { break }
+      if victim == key {
+        sparedSelf = true
+        continue
+      }
+      guard let removed = stats.removeValue(forKey: victim) else { continue }
+      totalCost -= removed.size
+      evicted.append(victim)
+    }
+    if sparedSelf {
+      strategy.didInsert(key, stats: entry)
+    }
+    return evicted
+  }
+
+  mutating func remove(_ key: ShapeKey) {
+    guard let removed = stats.removeValue(forKey: key) else { return }
+    totalCost -= removed.size
+    strategy.didRemove(key)
+  }
+
+  mutating func removeAll() {
+    stats.removeAll()
+    totalCost = 0
+    strategy = policy.eviction.makeStrategy()
+  }
+}
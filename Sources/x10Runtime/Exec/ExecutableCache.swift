@@ -4,10 +4,12 @@ import x10Core
 public struct CachePolicy: Sendable {
   public var maxEntries: Int
   public var maxBytes: Int
+  public var eviction: EvictionPolicy
 
-  public init(maxEntries: Int, maxBytes: Int) {
+  public init(maxEntries: Int, maxBytes: Int, eviction: EvictionPolicy = .lru) {
     self.maxEntries = max(1, maxEntries)
     self.maxBytes = max(1, maxBytes)
+    self.eviction = eviction
   }
 
   public static func fromEnvironment(_ env: [String: String]) -> CachePolicy {
@@ -19,21 +21,24 @@ public struct CachePolicy: Sendable {
 
     let rawBytes = env["X10_CACHE_MAX_BYTES"].flatMap(Int.init)
     let bytes = (rawBytes ?? defaultBytes).clamped(min: 1)
-    return CachePolicy(maxEntries: entries, maxBytes: bytes)
+
+    let eviction = env["X10_CACHE_EVICTION"].flatMap(EvictionPolicy.init(parse:)) ?? .lru
+    return CachePolicy(maxEntries: entries, maxBytes: bytes, eviction: eviction)
   }
 }
 
 public struct ExecRecord: Sendable {
   public let exec: Executable
   public let cost: Int
-  public var prev: ShapeKey?
-  public var next: ShapeKey?
+  public let compileSeconds: Double
+  /// Compiled by a cache warmer rather than on demand.
+  public let warmed: Bool
 
-  public init(exec: Executable, cost: Int, prev: ShapeKey? = nil, next: ShapeKey? = nil) {
+  public init(exec: Executable, cost: Int, compileSeconds: Double = 0, warmed: Bool = false) {
     self.exec = exec
     self.cost = cost
-    self.prev = prev
-    self.next = next
+    self.compileSeconds = compileSeconds
+    self.warmed = warmed
   }
 }
 
@@ -43,14 +48,14 @@ public actor ExecutableCache {
   public static let shared = ExecutableCache()
 
   private var table: [ShapeKey: ExecRecord] = [:]
-  private var head: ShapeKey?
-  private var tail: ShapeKey?
-  private var totalCost: Int = 0
+  private var ledger: EvictionLedger
   private let policy: CachePolicy
   private var costResolvers: [CostResolver] = []
+  private var trace: [CacheTraceEvent]?
 
   public init(policy: CachePolicy = CachePolicy.fromEnvironment(ProcessInfo.processInfo.environment)) {
     self.policy = policy
+    self.ledger = EvictionLedger(policy: policy)
   }
 
   // MARK: - Cost resolvers
@@ -66,104 +71,71 @@ public actor ExecutableCache {
   // MARK: - Public API
 
   public func get(_ key: ShapeKey) -> Executable? {
-    guard let record = table[key] else { return nil }
-    moveToHead(key, record: record)
-    return record.exec
+    record(for: key)?.exec
   }
 
-  public func put(_ exec: Executable, for key: ShapeKey) {
-    let cost = estimateCost(for: exec)
+  /// Like `get`, but returns the whole record (e.g. to tell warmed hits apart).
+  public func record(for key: ShapeKey) -> ExecRecord? {
+    guard let record = table[key], let stats = ledger.access(key) else { return nil }
+    trace?.append(CacheTraceEvent(key: key, compileSeconds: record.compileSeconds, size: stats.size))
+    return record
+  }
 
-    if let existing = table[key] {
-      removeNode(key, record: existing, subtractCost: true)
+  /// Inserts `exec`; `compileSeconds` is the measured compile latency that
+  /// cost-aware eviction policies weigh against hit frequency and size.
+  public func put(_ exec: Executable, for key: ShapeKey, compileSeconds: Double = 0, warmed: Bool = false) {
+    let cost = estimateCost(for: exec)
+    let record = ExecRecord(exec: exec, cost: cost, compileSeconds: compileSeconds, warmed: warmed)
+    var released: [Executable] = []
+    if let replaced = table.updateValue(record, forKey: key), replaced.exec != exec {
+      released.append(replaced.exec)
     }
+    trace?.append(CacheTraceEvent(key: key, compileSeconds: compileSeconds, size: cost))
 
-    let record = ExecRecord(exec: exec, cost: cost)
-    insertAtHead(key, record: record)
-    totalCost += cost
-    enforcePolicy()
+    let evicted = ledger.insert(key, stats: CacheEntryStats(size: cost, compileSeconds: compileSeconds))
+    for victim in evicted {
+      if let removed = table.removeValue(forKey: victim) {
+        released.append(removed.exec)
+      }
+    }
+    ExecutableLifecycle.release(released)
   }
 
+  /// Drops every entry and releases the backend artifacts behind them.
   public func clear() {
+    let released = table.values.map(\.exec)
     table.removeAll()
-    head = nil
-    tail = nil
-    totalCost = 0
+    ledger.removeAll()
+    ExecutableLifecycle.release(released)
   }
 
-  // MARK: - Internal helpers
-
-  private func estimateCost(for exec: Executable) -> Int {
-    for resolver in costResolvers.reversed() {
-      if let value = resolver(exec), value > 0 {
-        return value
-      }
-    }
-    return 1
+  /// Current number of entries and total cost charged against `maxBytes`.
+  public func usage() -> (entries: Int, cost: Int) {
+    (table.count, ledger.totalCost)
   }
 
-  private func moveToHead(_ key: ShapeKey, record: ExecRecord) {
-    guard head != key else { return }
-    removeNode(key, record: record, subtractCost: false)
-    insertAtHead(key, record: record)
-  }
-
-  private func insertAtHead(_ key: ShapeKey, record: ExecRecord) {
-    var mutable = record
-    mutable.prev = nil
-    mutable.next = head
-    table[key] = mutable
-
-    if let headKey = head {
-      updatePrev(of: headKey, to: key)
-    }
+  // MARK: - Trace capture (feed into `CacheSimulator`)
 
-    head = key
-    if tail == nil {
-      tail = key
-    }
-  }
-
-  private func removeNode(_ key: ShapeKey, record: ExecRecord, subtractCost: Bool) {
-    let prev = record.prev
-    let next = record.next
-
-    if let prevKey = prev {
-      updateNext(of: prevKey, to: next)
-    } else {
-      head = next
-    }
-
-    if let nextKey = next {
-      updatePrev(of: nextKey, to: prev)
-    } else {
-      tail = prev
-    }
-
-    if subtractCost {
-      totalCost -= record.cost
-    }
-
-    table.removeValue(forKey: key)
+  /// Starts recording every hit and insert as a `CacheTraceEvent`.
+  public func startRecordingTrace() {
+    trace = []
   }
 
-  private func updatePrev(of key: ShapeKey, to value: ShapeKey?) {
-    guard var record = table[key] else { return }
-    record.prev = value
-    table[key] = record
+  /// Stops recording and returns the captured trace.
+  public func stopRecordingTrace() -> [CacheTraceEvent] {
+    defer { trace = nil }
+    return trace ?? []
   }
 
-  private func updateNext(of key: ShapeKey, to value: ShapeKey?) {
-    guard var record = table[key] else { return }
-    record.next = value
-    table[key] = record
-  }
+  // MARK: - Internal helpers
 
-  private func enforcePolicy() {
-    while table.count > policy.maxEntries || totalCost > policy.maxBytes {
-      guard let tailKey = tail, let record = table[tailKey] else { break }
-      removeNode(tailKey, record: record, subtractCost: true)
+  private func estimateCost(for exec: Executable) -> Int {
+    for resolver in costResolvers.reversed() {
+      if let value = resolver(exec), value > 0 {
+        return value
+      }
     }
+    return 1
   }
 }
 
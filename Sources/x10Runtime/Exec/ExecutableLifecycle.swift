@@ -0,0 +1,52 @@
+import Foundation
+import x10Core
+
+/// Process-wide hook from cache eviction into backends. When an `Executable`
+/// leaves an `ExecutableCache` (eviction, replacement or `clear()`) and no
+/// caller still holds it, every registered handler is told so it can free
+/// VMFBs, runtime sessions or native handles. Backends are expected to defer
+/// the actual free while the executable is still running.
+public enum ExecutableLifecycle {
+  public typealias ReleaseHandler = @Sendable (Executable) -> Void
+
+  /// Returned by `registerReleaseHandler`; `unregister()` removes the handler.
+  public struct Registration: Sendable {
+    fileprivate let id: Int
+    public func unregister() { ExecutableLifecycle.unregister(id) }
+  }
+
+  private static let lock = NSLock()
+  private static var handlers: [(id: Int, handler: ReleaseHandler)] = []
+  private static var nextID = 0
+
+  /// Registers a handler; handlers run synchronously on the thread that
+  /// drops the last reference to a released executable.
+  @discardableResult
+  public static func registerReleaseHandler(_ handler: @escaping ReleaseHandler) -> Registration {
+    lock.lock(); defer { lock.unlock() }
+    nextID += 1
+    handlers.append((nextID, handler))
+    return Registration(id: nextID)
+  }
+
+  private static func unregister(_ id: Int) {
+    lock.lock(); defer { lock.unlock() }
+    handlers.removeAll { $0.id == id }
+  }
+
+  /// Notifies all handlers that `execs` are no longer reachable from a cache,
+  /// once the last `Executable` value with each id is gone. A caller that
+  /// still holds an evicted executable can keep running it.
+  public static func release(_ execs: [Executable]) {
+    for id in Set(execs.map(\.id)) {
+      ExecutableHandles.whenUnreferenced(id) {
+        lock.lock()
+        let current = handlers.map(\.handler)
+        lock.unlock()
+        // The handles are gone; handlers only need the id.
+        let exec = Executable(id: id)
+        for handler in current { handler(exec) }
+      }
+    }
+  }
+}
@@ -0,0 +1,221 @@
+import Foundation
+import x10Core
+import x10Diagnostics
+
+/// Knobs for `LatencyRouter`.
+public struct LatencyRouterConfig: Sendable, Equatable {
+  /// Timed runs per candidate before a key is decided. Each candidate's
+  /// first run of a key in a process is a warm-up and does not count.
+  public var explorationRuns: Int
+  /// Calls routed to the winner after which the key is explored again
+  /// (0 = never re-evaluate).
+  public var reevaluateEvery: Int
+
+  public init(explorationRuns: Int = 3, reevaluateEvery: Int = 1000) {
+    self.explorationRuns = max(1, explorationRuns)
+    self.reevaluateEvery = max(0, reevaluateEvery)
+  }
+
+  /// X10_ROUTE_EXPLORE_RUNS (default 3) and X10_ROUTE_REEVALUATE (default 1000).
+  public static func fromEnvironment(_ env: [String: String] = ProcessInfo.processInfo.environment) -> LatencyRouterConfig {
+    LatencyRouterConfig(explorationRuns: env["X10_ROUTE_EXPLORE_RUNS"].flatMap(Int.init) ?? 3,
+                        reevaluateEvery: env["X10_ROUTE_REEVALUATE"].flatMap(Int.init) ?? 1000)
+  }
+}
+
+/// What a `LatencyRouter` knows about one key; persisted and exposed for debugging.
+public struct LatencyRoute: Sendable, Codable, Equatable {
+  public var key: String
+  /// Candidate calls are routed to, or nil until the first exploration ends.
+  public var winner: String?
+  /// Per candidate, median latency (ns) measured by the last exploration.
+  public var explored: [String: UInt64]
+  /// Per candidate, exponentially weighted latency (ns) of all timed calls.
+  public var recent: [String: Double]
+  /// Calls routed to `winner` since it was chosen.
+  public var routedCalls: Int
+  /// Explorations completed for this key.
+  public var decisions: Int
+
+  public init(key: String, winner: String? = nil, explored: [String: UInt64] = [:],
+              recent: [String: Double] = [:], routedCalls: Int = 0, decisions: Int = 0) {
+    self.key = key
+    self.winner = winner
+    self.explored = explored
+    self.recent = recent
+    self.routedCalls = routedCalls
+    self.decisions = decisions
+  }
+}
+
+/// Per-key choice between interchangeable candidates (backends) by measured
+/// latency.
+///
+/// A key is first *explored*: calls go to the candidate with the fewest timed
+/// runs until each has `explorationRuns`, and the one with the lowest median
+/// becomes the winner. Calls are then routed to the winner; after
+/// `reevaluateEvery` of them the key is explored again, so a candidate that
+/// got faster (or a winner that got slower) is noticed. Decisions are written
+/// to `storeURL` and reloaded on start, so a new process skips straight to
+/// routing. A candidate that fails a call (`recordFailure`) is left out of
+/// that key for the rest of the process.
+public final class LatencyRouter: @unchecked Sendable {
+  public let config: LatencyRouterConfig
+  public let storeURL: URL?
+
+  private struct File: Codable {
+    var version: Int
+    var routes: [LatencyRoute]
+  }
+
+  /// Weight of a new sample in `LatencyRoute.recent`.
+  static let smoothing = 0.2
+
+  private let lock = NSLock()
+  private var table: [String: LatencyRoute] = [:]
+  /// Keys being explored -> candidate -> timed runs so far.
+  private var exploring: [String: [String: [UInt64]]] = [:]
+  /// "key|candidate" pairs that have had their warm-up run in this process.
+  private var warmed: Set<String> = []
+  /// Key -> candidates that failed a call for it in this process.
+  private var failed: [String: Set<String>] = [:]
+
+  /// `storeURL` nil keeps decisions in memory only.
+  public init(config: LatencyRouterConfig = .fromEnvironment(), storeURL: URL? = LatencyRouter.defaultStoreURL()) {
+    self.config = config
+    self.storeURL = storeURL
+    if let url = storeURL, let data = try? Data(contentsOf: url),
+       let file = try? JSONDecoder().decode(File.self, from: data) {
+      for route in file.routes { table[route.key] = route }
+    }
+  }
+
+  /// `X10_ROUTE_FILE`, else `<IR cache dir>/routes.json`.
+  public static func defaultStoreURL() -> URL {
+    if let override = ProcessInfo.processInfo.environment["X10_ROUTE_FILE"], !override.isEmpty {
+      return URL(fileURLWithPath: override)
+    }
+    return IRStore.baseDir().appendingPathComponent("routes.json")
+  }
+
+  /// Candidate the next call for `key` should run on.
+  public func choose(_ key: String, among candidates: [String]) -> String {
+    precondition(!candidates.isEmpty, "LatencyRouter.choose: no candidates")
+    lock.lock()
+    defer { lock.unlock() }
+    let candidates = usableLocked(key, candidates)
+    guard candidates.count > 1 else { return candidates[0] }
+    if let winner = table[key]?.winner, candidates.contains(winner), exploring[key] == nil {
+      return winner
+    }
+    let runs = exploring[key] ?? [:]
+    return candidates.min { (runs[$0]?.count ?? 0) < (runs[$1]?.count ?? 0) }!
+  }
+
+  /// Records that a call for `key` took `nanos` on `candidate`.
+  public func record(_ key: String, candidate: String, nanos: UInt64, among candidates: [String]) {
+    lock.lock()
+    defer { lock.unlock() }
+    let candidates = usableLocked(key, candidates)
+    var route = table[key] ?? LatencyRoute(key: key)
+    defer { table[key] = route }
+    // One usable candidate left (the others failed): nothing to explore.
+    if candidates == [candidate], route.winner != candidate {
+      exploring[key] = nil
+      route.winner = candidate
+      route.routedCalls = 0
+      table[key] = route
+      persistLocked()
+    }
+    // The first run pays for lazy loading and first-touch allocation.
+    guard !warmed.insert("\(key)|\(candidate)").inserted else { return }
+    let sample = Double(nanos)
+    route.recent[candidate] = route.recent[candidate].map { $0 + Self.smoothing * (sample - $0) } ?? sample
+
+    let decided = route.winner.map(candidates.contains) ?? false
+    guard candidates.count > 1, exploring[key] != nil || !decided else {
+      guard candidate == route.winner else { return }
+      route.routedCalls += 1
+      if config.reevaluateEvery > 0 && route.routedCalls >= config.reevaluateEvery {
+        exploring[key] = [:]
+      }
+      return
+    }
+
+    var runs = exploring[key] ?? [:]
+    runs[candidate, default: []].append(nanos)
+    guard candidates.allSatisfy({ (runs[$0]?.count ?? 0) >= config.explorationRuns }) else {
+      exploring[key] = runs
+      return
+    }
+    exploring[key] = nil
+    route.explored = runs.filter { candidates.contains($0.key) }.mapValues(Self.median)
+    route.winner = route.explored.min { ($0.value, $0.key) < ($1.value, $1.key) }?.key
+    route.routedCalls = 0
+    route.decisions += 1
+    Diagnostics.routeDecisions.inc()
+    table[key] = route
+    persistLocked()
+  }
+
+  /// Records that a call for `key` failed on `candidate`. It is skipped for
+  /// `key` from now on (unless every candidate has failed); a failed winner
+  /// is dropped and the remaining candidates are explored again.
+  public func recordFailure(_ key: String, candidate: String) {
+    lock.lock()
+    defer { lock.unlock() }
+    failed[key, default: []].insert(candidate)
+    exploring[key]?[candidate] = nil
+    if var route = table[key], route.winner == candidate {
+      route.winner = nil
+      table[key] = route
+      exploring[key] = exploring[key] ?? [:]
+    }
+  }
+
+  /// Every known key, sorted by key.
+  public func routes() -> [LatencyRoute] {
+    lock.lock()
+    defer { lock.unlock() }
+    return table.values.sorted { $0.key < $1.key }
+  }
+
+  public func route(for key: String) -> LatencyRoute? {
+    lock.lock()
+    defer { lock.unlock() }
+    return table[key]
+  }
+
+  /// Forgets every decision (in memory and on disk).
+  public func reset() {
+    lock.lock()
+    defer { lock.unlock() }
+    table.removeAll()
+    exploring.removeAll()
+    warmed.removeAll()
+    failed.removeAll()
+    persistLocked()
+  }
+
+  /// `candidates` minus those that failed for `key`, or all of them if none is left.
+  private func usableLocked(_ key: String, _ candidates: [String]) -> [String] {
+    guard let bad = failed[key], !bad.isEmpty else { return candidates }
+    let live = candidates.filter { !bad.contains($0) }
+    return live.isEmpty ? candidates : live
+  }
+
+  private func persistLocked() {
+    guard let url = storeURL else { return }
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = [.sortedKeys]
+    let file = File(version: 1, routes: table.values.sorted { $0.key < $1.key })
+    guard let data = try? encoder.encode(file) else { return }
+    try? FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+    try? data.write(to: url, options: .atomic)
+  }
+
+  private static func median(_ xs: [UInt64]) -> UInt64 {
+    let s = xs.sorted()
+    return s.count % 2 == 1 ? s[s.count / 2] : s[s.count / 2 - 1] / 2 + s[s.count / 2] / 2
+  }
+}
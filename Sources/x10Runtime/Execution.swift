@@ -17,7 +17,8 @@ extension x10Core.Tensor {
     return self // stub: real path will await device work
   }
 
-  /// Async host read; returns host bytes. Keeps the API non-blocking by default.
+  /// Async host read; returns a copy of the tensor's bytes (row-major).
+  /// `withUnsafeBytes` reads them without copying.
   public func materializeHost(
     file: StaticString = #fileID, line: UInt = #line
   ) async throws -> Data {
@@ -28,6 +29,6 @@ extension x10Core.Tensor {
       throw BarrierViolationError(site: (file, line), opHint: "materializeHost", backtrace: bt)
     }
     Diagnostics.forcedEvaluations.inc()
-    return Data() // stub: wire to backend.fromDevice(_) later
+    return withUnsafeBytes { Data($0) }
   }
 }
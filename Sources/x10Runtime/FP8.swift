@@ -0,0 +1,73 @@
+import Foundation
+import x10Core
+import x10KernelsC
+
+/// Bulk f32 <-> FP8 (f8E4M3FN / f8E5M2) conversion on the host with a
+/// per-tensor scale: `fp8 = round(f32 / scale)`, `f32 = fp8 * scale`.
+/// Quantizing rounds to nearest even and saturates to the largest finite
+/// value; NaN stays NaN. Vectorized for the running CPU like `HalfPrecision`.
+public enum FP8 {
+  public static func isFP8(_ dtype: DType) -> Bool { dtype == .f8E4M3FN || dtype == .f8E5M2 }
+
+  /// Largest finite value of `dtype` (448 or 57344).
+  public static func maxFinite(_ dtype: DType) -> Float {
+    precondition(isFP8(dtype), "maxFinite: \(dtype) is not an FP8 type")
+    return Float(dtype == .f8E4M3FN ? X10_FP8_E4M3FN_MAX : X10_FP8_E5M2_MAX)
+  }
+
+  /// Scale mapping the largest finite |value| onto `maxFinite(dtype)`; 1 when
+  /// the values are all zero, NaN, or include an infinity.
+  public static func scale(for values: UnsafeBufferPointer<Float>, as dtype: DType) -> Float {
+    guard let base = values.baseAddress else { return 1 }
+    let absmax = x10_f32_absmax(base, values.count)
+    guard absmax > 0, absmax.isFinite else { return 1 }
+    return absmax / maxFinite(dtype)
+  }
+
+  /// `count` floats from `src` divided by `scale` and quantized into `dst`.
+  public static func quantize(_ src: UnsafePointer<Float>, into dst: UnsafeMutablePointer<UInt8>,
+                              count: Int, as dtype: DType, scale: Float = 1) {
+    x10_f32_to_fp8(format(dtype), src, dst, count, scale)
+  }
+
+  /// `count` `dtype` values from `src` decoded and multiplied by `scale` into `dst`.
+  public static func dequantize(_ src: UnsafePointer<UInt8>, into dst: UnsafeMutablePointer<Float>,
+                                count: Int, from dtype: DType, scale: Float = 1) {
+    x10_fp8_to_f32(format(dtype), src, dst, count, scale)
+  }
+
+  /// Raw f32 bytes quantized to `dtype` (a quarter of the size) with `scale`,
+  /// or the per-tensor `scale(for:as:)` when nil. Returns the scale used.
+  public static func quantize(_ f32: UnsafeRawBufferPointer, to dtype: DType,
+                              scale: Float? = nil) -> (data: Data, scale: Float) {
+    let values = f32.bindMemory(to: Float.self)
+    let s = scale ?? self.scale(for: values, as: dtype)
+    var out = Data(count: values.count)
+    guard let src = values.baseAddress else { return (out, s) }
+    out.withUnsafeMutableBytes { dst in
+      quantize(src, into: dst.baseAddress!.assumingMemoryBound(to: UInt8.self),
+               count: values.count, as: dtype, scale: s)
+    }
+    return (out, s)
+  }
+
+  public static func quantize(_ values: [Float], to dtype: DType, scale: Float? = nil) -> (data: Data, scale: Float) {
+    values.withUnsafeBytes { quantize($0, to: dtype, scale: scale) }
+  }
+
+  /// Raw `dtype` bytes decoded to f32 values, multiplied by `scale`.
+  public static func dequantize(_ fp8: UnsafeRawBufferPointer, from dtype: DType, scale: Float = 1) -> [Float] {
+    let count = fp8.count
+    guard count > 0 else { return [] }
+    return [Float](unsafeUninitializedCapacity: count) { out, initialized in
+      dequantize(fp8.baseAddress!.assumingMemoryBound(to: UInt8.self), into: out.baseAddress!,
+                 count: count, from: dtype, scale: scale)
+      initialized = count
+    }
+  }
+
+  private static func format(_ dtype: DType) -> x10_fp8_format {
+    precondition(isFP8(dtype), "FP8: \(dtype) is not an FP8 type")
+    return dtype == .f8E4M3FN ? X10_FP8_E4M3FN : X10_FP8_E5M2
+  }
+}
@@ -0,0 +1,53 @@
+import Foundation
+import x10Core
+import x10KernelsC
+
+/// Bulk f32 <-> f16/bf16 conversion on the host. Narrowing rounds to nearest
+/// even; the kernels are vectorized for the running CPU (`isa`).
+public enum HalfPrecision {
+  /// Instruction set the kernels selected: "avx512", "avx2", "neon" or "scalar".
+  public static var isa: String { String(cString: x10_half_isa()) }
+
+  public static func isHalf(_ dtype: DType) -> Bool { dtype == .f16 || dtype == .bf16 }
+
+  /// `count` floats from `src` narrowed into `dst` as `dtype` (.f16 or .bf16).
+  public static func narrow(_ src: UnsafePointer<Float>, into dst: UnsafeMutablePointer<UInt16>,
+                            count: Int, as dtype: DType) {
+    precondition(isHalf(dtype), "narrow: \(dtype) is not a half type")
+    if dtype == .f16 { x10_f32_to_f16(src, dst, count) } else { x10_f32_to_bf16(src, dst, count) }
+  }
+
+  /// `count` `dtype` (.f16 or .bf16) values from `src` widened into `dst`.
+  public static func widen(_ src: UnsafePointer<UInt16>, into dst: UnsafeMutablePointer<Float>,
+                           count: Int, from dtype: DType) {
+    precondition(isHalf(dtype), "widen: \(dtype) is not a half type")
+    if dtype == .f16 { x10_f16_to_f32(src, dst, count) } else { x10_bf16_to_f32(src, dst, count) }
+  }
+
+  /// Raw f32 bytes narrowed to `dtype`; the result is half the size.
+  public static func narrow(_ f32: UnsafeRawBufferPointer, to dtype: DType) -> Data {
+    let count = f32.count / MemoryLayout<Float>.stride
+    var out = Data(count: count * 2)
+    guard count > 0 else { return out }
+    out.withUnsafeMutableBytes { dst in
+      narrow(f32.baseAddress!.assumingMemoryBound(to: Float.self),
+             into: dst.baseAddress!.assumingMemoryBound(to: UInt16.self), count: count, as: dtype)
+    }
+    return out
+  }
+
+  public static func narrow(_ values: [Float], to dtype: DType) -> Data {
+    values.withUnsafeBytes { narrow($0, to: dtype) }
+  }
+
+  /// Raw `dtype` (.f16 or .bf16) bytes widened to f32 values.
+  public static func widen(_ half: UnsafeRawBufferPointer, from dtype: DType) -> [Float] {
+    let count = half.count / 2
+    guard count > 0 else { return [] }
+    return [Float](unsafeUninitializedCapacity: count) { out, initialized in
+      widen(half.baseAddress!.assumingMemoryBound(to: UInt16.self), into: out.baseAddress!,
+            count: count, from: dtype)
+      initialized = count
+    }
+  }
+}
@@ -1 +1,218 @@
-public enum Memory {}
+import Foundation
+import x10Diagnostics
+
+/// Per-device caching allocator behind backend buffers.
+///
+/// Requests are rounded up to a size class (quarter steps between powers of
+/// two, so at most 25% slack) and served from that class's free list when
+/// possible. Blocks are 64-byte aligned. Handing a block out as `Data` ties
+/// its lifetime to the last `Data` copy: when that goes away the block goes
+/// back to the pool instead of to the system allocator.
+///
+/// Cached (idle) bytes per pool are capped by X10_MEMORY_POOL_MAX_CACHED
+/// (default 256 MiB); blocks returned past the cap are freed, and `trim`
+/// releases idle blocks on demand. X10_MEMORY_POOL=0 disables caching.
+public enum Memory {
+  public static let alignment = 64
+
+  private static let lock = NSLock()
+  private static var pools: [String: MemoryPool] = [:]
+
+  /// Pool for `deviceKey` (e.g. "iree:0", "pjrt:1"), created on first use.
+  public static func pool(for deviceKey: String) -> MemoryPool {
+    lock.lock(); defer { lock.unlock() }
+    if let pool = pools[deviceKey] { return pool }
+    let pool = MemoryPool(deviceKey: deviceKey)
+    pools[deviceKey] = pool
+    return pool
+  }
+
+  /// Live/cached/peak bytes for every pool, keyed by device.
+  public static func stats() -> [String: MemoryPoolStats] {
+    lock.lock()
+    let all = pools
+    lock.unlock()
+    return all.mapValues { $0.stats }
+  }
+
+  /// Releases idle blocks in every pool down to `bytes` cached each.
+  public static func trimAll(toCachedBytes bytes: Int = 0) {
+    lock.lock()
+    let all = Array(pools.values)
+    lock.unlock()
+    for pool in all { pool.trim(toCachedBytes: bytes) }
+  }
+}
+
+public struct MemoryPoolStats: Sendable, Equatable {
+  /// Bytes in blocks currently handed out (size-class rounded).
+  public var liveBytes: Int
+  /// Bytes in idle blocks kept for reuse.
+  public var cachedBytes: Int
+  /// High-water mark of `liveBytes`.
+  public var peakLiveBytes: Int
+  public var hits: Int
+  public var misses: Int
+}
+
+public final class MemoryPool: @unchecked Sendable {
+  public let deviceKey: String
+  /// Idle-byte cap; returns beyond it are freed.
+  public var maxCachedBytes: Int {
+    get { lock.lock(); defer { lock.unlock() }; return _maxCachedBytes }
+    set { lock.lock(); _maxCachedBytes = max(0, newValue); lock.unlock(); trim(toCachedBytes: newValue) }
+  }
+
+  /// Requests above this bypass the free lists (still counted as live).
+  static let maxPooledBlock = 1 << 30
+
+  private let lock = NSLock()
+  private var freeLists: [Int: [UnsafeMutableRawPointer]] = [:]
+  private var _maxCachedBytes: Int
+  private let cachingEnabled: Bool
+  private var live = 0
+  private var cached = 0
+  private var peak = 0
+  private var hits = 0
+  private var misses = 0
+
+  init(deviceKey: String, environment env: [String: String] = ProcessInfo.processInfo.environment) {
+    self.deviceKey = deviceKey
+    self._maxCachedBytes = max(0, env["X10_MEMORY_POOL_MAX_CACHED"].flatMap(Int.init) ?? 256 << 20)
+    self.cachingEnabled = env["X10_MEMORY_POOL"] != "0"
+  }
+
+  deinit {
+    for (_, blocks) in freeLists { blocks.forEach { $0.deallocate() } }
+  }
+
+  public var stats: MemoryPoolStats {
+    lock.lock(); defer { lock.unlock() }
+    return MemoryPoolStats(liveBytes: live, cachedBytes: cached, peakLiveBytes: peak, hits: hits, misses: misses)
+  }
+
+  // MARK: - Data-backed blocks
+
+  /// `byteCount` bytes of pooled memory exposed as `Data`; the block returns
+  /// to the pool when the last copy of the `Data` is released.
+  public func makeData(byteCount: Int, zeroed: Bool = true) -> Data {
+    guard byteCount > 0 else { return Data() }
+    let (ptr, size) = take(byteCount)
+    if zeroed { ptr.initializeMemory(as: UInt8.self, repeating: 0, count: byteCount) }
+    return wrap(ptr, size: size, count: byteCount)
+  }
+
+  /// Pooled copy of `bytes`.
+  public func makeData(copying bytes: UnsafeRawBufferPointer) -> Data {
+    guard let base = bytes.baseAddress, bytes.count > 0 else { return Data() }
+    let (ptr, size) = take(bytes.count)
+    ptr.copyMemory(from: base, byteCount: bytes.count)
+    return wrap(ptr, size: size, count: bytes.count)
+  }
+
+  public func makeData(copying data: Data) -> Data {
+    data.withUnsafeBytes { makeData(copying: $0) }
+  }
+
+  /// Raw pooled block for code that needs a stable address while it fills
+  /// the bytes in; hand it out with `makeData(adopting:count:)` or give it
+  /// back with `release(_:)`.
+  public struct Block: @unchecked Sendable {
+    public let base: UnsafeMutableRawPointer
+    let size: Int
+  }
+
+  public func allocateBlock(byteCount: Int) -> Block {
+    let (ptr, size) = take(max(1, byteCount))
+    return Block(base: ptr, size: size)
+  }
+
+  /// Wraps the first `count` bytes of `block` as `Data`; the block returns to
+  /// the pool with the last copy.
+  public func makeData(adopting block: Block, count: Int) -> Data {
+    guard count > 0 else {
+      release(block)
+      return Data()
+    }
+    return wrap(block.base, size: block.size, count: count)
+  }
+
+  public func release(_ block: Block) {
+    give(block.base, size: block.size)
+  }
+
+  /// Frees idle blocks, largest classes first, until at most `bytes` are cached.
+  public func trim(toCachedBytes bytes: Int = 0) {
+    var victims: [UnsafeMutableRawPointer] = []
+    lock.lock()
+    for size in freeLists.keys.sorted(by: >) where cached > bytes {
+      while cached > bytes, let block = freeLists[size]?.popLast() {
+        victims.append(block)
+        cached -= size
+      }
+    }
+    publish()
+    lock.unlock()
+    victims.forEach { $0.deallocate() }
+  }
+
+  // MARK: - Size classes
+
+  /// Rounds `n` up to a multiple of 64 on a quarter-power-of-two grid.
+  static func sizeClass(_ n: Int) -> Int {
+    let a = Memory.alignment
+    guard n > a else { return a }
+    let msb = Int.bitWidth - 1 - (n - 1).leadingZeroBitCount  // 2^msb < n <= 2^(msb+1)
+    let step = max(a, (1 << msb) / 4)
+    return (n + step - 1) / step * step
+  }
+
+  // MARK: - Private
+
+  private func take(_ byteCount: Int) -> (UnsafeMutableRawPointer, Int) {
+    let size = Self.sizeClass(byteCount)
+    lock.lock()
+    let reused = freeLists[size]?.popLast()
+    if reused != nil {
+      cached -= size
+      hits += 1
+    } else {
+      misses += 1
+    }
+    live += size
+    peak = max(peak, live)
+    publish()
+    lock.unlock()
+    let ptr = reused ?? UnsafeMutableRawPointer.allocate(byteCount: size, alignment: Memory.alignment)
+    return (ptr, size)
+  }
+
+  private func give(_ ptr: UnsafeMutableRawPointer, size: Int) {
+    lock.lock()
+    live -= size
+    let keep = cachingEnabled && size <= Self.maxPooledBlock && cached + size <= _maxCachedBytes
+    if keep {
+      freeLists[size, default: []].append(ptr)
+      cached += size
+    }
+    publish()
+    lock.unlock()
+    if !keep { ptr.deallocate() }
+  }
+
+  private func wrap(_ ptr: UnsafeMutableRawPointer, size: Int, count: Int) -> Data {
+    Data(bytesNoCopy: ptr, count: count, deallocator: .custom { [self] p, _ in
+      give(p, size: size)
+    })
+  }
+
+  // Caller holds `lock`. Gauges are shared by all pools, so publish deltas.
+  private var publishedLive = 0
+  private var publishedCached = 0
+  private func publish() {
+    Diagnostics.poolLiveBytes.add(Int64(live - publishedLive))
+    Diagnostics.poolCachedBytes.add(Int64(cached - publishedCached))
+    publishedLive = live
+    publishedCached = cached
+  }
+}
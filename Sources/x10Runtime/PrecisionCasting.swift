@@ -0,0 +1,85 @@
+import Foundation
+import x10Core
+
+extension PrecisionPolicy {
+  /// Element type f32 inputs are narrowed to on upload, or nil when
+  /// `castInputs` is off or `activations` is fp32. Throws for fp8: the
+  /// program's `stablehlo.convert` carries no scale, and unscaled E4M3FN
+  /// saturates above ±448 and flushes below 2⁻⁹.
+  public var inputCastType: DType? {
+    get throws {
+      guard castInputs else { return nil }
+      switch activations {
+      case .bf16: return .bf16
+      case .f16: return .f16
+      case .fp8: throw PrecisionCastingError.unscaledFP8
+      case .fp32: return nil
+      }
+    }
+  }
+}
+
+public enum PrecisionCastingError: Error, LocalizedError {
+  /// The module is verbatim text with no function signature to retype, so
+  /// narrowed uploads would reach a program that still expects f32.
+  case noSignature
+  /// fp8 activations would need a per-tensor scale the program does not take.
+  case unscaledFP8
+
+  public var errorDescription: String? {
+    switch self {
+    case .noSignature: return "castInputs needs a module with a function signature; verbatim text cannot be retyped"
+    case .unscaledFP8: return "castInputs does not support fp8 activations: inputs would be quantized without a scale"
+    }
+  }
+}
+
+extension StableHLOModule {
+  /// The module with every f32 argument of its entry function (`main`, else
+  /// the first) retyped to `dtype` and converted back to f32 on entry.
+  /// Aliases on those arguments no longer type-check and are dropped by
+  /// `validInputOutputAliases`. Throws for verbatim modules.
+  public func castingInputs(to dtype: DType) throws -> StableHLOModule {
+    guard let entry = functions.firstIndex(where: { $0.name == "main" }) ?? functions.indices.first else {
+      throw PrecisionCastingError.noSignature
+    }
+    var f = functions[entry]
+    let cast = Set(f.args.indices.filter { f.args[$0].dtype == .f32 })
+    guard !cast.isEmpty else { return self }
+
+    func narrowed(_ v: Value) -> Value { Value("\(v.name)_\(dtype)", v.shape, dtype) }
+    let original = f.args
+    var bound = Set<Int>()
+    var ops: [Op] = []
+    for op in f.ops {
+      if case .parameter(let i, let v) = op, cast.contains(i) {
+        ops.append(.parameter(index: i, into: narrowed(v)))
+        ops.append(.convert(operand: narrowed(v), into: v))
+        bound.insert(i)
+      } else {
+        ops.append(op)
+      }
+    }
+    // Arguments used without a `parameter` op are converted up front.
+    let unbound = cast.subtracting(bound).sorted().map { Op.convert(operand: narrowed(original[$0]), into: original[$0]) }
+    f.ops = unbound + ops
+    for i in cast { f.args[i] = narrowed(original[i]) }
+
+    var out = self
+    out.functions[entry] = f
+    return out
+  }
+}
+
+extension Backend {
+  /// `toDevice`, narrowing f32 data to `precision.inputCastType` on the host
+  /// first; pairs with programs compiled under the same policy.
+  public func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on device: Dev,
+                       precision: PrecisionPolicy) throws -> Buffer {
+    guard dtype == .f32, let narrow = try precision.inputCastType else {
+      return try toDevice(host, shape: shape, dtype: dtype, on: device)
+    }
+    let narrowed = HalfPrecision.narrow(host, to: narrow)
+    return try narrowed.withUnsafeBytes { try toDevice($0, shape: shape, dtype: narrow, on: device) }
+  }
+}
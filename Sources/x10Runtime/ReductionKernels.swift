@@ -0,0 +1,136 @@
+import Foundation
+import x10Core
+
+/// Elementwise `dst = op(dst, src)` over raw device-layout buffers, used by
+/// the in-process collectives. 32/64-bit types run on 64-byte SIMD vectors;
+/// f16/bf16/FP8 are widened to f32 a chunk at a time, reduced, and narrowed
+/// back (FP8 at scale 1, saturating).
+enum ReductionKernels {
+  static func reduce(_ dst: UnsafeMutableRawPointer, _ src: UnsafeRawPointer,
+                     count: Int, dtype: DType, op: ReduceOp) {
+    guard count > 0 else { return }
+    switch (dtype, op) {
+    case (.f32, .sum): simd(dst, src, count, SIMD16<Float>.self, { $0 + $1 }, { $0 + $1 })
+    case (.f32, .max): simd(dst, src, count, SIMD16<Float>.self, { pointwiseMax($0, $1) }, { Swift.max($0, $1) })
+    case (.f32, .min): simd(dst, src, count, SIMD16<Float>.self, { pointwiseMin($0, $1) }, { Swift.min($0, $1) })
+    case (.f64, .sum): simd(dst, src, count, SIMD8<Double>.self, { $0 + $1 }, { $0 + $1 })
+    case (.f64, .max): simd(dst, src, count, SIMD8<Double>.self, { pointwiseMax($0, $1) }, { Swift.max($0, $1) })
+    case (.f64, .min): simd(dst, src, count, SIMD8<Double>.self, { pointwiseMin($0, $1) }, { Swift.min($0, $1) })
+    case (.i32, .sum): simd(dst, src, count, SIMD16<Int32>.self, { $0 &+ $1 }, { $0 &+ $1 })
+    case (.i32, .max): simd(dst, src, count, SIMD16<Int32>.self, { pointwiseMax($0, $1) }, { Swift.max($0, $1) })
+    case (.i32, .min): simd(dst, src, count, SIMD16<Int32>.self, { pointwiseMin($0, $1) }, { Swift.min($0, $1) })
+    case (.i64, .sum): simd(dst, src, count, SIMD8<Int64>.self, { $0 &+ $1 }, { $0 &+ $1 })
+    case (.i64, .max): simd(dst, src, count, SIMD8<Int64>.self, { pointwiseMax($0, $1) }, { Swift.max($0, $1) })
+    case (.i64, .min): simd(dst, src, count, SIMD8<Int64>.self, { pointwiseMin($0, $1) }, { Swift.min($0, $1) })
+    case (.f16, _), (.bf16, _), (.f8E4M3FN, _), (.f8E5M2, _): widened(dst, src, count, dtype, op)
+    }
+  }
+
+  @inline(__always)
+  private static func simd<V: SIMD>(
+    _ dst: UnsafeMutableRawPointer, _ src: UnsafeRawPointer, _ count: Int, _: V.Type,
+    _ vop: (V, V) -> V, _ sop: (V.Scalar, V.Scalar) -> V.Scalar
+  ) {
+    let stride = MemoryLayout<V.Scalar>.stride
+    let lanes = V.scalarCount
+    var i = 0
+    while i + lanes <= count {
+      let offset = i * stride
+      let a = dst.loadUnaligned(fromByteOffset: offset, as: V.self)
+      let b = src.loadUnaligned(fromByteOffset: offset, as: V.self)
+      dst.storeBytes(of: vop(a, b), toByteOffset: offset, as: V.self)
+      i += lanes
+    }
+    let d = dst.assumingMemoryBound(to: V.Scalar.self)
+    let s = src.assumingMemoryBound(to: V.Scalar.self)
+    while i < count {
+      d[i] = sop(d[i], s[i])
+      i += 1
+    }
+  }
+
+  private static func widened(
+    _ dst: UnsafeMutableRawPointer, _ src: UnsafeRawPointer, _ count: Int, _ dtype: DType, _ op: ReduceOp
+  ) {
+    let chunk = 1024
+    withUnsafeTemporaryAllocation(of: Float.self, capacity: 2 * chunk) { scratch in
+      let a = scratch.baseAddress!, b = a + chunk
+      let width = dtype.byteWidth
+      var i = 0
+      while i < count {
+        let n = Swift.min(chunk, count - i)
+        let d = dst + i * width, s = src + i * width
+        if FP8.isFP8(dtype) {
+          FP8.dequantize(d.assumingMemoryBound(to: UInt8.self), into: a, count: n, from: dtype)
+          FP8.dequantize(s.assumingMemoryBound(to: UInt8.self), into: b, count: n, from: dtype)
+        } else {
+          HalfPrecision.widen(d.assumingMemoryBound(to: UInt16.self), into: a, count: n, from: dtype)
+          HalfPrecision.widen(s.assumingMemoryBound(to: UInt16.self), into: b, count: n, from: dtype)
+        }
+        reduce(UnsafeMutableRawPointer(a), UnsafeRawPointer(b), count: n, dtype: .f32, op: op)
+        if FP8.isFP8(dtype) {
+          FP8.quantize(a, into: d.assumingMemoryBound(to: UInt8.self), count: n, as: dtype)
+        } else {
+          HalfPrecision.narrow(a, into: d.assumingMemoryBound(to: UInt16.self), count: n, as: dtype)
+        }
+        i += n
+      }
+    }
+  }
+
+  // MARK: - Half-precision conversions (single values; bulk paths use HalfPrecision)
+
+  static func bfloatToFloat(_ h: UInt16) -> Float {
+    Float(bitPattern: UInt32(h) << 16)
+  }
+
+  /// Round-to-nearest-even; NaNs stay (quiet) NaNs.
+  static func floatToBfloat(_ f: Float) -> UInt16 {
+    let bits = f.bitPattern
+    if f.isNaN { return UInt16(bits >> 16) | 0x0040 }
+    let rounded = bits &+ 0x7FFF &+ ((bits >> 16) & 1)
+    return UInt16(rounded >> 16)
+  }
+
+  static func halfToFloat(_ h: UInt16) -> Float {
+    let sign = UInt32(h & 0x8000) << 16
+    let exp = UInt32(h >> 10) & 0x1F
+    let mant = UInt32(h) & 0x3FF
+    if exp == 0 {
+      // Zero or subnormal: mant * 2^-24.
+      let magnitude = Float(mant) * Float(sign: .plus, exponent: -24, significand: 1)
+      return sign == 0 ? magnitude : -magnitude
+    }
+    if exp == 0x1F {
+      return Float(bitPattern: sign | 0x7F80_0000 | (mant << 13))
+    }
+    return Float(bitPattern: sign | ((exp + 112) << 23) | (mant << 13))
+  }
+
+  /// Round-to-nearest-even, saturating to infinity; handles subnormals.
+  static func floatToHalf(_ f: Float) -> UInt16 {
+    let bits = f.bitPattern
+    let sign = UInt16((bits >> 16) & 0x8000)
+    let exp = Int((bits >> 23) & 0xFF)
+    let mant = bits & 0x7F_FFFF
+    if exp == 0xFF {
+      return sign | 0x7C00 | (mant != 0 ? 0x0200 : 0)
+    }
+    let e = exp - 127 + 15
+    if e >= 0x1F { return sign | 0x7C00 }
+    if e <= 0 {
+      if e < -10 { return sign }
+      let full = mant | 0x80_0000
+      let shift = UInt32(14 - e)
+      var half = full >> shift
+      let rem = full & ((1 << shift) - 1)
+      let halfway = UInt32(1) << (shift - 1)
+      if rem > halfway || (rem == halfway && (half & 1) == 1) { half += 1 }
+      return sign | UInt16(half)
+    }
+    var half = UInt32(e) << 10 | (mant >> 13)
+    let rem = mant & 0x1FFF
+    if rem > 0x1000 || (rem == 0x1000 && (half & 1) == 1) { half += 1 }  // may carry into the exponent: fine
+    return sign | UInt16(half)
+  }
+}
@@ -0,0 +1,170 @@
+import Foundation
+import x10Core
+import x10Diagnostics
+
+/// One argument of a replicated run, as host bytes of the global tensor.
+public struct ReplicatedInput: Sendable {
+  public enum Placement: Sendable, Equatable {
+    /// Split along axis 0; replica `i` gets the `i`-th equal slice.
+    case shard
+    /// Every replica gets the whole tensor (weights, scalars).
+    case replicate
+  }
+
+  public var data: Data
+  public var shape: [Int]
+  public var dtype: DType
+  public var placement: Placement
+
+  public init(_ data: Data, shape: [Int], dtype: DType, placement: Placement = .shard) {
+    self.data = data
+    self.shape = shape
+    self.dtype = dtype
+    self.placement = placement
+  }
+}
+
+/// How one output is brought back from the replicas.
+public enum ReplicaCombine: Sendable {
+  /// Stack replica outputs along axis 0 in device order.
+  case concatenate
+  /// Elementwise reduction across replicas (an all-reduce over the devices).
+  case reduce(ReduceOp)
+  /// Only replica `i`'s output.
+  case replica(Int)
+}
+
+public enum ReplicationError: Error, LocalizedError {
+  case invalid(String)
+
+  public var errorDescription: String? {
+    switch self {
+    case .invalid(let message): return message
+    }
+  }
+}
+
+/// Data-parallel execution of one module across several devices of a backend.
+///
+/// `module` is written for one replica: sharded arguments carry the
+/// per-replica batch in axis 0. It is compiled once through
+/// `JIT.compileCached` and the artifact is shared by every device, which
+/// assumes the devices are homogeneous (same backend kind and target).
+/// Replicas upload, run and read back concurrently; `.reduce` outputs are
+/// combined by a `CollectiveGroup` over the replicas' host copies. Each run
+/// gets its own group, so concurrent runs never pair each other's
+/// collectives; if one replica fails, its peers are cancelled and leave any
+/// collective they were waiting in. With `options.precision.castInputs`, f32
+/// inputs are uploaded narrowed.
+public struct ReplicatedExecution<B: Backend>: Sendable {
+  public let backend: B
+  public let devices: [B.Dev]
+  /// Collective member keys, one per device: the device's memory pool key.
+  let members: [String]
+
+  /// `devices` defaults to everything `backend.devices()` reports.
+  public init(backend: B, devices: [B.Dev]? = nil) throws {
+    let devs = try devices ?? backend.devices()
+    guard !devs.isEmpty else { throw ReplicationError.invalid("no devices to replicate over") }
+    self.backend = backend
+    self.devices = devs
+    let kind = BackendVersioning.info(for: backend).kind
+    // Devices without an ordinal fall back to their position.
+    self.members = devs.enumerated().map { "\(kind):\(($1 as? any OrdinalDevice)?.ordinal ?? $0)" }
+  }
+
+  public var replicaCount: Int { devices.count }
+
+  public func run(
+    _ module: StableHLOModule,
+    inputs: [ReplicatedInput],
+    combine: [ReplicaCombine],
+    options: CompileOptions = .init()
+  ) async throws -> [Data] {
+    let n = replicaCount
+    for (i, input) in inputs.enumerated() where input.placement == .shard {
+      guard let rows = input.shape.first, rows % n == 0 else {
+        throw ReplicationError.invalid("input \(i): axis 0 of \(input.shape) does not split into \(n) replicas")
+      }
+    }
+    for case .replica(let i) in combine where !(0..<n).contains(i) {
+      throw ReplicationError.invalid("replica \(i) out of range 0..<\(n)")
+    }
+
+    let traceStart = Trace.begin()
+    defer { Trace.end("Replicated.run", since: traceStart, arg: UInt64(n)) }
+
+    let exec = try await JIT.compileCached(module, with: backend, options: options)
+    let resultTypes = module.functions.first?.results.map(\.dtype) ?? []
+    let groups = CollectiveGroup.make(members: members)
+
+    // The first replica error leaves the loop; the task group then cancels
+    // the others, which fails any collective they are waiting in.
+    let perReplica = try await withThrowingTaskGroup(of: (Int, [Data?]).self) { tasks in
+      for r in 0..<n {
+        tasks.addTask {
+          (r, try await self.replica(r, group: groups[r], exec: exec, inputs: inputs, combine: combine,
+                                     resultTypes: resultTypes, precision: options.precision))
+        }
+      }
+      var results = [[Data?]](repeating: [], count: n)
+      for try await (r, outs) in tasks { results[r] = outs }
+      return results
+    }
+
+    return combine.indices.map { j in
+      switch combine[j] {
+      case .concatenate:
+        return perReplica.reduce(into: Data()) { $0.append($1[j]!) }
+      case .reduce:
+        return perReplica[0][j]!
+      case .replica(let i):
+        return perReplica[i][j]!
+      }
+    }
+  }
+
+  /// Upload, execute and read back for replica `r`; nil where `combine`
+  /// doesn't need this replica's copy.
+  private func replica(_ r: Int, group: CollectiveGroup, exec: Executable, inputs: [ReplicatedInput],
+                       combine: [ReplicaCombine], resultTypes: [DType],
+                       precision: PrecisionPolicy) async throws -> [Data?] {
+    let device = devices[r]
+    let buffers: [Buffer] = try inputs.map { input in
+      try input.data.withUnsafeBytes { raw in
+        switch input.placement {
+        case .replicate:
+          return try backend.toDevice(raw, shape: input.shape, dtype: input.dtype, on: device, precision: precision)
+        case .shard:
+          let rows = input.shape[0] / replicaCount
+          let sliceBytes = raw.count / replicaCount
+          let slice = UnsafeRawBufferPointer(rebasing: raw[(r * sliceBytes)..<((r + 1) * sliceBytes)])
+          return try backend.toDevice(slice, shape: [rows] + input.shape.dropFirst(), dtype: input.dtype, on: device,
+                                      precision: precision)
+        }
+      }
+    }
+
+    // Every upload above is private to this replica, so all of them can be donated.
+    let outputs = try await backend.execute(exec, inputs: buffers, donating: Set(buffers.indices), stream: nil)
+    guard outputs.count >= combine.count else {
+      throw ReplicationError.invalid("executable returned \(outputs.count) outputs, \(combine.count) combine rules given")
+    }
+
+    var host: [Data?] = []
+    for (j, rule) in combine.enumerated() {
+      switch rule {
+      case .concatenate:
+        host.append(Data(try backend.fromDevice(outputs[j])))
+      case .reduce(let op):
+        guard j < resultTypes.count else { throw ReplicationError.invalid("no result type for output \(j)") }
+        let local = Data(try backend.fromDevice(outputs[j]))
+        let reduced = try await group.allReduce(local, dtype: resultTypes[j], op: op)
+        host.append(r == 0 ? reduced : nil)
+      case .replica(let i):
+        host.append(r == i ? Data(try backend.fromDevice(outputs[j])) : nil)
+      }
+    }
+    return host
+  }
+}
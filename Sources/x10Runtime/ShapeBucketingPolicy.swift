@@ -1,11 +1,50 @@
 import x10Core
 
-public struct ShapeBucketingPolicy: Sendable, Hashable {
+public struct ShapeBucketingPolicy: Sendable, Hashable, Codable {
   public var dims: [DimSpec]
+  /// When set, bucket boundaries are derived from observed traffic instead of
+  /// `dims` (see `AdaptiveBucketing`).
+  public var adaptive: AdaptiveBucketingConfig?
 
   public init(dims: [DimSpec]) {
     self.dims = dims
+    self.adaptive = nil
+  }
+
+  public init(adaptive: AdaptiveBucketingConfig) {
+    self.dims = []
+    self.adaptive = adaptive
   }
 
   public static let `default` = ShapeBucketingPolicy(dims: [])
+
+  /// Auto-bucketing with default tuning knobs.
+  public static let auto = ShapeBucketingPolicy(adaptive: AdaptiveBucketingConfig())
+}
+
+/// Tuning knobs for traffic-derived shape buckets.
+public struct AdaptiveBucketingConfig: Sendable, Hashable, Codable {
+  /// Upper bound on buckets per dimension.
+  public var maxBuckets: Int
+  /// Price of one extra bucket (i.e. one more compile) expressed as average
+  /// padding fraction per call. 0.02 means a new bucket must cut the expected
+  /// padding by at least 2% of the real work to pay for itself.
+  public var compileCost: Double
+  /// Real executions between background re-tunes.
+  public var retuneEvery: Int
+  /// Hottest shapes read from the `ShapeProfiler` sketch per re-tune (capped
+  /// by its `sketchCapacity`; observations decay with its half-life).
+  public var valuesTracked: Int
+
+  public init(
+    maxBuckets: Int = 16,
+    compileCost: Double = 0.02,
+    retuneEvery: Int = 256,
+    valuesTracked: Int = 256
+  ) {
+    self.maxBuckets = max(1, maxBuckets)
+    self.compileCost = max(0, compileCost)
+    self.retuneEvery = max(1, retuneEvery)
+    self.valuesTracked = max(1, valuesTracked)
+  }
 }
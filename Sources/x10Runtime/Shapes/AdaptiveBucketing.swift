@@ -0,0 +1,285 @@
+import Foundation
+import x10Core
+
+/// Bucket boundaries currently in force for one (irHash, rank) under an
+/// adaptive `ShapeBucketingPolicy`.
+public struct AdaptiveBucketPlan: Sendable, Equatable {
+  /// Per dimension, ascending inclusive bucket upper bounds. A value lands in
+  /// the first bucket whose bound is >= the value; values above the last
+  /// bound are keyed exactly until the next re-tune.
+  public var boundaries: [[Int]]
+  /// Per dimension, expected padded size / real size - 1 under recent traffic.
+  public var perDimOverhead: [Double]
+  /// Observations the plan was derived from.
+  public var observations: Int
+
+  /// Expected padded elements / real elements - 1 across all dimensions,
+  /// treating dimensions as independent.
+  public var expectedPaddingOverhead: Double {
+    perDimOverhead.reduce(1) { $0 * (1 + $1) } - 1
+  }
+
+  public var bucketCount: Int {
+    boundaries.reduce(1) { $0 * max(1, $1.count) }
+  }
+}
+
+/// Traffic-derived shape buckets.
+///
+/// Cache-key derivation only reads the plan in force; it never counts as
+/// traffic. `JIT.compileCached` reports each real (non-warm-up) call, and
+/// every `retuneEvery` calls per (irHash, policy) a background task re-tunes
+/// from the `ShapeProfiler` sketch the call was already noted in: shapes are
+/// grouped by rank, each dimension's values are weighted by the decayed shape
+/// counts, and boundaries are recomputed by dynamic programming to minimize
+/// `compileCost * buckets + expected padding fraction`. A dimension keeps its
+/// old boundaries unless the new ones improve that objective by more than
+/// one compile, so keys stay put under steady traffic. Until the first tune,
+/// the static inferred buckets are used.
+public enum AdaptiveBucketing {
+  private struct Key: Hashable {
+    let irHash: String
+    let policy: ShapeBucketingPolicy
+  }
+
+  /// Per-(irHash, policy) state; guarded by `lock`.
+  private struct State {
+    var plans: [Int: AdaptiveBucketPlan] = [:]
+    var observations = 0
+    var sinceRetune = 0
+    var retuning = false
+    var lastUse: UInt64 = 0
+  }
+
+  /// Live states are capped; the least recently used one is dropped.
+  static let maxBucketers = 1024
+
+  private static let lock = NSLock()
+  private static var states: [Key: State] = [:]
+  private static var tick: UInt64 = 0
+  private static var pending: [UUID: Task<Void, Never>] = [:]
+
+  /// Dim specs for `shape` under the current plan, or nil if none exists yet.
+  /// Pure lookup: does not count as an observation.
+  static func dimSpecs(irHash: String, shape: [Int], policy: ShapeBucketingPolicy) -> [DimSpec]? {
+    lock.lock()
+    let plan = states[Key(irHash: irHash, policy: policy)]?.plans[shape.count]
+    lock.unlock()
+    guard let plan else { return nil }
+    return zip(shape, plan.boundaries).map { value, bounds in
+      guard let idx = bucketIndex(value, bounds: bounds) else { return .exact(value) }
+      let lo = idx == 0 ? 0 : bounds[idx - 1] + 1
+      return .bucket(lo: lo, hi: bounds[idx])
+    }
+  }
+
+  /// Counts one real execution for `irHash` (already noted in `profiler`) and
+  /// starts a background re-tune every `retuneEvery` calls.
+  static func noteExecution(
+    irHash: String,
+    policy: ShapeBucketingPolicy,
+    profiler: ShapeProfiler = .shared
+  ) {
+    guard let config = policy.adaptive else { return }
+    let key = Key(irHash: irHash, policy: policy)
+    lock.lock()
+    tick &+= 1
+    if states[key] == nil, states.count >= maxBucketers,
+       let stale = states.min(by: { $0.value.lastUse < $1.value.lastUse }) {
+      states.removeValue(forKey: stale.key)
+    }
+    var state = states[key] ?? State()
+    state.lastUse = tick
+    state.observations += 1
+    state.sinceRetune += 1
+    let due = state.sinceRetune >= config.retuneEvery && !state.retuning
+    if due {
+      state.sinceRetune = 0
+      state.retuning = true
+    }
+    states[key] = state
+    if due {
+      // The task cannot finish before it is recorded: it needs `lock` to do so.
+      let id = UUID()
+      pending[id] = Task.detached(priority: .utility) {
+        await retune(irHash: irHash, policy: policy, from: profiler)
+        lock.lock()
+        pending.removeValue(forKey: id)
+        lock.unlock()
+      }
+    }
+    lock.unlock()
+  }
+
+  /// Current plans for `irHash`, one per tuned rank.
+  public static func plans(irHash: String) -> [AdaptiveBucketPlan] {
+    lock.lock(); defer { lock.unlock() }
+    return states.filter { $0.key.irHash == irHash }
+      .flatMap { $0.value.plans.sorted { $0.key < $1.key }.map(\.value) }
+  }
+
+  /// Re-tunes `irHash` under `policy` from `profiler`'s current sketch.
+  public static func retune(
+    irHash: String,
+    policy: ShapeBucketingPolicy,
+    from profiler: ShapeProfiler = .shared
+  ) async {
+    guard let config = policy.adaptive else { return }
+    let key = Key(irHash: irHash, policy: policy)
+    let shapes = await profiler.topKWithCounts(irHash: irHash, policy: policy, k: config.valuesTracked)
+
+    lock.lock()
+    let current = states[key]?.plans ?? [:]
+    let observations = states[key]?.observations ?? 0
+    lock.unlock()
+
+    // The DP runs here, off the request path and outside the lock.
+    var plans = current
+    for (rank, group) in Dictionary(grouping: shapes, by: { $0.shape.count }) where rank > 0 {
+      var boundaries: [[Int]] = []
+      var overheads: [Double] = []
+      for d in 0..<rank {
+        var weights: [Int: Double] = [:]
+        for item in group { weights[item.shape[d], default: 0] += item.count }
+        let values = weights.map { (value: $0.key, weight: $0.value) }
+        var bounds = optimalBoundaries(values, maxBuckets: config.maxBuckets, compileCost: config.compileCost)
+        if let old = current[rank]?.boundaries[d],
+           objective(values, bounds: old, compileCost: config.compileCost)
+             <= objective(values, bounds: bounds, compileCost: config.compileCost) + config.compileCost {
+          bounds = old
+        }
+        boundaries.append(bounds)
+        overheads.append(paddingOverhead(values, bounds: bounds))
+      }
+      plans[rank] = AdaptiveBucketPlan(boundaries: boundaries, perDimOverhead: overheads, observations: observations)
+    }
+
+    lock.lock()
+    var state = states[key] ?? State()
+    state.plans = plans
+    state.retuning = false
+    states[key] = state
+    lock.unlock()
+  }
+
+  /// Waits for background re-tunes started so far.
+  public static func waitForPendingRetunes() async {
+    lock.lock()
+    let tasks = Array(pending.values)
+    lock.unlock()
+    for task in tasks { await task.value }
+  }
+
+  public static func reset() {
+    lock.lock(); defer { lock.unlock() }
+    states.removeAll()
+  }
+
+  // MARK: - Boundary search
+
+  /// Minimizes `compileCost * B + Σ w·(hi - v)/hi / Σ w` over partitions of the
+  /// sorted distinct `values` into at most `maxBuckets` contiguous buckets,
+  /// each padded to its largest member. O(maxBuckets · n²).
+  static func optimalBoundaries(
+    _ values: [(value: Int, weight: Double)],
+    maxBuckets: Int,
+    compileCost: Double
+  ) -> [Int] {
+    let sorted = values.filter { $0.weight > 0 }.sorted { $0.value < $1.value }
+    let n = sorted.count
+    guard n > 0 else { return [] }
+
+    var prefixW = [Double](repeating: 0, count: n + 1)
+    var prefixWV = [Double](repeating: 0, count: n + 1)
+    for (i, item) in sorted.enumerated() {
+      prefixW[i + 1] = prefixW[i] + item.weight
+      prefixWV[i + 1] = prefixWV[i] + item.weight * Double(item.value)
+    }
+    let total = prefixW[n]
+
+    // Padding fraction contributed by values i..<j padded to sorted[j-1].
+    func waste(_ i: Int, _ j: Int) -> Double {
+      let hi = Double(sorted[j - 1].value)
+      guard hi > 0 else { return 0 }
+      let w = prefixW[j] - prefixW[i]
+      let wv = prefixWV[j] - prefixWV[i]
+      return (w - wv / hi) / total
+    }
+
+    let maxB = min(max(1, maxBuckets), n)
+    let inf = Double.infinity
+    // best[b][j]: min waste covering the first j values with b buckets.
+    var best = [[Double]](repeating: [Double](repeating: inf, count: n + 1), count: maxB + 1)
+    var split = [[Int]](repeating: [Int](repeating: 0, count: n + 1), count: maxB + 1)
+    best[0][0] = 0
+    for b in 1...maxB {
+      for j in b...n {
+        for i in (b - 1)..<j where best[b - 1][i] < inf {
+          let c = best[b - 1][i] + waste(i, j)
+          if c < best[b][j] {
+            best[b][j] = c
+            split[b][j] = i
+          }
+        }
+      }
+    }
+
+    var bestB = 1
+    for b in 1...maxB where best[b][n] + compileCost * Double(b) < best[bestB][n] + compileCost * Double(bestB) {
+      bestB = b
+    }
+
+    var bounds: [Int] = []
+    var j = n
+    var b = bestB
+    while b > 0 {
+      bounds.append(sorted[j - 1].value)
+      j = split[b][j]
+      b -= 1
+    }
+    return bounds.reversed()
+  }
+
+  /// Expected padded / real size - 1 for `values` under `bounds`.
+  static func paddingOverhead(_ values: [(value: Int, weight: Double)], bounds: [Int]) -> Double {
+    var real = 0.0, padded = 0.0
+    for item in values {
+      let hi = bucketUpperBound(item.value, bounds: bounds) ?? item.value
+      real += item.weight * Double(item.value)
+      padded += item.weight * Double(hi)
+    }
+    return real > 0 ? padded / real - 1 : 0
+  }
+
+  /// The boundary search's objective for `bounds` on `values`: one compile
+  /// per bucket plus one per distinct value past the last bound (keyed
+  /// exactly), plus the weighted padding fraction.
+  static func objective(_ values: [(value: Int, weight: Double)], bounds: [Int], compileCost: Double) -> Double {
+    let total = values.reduce(0) { $0 + $1.weight }
+    guard total > 0 else { return 0 }
+    var waste = 0.0
+    var compiles = bounds.count
+    for item in values where item.weight > 0 {
+      guard let hi = bucketUpperBound(item.value, bounds: bounds) else {
+        compiles += 1
+        continue
+      }
+      if hi > 0 { waste += item.weight * Double(hi - item.value) / Double(hi) }
+    }
+    return compileCost * Double(compiles) + waste / total
+  }
+
+  static func bucketUpperBound(_ value: Int, bounds: [Int]) -> Int? {
+    bucketIndex(value, bounds: bounds).map { bounds[$0] }
+  }
+
+  /// Index of the first bound >= `value` (binary search), nil past the end.
+  static func bucketIndex(_ value: Int, bounds: [Int]) -> Int? {
+    var lo = 0, hi = bounds.count
+    while lo < hi {
+      let mid = (lo + hi) / 2
+      if bounds[mid] < value { lo = mid + 1 } else { hi = mid }
+    }
+    return lo < bounds.count ? lo : nil
+  }
+}
@@ -0,0 +1,127 @@
+import Foundation
+
+/// Fixed-size Space-Saving sketch over concrete shapes with exponential
+/// time decay.
+///
+/// At most `capacity` shapes are tracked. A shape seen for the first time
+/// when the sketch is full takes over the slot of the current minimum and
+/// inherits its count as error bound, so any shape whose true (decayed)
+/// frequency exceeds total/capacity is guaranteed to be present.
+///
+/// Decay uses forward decay: an observation at time t is weighted by
+/// 2^((t - landmark) / halfLife) instead of aging every stored count. That
+/// preserves the ordering of existing counters, so the array stays sorted
+/// and `topK` is O(k). Weights are folded back into the counts when they
+/// grow large.
+///
+/// `add` moves the counter past each run of tied counts it overtakes with
+/// one binary search and one swap, so it costs O(r log capacity) for r
+/// distinct counts overtaken. Without decay every increment is 1 and r <= 1;
+/// it never degrades to a walk over a long run of ties.
+struct HeavyHitterSketch {
+  struct Counter {
+    var shape: [Int]
+    var count: Double
+    var error: Double
+  }
+
+  let capacity: Int
+  let halfLife: Double?
+
+  /// Sorted by `count`, highest first.
+  private(set) var counters: [Counter] = []
+  private var index: [[Int]: Int] = [:]
+  private var storedDims = 0
+  private var landmark: Double
+  private(set) var lastUpdate: Double
+
+  init(capacity: Int, halfLife: Double?, now: Double) {
+    self.capacity = max(1, capacity)
+    self.halfLife = halfLife.flatMap { $0 > 0 ? $0 : nil }
+    self.landmark = now
+    self.lastUpdate = now
+  }
+
+  var isEmpty: Bool { counters.isEmpty }
+
+  /// Records `weight` observations of `shape` at time `now`.
+  mutating func add(_ shape: [Int], weight: Double = 1, now: Double) {
+    lastUpdate = max(lastUpdate, now)
+    let w = weight * scale(at: now)
+
+    if let i = index[shape] {
+      counters[i].count += w
+      siftUp(i)
+    } else if counters.count < capacity {
+      counters.append(Counter(shape: shape, count: w, error: 0))
+      storedDims += shape.count
+      index[shape] = counters.count - 1
+      siftUp(counters.count - 1)
+    } else {
+      let last = counters.count - 1
+      let victim = counters[last]
+      index.removeValue(forKey: victim.shape)
+      storedDims += shape.count - victim.shape.count
+      counters[last] = Counter(shape: shape, count: victim.count + w, error: victim.count)
+      index[shape] = last
+      siftUp(last)
+    }
+
+    if let halfLife, (now - landmark) / halfLife > 64 { renormalize(at: now) }
+  }
+
+  /// The `k` heaviest shapes with their decayed counts as of `now`, heaviest first.
+  func topK(_ k: Int, now: Double) -> [(shape: [Int], count: Double)] {
+    guard k > 0 else { return [] }
+    let s = scale(at: now)
+    return counters.prefix(k).map { ($0.shape, $0.count / s) }
+  }
+
+  /// Rough resident size, used for `ShapeProfiler.memoryUsage()`.
+  var approximateBytes: Int {
+    let perCounter = MemoryLayout<Counter>.stride + 2 * MemoryLayout<Int>.stride
+    // Shapes are stored twice (counter + index key).
+    return counters.count * perCounter + 2 * storedDims * MemoryLayout<Int>.stride
+  }
+
+  // MARK: - Private
+
+  private func scale(at now: Double) -> Double {
+    guard let halfLife else { return 1 }
+    return exp2((now - landmark) / halfLife)
+  }
+
+  /// Moves `i` toward the front until the array is sorted again. Counts only
+  /// grow, so one direction suffices. Each step swaps `i` with the first
+  /// counter of the tied run just ahead of it, which keeps the run sorted.
+  private mutating func siftUp(_ i: Int) {
+    var i = i
+    while i > 0 && counters[i - 1].count < counters[i].count {
+      let runStart = firstIndex(withCountAtMost: counters[i - 1].count, below: i)
+      counters.swapAt(runStart, i)
+      index[counters[i].shape] = i
+      i = runStart
+    }
+    index[counters[i].shape] = i
+  }
+
+  /// Smallest index in `0..<end` whose count is <= `count` (counts descend).
+  private func firstIndex(withCountAtMost count: Double, below end: Int) -> Int {
+    var lo = 0, hi = end
+    while lo < hi {
+      let mid = (lo + hi) / 2
+      if counters[mid].count <= count { hi = mid } else { lo = mid + 1 }
+    }
+    return lo
+  }
+
+  /// Rebases counts on `now` so forward-decay weights stay in range.
+  private mutating func renormalize(at now: Double) {
+    let s = scale(at: now)
+    for i in counters.indices {
+      counters[i].count /= s
+      counters[i].error /= s
+    }
+    landmark = now
+  }
+}
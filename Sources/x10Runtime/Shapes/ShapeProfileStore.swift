@@ -0,0 +1,71 @@
+import Foundation
+import x10Core
+
+/// On-disk form of one irHash's shape histogram, written by
+/// `ShapeProfiler.persist` and read back by `CacheWarmer.prewarm`.
+public struct ShapeProfileSnapshot: Sendable, Codable, Equatable {
+  public struct ShapeCount: Sendable, Codable, Equatable {
+    public var shape: [Int]
+    /// Decayed observation count.
+    public var count: Double
+
+    public init(shape: [Int], count: Double) {
+      self.shape = shape
+      self.count = count
+    }
+  }
+
+  public struct Entry: Sendable, Codable, Equatable {
+    public var policy: ShapeBucketingPolicy
+    /// Hottest first.
+    public var shapes: [ShapeCount]
+
+    public init(policy: ShapeBucketingPolicy, shapes: [ShapeCount]) {
+      self.policy = policy
+      self.shapes = shapes
+    }
+  }
+
+  public var version: Int
+  public var irHash: String
+  public var entries: [Entry]
+
+  public init(irHash: String, entries: [Entry], version: Int = 1) {
+    self.version = version
+    self.irHash = irHash
+    self.entries = entries
+  }
+}
+
+/// Location and (de)serialization of shape profile snapshots.
+/// Files live at `<X10_IR_CACHE_DIR>/profiles/<irHash>.json` unless
+/// `X10_SHAPE_PROFILE_DIR` points elsewhere.
+enum ShapeProfileStore {
+  static func directory() -> URL {
+    if let override = ProcessInfo.processInfo.environment["X10_SHAPE_PROFILE_DIR"], !override.isEmpty {
+      return URL(fileURLWithPath: override, isDirectory: true)
+    }
+    return IRStore.baseDir().appendingPathComponent("profiles", isDirectory: true)
+  }
+
+  static func url(irHash: String, in dir: URL) -> URL {
+    dir.appendingPathComponent("\(irHash).json")
+  }
+
+  static func read(irHash: String, from dir: URL) -> ShapeProfileSnapshot? {
+    guard let data = try? Data(contentsOf: url(irHash: irHash, in: dir)) else { return nil }
+    return try? JSONDecoder().decode(ShapeProfileSnapshot.self, from: data)
+  }
+
+  static func write(_ snapshot: ShapeProfileSnapshot, to dir: URL) throws {
+    try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = [.sortedKeys]
+    try encoder.encode(snapshot).write(to: url(irHash: snapshot.irHash, in: dir), options: .atomic)
+  }
+
+  /// Whether `ShapeProfiler` should snapshot automatically (X10_SHAPE_PROFILE_PERSIST=1).
+  static func autoPersistEnabled() -> Bool {
+    ProcessInfo.processInfo.environment["X10_SHAPE_PROFILE_PERSIST"] == "1"
+  }
+}
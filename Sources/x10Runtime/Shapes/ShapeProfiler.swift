@@ -1,34 +1,216 @@
 import Foundation
 import x10Core
+import x10Diagnostics
 
+/// Tracks the hottest concrete shapes per (irHash, policy).
+///
+/// Memory is fixed: each (irHash, policy) gets a `HeavyHitterSketch` of
+/// `sketchCapacity` shapes (X10_SHAPE_PROFILE_CAPACITY, default 64) and at most
+/// `maxSketches` sketches are kept (X10_SHAPE_PROFILE_MAX_KEYS, default 1024;
+/// least recently updated goes first). Counts decay with a half-life of
+/// X10_SHAPE_PROFILE_HALFLIFE seconds (default 3600, 0 disables) so shapes
+/// that stop showing up age out.
 public actor ShapeProfiler {
   public static let shared = ShapeProfiler()
 
+  /// Notes per irHash between automatic snapshots (X10_SHAPE_PROFILE_PERSIST=1).
+  static let autoPersistInterval = 32
+  /// Debounce before a scheduled snapshot is written, so bursts of notes
+  /// coalesce into one write per irHash.
+  static let autoPersistDelayNanos: UInt64 = 500_000_000
+
   private struct Entry: Hashable {
     let irHash: String
     let policy: ShapeBucketingPolicy
   }
 
-  private var histo: [Entry: [ [Int]: Int ]] = [:]
+  public let sketchCapacity: Int
+  public let maxSketches: Int
+  private let halfLife: Double?
+  private let clock: @Sendable () -> Double
+
+  private var sketches: [Entry: HeavyHitterSketch] = [:]
+  /// This profiler's share of `Diagnostics.shapeProfilerBytes`, which sums
+  /// every instance.
+  private var trackedBytes = 0
+  /// irHashes whose on-disk snapshot has already been merged into `sketches`.
+  private var restored: Set<String> = []
+  private var notesSincePersist: [String: Int] = [:]
+  /// irHashes due for an automatic snapshot, and the task writing them.
+  private var dirty: Set<String> = []
+  private var persistTask: Task<Void, Never>?
+
+  public init(
+    sketchCapacity: Int? = nil,
+    maxSketches: Int? = nil,
+    halfLifeSeconds: Double? = nil,
+    clock: @escaping @Sendable () -> Double = { Double(DispatchTime.now().uptimeNanoseconds) / 1e9 }
+  ) {
+    let env = ProcessInfo.processInfo.environment
+    self.sketchCapacity = max(1, sketchCapacity ?? env["X10_SHAPE_PROFILE_CAPACITY"].flatMap(Int.init) ?? 64)
+    self.maxSketches = max(1, maxSketches ?? env["X10_SHAPE_PROFILE_MAX_KEYS"].flatMap(Int.init) ?? 1024)
+    let hl = halfLifeSeconds ?? env["X10_SHAPE_PROFILE_HALFLIFE"].flatMap(Double.init) ?? 3600
+    self.halfLife = hl > 0 ? hl : nil
+    self.clock = clock
+  }
+
+  deinit { Diagnostics.shapeProfilerBytes.sub(Int64(trackedBytes)) }
 
   public func note(irHash: String, policy: ShapeBucketingPolicy, concreteShape: [Int]) {
-    let entry = Entry(irHash: irHash, policy: policy)
-    var bucket = histo[entry] ?? [:]
-    bucket[concreteShape, default: 0] += 1
-    histo[entry] = bucket
+    add(Entry(irHash: irHash, policy: policy), shape: concreteShape, weight: 1)
+
+    guard ShapeProfileStore.autoPersistEnabled() else { return }
+    notesSincePersist[irHash, default: 0] += 1
+    if notesSincePersist[irHash, default: 0] >= Self.autoPersistInterval {
+      notesSincePersist[irHash] = 0
+      schedulePersist(irHash)
+    }
+  }
+
+  /// Waits for the scheduled background snapshot, if any, to be written.
+  public func waitForPendingPersist() async {
+    while let task = persistTask { await task.value }
+  }
+
+  /// Marks `irHash` dirty and starts the debounced writer if it is idle. The
+  /// writer reads and writes files off the actor; only the in-memory merge
+  /// and the snapshot run here.
+  private func schedulePersist(_ irHash: String) {
+    dirty.insert(irHash)
+    guard persistTask == nil else { return }
+    persistTask = Task.detached(priority: .utility) { [weak self] in
+      try? await Task.sleep(nanoseconds: Self.autoPersistDelayNanos)
+      guard let self else { return }
+      let dir = ShapeProfileStore.directory()
+      for irHash in await self.takeDirty() {
+        let previous = await self.needsRestore(irHash) ? ShapeProfileStore.read(irHash: irHash, from: dir) : nil
+        let snapshot = await self.mergeAndSnapshot(irHash: irHash, previous: previous)
+        try? ShapeProfileStore.write(snapshot, to: dir)
+      }
+      await self.persistFinished()
+    }
+  }
+
+  private func takeDirty() -> Set<String> {
+    defer { dirty.removeAll() }
+    return dirty
+  }
+
+  private func needsRestore(_ irHash: String) -> Bool { !restored.contains(irHash) }
+
+  private func mergeAndSnapshot(irHash: String, previous: ShapeProfileSnapshot?) -> ShapeProfileSnapshot {
+    if !restored.contains(irHash) {
+      restored.insert(irHash)
+      if let previous { merge(previous) }
+    }
+    return snapshot(irHash: irHash)
+  }
+
+  private func persistFinished() {
+    persistTask = nil
+    if let next = dirty.first { schedulePersist(next) }
   }
 
   public func topK(irHash: String, policy: ShapeBucketingPolicy, k: Int) -> [[Int]] {
-    guard k > 0 else { return [] }
-    let entry = Entry(irHash: irHash, policy: policy)
-    guard let bucket = histo[entry] else { return [] }
-    return bucket
-      .sorted { $0.value > $1.value }
-      .prefix(k)
-      .map { $0.key }
+    topKWithCounts(irHash: irHash, policy: policy, k: k).map { $0.shape }
+  }
+
+  /// Like `topK`, with decayed observation counts (used as warm-up priority).
+  public func topKWithCounts(
+    irHash: String, policy: ShapeBucketingPolicy, k: Int
+  ) -> [ShapeProfileSnapshot.ShapeCount] {
+    guard let sketch = sketches[Entry(irHash: irHash, policy: policy)] else { return [] }
+    return sketch.topK(k, now: clock()).map { .init(shape: $0.shape, count: $0.count) }
+  }
+
+  /// Sketches held, shapes tracked across them, and their approximate bytes.
+  public func memoryUsage() -> (sketches: Int, trackedShapes: Int, approximateBytes: Int) {
+    var shapes = 0, bytes = 0
+    for sketch in sketches.values {
+      shapes += sketch.counters.count
+      bytes += sketch.approximateBytes
+    }
+    return (sketches.count, shapes, bytes)
   }
 
   public func reset() {
-    histo.removeAll()
+    sketches.removeAll()
+    restored.removeAll()
+    notesSincePersist.removeAll()
+    dirty.removeAll()
+    Diagnostics.shapeProfilerBytes.sub(Int64(trackedBytes))
+    trackedBytes = 0
+  }
+
+  private func add(_ entry: Entry, shape: [Int], weight: Double) {
+    let now = clock()
+    if sketches[entry] == nil {
+      if sketches.count >= maxSketches,
+         let stale = sketches.min(by: { $0.value.lastUpdate < $1.value.lastUpdate }) {
+        trackedBytes -= stale.value.approximateBytes
+        Diagnostics.shapeProfilerBytes.sub(Int64(stale.value.approximateBytes))
+        sketches.removeValue(forKey: stale.key)
+      }
+      sketches[entry] = HeavyHitterSketch(capacity: sketchCapacity, halfLife: halfLife, now: now)
+    }
+    let before = sketches[entry]!.approximateBytes
+    sketches[entry]!.add(shape, weight: weight, now: now)
+    let delta = sketches[entry]!.approximateBytes - before
+    trackedBytes += delta
+    Diagnostics.shapeProfilerBytes.add(Int64(delta))
+  }
+
+  // MARK: - Persistence
+
+  /// Current sketch contents for `irHash`, hottest shapes first.
+  public func snapshot(irHash: String) -> ShapeProfileSnapshot {
+    let now = clock()
+    let entries = sketches
+      .filter { $0.key.irHash == irHash }
+      .map { item in
+        ShapeProfileSnapshot.Entry(
+          policy: item.key.policy,
+          shapes: item.value.topK(sketchCapacity, now: now).map { .init(shape: $0.shape, count: $0.count) })
+      }
+      .sorted { ($0.shapes.first?.count ?? 0) > ($1.shapes.first?.count ?? 0) }
+    return ShapeProfileSnapshot(irHash: irHash, entries: entries)
+  }
+
+  /// Writes the histogram for `irHash` to disk. The previous snapshot is
+  /// merged in first, so counts accumulate across process restarts.
+  public func persist(irHash: String, directory: URL? = nil) throws {
+    let dir = directory ?? ShapeProfileStore.directory()
+    restore(irHash: irHash, directory: dir)
+    notesSincePersist[irHash] = 0
+    try ShapeProfileStore.write(snapshot(irHash: irHash), to: dir)
+  }
+
+  /// Snapshots every profiled irHash (e.g. at shutdown).
+  public func persistAll(directory: URL? = nil) throws {
+    for irHash in Set(sketches.keys.map(\.irHash)) {
+      try persist(irHash: irHash, directory: directory)
+    }
+  }
+
+  /// Merges the on-disk snapshot for `irHash` into memory, once per process.
+  /// Returns false when no snapshot exists or it was already merged.
+  @discardableResult
+  public func restore(irHash: String, directory: URL? = nil) -> Bool {
+    guard !restored.contains(irHash) else { return false }
+    restored.insert(irHash)
+    let dir = directory ?? ShapeProfileStore.directory()
+    guard let snapshot = ShapeProfileStore.read(irHash: irHash, from: dir) else { return false }
+    merge(snapshot)
+    return true
+  }
+
+  private func merge(_ snapshot: ShapeProfileSnapshot) {
+    for stored in snapshot.entries {
+      let entry = Entry(irHash: snapshot.irHash, policy: stored.policy)
+      // Coldest first so the merged sketch keeps the persisted hot set.
+      for item in stored.shapes.reversed() {
+        add(entry, shape: item.shape, weight: item.count)
+      }
+    }
   }
 }
@@ -0,0 +1,200 @@
+import Foundation
+import x10Core
+
+/// Ordered work queue for one device. Work enqueued on a stream runs in
+/// submission order, one item at a time; separate streams run concurrently,
+/// so a copy stream can upload step N+1 while a compute stream runs step N.
+/// Cross-stream ordering is expressed with `Event`s.
+///
+/// The first error thrown by an item is sticky: later items are skipped and
+/// `synchronize()` rethrows it. Events recorded on a failed stream still
+/// fire, carrying the error, so waiters rethrow instead of hanging.
+public final class Stream: @unchecked Sendable {
+  public let label: String
+
+  private let lock = NSLock()
+  private var tail: Task<Void, Never>?
+  private var failure: Error?
+
+  public init(label: String = "x10.stream") {
+    self.label = label
+  }
+
+  /// Appends `body` to the stream; the returned future resolves once it ran.
+  @discardableResult
+  public func enqueue<T: Sendable>(_ body: @escaping @Sendable () async throws -> T) -> StreamFuture<T> {
+    lock.lock(); defer { lock.unlock() }
+    let previous = tail
+    let task = Task<T, Error> { [self] in
+      await previous?.value
+      if let failure = currentFailure() { throw failure }
+      do {
+        return try await body()
+      } catch {
+        recordFailure(error)
+        throw error
+      }
+    }
+    tail = Task { _ = try? await task.value }
+    return StreamFuture(task)
+  }
+
+  /// Marks the current end of the stream on `event` (a fresh one by default).
+  /// The event fires even if the stream has failed, with that error.
+  @discardableResult
+  public func record(_ event: Event = Event()) -> Event {
+    let signal = event.arm()
+    lock.lock(); defer { lock.unlock() }
+    let previous = tail
+    // Not an `enqueue` item: those are skipped once the stream has failed.
+    tail = Task { [self] in
+      await previous?.value
+      signal.fire(failure: currentFailure())
+    }
+    return event
+  }
+
+  /// Later work on this stream waits until `event`'s latest record completes;
+  /// if the recording stream had failed, this stream fails with its error.
+  public func wait(for event: Event) {
+    let signal = event.armed
+    enqueue { try await signal?.wait() }
+  }
+
+  /// Waits for everything enqueued so far; rethrows the stream's error, if any.
+  public func synchronize() async throws {
+    lock.lock()
+    let current = tail
+    lock.unlock()
+    await current?.value
+    if let failure = currentFailure() { throw failure }
+  }
+
+  private func currentFailure() -> Error? {
+    lock.lock(); defer { lock.unlock() }
+    return failure
+  }
+
+  private func recordFailure(_ error: Error) {
+    lock.lock(); defer { lock.unlock() }
+    if failure == nil { failure = error }
+  }
+}
+
+/// Result of work enqueued on a `Stream`.
+public struct StreamFuture<T: Sendable>: Sendable {
+  private let task: Task<T, Error>
+
+  init(_ task: Task<T, Error>) { self.task = task }
+
+  /// An already-available value, for mixing host-side buffers into stream work.
+  public static func ready(_ value: T) -> StreamFuture<T> {
+    StreamFuture(Task { value })
+  }
+
+  public var value: T {
+    get async throws { try await task.value }
+  }
+}
+
+/// Point in a stream's timeline. `Stream.record(_:)` arms it; waiting (from the
+/// host or from another stream) blocks until the stream reaches that point.
+/// Re-recording moves the event; waits already issued keep their old target.
+public final class Event: @unchecked Sendable {
+  private let lock = NSLock()
+  private var signal: Signal?
+
+  public init() {}
+
+  /// True once the latest record has been reached (or if never recorded).
+  public var isComplete: Bool {
+    armed?.isFired ?? true
+  }
+
+  /// Host-side wait for the latest record; rethrows the recording stream's
+  /// error if it had failed.
+  public func wait() async throws {
+    try await armed?.wait()
+  }
+
+  fileprivate var armed: Signal? {
+    lock.lock(); defer { lock.unlock() }
+    return signal
+  }
+
+  fileprivate func arm() -> Signal {
+    lock.lock(); defer { lock.unlock() }
+    let fresh = Signal()
+    signal = fresh
+    return fresh
+  }
+}
+
+/// One-shot latch behind `Event`, optionally carrying the recording
+/// stream's error.
+private final class Signal: @unchecked Sendable {
+  private let lock = NSLock()
+  private var fired = false
+  private var failure: Error?
+  private var waiters: [CheckedContinuation<Void, Error>] = []
+
+  var isFired: Bool {
+    lock.lock(); defer { lock.unlock() }
+    return fired
+  }
+
+  func fire(failure: Error? = nil) {
+    lock.lock()
+    fired = true
+    self.failure = failure
+    let pending = waiters
+    waiters.removeAll()
+    lock.unlock()
+    for waiter in pending {
+      if let failure { waiter.resume(throwing: failure) } else { waiter.resume() }
+    }
+  }
+
+  func wait() async throws {
+    try await withCheckedThrowingContinuation { (c: CheckedContinuation<Void, Error>) in
+      lock.lock()
+      if fired {
+        let failure = self.failure
+        lock.unlock()
+        if let failure { c.resume(throwing: failure) } else { c.resume() }
+      } else {
+        waiters.append(c)
+        lock.unlock()
+      }
+    }
+  }
+}
+
+// MARK: - Enqueued transfers and execution
+
+public extension Backend {
+  /// Host-to-device copy of `host` as the next item on `stream`.
+  func enqueueToDevice(_ host: Data, shape: [Int], dtype: DType, on device: Dev,
+                       stream: Stream) -> StreamFuture<Buffer> {
+    stream.enqueue {
+      try host.withUnsafeBytes { try self.toDevice($0, shape: shape, dtype: dtype, on: device) }
+    }
+  }
+
+  /// Runs `exec` on `stream` once its inputs (possibly produced on other streams) resolve.
+  @discardableResult
+  func enqueueExecute(_ exec: Executable, inputs: [StreamFuture<Buffer>], donating: Set<Int> = [],
+                      stream: Stream) -> StreamFuture<[Buffer]> {
+    stream.enqueue {
+      var resolved: [Buffer] = []
+      resolved.reserveCapacity(inputs.count)
+      for input in inputs { resolved.append(try await input.value) }
+      return try await self.execute(exec, inputs: resolved, donating: donating, stream: stream)
+    }
+  }
+
+  /// Device-to-host copy of `buffer` as the next item on `stream`.
+  func enqueueFromDevice(_ buffer: StreamFuture<Buffer>, stream: Stream) -> StreamFuture<[UInt8]> {
+    stream.enqueue { try self.fromDevice(try await buffer.value) }
+  }
+}
@@ -0,0 +1,35 @@
+import Foundation
+import x10Core
+
+public enum TensorTransferError: Error, CustomStringConvertible, Sendable {
+  case sizeMismatch(expected: Int, got: Int)
+
+  public var description: String {
+    switch self {
+    case .sizeMismatch(let expected, let got): return "buffer holds \(got) bytes, tensor needs \(expected)"
+    }
+  }
+}
+
+extension Backend {
+  /// Uploads `tensor` directly from its storage; the backend's own transfer
+  /// is the only copy. f32 tensors are narrowed per `precision` like the
+  /// raw-bytes overload.
+  public func toDevice<S>(_ tensor: Tensor<S>, on device: Dev, precision: PrecisionPolicy = .init()) throws -> Buffer {
+    try tensor.withUnsafeBytes {
+      try toDevice($0, shape: tensor.shape, dtype: S.dtype, on: device, precision: precision)
+    }
+  }
+
+  /// Downloads `buffer` (of `shape`) into new aligned tensor storage, with
+  /// the backend writing into it directly.
+  public func tensor<S: TensorScalar>(from buffer: Buffer, shape: [Int], as _: S.Type = S.self,
+                                      on device: Device = .cpu(0)) throws -> Tensor<S> {
+    let storage = TensorStorage(uninitializedByteCount: shape.reduce(1, *) * MemoryLayout<S>.stride)
+    let written = try fromDevice(buffer, into: UnsafeMutableRawBufferPointer(start: storage.data, count: storage.byteCount))
+    guard written == storage.byteCount else {
+      throw TensorTransferError.sizeMismatch(expected: storage.byteCount, got: written)
+    }
+    return Tensor(shape: shape, storage: storage, on: device)
+  }
+}
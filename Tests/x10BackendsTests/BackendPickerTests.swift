@@ -1,4 +1,6 @@
 import Testing
+import x10Core
+import x10Runtime
 import x10BackendsSelect
 
 @Test
@@ -6,3 +8,26 @@ func pickerReturnsSupportedKind() {
   let k = BackendPicker.choose()
   #expect(k == .iree || k == .pjrt)
 }
+
+@Test
+func routerCandidatesAreNeverEmpty() {
+  let kinds = BackendPicker.availableKinds()
+  #expect(!kinds.isEmpty)
+  let router = BackendRouter(candidates: kinds, latency: LatencyRouter(storeURL: nil))
+  #expect(kinds.contains(router.choose(StableHLOModule(functions: []))))
+}
+
+@Test
+func routerGivesUpOnceEveryCandidateFails() async {
+  let kinds = BackendPicker.availableKinds()
+  let router = BackendRouter(candidates: kinds, latency: LatencyRouter(storeURL: nil))
+  let fn = IRBuilder().function(name: "main", args: [("x", [4], .f32)], results: [("r", [4], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.add(f.args[0], f.args[0], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  // No backend has a device with this ordinal, so each candidate fails once.
+  await #expect(throws: (any Error).self) {
+    _ = try await router.run(StableHLOModule(functions: [fn]), inputs: [], options: .init(device: .cpu(99)))
+  }
+}
@@ -0,0 +1,85 @@
+import Testing
+import Foundation
+import x10Core
+import x10Runtime
+@testable import x10BackendsIREE
+
+private func tempBundle() -> URL {
+  FileManager.default.temporaryDirectory.appendingPathComponent("x10-\(UUID().uuidString).x10bundle")
+}
+
+private func addModule(_ shape: [Int] = [2, 3]) -> StableHLOModule {
+  let fn = IRBuilder().function(name: "main", args: [("a", shape, .f32), ("b", shape, .f32)],
+                                results: [("r", shape, .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.parameter(1, into: f.args[1])
+    f.add(f.args[0], f.args[1], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+@Test
+func textModulesKeyLikeTheBuiltModuleGivenItsShape() {
+  let built = addModule()
+  let text = StableHLOModule(text: built.textual())
+  #expect(text.textual() == built.textual())
+
+  let backend = IREEBackend()
+  let runtimeKey = JIT.cacheKey(for: built, with: backend, options: .init(device: .cpu(0))).key
+  let bundleKey = JIT.cacheKey(for: text, with: backend, options: .init(device: .cpu(0), shapeHint: [2, 3])).key
+  #expect(runtimeKey == bundleKey)
+}
+
+@Test
+func malformedBundlesAreRejected() throws {
+  let url = tempBundle()
+  defer { try? FileManager.default.removeItem(at: url) }
+
+  try Data("definitely not a bundle, just some bytes".utf8).write(to: url)
+  #expect(throws: (any Error).self) { try IREEBundle(contentsOf: url) }
+  #expect(throws: (any Error).self) { try IREEBundle(contentsOf: url.appendingPathExtension("missing")) }
+
+  // A valid header whose index points past the end of the file.
+  var header = Data(IREEBundle.magic.utf8)
+  for v: UInt32 in [1, 0] { withUnsafeBytes(of: v.littleEndian) { header.append(contentsOf: $0) } }
+  for v: UInt64 in [1 << 20, 64] { withUnsafeBytes(of: v.littleEndian) { header.append(contentsOf: $0) } }
+  try header.write(to: url)
+  #expect(throws: (any Error).self) { try IREEBundle(contentsOf: url) }
+
+  try IREEBundleBuilder().write(to: url)
+  #expect(try IREEBundle(contentsOf: url).entries.isEmpty)
+}
+
+@Test
+func bundledExecutablesPrepopulateTheCacheIfAvailable() async throws {
+  guard IREECompileCLI.find() != nil else { return }
+  let url = tempBundle()
+  defer { try? FileManager.default.removeItem(at: url) }
+
+  // A shape no other test compiles, so its cache entries are this test's own.
+  let module = addModule([3, 7])
+  // The build host's tuned flags stay out of the bundle (this one would not even compile).
+  let db = IREETuningDB(url: nil)
+  db.put(IREETuningRecord(key: IREETuningDB.key(text: module.textual(), target: "llvm-cpu"), target: "llvm-cpu",
+                          flags: ["--x10-no-such-flag"], trials: [], complete: true))
+  var builder = IREEBundleBuilder(tuningDB: db)
+  try builder.add(StableHLOModule(text: module.textual()), shapes: [[3, 7]], options: .init(device: .cpu(0)))
+  try builder.add(module, options: .init(device: .cpu(0), flags: ["variant": "b"]))
+  try builder.write(to: url)
+
+  let bundle = try IREEBundle(contentsOf: url)
+  #expect(bundle.entries.count == 2)
+  // Same IR and target: the artifact is stored once.
+  #expect(bundle.entries[0].offset == bundle.entries[1].offset)
+  #expect(bundle.entries.allSatisfy { $0.offset % UInt64(IREEBundle.pageAlignment) == 0 })
+  #expect(bundle.entries.allSatisfy { $0.compileFlags == IREEBundleBuilder.portableFlags(for: "llvm-cpu") })
+
+  let cache = ExecutableCache(policy: .init(maxEntries: 16, maxBytes: 1 << 30))
+  let execs = await bundle.install(into: cache)
+  #expect(execs.count == 2)
+  let key = JIT.cacheKey(for: module, with: IREEBackend(), options: .init(device: .cpu(0)), moduleSalts: false).key
+  #expect(await cache.get(key) == execs[0])
+  #expect(IREEExecutableRegistry.shared.getVMFB(id: execs[0].id) == bundle.artifact(bundle.entries[0]))
+  for exec in execs { IREEExecutableRegistry.shared.release(id: exec.id) }
+}
@@ -0,0 +1,72 @@
+import Testing
+import Foundation
+import x10Core
+import x10Runtime
+import x10Diagnostics
+@testable import x10BackendsIREE
+
+@Test
+func donationWritesInPlaceOnlyWhenTheDonorIsUnshared() {
+  let result = [Float](repeating: 7, count: 32)
+
+  // The mirror holds the last reference: the result reuses its block.
+  let unique = IREEHostStorage(Data(count: 128))
+  let block = unique.data.withUnsafeBytes { $0.baseAddress }
+  let reused = result.withUnsafeBytes { IREEDonation.write($0, into: unique) }
+  #expect(reused?.withUnsafeBytes { $0.baseAddress } == block)
+  #expect(reused == result.withUnsafeBytes { Data($0) })
+  #expect(unique.data.isEmpty)
+
+  // Still held elsewhere: those bytes are left alone.
+  let held = Data(count: 128)
+  let shared = IREEHostStorage(held)
+  let copied = result.withUnsafeBytes { IREEDonation.write($0, into: shared) }
+  #expect(copied == result.withUnsafeBytes { Data($0) })
+  #expect(held == Data(count: 128))
+
+  // Size mismatch: nothing to reuse, and the donor keeps its block.
+  let small = IREEHostStorage(Data(count: 64))
+  #expect(result.withUnsafeBytes { IREEDonation.write($0, into: small) } == nil)
+  #expect(small.data.count == 64)
+}
+
+@Test
+func ireeBackendWritesAnAliasedResultIntoTheDonatedInput() async throws {
+  guard IREECompileCLI.find() != nil, IREEExecuteCLI.find() != nil else { return }
+
+  // x = x + d  (f32[4,8]); result 0 may reuse parameter 0.
+  let fn = IRBuilder().function(
+    name: "main",
+    args: [("x", [4, 8], .f32), ("d", [4, 8], .f32)],
+    results: [("r", [4, 8], .f32)]
+  ) { f in
+    let x = f.args[0], d = f.args[1], r = f.results[0]
+    f.parameter(0, into: x)
+    f.parameter(1, into: d)
+    f.add(x, d, into: r)
+    f.returnValues([r])
+    f.alias(output: 0, parameter: 0)
+  }
+  let be = IREEBackend()
+  let exec = try be.compile(stablehlo: StableHLOModule(functions: [fn]), options: .init(device: .cpu(0)))
+
+  let x = [Float](repeating: 1, count: 32)
+  let d = [Float](repeating: 2, count: 32)
+  let xBuf = try x.withUnsafeBytes { try be.toDevice($0, shape: [4, 8], dtype: .f32, on: .init(ordinal: 0)) }
+  let dBuf = try d.withUnsafeBytes { try be.toDevice($0, shape: [4, 8], dtype: .f32, on: .init(ordinal: 0)) }
+  func base(_ buffer: Buffer) -> UnsafeRawPointer? {
+    guard let ib = buffer as? IREEDeviceBuffer, case .host(let mirror) = ib.storage else { return nil }
+    return mirror.data.withUnsafeBytes { $0.baseAddress }
+  }
+  let donorBase = base(xBuf)
+
+  let donatedBefore = Diagnostics.donatedOutputs.value
+  let outs = try await be.execute(exec, inputs: [xBuf, dBuf], donating: [0], stream: nil)
+
+  let out: [Float] = try be.fromDevice(outs[0]).withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
+  #expect(out == [Float](repeating: 3, count: 32))
+  #expect(donorBase != nil && base(outs[0]) == donorBase)
+  #expect(Diagnostics.donatedOutputs.value > donatedBefore)
+  // The donated buffer was handed over and is empty now.
+  #expect(try be.fromDevice(xBuf).isEmpty)
+}
@@ -0,0 +1,93 @@
+import Testing
+import Foundation
+import x10Core
+import x10Runtime
+@testable import x10BackendsIREE
+
+private func tempDB() -> URL {
+  FileManager.default.temporaryDirectory.appendingPathComponent("x10-iree-tuning-\(UUID().uuidString).json")
+}
+
+private func addModule(_ n: Int) -> StableHLOModule {
+  let fn = IRBuilder().function(name: "main", args: [("a", [n], .f32), ("b", [n], .f32)],
+                                results: [("r", [n], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.parameter(1, into: f.args[1])
+    f.add(f.args[0], f.args[1], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+@Test
+func tunedFlagsOverrideExtraFlagsByName() {
+  let merged = IREECompileCLI.mergeFlags(["--iree-opt-level=O2", "--iree-opt-data-tiling", "--x"],
+                                         ["--iree-opt-level=O3"])
+  #expect(merged == ["--iree-opt-data-tiling", "--x", "--iree-opt-level=O3"])
+  #expect(IREECompileCLI.mergeFlags([], []) == [])
+}
+
+@Test
+func tuningRecordsPersistAndKeysFollowTheModule() {
+  let url = tempDB()
+  defer { try? FileManager.default.removeItem(at: url) }
+
+  let key = IREETuningDB.key(text: addModule(4).textual(), target: "llvm-cpu")
+  #expect(key == IREETuningDB.key(text: addModule(4).textual(), target: "llvm-cpu"))
+  #expect(key != IREETuningDB.key(text: addModule(8).textual(), target: "llvm-cpu"))
+  #expect(key != IREETuningDB.key(text: addModule(4).textual(), target: "vulkan-spirv"))
+
+  let record = IREETuningRecord(key: key, target: "llvm-cpu", flags: ["--iree-opt-level=O3"],
+                                trials: [.init(flags: [], nanos: 900),
+                                         .init(flags: ["--iree-opt-level=O3"], nanos: 600),
+                                         .init(flags: ["--bogus"], error: "unknown flag")],
+                                complete: true)
+  IREETuningDB(url: url).put(record)
+
+  let reloaded = IREETuningDB(url: url)
+  #expect(reloaded.record(for: key) == record)
+  #expect(reloaded.flags(for: key) == ["--iree-opt-level=O3"])
+  #expect(reloaded.flags(for: "missing") == nil)
+  reloaded.removeAll()
+  #expect(IREETuningDB(url: url).records().isEmpty)
+}
+
+@Test
+func autotunerPicksAWorkingConfigurationIfAvailable() async {
+  guard IREECompileCLI.find() != nil, IREEBackend.isRuntimeAvailable else { return }
+  let db = IREETuningDB(url: nil)
+  let tuner = IREEAutotuner(db: db, runs: 1)
+  let module = addModule(64)
+
+  let record = await tuner.tune(module, target: "llvm-cpu", budget: 60,
+                                candidates: [[], ["--iree-opt-level=O3"], ["--x10-no-such-flag"]])
+  #expect(record != nil)
+  #expect(record?.trials.count == 3)
+  #expect(record?.trials.last?.nanos == nil)
+  #expect(record?.flags != ["--x10-no-such-flag"])
+  #expect(db.flags(for: IREETuningDB.key(text: module.textual(), target: "llvm-cpu")) == record?.flags)
+
+  // Already tuned: nothing is scheduled.
+  #expect(tuner.schedule(module, target: "llvm-cpu") == nil)
+}
+
+@Test
+func tunedFlagsArePartOfTheCacheKey() {
+  let module = addModule(12)
+  let db = IREETuningDB(url: nil)
+  let backend = IREEBackend(tuningDB: db)
+  let options = CompileOptions(flags: ["iree_target": "llvm-cpu"])
+  let before = JIT.cacheKey(for: module, with: backend, options: options).key
+
+  let key = IREETuningDB.key(text: module.textual(), target: "llvm-cpu")
+  db.put(IREETuningRecord(key: key, target: "llvm-cpu", flags: ["--iree-opt-level=O3"], trials: [], complete: true))
+  #expect(db.hasRecords(target: "llvm-cpu") && !db.hasRecords(target: "vulkan-spirv"))
+  let tuned = JIT.cacheKey(for: module, with: backend, options: options).key
+  // Another backend's DB does not leak into this key.
+  #expect(JIT.cacheKey(for: module, with: IREEBackend(tuningDB: IREETuningDB(url: nil)), options: options)
+            .key.fingerprint == before.fingerprint)
+  db.remove(key)
+  #expect(!db.hasRecords(target: "llvm-cpu"))
+  #expect(tuned.fingerprint != before.fingerprint)
+  #expect(JIT.cacheKey(for: module, with: backend, options: options).key.fingerprint == before.fingerprint)
+}
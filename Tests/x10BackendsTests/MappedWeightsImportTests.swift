@@ -0,0 +1,49 @@
+import Testing
+import Foundation
+import x10Core
+import x10Runtime
+import x10BackendsIREE
+import x10BackendsPJRT
+import x10InteropDLPack
+
+/// A one-tensor safetensors checkpoint holding `w: f32[2, 3] = 1...6`.
+private func writeCheckpoint() throws -> URL {
+  let url = FileManager.default.temporaryDirectory.appendingPathComponent("x10-\(UUID().uuidString).safetensors")
+  let json = Data(#"{"w": {"dtype": "F32", "shape": [2, 3], "data_offsets": [0, 24]}}    "#.utf8)
+  var file = Data()
+  withUnsafeBytes(of: UInt64(json.count).littleEndian) { file.append(contentsOf: $0) }
+  file.append(json)
+  [Float(1), 2, 3, 4, 5, 6].withUnsafeBytes { file.append(contentsOf: $0) }
+  try file.write(to: url)
+  return url
+}
+
+@Test
+func mappedWeightsImportIntoBothBackendsWithoutCopying() throws {
+  if !DLPack.isAvailable { return }
+  let url = try writeCheckpoint()
+  defer { try? FileManager.default.removeItem(at: url) }
+
+  let pjrt = PJRTBackend()
+  let iree = IREEBackend()
+  let pjrtBuffer: PJRTDeviceBuffer
+  let ireeBuffer: IREEDeviceBuffer
+  let mappedData: UnsafeMutableRawPointer?
+  do {
+    let weights = try MappedWeights(contentsOf: url)
+    let cap = try weights.capsule("w")
+    mappedData = DLPack.dataPointer(cap)
+    pjrtBuffer = try pjrt.importDLPack(cap)
+    ireeBuffer = try iree.importDLPack(cap)
+    DLPack.dispose(cap)
+  }
+  // The buffers alone keep the file mapped.
+  #expect(ireeBuffer.shape == [2, 3] && ireeBuffer.dtype == .f32)
+  let exported = try iree.exportDLPack(ireeBuffer)
+  #expect(DLPack.dataPointer(exported) == mappedData)
+  DLPack.dispose(exported)
+
+  let expected = [Float(1), 2, 3, 4, 5, 6]
+  #expect(try pjrt.fromDevice(pjrtBuffer).withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == expected)
+  #expect(try iree.fromDevice(ireeBuffer).withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == expected)
+}
@@ -42,3 +42,22 @@ func pjrtDLPackZeroCopyHostAlias() throws {
   let back: [Float] = raw.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
   #expect(back == scalars)
 }
+
+@Test
+func pjrtAcceptsStridedDLPackViews() throws {
+  let scalars: [Float] = [1, 2, 3, 4, 5, 6]
+  let ptr = UnsafeMutableRawPointer.allocate(byteCount: 24, alignment: MemoryLayout<Float>.alignment)
+  _ = scalars.withUnsafeBytes { memcpy(ptr, $0.baseAddress!, 24) }
+  let cap = try DLPack.wrapHostBufferFree(ptr: ptr, shape: [2, 3], dtype: .f32)
+  let transposed = try DLPack.transpose(cap, permutation: [1, 0])
+  defer {
+    DLPack.dispose(transposed)
+    DLPack.dispose(cap)
+  }
+
+  let be = PJRTBackend()
+  let buf = try be.importDLPack(transposed)
+  #expect(buf.shape == [3, 2])
+  let raw = try be.fromDevice(buf)
+  #expect(raw.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == [1, 4, 2, 5, 3, 6])
+}
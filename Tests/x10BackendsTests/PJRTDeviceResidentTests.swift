@@ -0,0 +1,88 @@
+import Testing
+import Foundation
+import PJRTC
+import x10Core
+import x10Runtime
+@testable import x10BackendsPJRT
+
+@Test
+func sharedClientIsCreatedOnceAndBuffersRoundtrip() throws {
+  var first: x10_pjrt_client_t? = nil
+  var second: x10_pjrt_client_t? = nil
+  #expect(x10_pjrt_client_shared(&first) == 1)
+  #expect(x10_pjrt_client_shared(&second) == 1)
+  #expect(first != nil && first == second)
+  x10_pjrt_client_destroy(first)   // ignored for the shared client
+  var third: x10_pjrt_client_t? = nil
+  #expect(x10_pjrt_client_shared(&third) == 1 && third == first)
+
+  let host: [Float] = [1, 2, 3, 4, 5, 6]
+  let dims: [Int64] = [2, 3]
+  var buf: x10_pjrt_buffer_t? = nil
+  let ok = host.withUnsafeBytes { h in
+    x10_pjrt_buffer_from_host(first, 0, h.baseAddress, h.count, Int32(X10_PJRT_TYPE_F32), dims, dims.count, &buf)
+  }
+  #expect(ok == 1)
+  let handle = PJRTBufferHandle(try #require(buf))
+  #expect(handle.shape == [2, 3])
+  #expect(handle.dtype == .f32)
+  let back = try PJRTClient.download(handle)
+  #expect(back.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == host)
+}
+
+@Test
+func mlirEmissionMapsParametersAndAliases() {
+  let fn = IRBuilder().function(name: "step", args: [("a", [2, 3], .f32), ("b", [2, 3], .f32)],
+                                results: [("r", [2, 3], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.parameter(1, into: f.args[1])
+    f.add(f.args[0], f.args[1], into: f.results[0])
+    f.returnValues([f.results[0]])
+    f.alias(output: 0, parameter: 0)
+  }
+  let text = StableHLOModule(functions: [fn]).pjrtMLIR()
+  #expect(text.contains("func.func @main(%arg0: tensor<2x3xf32> {tf.aliasing_output = 0 : i32}, %arg1: tensor<2x3xf32>)"))
+  #expect(text.contains("%0 = stablehlo.add %arg0, %arg1 : tensor<2x3xf32>"))
+  #expect(text.contains("func.return %0 : tensor<2x3xf32>"))
+}
+
+/// Needs a PJRT plugin, e.g. `X10_PJRT_LIB=/path/to/pjrt_c_api_cpu_plugin.so`.
+@Test
+func chainedExecutesStayOnDeviceWithRealPlugin() async throws {
+  guard PJRTClient.isReal else {
+    // A plugin was asked for but the shim fell back to the stub.
+    if ProcessInfo.processInfo.environment["X10_PJRT_LIB"] != nil,
+       ProcessInfo.processInfo.environment["X10_PJRT_FORCE_STUB"] != "1" {
+      Issue.record("X10_PJRT_LIB is set but PJRTClient is not backed by a real plugin")
+    }
+    return
+  }
+
+  let fn = IRBuilder().function(name: "main", args: [("a", [2, 3], .f32), ("b", [2, 3], .f32)],
+                                results: [("r", [2, 3], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.parameter(1, into: f.args[1])
+    f.add(f.args[0], f.args[1], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  let be = PJRTBackend()
+  let dev = try #require(try be.devices().first)
+  let exec = try be.compile(stablehlo: StableHLOModule(functions: [fn]), options: .init(device: .cpu(0)))
+
+  let a: [Float] = [1, 2, 3, 4, 5, 6]
+  let b: [Float] = [10, 10, 10, 10, 10, 10]
+  let bufA = try a.withUnsafeBytes { try be.toDevice($0, shape: [2, 3], dtype: .f32, on: dev) }
+  let bufB = try b.withUnsafeBytes { try be.toDevice($0, shape: [2, 3], dtype: .f32, on: dev) }
+
+  // The intermediate result feeds the second execute as a PJRT_Buffer.
+  let first = try await be.execute(exec, inputs: [bufA, bufB], stream: nil)
+  guard case .handle(let mid) = (first[0] as! PJRTDeviceBuffer).storage else {
+    Issue.record("output is not device-resident")
+    return
+  }
+  let acc = try await be.execute(exec, inputs: [first[0], bufB], stream: nil)
+  #expect(mid.shape == [2, 3])
+
+  let out = try be.fromDevice(acc[0])
+  #expect(out.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == [21, 22, 23, 24, 25, 26])
+}
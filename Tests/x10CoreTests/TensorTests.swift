@@ -7,3 +7,56 @@ func tensorBasics() {
   #expect(t.shape == [2, 3])
   #expect(String(describing: t) == "Tensor<Float>(shape: [2, 3], device: gpu(0))")
 }
+
+@Test
+func tensorStorageIsAlignedAndFilled() {
+  let z = Tensor<Float>.zeros(shape: [3, 5])
+  #expect(Int(bitPattern: z.storage.data) % TensorStorage.alignment == 0)
+  #expect(z.scalars == Array(repeating: 0, count: 15))
+  #expect(Tensor<Int32>.ones(shape: [4]).scalars == [1, 1, 1, 1])
+  #expect(Tensor<Double>(shape: [0]).scalars.isEmpty)
+
+  let t = Tensor<Float>(shape: [2, 3], scalars: [0, 1, 2, 3, 4, 5])
+  #expect(t[1, 2] == 5)
+  #expect(t[0, 1] == 1)
+  #expect(t.byteCount == 24)
+  #expect(t.dtype == .f32)
+}
+
+@Test
+func tensorCopiesShareStorageUntilWritten() {
+  var a = Tensor<Int64>(shape: [2, 2], scalars: [1, 2, 3, 4])
+  let b = a
+  #expect(a.storage === b.storage)
+
+  a[0, 0] = 10
+  #expect(a.storage !== b.storage)
+  #expect(a.scalars == [10, 2, 3, 4])
+  #expect(b.scalars == [1, 2, 3, 4])
+
+  // A unique owner writes in place. Only the address is kept: holding the
+  // storage itself would make it shared and force the copy.
+  let before = a.storage.data
+  a[1, 1] = 40
+  #expect(a.storage.data == before)
+  #expect(a.scalars == [10, 2, 3, 40])
+}
+
+@Test
+func borrowedReadOnlyStorageIsCopiedOnWrite() {
+  let backing = UnsafeMutableRawPointer.allocate(byteCount: 8, alignment: 8)
+  backing.storeBytes(of: 7, as: Int32.self)
+  backing.storeBytes(of: 8, toByteOffset: 4, as: Int32.self)
+  var released = false
+  do {
+    var t = Tensor<Int32>(shape: [2], storage: TensorStorage(borrowing: backing, byteCount: 8, writable: false) {
+      released = true
+    })
+    #expect(t.scalars == [7, 8])
+    t[0] = 1
+    #expect(t.scalars == [1, 8])
+    #expect(backing.load(as: Int32.self) == 7)
+  }
+  #expect(released)
+  backing.deallocate()
+}
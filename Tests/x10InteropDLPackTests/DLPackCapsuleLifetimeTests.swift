@@ -0,0 +1,58 @@
+import Testing
+import Foundation
+import x10Core
+import x10InteropDLPack
+
+private func capsule(_ values: [Float]) throws -> DLPackCapsule {
+  let ptr = UnsafeMutableRawPointer.allocate(byteCount: values.count * 4, alignment: 64)
+  _ = values.withUnsafeBytes { memcpy(ptr, $0.baseAddress!, $0.count) }
+  return try DLPack.wrapHostBufferFree(ptr: ptr, shape: [values.count], dtype: .f32)
+}
+
+@Test
+func concurrentRetainDisposeKeepsTheCapsuleAlive() async throws {
+  if !DLPack.isAvailable { return }
+  let shared = try capsule([1, 2, 3, 4])
+
+  try await withThrowingTaskGroup(of: Void.self) { group in
+    for _ in 0..<16 {
+      group.addTask {
+        for _ in 0..<2_000 {
+          let view = try DLPack.slice(DLPack.retain(shared), axis: 0, 1..<3)
+          DLPack.dispose(shared)
+          DLPack.dispose(view)
+          DLPack.dispose(try capsule([0]))   // churn the freelist
+        }
+      }
+    }
+    try await group.waitForAll()
+  }
+
+  let back = try DLPackHost.toHostData(shared)
+  #expect(back.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == [1, 2, 3, 4])
+  DLPack.dispose(shared)
+}
+
+@Test
+func versionedExchangeAndReadOnlyFlag() throws {
+  if !DLPack.isAvailable { return }
+  let cap = try capsule([5, 6, 7])
+  #expect(!DLPack.isReadOnly(cap))
+
+  // Our own export comes back as the same capsule, carrying the export's reference.
+  let managed = try DLPack.exportVersioned(cap)
+  let imported = try DLPack.importVersioned(managed)
+  #expect(imported == cap)
+  DLPack.dispose(imported)
+
+  // The read-only bit goes on a per-consumer capsule, never on the shared one.
+  let readOnly = try DLPack.readOnlyView(cap)
+  let view = try DLPack.slice(readOnly, axis: 0, 0..<2)
+  #expect(!DLPack.isReadOnly(cap))
+  #expect(DLPack.isReadOnly(readOnly) && DLPack.isReadOnly(view))
+  #expect(DLPack.dataPointer(readOnly) == DLPack.dataPointer(cap))
+  DLPack.dispose(cap)
+  DLPack.dispose(readOnly)
+  #expect(try DLPackHost.toHostData(view).count == 8)
+  DLPack.dispose(view)
+}
@@ -0,0 +1,34 @@
+import Testing
+import Foundation
+import x10Core
+import x10InteropDLPack
+
+@Test
+func copyBytesMatchesAcrossChunkBoundaries() {
+  if !DLPack.isAvailable { return }
+  // Large enough to be split across workers; odd length and offsets so chunk
+  // edges and the unaligned head/tail are exercised.
+  let count = (24 << 20) + 13
+  let src = UnsafeMutableRawPointer.allocate(byteCount: count + 3, alignment: 64)
+  let dst = UnsafeMutableRawPointer.allocate(byteCount: count + 1, alignment: 64)
+  defer { src.deallocate(); dst.deallocate() }
+  let bytes = src.bindMemory(to: UInt8.self, capacity: count + 3)
+  for i in 0..<(count + 3) { bytes[i] = UInt8(truncatingIfNeeded: i &* 131) }
+
+  DLPackHost.copyBytes(from: src + 3, to: dst + 1, count: count)
+  #expect(memcmp(src + 3, dst + 1, count) == 0)
+}
+
+@Test
+func toHostDataReportsLargeSizes() throws {
+  if !DLPack.isAvailable { return }
+  let elements = 3 << 20   // 12 MiB of f32: goes through the chunked path
+  let values = (0..<elements).map { Float($0 % 1000) }
+  let cap = try values.withUnsafeBytes {
+    try DLPackHost.wrapHostCopy(bytes: $0, shape: [elements], dtype: .f32, device: .cpu(0))
+  }
+  defer { DLPack.dispose(cap) }
+  let back = try DLPackHost.toHostData(cap)
+  #expect(back.count == elements * 4)
+  #expect(back.withUnsafeBytes { memcmp($0.baseAddress!, values, elements * 4) } == 0)
+}
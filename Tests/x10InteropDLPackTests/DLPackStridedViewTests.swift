@@ -0,0 +1,57 @@
+import Testing
+import Foundation
+import x10Core
+import x10InteropDLPack
+
+/// f32[3, 4] holding 0...11, owned by the capsule.
+private func iota3x4() throws -> DLPackCapsule {
+  let ptr = UnsafeMutableRawPointer.allocate(byteCount: 12 * 4, alignment: 64)
+  for i in 0..<12 { ptr.storeBytes(of: Float(i), toByteOffset: i * 4, as: Float.self) }
+  return try DLPack.wrapHostBufferFree(ptr: ptr, shape: [3, 4], dtype: .f32)
+}
+
+private func floats(_ cap: DLPackCapsule) throws -> [Float] {
+  try DLPackHost.toHostData(cap).withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
+}
+
+@Test
+func viewsAliasTheParentWithoutCopying() throws {
+  if !DLPack.isAvailable { return }
+  let base = try iota3x4()
+  #expect(DLPack.strides(base) == [4, 1])
+  #expect(DLPack.isContiguous(base))
+
+  let t = try DLPack.transpose(base, permutation: [1, 0])
+  #expect(DLPack.shape(t) == [4, 3] && DLPack.strides(t) == [1, 4])
+  #expect(DLPack.dataPointer(t) == DLPack.dataPointer(base))
+  #expect(!DLPack.isContiguous(t))
+  #expect(try floats(t) == [0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11])
+
+  // Crop rows 1..<3, columns 1..<3.
+  let crop = try DLPack.slice(try DLPack.slice(base, axis: 0, 1..<3), axis: 1, 1..<3)
+  #expect(DLPack.byteOffset(crop) == 5 * 4)
+  #expect(try floats(crop) == [5, 6, 9, 10])
+
+  // Every other column, then broadcast a row over a new leading axis.
+  #expect(try floats(try DLPack.slice(base, axis: 1, 0..<4, step: 2)) == [0, 2, 4, 6, 8, 10])
+  let row = try DLPack.slice(base, axis: 0, 2..<3)
+  let wide = try DLPack.expand(row, to: [2, 3, 4])
+  #expect(DLPack.strides(wide) == [0, 0, 1])
+  #expect(try floats(wide) == Array(repeating: [8, 9, 10, 11] as [Float], count: 6).flatMap { $0 })
+
+  // The views keep the data alive after the parent handle is gone.
+  DLPack.dispose(base)
+  #expect(try floats(crop) == [5, 6, 9, 10])
+  for v in [t, crop, row, wide] { DLPack.dispose(v) }
+}
+
+@Test
+func invalidViewsAreRejected() throws {
+  if !DLPack.isAvailable { return }
+  let base = try iota3x4()
+  defer { DLPack.dispose(base) }
+  #expect(throws: DLPackError.self) { try DLPack.view(base, shape: [3, 5], strides: [4, 1], byteOffset: 0) }
+  #expect(throws: DLPackError.self) { try DLPack.slice(base, axis: 1, 2..<5) }
+  #expect(throws: DLPackError.self) { try DLPack.transpose(base, permutation: [0, 0]) }
+  #expect(throws: DLPackError.self) { try DLPack.expand(base, to: [3, 2]) }
+}
@@ -0,0 +1,146 @@
+import Testing
+import Foundation
+import x10Core
+import x10InteropDLPack
+
+private func tempFile(_ ext: String) -> URL {
+  FileManager.default.temporaryDirectory.appendingPathComponent("x10-\(UUID().uuidString).\(ext)")
+}
+
+private func bytes<T>(_ values: [T]) -> Data { values.withUnsafeBytes { Data($0) } }
+
+/// A safetensors file with `header` (JSON) padded to 8 bytes, then `data`.
+private func writeSafetensors(_ header: String, _ data: Data, to url: URL) throws {
+  var json = Data(header.utf8)
+  while json.count % 8 != 0 { json.append(0x20) }
+  var file = Data()
+  withUnsafeBytes(of: UInt64(json.count).littleEndian) { file.append(contentsOf: $0) }
+  file.append(json)
+  file.append(data)
+  try file.write(to: url)
+}
+
+/// A version-1 `.npy` file whose header is padded to 64 bytes, as NumPy writes it.
+private func writeNPY(descr: String, fortran: Bool, shape: String, _ data: Data, to url: URL) throws {
+  var dict = "{'descr': '\(descr)', 'fortran_order': \(fortran ? "True" : "False"), 'shape': \(shape), }"
+  while (10 + dict.utf8.count + 1) % 64 != 0 { dict += " " }
+  dict += "\n"
+  var file = Data([0x93] + Array("NUMPY".utf8) + [1, 0])
+  withUnsafeBytes(of: UInt16(dict.utf8.count).littleEndian) { file.append(contentsOf: $0) }
+  file.append(Data(dict.utf8))
+  file.append(data)
+  try file.write(to: url)
+}
+
+@Test
+func safetensorsEntriesAliasTheMapping() throws {
+  if !DLPack.isAvailable { return }
+  let url = tempFile("safetensors")
+  defer { try? FileManager.default.removeItem(at: url) }
+  let header = """
+  {"__metadata__": {"format": "pt"},
+   "w": {"dtype": "F32", "shape": [2, 3], "data_offsets": [16, 40]},
+   "step": {"dtype": "I64", "shape": [2], "data_offsets": [0, 16]},
+   "mask": {"dtype": "BOOL", "shape": [4], "data_offsets": [40, 44]}}
+  """
+  var data = bytes([Int64(7), 8])
+  data.append(bytes([Float(1), 2, 3, 4, 5, 6]))
+  data.append(Data([1, 0, 1, 1]))
+  try writeSafetensors(header, data, to: url)
+
+  let weights = try MappedWeights(contentsOf: url)
+  #expect(weights.names == ["step", "w"])
+  #expect(weights.metadata == ["format": "pt"])
+  #expect(weights.skipped["mask"] == "dtype BOOL")
+  #expect(weights["w"]?.shape == [2, 3])
+
+  let cap = try weights.capsule("w")
+  #expect(DLPack.isReadOnly(cap))
+  #expect(DLPack.shape(cap) == [2, 3])
+  #expect(try DLPackHost.toHostData(cap) == bytes([Float(1), 2, 3, 4, 5, 6]))
+  DLPack.dispose(cap)
+
+  let step = try weights.tensor("step", as: Int64.self)
+  #expect(step.scalars == [7, 8])
+  #expect(!step.storage.isWritable)
+  #expect(throws: (any Error).self) { try weights.capsule("missing") }
+}
+
+@Test
+func misalignedEntriesAreCopiedIntoAlignedStorage() throws {
+  if !DLPack.isAvailable { return }
+  let url = tempFile("safetensors")
+  defer { try? FileManager.default.removeItem(at: url) }
+  // `b` starts one byte into the data section, so its floats are misaligned.
+  var data = Data([0x7f])
+  data.append(bytes([Float(1.5), -2]))
+  try writeSafetensors(#"{"a": {"dtype": "I8", "shape": [1], "data_offsets": [0, 1]},"#
+                         + #" "b": {"dtype": "F32", "shape": [2], "data_offsets": [1, 9]}}"#, data, to: url)
+
+  let weights = try MappedWeights(contentsOf: url)
+  #expect(weights["b"].map { $0.byteOffset % 4 } == 1)
+  let b = try weights.tensor("b", as: Float.self)
+  #expect(b.scalars == [1.5, -2])
+  #expect(b.storage.isWritable)
+  b.withUnsafeBytes { #expect(Int(bitPattern: $0.baseAddress) % MemoryLayout<Float>.alignment == 0) }
+}
+
+@Test
+func capsulesKeepTheFileMappedAfterTheLoaderIsGone() throws {
+  if !DLPack.isAvailable { return }
+  let url = tempFile("safetensors")
+  defer { try? FileManager.default.removeItem(at: url) }
+  try writeSafetensors(#"{"a": {"dtype": "F64", "shape": [3], "data_offsets": [0, 24]}}"#,
+                       bytes([1.5, 2.5, 3.5]), to: url)
+
+  var caps: [String: DLPackCapsule] = [:]
+  do { caps = try MappedWeights.safetensors(url).capsules() }
+  // The capsule, not the loader, now holds the only reference to the mapping.
+  let view = try DLPack.slice(caps["a"]!, axis: 0, 1..<3)
+  DLPack.dispose(caps["a"]!)
+  #expect(try DLPackHost.toHostData(view) == bytes([2.5, 3.5]))
+  DLPack.dispose(view)
+}
+
+@Test
+func npyArraysMapInEitherOrder() throws {
+  if !DLPack.isAvailable { return }
+  let urls = [tempFile("npy"), tempFile("npy"), tempFile("npy")]
+  defer { urls.forEach { try? FileManager.default.removeItem(at: $0) } }
+  let names = urls.map { $0.deletingPathExtension().lastPathComponent }
+
+  try writeNPY(descr: "<f4", fortran: false, shape: "(2, 2)", bytes([Float(1), 2, 3, 4]), to: urls[0])
+  let rowMajor = try MappedWeights(contentsOf: urls[0])
+  #expect(rowMajor.names == [names[0]])
+  #expect(rowMajor[names[0]].map { $0.byteOffset % 64 == 0 } == true)
+  #expect(try rowMajor.tensor(names[0], as: Float.self).scalars == [1, 2, 3, 4])
+
+  // Column-major: stored [1, 3, 2, 4] is the matrix [[1, 2], [3, 4]].
+  try writeNPY(descr: "<i4", fortran: true, shape: "(2, 2)", bytes([Int32(1), 3, 2, 4]), to: urls[1])
+  let colMajor = try MappedWeights.npy(urls[1])
+  #expect(colMajor[names[1]]?.strides == [1, 2])
+  #expect(try colMajor.tensor(names[1], as: Int32.self).scalars == [1, 2, 3, 4])
+
+  try writeNPY(descr: "|u1", fortran: false, shape: "(3,)", Data([1, 2, 3]), to: urls[2])
+  #expect(try MappedWeights.npy(urls[2]).skipped[names[2]] == "dtype |u1")
+}
+
+@Test
+func malformedWeightFilesAreRejected() throws {
+  if !DLPack.isAvailable { return }
+  let url = tempFile("safetensors")
+  defer { try? FileManager.default.removeItem(at: url) }
+
+  try Data("not a checkpoint".utf8).write(to: url)
+  #expect(throws: (any Error).self) { try MappedWeights.safetensors(url) }
+  #expect(throws: (any Error).self) { try MappedWeights.npy(url) }
+  #expect(throws: (any Error).self) { try MappedWeights(contentsOf: url.appendingPathExtension("missing")) }
+
+  // Data offsets past the end of the file.
+  try writeSafetensors(#"{"a": {"dtype": "F32", "shape": [4], "data_offsets": [0, 16]}}"#, bytes([Float(1)]), to: url)
+  #expect(throws: (any Error).self) { try MappedWeights.safetensors(url) }
+
+  // Byte count that does not match the shape.
+  try writeSafetensors(#"{"a": {"dtype": "F32", "shape": [2], "data_offsets": [0, 4]}}"#, bytes([Float(1)]), to: url)
+  #expect(throws: (any Error).self) { try MappedWeights.safetensors(url) }
+}
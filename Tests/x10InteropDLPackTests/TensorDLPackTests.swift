@@ -0,0 +1,56 @@
+import Testing
+import Foundation
+import x10Core
+import x10InteropDLPack
+
+@Test
+func tensorExportAliasesItsStorage() throws {
+  if !DLPack.isAvailable { return }
+  var t = Tensor<Float>(shape: [2, 3], scalars: [1, 2, 3, 4, 5, 6])
+  let cap = try t.dlpackCapsule()
+  #expect(DLPack.dataPointer(cap) == t.storage.data)
+  #expect(DLPack.shape(cap) == [2, 3])
+  #expect(DLPack.isReadOnly(cap))
+
+  // Writing to the tensor copies, so the capsule keeps the exported values.
+  t[0, 0] = 100
+  #expect(DLPack.dataPointer(cap) != t.storage.data)
+  #expect(try DLPackHost.toHostData(cap).withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } == [1, 2, 3, 4, 5, 6])
+  DLPack.dispose(cap)
+}
+
+@Test
+func capsuleOutlivesTheTensorItCameFrom() throws {
+  if !DLPack.isAvailable { return }
+  var cap: DLPackCapsule?
+  do {
+    let t = Tensor<Int64>(shape: [3], scalars: [7, 8, 9])
+    cap = try t.dlpackCapsule()
+  }
+  let back = try Tensor<Int64>(dlpack: cap!)
+  DLPack.dispose(cap!)
+  #expect(back.scalars == [7, 8, 9])
+}
+
+@Test
+func importBorrowsDenseCapsulesAndGathersViews() throws {
+  if !DLPack.isAvailable { return }
+  let ptr = UnsafeMutableRawPointer.allocate(byteCount: 6 * 4, alignment: 64)
+  for i in 0..<6 { ptr.storeBytes(of: Float(i), toByteOffset: i * 4, as: Float.self) }
+  let cap = try DLPack.wrapHostBufferFree(ptr: ptr, shape: [2, 3], dtype: .f32)
+
+  var dense = try Tensor<Float>(dlpack: cap)
+  #expect(dense.storage.data == ptr)
+  #expect(!dense.storage.isWritable)
+  dense[0, 0] = -1
+  #expect(ptr.load(as: Float.self) == 0)
+
+  let column = try DLPack.slice(cap, axis: 1, 1..<2)
+  let gathered = try Tensor<Float>(dlpack: column)
+  #expect(gathered.shape == [2, 1])
+  #expect(gathered.scalars == [1, 4])
+  #expect(throws: (any Error).self) { try Tensor<Int32>(dlpack: cap) }
+
+  DLPack.dispose(column)
+  DLPack.dispose(cap)
+}
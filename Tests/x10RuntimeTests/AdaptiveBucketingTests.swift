@@ -0,0 +1,81 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+
+@Test
+func boundarySearchTradesCompilesAgainstPadding() {
+  // Two clusters of sequence lengths.
+  let values: [(value: Int, weight: Double)] =
+    (100...128).map { ($0, 1) } + (480...512).map { ($0, 1) }
+
+  let cheap = AdaptiveBucketing.optimalBoundaries(values, maxBuckets: 8, compileCost: 0.01)
+  #expect(cheap.count >= 2)
+  #expect(cheap.contains(128))
+  #expect(cheap.last == 512)
+
+  // Compiles priced out of reach: one bucket, lots of padding.
+  let expensive = AdaptiveBucketing.optimalBoundaries(values, maxBuckets: 8, compileCost: 100)
+  #expect(expensive == [512])
+  #expect(AdaptiveBucketing.paddingOverhead(values, bounds: expensive) >
+          AdaptiveBucketing.paddingOverhead(values, bounds: cheap))
+
+  // Free compiles: every value exact, no padding.
+  let free = AdaptiveBucketing.optimalBoundaries(Array(values.prefix(5)), maxBuckets: 8, compileCost: 0)
+  #expect(AdaptiveBucketing.paddingOverhead(Array(values.prefix(5)), bounds: free) == 0)
+}
+
+@Test
+func autoPolicyRetunesFromTheShapeProfileAndSharesKeys() async throws {
+  let salt = "adaptive-\(UUID().uuidString)"
+  let config = AdaptiveBucketingConfig(maxBuckets: 4, compileCost: 0.02, retuneEvery: 64)
+  let policy = ShapeBucketingPolicy(adaptive: config)
+  let module = StableHLOModule(functions: [])
+  let profiler = ShapeProfiler(sketchCapacity: 64, halfLifeSeconds: 0)
+
+  func key(_ shape: [Int]) -> (ShapeKey, String) {
+    makeCacheKey(
+      module: module, backendKey: "t", deviceKey: "cpu:0", versionSalt: salt,
+      concreteShape: shape, bucketing: policy
+    )
+  }
+
+  // Deriving keys is not traffic: no plan appears however often it runs.
+  let irHash = key([8, 100]).1
+  for i in 0..<256 { _ = key([8, 100 + (i % 29)]) }
+  #expect(AdaptiveBucketing.plans(irHash: irHash).isEmpty)
+
+  for i in 0..<64 {
+    await profiler.note(irHash: irHash, policy: policy, concreteShape: [8, 100 + (i % 29)])
+  }
+  await AdaptiveBucketing.retune(irHash: irHash, policy: policy, from: profiler)
+  let plan = try #require(AdaptiveBucketing.plans(irHash: irHash).first)
+  #expect(plan.boundaries[0] == [8])
+  #expect(plan.boundaries[1].last == 128)
+  #expect(plan.expectedPaddingOverhead >= 0)
+  #expect(plan.expectedPaddingOverhead < 0.25)
+
+  // Shapes inside the same learned bucket share one executable.
+  #expect(key([8, 127]).0.fingerprint == key([8, 128]).0.fingerprint)
+
+  // The same traffic again does not move the boundaries.
+  for i in 0..<64 {
+    await profiler.note(irHash: irHash, policy: policy, concreteShape: [8, 100 + (i % 29)])
+  }
+  await AdaptiveBucketing.retune(irHash: irHash, policy: policy, from: profiler)
+  #expect(AdaptiveBucketing.plans(irHash: irHash).first?.boundaries == plan.boundaries)
+}
+
+@Test
+func executionsTriggerABackgroundRetune() async throws {
+  let irHash = "adaptive-\(UUID().uuidString)"
+  let policy = ShapeBucketingPolicy(adaptive: AdaptiveBucketingConfig(retuneEvery: 8))
+  let profiler = ShapeProfiler(halfLifeSeconds: 0)
+  for n in 0..<8 {
+    await profiler.note(irHash: irHash, policy: policy, concreteShape: [4, 60 + n])
+    AdaptiveBucketing.noteExecution(irHash: irHash, policy: policy, profiler: profiler)
+  }
+  await AdaptiveBucketing.waitForPendingRetunes()
+  let plan = try #require(AdaptiveBucketing.plans(irHash: irHash).first)
+  #expect(plan.observations == 8)
+}
@@ -0,0 +1,135 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+
+/// Host-memory backend whose executable adds 1 to every element and returns
+/// f32; half-width inputs are widened first.
+private struct AddOneBackend: Backend {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+  struct HostBuffer: Buffer { let shape: [Int]; let dtype: DType; let bytes: [UInt8] }
+
+  final class Log: @unchecked Sendable {
+    private let lock = NSLock()
+    private var sizes: [Int] = []
+    private var dtypes: [DType] = []
+    func add(_ n: Int) { lock.lock(); sizes.append(n); lock.unlock() }
+    func uploaded(_ d: DType) { lock.lock(); dtypes.append(d); lock.unlock() }
+    var batchSizes: [Int] { lock.lock(); defer { lock.unlock() }; return sizes }
+    var uploadTypes: [DType] { lock.lock(); defer { lock.unlock() }; return dtypes }
+  }
+  let log = Log()
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { HostBuffer(shape: shape, dtype: dtype, bytes: []) }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
+    log.uploaded(dtype)
+    return HostBuffer(shape: shape, dtype: dtype, bytes: Array(host))
+  }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { (buffer as! HostBuffer).bytes }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable { Executable() }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] {
+    let x = inputs[0] as! HostBuffer
+    log.add(x.shape[0])
+    let floats = x.bytes.withUnsafeBytes {
+      x.dtype == .f32 ? Array($0.bindMemory(to: Float.self)) : HalfPrecision.widen($0, from: x.dtype)
+    }.map { $0 + 1 }
+    return [HostBuffer(shape: x.shape, dtype: .f32, bytes: floats.withUnsafeBytes { Array($0) })]
+  }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+}
+
+private func addOneFamily(_ n: Int) -> StableHLOModule {
+  let fn = IRBuilder().function(name: "batched_add_one",
+                                args: [("x", [n, 4], .f32)],
+                                results: [("r", [n, 4], .f32)]) { f in
+    let x = f.args[0], r = f.results[0]
+    f.parameter(0, into: x)
+    f.add(x, x, into: r)
+    f.returnValues([r])
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+private func row(_ v: Float) -> Data {
+  [v, v, v, v].withUnsafeBytes { Data($0) }
+}
+
+private func floats(_ d: Data) -> [Float] {
+  d.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
+}
+
+@Test
+func batchingConfigBucketsAndEnvironment() {
+  let c = BatchingConfig(maxBatchSize: 12)
+  #expect(c.batchSizes == [1, 2, 4, 8, 12])
+  #expect(c.bucket(for: 3) == 4)
+  #expect(c.bucket(for: 9) == 12)
+  let env = BatchingConfig.fromEnvironment(["X10_BATCH_MAX_SIZE": "4", "X10_BATCH_MAX_DELAY_US": "500"])
+  #expect(env.maxBatchSize == 4 && env.maxDelay == 0.0005)
+}
+
+@Test
+func concurrentRequestsShareOneExecuteAndGetTheirOwnRows() async throws {
+  let be = AddOneBackend()
+  let scheduler = BatchScheduler(backend: be, device: .init(ordinal: 0),
+                                 config: BatchingConfig(maxBatchSize: 8, maxDelay: 5),
+                                 family: addOneFamily)
+
+  let results = try await withThrowingTaskGroup(of: (Float, [Float]).self) { group in
+    for i in 0..<8 {
+      group.addTask { (Float(i), floats(try await scheduler.submit([row(Float(i))]).first!)) }
+    }
+    return try await group.reduce(into: [:]) { $0[$1.0] = $1.1 }
+  }
+
+  // A full batch dispatches immediately, long before the 5 s deadline.
+  #expect(be.log.batchSizes == [8])
+  for i in 0..<8 { #expect(results[Float(i)] == [Float](repeating: Float(i) + 1, count: 4)) }
+  let stats = await scheduler.stats()
+  #expect(stats.batches == 1 && stats.fillRate == 1)
+}
+
+@Test
+func partialBatchRunsAtDeadlineOnPaddedBucket() async throws {
+  let be = AddOneBackend()
+  let scheduler = BatchScheduler(backend: be, device: .init(ordinal: 0),
+                                 config: BatchingConfig(maxBatchSize: 8, maxDelay: 0.02),
+                                 family: addOneFamily)
+
+  async let a = scheduler.submit([row(10)])
+  async let b = scheduler.submit([row(20)])
+  async let c = scheduler.submit([row(30)])
+  let outs = try await [a, b, c].map { floats($0[0]) }
+
+  #expect(Set(outs.map { $0[0] }) == [11, 21, 31])
+  #expect(be.log.batchSizes == [4])
+  let stats = await scheduler.stats()
+  #expect(stats.requests == 3 && stats.slots == 4)
+  #expect(stats.fillRate == 0.75)
+}
+
+@Test
+func castInputsUploadsTheStackedBatchNarrowed() async throws {
+  let be = AddOneBackend()
+  let options = CompileOptions(precision: PrecisionPolicy(activations: .bf16, castInputs: true))
+  let scheduler = BatchScheduler(backend: be, device: .init(ordinal: 0),
+                                 config: BatchingConfig(maxBatchSize: 2, maxDelay: 5),
+                                 options: options, family: addOneFamily)
+
+  async let a = scheduler.submit([row(2)])
+  async let b = scheduler.submit([row(3)])
+  let outs = try await [a, b].map { floats($0[0]) }
+
+  // The program was compiled for bf16 arguments, so the upload must be bf16 too.
+  #expect(be.log.uploadTypes == [.bf16])
+  #expect(Set(outs.map { $0[0] }) == [3, 4])
+}
+
+@Test
+func malformedRequestIsRejected() async {
+  let scheduler = BatchScheduler(backend: AddOneBackend(), device: .init(ordinal: 0), family: addOneFamily)
+  await #expect(throws: BatchingError.self) { try await scheduler.submit([Data(count: 3)]) }
+}
@@ -0,0 +1,104 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+
+private func bytes<T>(_ values: [T]) -> Data { values.withUnsafeBytes { Data($0) } }
+private func values<T>(_ data: Data, as: T.Type) -> [T] { data.withUnsafeBytes { Array($0.bindMemory(to: T.self)) } }
+
+/// Runs `body` once per rank concurrently and returns results in rank order.
+private func perRank(_ groups: [CollectiveGroup],
+                     _ body: @escaping @Sendable (CollectiveGroup) async throws -> Data) async throws -> [Data] {
+  try await withThrowingTaskGroup(of: (Int, Data).self) { tasks in
+    for g in groups { tasks.addTask { (g.rank, try await body(g)) } }
+    var out = [Data](repeating: Data(), count: groups.count)
+    for try await (rank, data) in tasks { out[rank] = data }
+    return out
+  }
+}
+
+private func members(_ n: Int) -> [String] { (0..<n).map { "test-coll:\($0)" } }
+
+@Test(arguments: [CollectiveAlgorithm.ring, .tree])
+func allReduceSumMatchesSerialReference(algorithm: CollectiveAlgorithm) async throws {
+  for ranks in 1...5 {
+    for count in [3, 64, 1000] {
+      // 64-byte segments force many pipelined units per step.
+      let groups = CollectiveGroup.make(members: members(ranks),
+                                        config: CollectiveConfig(algorithm: algorithm, segmentBytes: 64))
+      let inputs = (0..<ranks).map { r in (0..<count).map { Float(r * 1000 + $0) } }
+      let expected = (0..<count).map { i in inputs.reduce(Float(0)) { $0 + $1[i] } }
+
+      let outs = try await perRank(groups) { g in
+        try await g.allReduce(bytes(inputs[g.rank]), dtype: .f32, op: .sum)
+      }
+      for out in outs { #expect(values(out, as: Float.self) == expected) }
+    }
+  }
+}
+
+@Test
+func allReduceMaxMinOnIntegers() async throws {
+  let groups = CollectiveGroup.make(members: members(4), config: CollectiveConfig(algorithm: .ring, segmentBytes: 128))
+  let inputs: [[Int64]] = (0..<4).map { r in (0..<37).map { Int64(($0 * 7 + r * 13) % 29) - 10 } }
+
+  let maxes = try await perRank(groups) { try await $0.allReduce(bytes(inputs[$0.rank]), dtype: .i64, op: .max) }
+  let mins = try await perRank(groups) { try await $0.allReduce(bytes(inputs[$0.rank]), dtype: .i64, op: .min) }
+  #expect(values(maxes[2], as: Int64.self) == (0..<37).map { i in inputs.map { $0[i] }.max()! })
+  #expect(values(mins[1], as: Int64.self) == (0..<37).map { i in inputs.map { $0[i] }.min()! })
+}
+
+@Test
+func allReduceHalfPrecisionWidensToFloat() async throws {
+  let groups = CollectiveGroup.make(members: members(3))
+  let one = ReductionKernels.floatToBfloat(1.5)
+  let outs = try await perRank(groups) { g in
+    try await g.allReduce(bytes([UInt16](repeating: one, count: 40)), dtype: .bf16, op: .sum)
+  }
+  #expect(values(outs[0], as: UInt16.self).allSatisfy { ReductionKernels.bfloatToFloat($0) == 4.5 })
+
+  for f: Float in [0, 1, -2.5, 65504, 6.103515625e-5, 3e-7, .infinity] {
+    #expect(ReductionKernels.halfToFloat(ReductionKernels.floatToHalf(f)) == (f == 3e-7 ? 2.98023224e-7 : f))
+  }
+}
+
+@Test
+func allGatherAndReduceScatter() async throws {
+  let groups = CollectiveGroup.make(members: members(3))
+  let gathered = try await perRank(groups) { g in try await g.allGather(bytes([Int32](repeating: Int32(g.rank), count: 5))) }
+  for out in gathered { #expect(values(out, as: Int32.self) == [0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2]) }
+
+  // 10 elements over 3 ranks: chunks of 4, 3, 3.
+  let scattered = try await perRank(groups) { g in
+    try await g.reduceScatter(bytes((0..<10).map { Int32($0 + g.rank) }), dtype: .i32, op: .sum)
+  }
+  #expect(values(scattered[0], as: Int32.self) == [3, 6, 9, 12])
+  #expect(values(scattered[1], as: Int32.self) == [15, 18, 21])
+  #expect(values(scattered[2], as: Int32.self) == [24, 27, 30])
+}
+
+@Test
+func mismatchedCallsFailInsteadOfHanging() async throws {
+  let groups = CollectiveGroup.make(members: members(2))
+  await #expect(throws: CollectiveError.self) {
+    _ = try await perRank(groups) { g in
+      try await g.allReduce(bytes([Float](repeating: 1, count: 8 + g.rank)), dtype: .f32, op: .sum)
+    }
+  }
+}
+
+@Test
+func cancellingAWaitingRankFailsTheCollective() async throws {
+  let names = (0..<2).map { "test-coll-cancel-\(UUID().uuidString):\($0)" }
+  let groups = CollectiveGroup.make(members: names)
+  let payload = bytes([Float](repeating: 1, count: 64))
+
+  let waiting = Task { try await groups[0].allReduce(payload, dtype: .f32, op: .sum) }
+  waiting.cancel()
+  await #expect(throws: CancellationError.self) { try await waiting.value }
+  // A peer arriving after the failure sees it instead of waiting forever.
+  await #expect(throws: CancellationError.self) { try await groups[1].allReduce(payload, dtype: .f32, op: .sum) }
+
+  // Both ranks have left, so their blocks went back to the pools.
+  for name in names { #expect(Memory.pool(for: name).stats.liveBytes == 0) }
+}
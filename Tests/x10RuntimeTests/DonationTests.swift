@@ -0,0 +1,68 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+
+private struct PassthroughBackend: Backend {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { struct B: Buffer {}; return B() }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer { struct B: Buffer {}; return B() }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { [] }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable { Executable() }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] { Array(inputs.prefix(1)) }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+}
+
+private func updateModule(aliased: Bool) -> StableHLOModule {
+  let fn = IRBuilder().function(name: "main",
+                                args: [("x", [4, 8], .f32), ("d", [4, 8], .f32)],
+                                results: [("r", [4, 8], .f32)]) { f in
+    let x = f.args[0], d = f.args[1], r = f.results[0]
+    f.parameter(0, into: x)
+    f.parameter(1, into: d)
+    f.add(x, d, into: r)
+    f.returnValues([r])
+    if aliased { f.alias(output: 0, parameter: 0) }
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+@Test
+func invalidAliasesAreDropped() {
+  var fn = updateModule(aliased: true).functions[0]
+  fn.inputOutputAliases += [
+    .init(output: 0, parameter: 1),   // result already aliased
+    .init(output: 3, parameter: 1),   // no such result
+  ]
+  #expect(fn.validInputOutputAliases == [.init(output: 0, parameter: 0)])
+
+  fn.args[0].dtype = .f16
+  #expect(fn.validInputOutputAliases == [.init(output: 0, parameter: 1)])
+}
+
+@Test
+func donationPlanOnlyCoversDonatedParameters() {
+  let aliases: [StableHLOModule.InputOutputAlias] = [.init(output: 0, parameter: 0), .init(output: 1, parameter: 2)]
+  #expect(aliases.donationPlan(donating: []) == [:])
+  #expect(aliases.donationPlan(donating: [2]) == [1: 2])
+  #expect(aliases.donationPlan(donating: [0, 1, 2]) == [0: 0, 1: 2])
+}
+
+@Test
+func aliasingIsPartOfTheCacheKey() {
+  let be = PassthroughBackend()
+  let plain = JIT.cacheKey(for: updateModule(aliased: false), with: be).key
+  let aliased = JIT.cacheKey(for: updateModule(aliased: true), with: be).key
+  #expect(plain != aliased)
+}
+
+@Test
+func backendsWithoutReuseIgnoreDonation() async throws {
+  struct B: Buffer {}
+  let outs = try await PassthroughBackend().execute(Executable(), inputs: [B(), B()], donating: [0], stream: nil)
+  #expect(outs.count == 1)
+}
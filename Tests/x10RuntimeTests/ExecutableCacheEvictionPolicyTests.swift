@@ -0,0 +1,75 @@
+import Testing
+import Foundation
+import x10Core
+@testable import x10Runtime
+
+@Test
+func gdsfKeepsExpensiveEntryThatLRUWouldEvict() async throws {
+  let policy = CachePolicy(maxEntries: 2, maxBytes: 1024, eviction: .gdsf)
+  let cache = ExecutableCache(policy: policy)
+
+  let slow = ShapeKey(fingerprint: "slow", versionSalt: "salt")
+  let fastA = ShapeKey(fingerprint: "fast-a", versionSalt: "salt")
+  let fastB = ShapeKey(fingerprint: "fast-b", versionSalt: "salt")
+
+  await cache.put(Executable(), for: slow, compileSeconds: 40)
+  await cache.put(Executable(), for: fastA, compileSeconds: 0.04)
+  await cache.put(Executable(), for: fastB, compileSeconds: 0.04)
+
+  // Under LRU `slow` would be the victim; GDSF drops the cheap entry instead.
+  #expect(await cache.get(slow) != nil)
+  #expect(await cache.get(fastA) == nil)
+  #expect(await cache.get(fastB) != nil)
+}
+
+@Test
+func evictionPolicyParsesFromEnvironment() {
+  #expect(CachePolicy.fromEnvironment([:]).eviction.description == "lru")
+  #expect(CachePolicy.fromEnvironment(["X10_CACHE_EVICTION": "gdsf"]).eviction.description == "gdsf")
+  #expect(CachePolicy.fromEnvironment(["X10_CACHE_EVICTION": "bogus"]).eviction.description == "lru")
+}
+
+@Test
+func simulatorRanksGDSFAheadOfLRUOnMixedCostTrace() throws {
+  // One slow model re-used every few steps amid a scan of cheap shapes.
+  var trace: [CacheTraceEvent] = []
+  for round in 0..<20 {
+    trace.append(CacheTraceEvent(fingerprint: "big", compileSeconds: 30))
+    for i in 0..<4 {
+      trace.append(CacheTraceEvent(fingerprint: "small-\(round)-\(i)", compileSeconds: 0.05))
+    }
+  }
+
+  let lru = CachePolicy(maxEntries: 3, maxBytes: 1 << 20, eviction: .lru)
+  let gdsf = CachePolicy(maxEntries: 3, maxBytes: 1 << 20, eviction: .gdsf)
+  let results = CacheSimulator.compare(trace, policies: [lru, gdsf])
+
+  #expect(results.first?.policyName == "gdsf")
+  let byName = Dictionary(uniqueKeysWithValues: results.map { ($0.policyName, $0) })
+  #expect(byName["lru"]!.totalRecompileSeconds >= 30 * 19)
+  #expect(byName["gdsf"]!.totalRecompileSeconds < 1)
+
+  // Round-trip through disk to exercise the offline workflow.
+  let url = FileManager.default.temporaryDirectory
+    .appendingPathComponent(UUID().uuidString).appendingPathExtension("json")
+  defer { try? FileManager.default.removeItem(at: url) }
+  try CacheSimulator.save(trace, to: url)
+  #expect(try CacheSimulator.loadTrace(from: url) == trace)
+}
+
+@Test
+func recordedTraceReplaysLikeTheLiveCache() async {
+  let policy = CachePolicy(maxEntries: 2, maxBytes: 1024)
+  let cache = ExecutableCache(policy: policy)
+  await cache.startRecordingTrace()
+
+  let keys = (0..<3).map { ShapeKey(fingerprint: "k\($0)", versionSalt: "salt") }
+  for key in keys { await cache.put(Executable(), for: key, compileSeconds: 1) }
+  _ = await cache.get(keys[2])
+
+  let trace = await cache.stopRecordingTrace()
+  #expect(trace.count == 4)
+  let replay = CacheSimulator.replay(trace, policy: policy)
+  #expect(replay.hits == 1)
+  #expect(replay.evictions == 1)
+}
@@ -0,0 +1,66 @@
+import Testing
+import Foundation
+import x10Core
+@testable import x10Runtime
+
+private final class ReleasedIDs: @unchecked Sendable {
+  private let lock = NSLock()
+  private var ids: Set<UUID> = []
+  func insert(_ id: UUID) { lock.lock(); ids.insert(id); lock.unlock() }
+  func contains(_ id: UUID) -> Bool { lock.lock(); defer { lock.unlock() }; return ids.contains(id) }
+}
+
+@Test
+func evictionAndClearReleaseBackendArtifacts() async {
+  let released = ReleasedIDs()
+  let registration = ExecutableLifecycle.registerReleaseHandler { released.insert($0.id) }
+  defer { registration.unregister() }
+
+  let cache = ExecutableCache(policy: CachePolicy(maxEntries: 1, maxBytes: 1024))
+  let firstID: UUID, secondID: UUID
+  do {
+    let first = Executable(), second = Executable()
+    (firstID, secondID) = (first.id, second.id)
+    await cache.put(first, for: ShapeKey(fingerprint: "a", versionSalt: "salt"))
+    await cache.put(second, for: ShapeKey(fingerprint: "b", versionSalt: "salt"))
+  }
+  #expect(released.contains(firstID))
+  #expect(!released.contains(secondID))
+
+  await cache.clear()
+  #expect(released.contains(secondID))
+}
+
+@Test
+func evictedExecutablesStayUsableWhileCallersHoldThem() async {
+  let released = ReleasedIDs()
+  let registration = ExecutableLifecycle.registerReleaseHandler { released.insert($0.id) }
+  defer { registration.unregister() }
+
+  let cache = ExecutableCache(policy: CachePolicy(maxEntries: 1, maxBytes: 1024))
+  var held: Executable? = Executable()
+  let id = held!.id
+  await cache.put(held!, for: ShapeKey(fingerprint: "a", versionSalt: "salt"))
+  await cache.clear()
+  #expect(!released.contains(id))
+  #expect(ExecutableHandles.liveCount(id) == 1)
+
+  held = nil
+  #expect(released.contains(id))
+  #expect(ExecutableHandles.liveCount(id) == 0)
+}
+
+@Test
+func unregisteredHandlersAreNotCalled() async {
+  let released = ReleasedIDs()
+  ExecutableLifecycle.registerReleaseHandler { released.insert($0.id) }.unregister()
+  let cache = ExecutableCache(policy: CachePolicy(maxEntries: 1, maxBytes: 1024))
+  let id: UUID
+  do {
+    let exec = Executable()
+    id = exec.id
+    await cache.put(exec, for: ShapeKey(fingerprint: "a", versionSalt: "salt"))
+  }
+  await cache.clear()
+  #expect(!released.contains(id))
+}
@@ -0,0 +1,80 @@
+import Testing
+import Foundation
+import x10Core
+@testable import x10Runtime
+
+private func codes(_ data: Data) -> [UInt8] { Array(data) }
+
+@Test
+func quantizeRoundsToNearestEvenAndSaturates() {
+  // 13 values so the vector body and the padded tail both run; 1.0625 and
+  // 1.1875 are ties that round to the even mantissa.
+  let values: [Float] = [1, -1, 448, 1000, .infinity, 0x1p-9, 0, -0.0, 1.0625, 1.1875, 57344, -.infinity, .nan]
+  let e4m3 = FP8.quantize(values, to: .f8E4M3FN, scale: 1)
+  #expect(e4m3.scale == 1)
+  #expect(codes(e4m3.data) == [0x38, 0xB8, 0x7E, 0x7E, 0x7E, 0x01, 0x00, 0x80, 0x38, 0x3A, 0x7E, 0xFE, 0x7F])
+  let e5m2 = FP8.quantize(values, to: .f8E5M2, scale: 1)
+  #expect(codes(e5m2.data) == [0x3C, 0xBC, 0x5F, 0x64, 0x7B, 0x18, 0x00, 0x80, 0x3C, 0x3D, 0x7B, 0xFB, 0x7F])
+
+  let back = e4m3.data.withUnsafeBytes { FP8.dequantize($0, from: .f8E4M3FN) }
+  #expect(Array(back.prefix(12)) == [1, -1, 448, 448, 448, 0x1p-9, 0, -0.0, 1, 1.25, 448, -448])
+  #expect(back[12].isNaN)
+}
+
+@Test
+func everyCodeRoundTrips() {
+  // Decoding then re-encoding is the identity on all non-NaN codes (E5M2
+  // infinities saturate, so they come back as ±57344).
+  let all = Data((0...255).map(UInt8.init))
+  for dtype in [DType.f8E4M3FN, .f8E5M2] {
+    let decoded = all.withUnsafeBytes { FP8.dequantize($0, from: dtype) }
+    let again = codes(FP8.quantize(decoded, to: dtype, scale: 1).data)
+    for code in 0...255 where decoded[code].isFinite {
+      #expect(again[code] == UInt8(code), "\(dtype) code \(code)")
+    }
+  }
+}
+
+@Test
+func perTensorScaleMapsAbsmaxOntoTheLargestFiniteValue() {
+  let weights: [Float] = [-3, 2, 1.5, 0.01]
+  let q = FP8.quantize(weights, to: .f8E4M3FN)
+  #expect(q.scale == 3 / FP8.maxFinite(.f8E4M3FN))
+  #expect(q.data.count == weights.count)
+  #expect(codes(q.data)[0] == 0xFE)   // -448
+
+  let restored = q.data.withUnsafeBytes { FP8.dequantize($0, from: .f8E4M3FN, scale: q.scale) }
+  for (a, b) in zip(weights, restored) { #expect(abs(a - b) <= abs(a) / 16) }
+
+  #expect(FP8.quantize([0, 0], to: .f8E5M2).scale == 1)
+  #expect(FP8.quantize([1, .infinity], to: .f8E5M2).scale == 1)
+}
+
+@Test
+func fp8ReductionsWidenAndSaturate() {
+  var dst = FP8.quantize([1, 300, -2], to: .f8E4M3FN, scale: 1).data
+  let src = FP8.quantize([0.5, 300, -4], to: .f8E4M3FN, scale: 1).data
+  dst.withUnsafeMutableBytes { d in
+    src.withUnsafeBytes { s in
+      ReductionKernels.reduce(d.baseAddress!, s.baseAddress!, count: 3, dtype: .f8E4M3FN, op: .sum)
+    }
+  }
+  #expect(dst.withUnsafeBytes { FP8.dequantize($0, from: .f8E4M3FN) } == [1.5, 448, -6])
+}
+
+@Test
+func fp8PolicyRefusesUnscaledInputCasts() throws {
+  // Scale-1 E4M3FN would saturate at ±448 and flush small inputs to zero.
+  let policy = PrecisionPolicy(activations: .fp8, castInputs: true)
+  #expect(throws: PrecisionCastingError.self) { try policy.inputCastType }
+  #expect(DType.f8E4M3FN.byteWidth == 1)
+  #expect(DType.fromIREE(token: DType.f8E5M2.ireeToken) == .f8E5M2)
+
+  let fn = IRBuilder().function(name: "main", args: [("x", [4], .f32)], results: [("r", [4], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.add(f.args[0], f.args[0], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  let text = try StableHLOModule(functions: [fn]).castingInputs(to: .f8E4M3FN).textual()
+  #expect(text.contains("stablehlo.convert %x_f8E4M3FN : f8E4M3FN[4] -> f32[4]"))
+}
@@ -0,0 +1,123 @@
+import Testing
+import Foundation
+import x10Core
+@testable import x10Runtime
+
+/// Records uploads and the module handed to `compile`.
+private final class RecordingBackend: Backend, @unchecked Sendable {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+  struct B: Buffer { let bytes: Int; let dtype: DType }
+
+  private let lock = NSLock()
+  private(set) var uploads: [B] = []
+  private(set) var compiled: StableHLOModule?
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { B(bytes: 0, dtype: dtype) }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
+    let b = B(bytes: host.count, dtype: dtype)
+    lock.lock(); uploads.append(b); lock.unlock()
+    return b
+  }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { [] }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable {
+    lock.lock(); compiled = stablehlo; lock.unlock()
+    return Executable()
+  }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] { inputs }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+}
+
+@Test
+func bulkConversionsMatchTheScalarReference() {
+  // Odd count so the SIMD body and the scalar tail both run.
+  var values: [Float] = (0..<37).map { Float($0) * 0.3127 - 5 }
+  values += [65504, 65520, 1e-7, -0.0, .infinity, 3.0e38, 1.0 + 0x1p-8, 1.0 + 0x1p-11]
+  let f16 = HalfPrecision.narrow(values, to: .f16)
+  let bf16 = HalfPrecision.narrow(values, to: .bf16)
+  #expect(f16.count == values.count * 2)
+
+  let halfWords = f16.withUnsafeBytes { Array($0.bindMemory(to: UInt16.self)) }
+  let bfWords = bf16.withUnsafeBytes { Array($0.bindMemory(to: UInt16.self)) }
+  #expect(halfWords == values.map(ReductionKernels.floatToHalf))
+  #expect(bfWords == values.map(ReductionKernels.floatToBfloat))
+
+  #expect(f16.withUnsafeBytes { HalfPrecision.widen($0, from: .f16) } == halfWords.map(ReductionKernels.halfToFloat))
+  #expect(bf16.withUnsafeBytes { HalfPrecision.widen($0, from: .bf16) } == bfWords.map(ReductionKernels.bfloatToFloat))
+
+  let nan = HalfPrecision.narrow([.nan, -.nan], to: .bf16)
+  #expect(nan.withUnsafeBytes { HalfPrecision.widen($0, from: .bf16) }.allSatisfy(\.isNaN))
+}
+
+private func addModule() -> StableHLOModule {
+  let fn = IRBuilder().function(name: "main",
+                                args: [("x", [8], .f32), ("n", [8], .i32), ("y", [8], .f32)],
+                                results: [("r", [8], .f32)]) { f in
+    let x = f.args[0], y = f.args[2], r = f.results[0]
+    f.parameter(0, into: x)
+    f.add(x, y, into: r)   // `y` is used without a parameter op
+    f.returnValues([r])
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+@Test
+func castingInputsRetypesF32ArgumentsAndConvertsOnEntry() throws {
+  let cast = try addModule().castingInputs(to: .bf16)
+  let fn = cast.functions[0]
+  #expect(fn.args.map(\.dtype) == [.bf16, .i32, .bf16])
+  let converts = fn.ops.compactMap { op -> (String, String)? in
+    if case .convert(let a, let r) = op { return (a.name, r.name) } else { return nil }
+  }
+  #expect(converts.map(\.1).sorted() == ["x", "y"])
+  #expect(cast.textual().contains("stablehlo.convert %x_bf16 : bf16[8] -> f32[8]"))
+  #expect(try addModule().castingInputs(to: .f16).functions[0].args[1].dtype == .i32)
+}
+
+@Test
+func castInputsPolicyHalvesUploadsAndCompilesTheNarrowedProgram() async throws {
+  let backend = RecordingBackend()
+  let precision = PrecisionPolicy(activations: .bf16, castInputs: true)
+  let module = addModule()
+
+  _ = try await JIT.compileCached(module, with: backend, options: .init(precision: precision))
+  #expect(backend.compiled?.functions[0].args.map(\.dtype) == [.bf16, .i32, .bf16])
+
+  let x = [Float](repeating: 1.5, count: 8)
+  _ = try x.withUnsafeBytes { try backend.toDevice($0, shape: [8], dtype: .f32, on: .init(ordinal: 0), precision: precision) }
+  _ = try x.withUnsafeBytes { try backend.toDevice($0, shape: [8], dtype: .f32, on: .init(ordinal: 0), precision: .init()) }
+  #expect(backend.uploads.map(\.bytes) == [16, 32])
+  #expect(backend.uploads.map(\.dtype) == [.bf16, .f32])
+
+  // The policy is part of the cache key, so the f32 program is compiled separately.
+  let plain = JIT.cacheKey(for: module, with: backend, options: .init()).key
+  let narrowed = JIT.cacheKey(for: module, with: backend, options: .init(precision: precision)).key
+  #expect(plain.fingerprint != narrowed.fingerprint)
+}
+
+@Test
+func castInputsRefusesVerbatimModules() async throws {
+  let backend = RecordingBackend()
+  let text = StableHLOModule(text: "func.func @main(%x: tensor<8xf32>) -> tensor<8xf32> { return %x : tensor<8xf32> }")
+  let precision = PrecisionPolicy(activations: .bf16, castInputs: true)
+  await #expect(throws: PrecisionCastingError.self) {
+    _ = try await JIT.compileCached(text, with: backend, options: .init(precision: precision))
+  }
+  #expect(backend.compiled == nil)
+}
+
+@Test
+func castInputsRefusesFP8Activations() async throws {
+  let backend = RecordingBackend()
+  let precision = PrecisionPolicy(activations: .fp8, castInputs: true)
+  await #expect(throws: PrecisionCastingError.self) {
+    _ = try await JIT.compileCached(addModule(), with: backend, options: .init(precision: precision))
+  }
+  let x = [Float](repeating: 1000, count: 8)
+  #expect(throws: PrecisionCastingError.self) {
+    try x.withUnsafeBytes { try backend.toDevice($0, shape: [8], dtype: .f32, on: .init(ordinal: 0), precision: precision) }
+  }
+  #expect(backend.compiled == nil && backend.uploads.isEmpty)
+}
@@ -0,0 +1,104 @@
+import Testing
+import Foundation
+import x10Core
+@testable import x10Runtime
+
+private let arms = ["pjrt", "iree"]
+
+/// Drives `router` like a caller: choose, "run" with the given latency, record.
+@discardableResult
+private func call(_ router: LatencyRouter, _ key: String, latency: [String: UInt64]) -> String {
+  let arm = router.choose(key, among: arms)
+  router.record(key, candidate: arm, nanos: latency[arm]!, among: arms)
+  return arm
+}
+
+private func tempStore() -> URL {
+  FileManager.default.temporaryDirectory.appendingPathComponent("x10-routes-\(UUID().uuidString).json")
+}
+
+@Test
+func exploresEveryCandidateThenRoutesToTheFastest() {
+  let router = LatencyRouter(config: .init(explorationRuns: 3, reevaluateEvery: 0), storeURL: nil)
+  let latency: [String: UInt64] = ["pjrt": 900, "iree": 300]
+
+  // One warm-up plus three timed runs per candidate.
+  let explored = (0..<8).map { _ in call(router, "k", latency: latency) }
+  #expect(explored.filter { $0 == "pjrt" }.count == 4)
+  #expect(explored.filter { $0 == "iree" }.count == 4)
+
+  let route = router.route(for: "k")
+  #expect(route?.winner == "iree")
+  #expect(route?.explored == ["pjrt": 900, "iree": 300])
+  #expect((0..<20).allSatisfy { _ in call(router, "k", latency: latency) == "iree" })
+  #expect(router.route(for: "k")?.routedCalls == 20)
+
+  // Keys are independent.
+  #expect(router.route(for: "other") == nil)
+}
+
+@Test
+func reevaluationPicksUpAChangedWinner() {
+  let router = LatencyRouter(config: .init(explorationRuns: 2, reevaluateEvery: 5), storeURL: nil)
+  for _ in 0..<6 { call(router, "k", latency: ["pjrt": 100, "iree": 500]) }
+  #expect(router.route(for: "k")?.winner == "pjrt")
+
+  // pjrt slows down; after 5 routed calls the key is explored again.
+  for _ in 0..<12 { call(router, "k", latency: ["pjrt": 800, "iree": 500]) }
+  let route = router.route(for: "k")
+  #expect(route?.winner == "iree")
+  #expect(route?.decisions == 2)
+  #expect(route!.recent["pjrt"]! > 100)
+}
+
+@Test
+func decisionsPersistAcrossRouters() throws {
+  let url = tempStore()
+  defer { try? FileManager.default.removeItem(at: url) }
+
+  let first = LatencyRouter(config: .init(explorationRuns: 1, reevaluateEvery: 0), storeURL: url)
+  for _ in 0..<4 { call(first, "k", latency: ["pjrt": 100, "iree": 500]) }
+  #expect(first.route(for: "k")?.winner == "pjrt")
+
+  // A new process starts routing immediately, without exploring.
+  let second = LatencyRouter(config: .init(explorationRuns: 1, reevaluateEvery: 0), storeURL: url)
+  #expect(second.routes() == first.routes())
+  #expect(second.choose("k", among: arms) == "pjrt")
+
+  // A winner that is no longer a candidate is ignored.
+  #expect(second.choose("k", among: ["iree"]) == "iree")
+
+  second.reset()
+  #expect(LatencyRouter(storeURL: url).routes().isEmpty)
+}
+
+@Test
+func routeKeyIgnoresTheBackend() {
+  let fn = IRBuilder().function(name: "main", args: [("x", [4], .f32)], results: [("r", [4], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.add(f.args[0], f.args[0], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  let module = StableHLOModule(functions: [fn])
+  let key = JIT.routeKey(for: module, options: .init(device: .cpu(0)))
+  #expect(key == JIT.routeKey(for: module, options: .init(device: .cpu(0))))
+  #expect(key != JIT.routeKey(for: module, options: .init(device: .cpu(0), flags: ["x": "1"])))
+}
+
+@Test
+func failedCandidatesAreSkippedForTheirKey() {
+  let router = LatencyRouter(config: .init(explorationRuns: 1, reevaluateEvery: 0), storeURL: nil)
+  for _ in 0..<4 { call(router, "k", latency: ["pjrt": 100, "iree": 500]) }
+  #expect(router.route(for: "k")?.winner == "pjrt")
+
+  // The winner fails: calls move to the other candidate, other keys are untouched.
+  router.recordFailure("k", candidate: "pjrt")
+  #expect(router.route(for: "k")?.winner == nil)
+  #expect((0..<5).allSatisfy { _ in call(router, "k", latency: ["pjrt": 100, "iree": 500]) == "iree" })
+  #expect(router.route(for: "k")?.winner == "iree")
+  #expect(router.choose("other", among: arms) == "pjrt")
+
+  // With every candidate failed, the full list is used again.
+  router.recordFailure("k", candidate: "iree")
+  #expect(arms.contains(router.choose("k", among: arms)))
+}
@@ -0,0 +1,72 @@
+import Testing
+import Foundation
+@testable import x10Runtime
+
+@Test
+func sizeClassesAreAlignedWithBoundedSlack() {
+  #expect(MemoryPool.sizeClass(1) == 64)
+  #expect(MemoryPool.sizeClass(64) == 64)
+  #expect(MemoryPool.sizeClass(65) == 128)
+  #expect(MemoryPool.sizeClass(1000) == 1024)
+  #expect(MemoryPool.sizeClass(1025) == 1280)
+  for n in [100, 4097, 70_000, 1 << 20, (3 << 20) + 1] {
+    let c = MemoryPool.sizeClass(n)
+    #expect(c >= n)
+    #expect(c % Memory.alignment == 0)
+    #expect(Double(c) <= Double(n) * 1.25 + 64)
+  }
+}
+
+@Test
+func blockReturnsToPoolOnLastReferenceAndIsReused() {
+  let pool = MemoryPool(deviceKey: "test:\(UUID())", environment: [:])
+  var first: Data? = pool.makeData(byteCount: 1000)
+  var alias = first
+  #expect(pool.stats.liveBytes == 1024)
+  first = nil
+  #expect(pool.stats.liveBytes == 1024)  // `alias` still holds it
+  alias = nil
+  _ = alias
+  #expect(pool.stats.liveBytes == 0)
+  #expect(pool.stats.cachedBytes == 1024)
+
+  let again = pool.makeData(byteCount: 900)
+  let s = pool.stats
+  #expect(s.hits == 1 && s.misses == 1)
+  #expect(s.cachedBytes == 0)
+  #expect(s.peakLiveBytes == 1024)
+  #expect(again.allSatisfy { $0 == 0 })
+  again.withUnsafeBytes { #expect(Int(bitPattern: $0.baseAddress) % Memory.alignment == 0) }
+}
+
+@Test
+func copiesContentAndTrimsAboveHighWater() {
+  let pool = MemoryPool(deviceKey: "test:\(UUID())", environment: ["X10_MEMORY_POOL_MAX_CACHED": "2048"])
+  let source = Data((0..<300).map { UInt8($0 & 0xff) })
+  var blocks: [Data] = (0..<4).map { _ in pool.makeData(copying: source) }
+  #expect(blocks[2] == source)
+  blocks.removeAll()
+  // 4 x 320-byte blocks: all fit under the 2 KiB cap.
+  #expect(pool.stats.cachedBytes == 4 * 320)
+
+  var big: Data? = pool.makeData(byteCount: 4096)
+  big = nil
+  _ = big
+  #expect(pool.stats.cachedBytes == 4 * 320)  // over the cap, freed instead of cached
+
+  pool.trim(toCachedBytes: 640)
+  #expect(pool.stats.cachedBytes == 640)
+  pool.trim()
+  #expect(pool.stats.cachedBytes == 0)
+}
+
+@Test
+func poolsArePerDevice() {
+  let a = Memory.pool(for: "test-a:0")
+  let b = Memory.pool(for: "test-b:0")
+  #expect(a !== b)
+  #expect(Memory.pool(for: "test-a:0") === a)
+  let held = b.makeData(byteCount: 64)
+  #expect(Memory.stats()["test-b:0"]?.liveBytes == 64)
+  #expect(held.count == 64)
+}
@@ -0,0 +1,94 @@
+import Testing
+import Foundation
+import x10Diagnostics
+
+@Test
+func concurrentIncrementsAreNotLost() async {
+  let counter = Counter("test_concurrent_increments_\(UUID().uuidString.prefix(8))")
+  await withTaskGroup(of: Void.self) { group in
+    for _ in 0..<8 {
+      group.addTask {
+        for _ in 0..<10_000 { counter.inc() }
+      }
+    }
+  }
+  #expect(counter.value == 80_000)
+}
+
+@Test
+func histogramQuantilesStayWithinBucketError() {
+  let h = Histogram("test_latency_ns_\(UUID().uuidString.prefix(8))", unit: .nanoseconds)
+  for v in 1...10_000 { h.record(UInt64(v) * 1_000) }
+
+  let snap = h.snapshot()
+  #expect(snap.count == 10_000)
+  #expect(snap.min == 1_000)
+  #expect(snap.max == 10_000_000)
+  // Log-linear buckets with 16 sub-buckets: <= 1/16 relative error.
+  #expect(abs(Double(snap.p50) - 5_000_000) / 5_000_000 < 1.0 / 16)
+  #expect(abs(Double(snap.p99) - 9_900_000) / 9_900_000 < 1.0 / 16)
+}
+
+@Test
+func exportsPrometheusTextAndJSON() throws {
+  Diagnostics.compileLatency.record(1_500)
+  let text = Metrics.prometheusText()
+  #expect(text.contains("# TYPE x10_uncached_compiles_total counter"))
+  #expect(text.contains("# TYPE x10_compile_latency_ns histogram"))
+  #expect(text.contains("x10_compile_latency_ns_bucket{le=\"+Inf\"}"))
+
+  let snapshot = try JSONDecoder().decode(MetricsSnapshot.self, from: Metrics.jsonSnapshot())
+  #expect(snapshot.counters["uncached_compiles"] != nil)
+  #expect((snapshot.histograms["compile_latency_ns"]?.count ?? 0) >= 1)
+
+  let notFound = MetricsEndpoint.response(forRequestLine: "GET /nope HTTP/1.1")
+  #expect(notFound.status.hasPrefix("404"))
+}
+
+@Test
+func hotPathOverheadIsMeasuredInNanoseconds() {
+  let counter = Counter("test_overhead_counter_\(UUID().uuidString.prefix(8))")
+  let h = Histogram("test_overhead_hist_\(UUID().uuidString.prefix(8))", unit: .nanoseconds)
+  let iterations: UInt64 = 200_000
+
+  let c0 = Metrics.nowNanos()
+  for _ in 0..<iterations { counter.inc() }
+  let counterNs = Double(Metrics.nowNanos() - c0) / Double(iterations)
+
+  let h0 = Metrics.nowNanos()
+  for i in 0..<iterations { h.record(i) }
+  let histNs = Double(Metrics.nowNanos() - h0) / Double(iterations)
+
+  // Generous bounds so debug builds on shared CI stay green.
+  #expect(counterNs < 1_000)
+  #expect(histNs < 2_000)
+}
+
+@Test
+func histogramShardsMergeAcrossThreads() async {
+  let h = Histogram("test_sharded_hist_\(UUID().uuidString.prefix(8))", unit: .bytes)
+  await withTaskGroup(of: Void.self) { group in
+    for t in 0..<8 {
+      group.addTask {
+        for v in 1...1_000 { h.record(UInt64(t * 1_000 + v)) }
+      }
+    }
+  }
+  let snap = h.snapshot()
+  #expect(snap.count == 8_000)
+  #expect(snap.sum == (1...8_000).reduce(0) { $0 + UInt64($1) })
+  #expect(snap.min == 1)
+  #expect(snap.max == 8_000)
+  #expect(snap.buckets.reduce(0) { $0 + $1.count } == 8_000)
+}
+
+@Test
+func droppedMetricsLeaveTheRegistry() throws {
+  let name = "test_dropped_\(UUID().uuidString.prefix(8))"
+  do {
+    let counter = Counter(name)
+    counter.inc()
+    #expect(Metrics.snapshot().counters[name] == 1)
+  }
+  #expect(Metrics.snapshot().counters[name] == nil)
+}
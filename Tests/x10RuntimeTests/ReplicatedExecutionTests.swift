@@ -0,0 +1,147 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+
+/// Four host "devices"; execute doubles f32 input 0 after a fixed delay that
+/// stands in for device time.
+private struct FourDeviceBackend: Backend {
+  struct Dev: Hashable, Sendable, OrdinalDevice { let ordinal: Int }
+  struct HostBuffer: Buffer { let device: Int; let bytes: [UInt8] }
+
+  final class Counter: @unchecked Sendable {
+    private let lock = NSLock()
+    private var compiles = 0
+    private var devicesSeen: Set<Int> = []
+    func compiled() { lock.lock(); compiles += 1; lock.unlock() }
+    func ran(on d: Int) { lock.lock(); devicesSeen.insert(d); lock.unlock() }
+    var snapshot: (Int, Set<Int>) { lock.lock(); defer { lock.unlock() }; return (compiles, devicesSeen) }
+  }
+  let counter = Counter()
+  var delayNanos: UInt64 = 0
+  /// Device whose execute throws, if any.
+  var failing: Int?
+
+  func devices() throws -> [Dev] { (0..<4).map(Dev.init) }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { HostBuffer(device: on.ordinal, bytes: []) }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
+    HostBuffer(device: on.ordinal, bytes: Array(host))
+  }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { (buffer as! HostBuffer).bytes }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable {
+    counter.compiled()
+    return Executable()
+  }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] {
+    struct DeviceLost: Error {}
+    let x = inputs[0] as! HostBuffer
+    counter.ran(on: x.device)
+    if x.device == failing { throw DeviceLost() }
+    if delayNanos > 0 { try await Task.sleep(nanoseconds: delayNanos) }
+    let doubled = x.bytes.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }.map { $0 * 2 }
+    return [HostBuffer(device: x.device, bytes: doubled.withUnsafeBytes { Array($0) })]
+  }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+}
+
+private func doubleModule(rows: Int, tag: String) -> StableHLOModule {
+  let fn = IRBuilder().function(name: "replica_\(tag)", args: [("x", [rows, 2], .f32)], results: [("r", [rows, 2], .f32)]) { f in
+    f.parameter(0, into: f.args[0])
+    f.add(f.args[0], f.args[0], into: f.results[0])
+    f.returnValues([f.results[0]])
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+private func floats(_ d: Data) -> [Float] { d.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) } }
+
+@Test
+func shardsRunOnEveryDeviceWithOneCompile() async throws {
+  let be = FourDeviceBackend()
+  let replicated = try ReplicatedExecution(backend: be)
+  let global = (0..<16).map(Float.init)   // f32[8, 2], 2 rows per replica
+  let input = ReplicatedInput(global.withUnsafeBytes { Data($0) }, shape: [8, 2], dtype: .f32)
+
+  let outs = try await replicated.run(doubleModule(rows: 2, tag: "gather"), inputs: [input],
+                                      combine: [.concatenate])
+  #expect(floats(outs[0]) == global.map { $0 * 2 })
+
+  let (compiles, devices) = be.counter.snapshot
+  #expect(compiles == 1)
+  #expect(devices == [0, 1, 2, 3])
+}
+
+@Test
+func collectiveMembersAreKeyedByDeviceOrdinal() throws {
+  let replicated = try ReplicatedExecution(backend: FourDeviceBackend(), devices: [.init(ordinal: 2), .init(ordinal: 3)])
+  #expect(replicated.members == ["unknown:2", "unknown:3"])
+}
+
+@Test
+func reduceAndSingleReplicaCombines() async throws {
+  let replicated = try ReplicatedExecution(backend: FourDeviceBackend())
+  let global = (0..<8).map(Float.init)    // f32[4, 2], one row each
+  let input = ReplicatedInput(global.withUnsafeBytes { Data($0) }, shape: [4, 2], dtype: .f32)
+  let module = doubleModule(rows: 1, tag: "reduce")
+
+  let summed = try await replicated.run(module, inputs: [input], combine: [.reduce(.sum)])
+  #expect(floats(summed[0]) == [2 * (0 + 2 + 4 + 6), 2 * (1 + 3 + 5 + 7)])
+
+  let third = try await replicated.run(module, inputs: [input], combine: [.replica(2)])
+  #expect(floats(third[0]) == [8, 10])
+
+  await #expect(throws: ReplicationError.self) {
+    _ = try await replicated.run(module, inputs: [ReplicatedInput(Data(count: 24), shape: [3, 2], dtype: .f32)],
+                                 combine: [.concatenate])
+  }
+}
+
+@Test
+func replicasRunConcurrently() async throws {
+  var be = FourDeviceBackend()
+  be.delayNanos = 50_000_000
+  let replicated = try ReplicatedExecution(backend: be)
+  let input = ReplicatedInput(Data(count: 4 * 2 * 4), shape: [4, 2], dtype: .f32)
+  let module = doubleModule(rows: 1, tag: "overlap")
+  _ = try await replicated.run(module, inputs: [input], combine: [.concatenate])  // compile outside the timing
+
+  let start = DispatchTime.now().uptimeNanoseconds
+  _ = try await replicated.run(module, inputs: [input], combine: [.concatenate])
+  let elapsed = DispatchTime.now().uptimeNanoseconds - start
+  // Serial would be 4 x 50 ms.
+  #expect(elapsed < 150_000_000)
+}
+
+@Test
+func concurrentRunsKeepTheirReductionsApart() async throws {
+  let replicated = try ReplicatedExecution(backend: FourDeviceBackend())
+  let module = doubleModule(rows: 1, tag: "concurrent")
+  let sums = try await withThrowingTaskGroup(of: (Int, [Float]).self) { tasks in
+    for k in 0..<8 {
+      tasks.addTask {
+        let input = ReplicatedInput([Float](repeating: Float(k), count: 8).withUnsafeBytes { Data($0) },
+                                    shape: [4, 2], dtype: .f32)
+        let out = try await replicated.run(module, inputs: [input], combine: [.reduce(.sum)])
+        return (k, floats(out[0]))
+      }
+    }
+    var byRun: [Int: [Float]] = [:]
+    for try await (k, sum) in tasks { byRun[k] = sum }
+    return byRun
+  }
+  for k in 0..<8 { #expect(sums[k] == [Float(8 * k), Float(8 * k)]) }
+}
+
+@Test
+func aFailingReplicaDoesNotStrandItsPeers() async throws {
+  var be = FourDeviceBackend()
+  be.failing = 2
+  let replicated = try ReplicatedExecution(backend: be)
+  let input = ReplicatedInput(Data(count: 4 * 2 * 4), shape: [4, 2], dtype: .f32)
+  // Replicas 0, 1 and 3 reach the all-reduce; replica 2 never does.
+  await #expect(throws: (any Error).self) {
+    _ = try await replicated.run(doubleModule(rows: 1, tag: "failing"), inputs: [input], combine: [.reduce(.sum)])
+  }
+}
@@ -0,0 +1,113 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+import x10Diagnostics
+
+private final class CompileLog: @unchecked Sendable {
+  private let lock = NSLock()
+  private var shapes: [[Int]] = []
+  func append(_ shape: [Int]) { lock.lock(); shapes.append(shape); lock.unlock() }
+  var all: [[Int]] { lock.lock(); defer { lock.unlock() }; return shapes }
+}
+
+private struct PrewarmBackend: Backend {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+  let log: CompileLog
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { StubBuffer() }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer { StubBuffer() }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { [] }
+
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable {
+    log.append(options.shapeHint ?? [])
+    return Executable()
+  }
+
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] { inputs }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+
+  private struct StubBuffer: Buffer {}
+}
+
+private func prewarmModule() -> StableHLOModule {
+  let builder = IRBuilder()
+  let fn = builder.function(
+    name: "prewarm_main",
+    args: [("a", [nil], .f32)],
+    results: [("r", [nil], .f32)]
+  ) { f in
+    let a = f.args[0], r = f.results[0]
+    f.parameter(0, into: a)
+    f.returnValues([r])
+  }
+  return StableHLOModule(functions: [fn])
+}
+
+@Test
+func persistedProfilePrewarmsHottestShapesFirst() async throws {
+  let dir = FileManager.default.temporaryDirectory
+    .appendingPathComponent("x10-profiles-\(UUID().uuidString)", isDirectory: true)
+  defer { try? FileManager.default.removeItem(at: dir) }
+
+  let module = prewarmModule()
+  let options = CompileOptions(device: .cpu(0), flags: ["test": "prewarm"])
+  let log = CompileLog()
+  let backend = PrewarmBackend(log: log)
+  let (_, irHash) = JIT.cacheKey(for: module, with: backend, options: options)
+
+  // "Previous deploy": record traffic and snapshot it.
+  let recorder = ShapeProfiler()
+  for shape in [[8], [16], [16], [32], [32], [32]] {
+    await recorder.note(irHash: irHash, policy: .default, concreteShape: shape)
+  }
+  try await recorder.persist(irHash: irHash, directory: dir)
+  let snapshot = try #require(ShapeProfileStore.read(irHash: irHash, from: dir))
+  #expect(snapshot.entries.first?.shapes.map(\.shape) == [[32], [16], [8]])
+
+  // "Startup": warm the two hottest shapes before any traffic.
+  await ExecutableCache.shared.clear()
+  let warmer = CacheWarmer(capacity: 8)
+  let queued = await warmer.prewarm(
+    module: module, backend: backend, options: options, topK: 2, profileDirectory: dir)
+  #expect(queued == 2)
+  await warmer.waitUntilIdle()
+
+  let progress = await warmer.progress()
+  #expect(progress.completed == 2)
+  #expect(progress.isIdle)
+  #expect(log.all == [[32], [16]])
+
+  var hinted = options
+  hinted.shapeHint = [32]
+  _ = try await JIT.compileCached(module, with: backend, options: hinted)
+  #expect(log.all.count == 2)
+  #expect(Diagnostics.warmedHits.value >= 1)
+}
+
+@Test
+func prewarmQueueDropsColdestWhenFull() async throws {
+  let dir = FileManager.default.temporaryDirectory
+    .appendingPathComponent("x10-profiles-\(UUID().uuidString)", isDirectory: true)
+  defer { try? FileManager.default.removeItem(at: dir) }
+
+  let module = prewarmModule()
+  let options = CompileOptions(device: .cpu(0), flags: ["test": "prewarm-bounded"])
+  let backend = PrewarmBackend(log: CompileLog())
+  let (_, irHash) = JIT.cacheKey(for: module, with: backend, options: options)
+
+  let snapshot = ShapeProfileSnapshot(irHash: irHash, entries: [
+    .init(policy: .default, shapes: (1...4).map { .init(shape: [$0], count: Double($0)) })
+  ])
+  try ShapeProfileStore.write(snapshot, to: dir)
+
+  let warmer = CacheWarmer(capacity: 1)
+  _ = await warmer.prewarm(module: module, backend: backend, options: options, topK: 4, profileDirectory: dir)
+  await warmer.waitUntilIdle()
+  let progress = await warmer.progress()
+  #expect(progress.completed + progress.dropped == 4)
+  #expect(progress.pending == 0)
+}
@@ -0,0 +1,73 @@
+import Testing
+import Foundation
+@testable import x10Runtime
+
+private final class ManualClock: @unchecked Sendable {
+  private let lock = NSLock()
+  private var t = 0.0
+  func advance(_ dt: Double) { lock.lock(); t += dt; lock.unlock() }
+  var now: Double { lock.lock(); defer { lock.unlock() }; return t }
+}
+
+@Test
+func profilerMemoryStaysBoundedUnderLongTail() async {
+  let profiler = ShapeProfiler(sketchCapacity: 8, maxSketches: 2, halfLifeSeconds: 0)
+  for i in 0..<10_000 {
+    await profiler.note(irHash: "h", policy: .default, concreteShape: [1 + i])
+    if i % 4 == 0 {
+      await profiler.note(irHash: "h", policy: .default, concreteShape: [0])
+    }
+  }
+
+  let usage = await profiler.memoryUsage()
+  #expect(usage.sketches == 1)
+  #expect(usage.trackedShapes == 8)
+  #expect(await profiler.topK(irHash: "h", policy: .default, k: 1) == [[0]])
+
+  for h in ["a", "b", "c"] {
+    await profiler.note(irHash: h, policy: .default, concreteShape: [1])
+  }
+  #expect(await profiler.memoryUsage().sketches == 2)
+}
+
+@Test
+func staleShapesDecayBehindRecentOnes() async {
+  let clock = ManualClock()
+  let profiler = ShapeProfiler(sketchCapacity: 4, halfLifeSeconds: 10, clock: { clock.now })
+
+  for _ in 0..<100 { await profiler.note(irHash: "h", policy: .default, concreteShape: [128]) }
+  clock.advance(100)  // ten half-lives: 100 old hits weigh ~0.1
+  for _ in 0..<5 { await profiler.note(irHash: "h", policy: .default, concreteShape: [256]) }
+
+  let top = await profiler.topKWithCounts(irHash: "h", policy: .default, k: 2)
+  #expect(top.map(\.shape) == [[256], [128]])
+  #expect(abs(top[0].count - 5) < 1e-9)
+  #expect(abs(top[1].count - 100.0 / 1024) < 1e-9)
+}
+
+@Test
+func sketchRenormalizesWithoutChangingCounts() {
+  var sketch = HeavyHitterSketch(capacity: 2, halfLife: 1, now: 0)
+  sketch.add([1], now: 0)
+  sketch.add([2], now: 100)  // forces a rebase of the forward-decay landmark
+  let top = sketch.topK(2, now: 100)
+  #expect(top.map(\.shape) == [[2], [1]])
+  #expect(abs(top[0].count - 1) < 1e-9)
+  #expect(top[1].count < 1e-20)
+}
+
+@Test
+func sketchStaysSortedAcrossLongRunsOfTies() {
+  var sketch = HeavyHitterSketch(capacity: 64, halfLife: nil, now: 0)
+  for i in 0..<64 { sketch.add([i], now: 0) }
+  // Every counter ties at 1; bumping the last one jumps the whole run.
+  sketch.add([63], now: 0)
+  sketch.add([10], weight: 3, now: 0)
+  sketch.add([63], now: 0)
+  let counts = sketch.counters.map(\.count)
+  #expect(counts == counts.sorted(by: >))
+  #expect(sketch.topK(2, now: 0).map(\.shape) == [[10], [63]])
+  // Later adds still find each shape's slot.
+  sketch.add([0], weight: 10, now: 0)
+  #expect(sketch.topK(1, now: 0).map(\.shape) == [[0]])
+}
@@ -0,0 +1,193 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+
+/// Ordered log: every entry gets the next sequence number, so tests compare
+/// positions instead of wall-clock times.
+private final class StepLog: @unchecked Sendable {
+  private let lock = NSLock()
+  private var entries: [String] = []
+
+  func add(_ name: String) {
+    lock.lock(); entries.append(name); lock.unlock()
+  }
+
+  /// Position of `name` in the log, nil if it never happened.
+  func position(_ name: String) -> Int? {
+    lock.lock(); defer { lock.unlock() }
+    return entries.firstIndex(of: name)
+  }
+
+  var all: [String] {
+    lock.lock(); defer { lock.unlock() }
+    return entries
+  }
+}
+
+/// One-shot gate a test opens explicitly.
+private final class Gate: @unchecked Sendable {
+  private let lock = NSLock()
+  private var open = false
+  private var waiters: [CheckedContinuation<Void, Never>] = []
+
+  func release() {
+    lock.lock()
+    open = true
+    let pending = waiters
+    waiters.removeAll()
+    lock.unlock()
+    pending.forEach { $0.resume() }
+  }
+
+  func wait() async {
+    await withCheckedContinuation { (c: CheckedContinuation<Void, Never>) in
+      lock.lock()
+      if open {
+        lock.unlock()
+        c.resume()
+      } else {
+        waiters.append(c)
+        lock.unlock()
+      }
+    }
+  }
+}
+
+/// Execution of step i does not finish until the upload for step i + 1 has
+/// started, so the test only completes if the copy stream runs ahead of the
+/// compute stream.
+private struct GatedBackend: Backend {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+  struct B: Buffer {}
+  let log: StepLog
+  let uploadStarted: [Gate]
+
+  private final class Tally: @unchecked Sendable {
+    private let lock = NSLock()
+    private var uploads = 0, runs = 0
+    func nextUpload() -> Int { lock.lock(); defer { lock.unlock() }; uploads += 1; return uploads - 1 }
+    func nextRun() -> Int { lock.lock(); defer { lock.unlock() }; runs += 1; return runs - 1 }
+  }
+  private let counter = Tally()
+
+  init(log: StepLog, steps: Int) {
+    self.log = log
+    self.uploadStarted = (0..<steps).map { _ in Gate() }
+  }
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { B() }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer {
+    let i = counter.nextUpload()
+    log.add("h2d\(i)")
+    uploadStarted[i].release()
+    log.add("h2d\(i)-done")
+    return B()
+  }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { [] }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable { Executable() }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] {
+    let i = counter.nextRun()
+    log.add("exec\(i)")
+    if i + 1 < uploadStarted.count { await uploadStarted[i + 1].wait() }
+    log.add("exec\(i)-done")
+    return inputs
+  }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+}
+
+@Test
+func uploadForNextStepOverlapsCurrentCompute() async throws {
+  let log = StepLog()
+  let steps = 4
+  let be = GatedBackend(log: log, steps: steps)
+  let copy = try be.stream(device: .init(ordinal: 0))
+  let compute = try be.stream(device: .init(ordinal: 0))
+  let exec = Executable()
+
+  for _ in 0..<steps {
+    let x = be.enqueueToDevice(Data(count: 64), shape: [16], dtype: .f32, on: .init(ordinal: 0), stream: copy)
+    compute.wait(for: copy.record())
+    be.enqueueExecute(exec, inputs: [x], stream: compute)
+  }
+  try await compute.synchronize()
+
+  for i in 0..<steps {
+    // Each step computes only after its own upload finished...
+    let uploaded = try #require(log.position("h2d\(i)-done"))
+    let ran = try #require(log.position("exec\(i)"))
+    #expect(ran > uploaded)
+    // ...while the next upload starts before it ends.
+    if i + 1 < steps {
+      let next = try #require(log.position("h2d\(i + 1)"))
+      let finished = try #require(log.position("exec\(i)-done"))
+      #expect(next < finished)
+    }
+  }
+}
+
+@Test
+func streamRunsInOrderAndFailureIsSticky() async throws {
+  struct Boom: Error {}
+  let s = Stream(label: "test")
+  let log = StepLog()
+  let gate = Gate()
+  // The first item holds the stream until everything is enqueued.
+  s.enqueue {
+    await gate.wait()
+    log.add("step0")
+  }
+  for i in 1..<5 {
+    s.enqueue { log.add("step\(i)") }
+  }
+  let failed = s.enqueue { () throws -> Int in throw Boom() }
+  let skipped = s.enqueue { log.add("after") }
+  gate.release()
+
+  await #expect(throws: Boom.self) { try await failed.value }
+  await #expect(throws: Boom.self) { try await skipped.value }
+  await #expect(throws: Boom.self) { try await s.synchronize() }
+  #expect(log.all == (0..<5).map { "step\($0)" })
+}
+
+@Test
+func eventGatesAnotherStream() async throws {
+  let producer = Stream(label: "producer"), consumer = Stream(label: "consumer")
+  let log = StepLog()
+  let gate = Gate()
+  producer.enqueue {
+    await gate.wait()
+    log.add("produce")
+  }
+  let done = producer.record()
+  #expect(!done.isComplete)
+  consumer.wait(for: done)
+  consumer.enqueue { log.add("consume") }
+  gate.release()
+  try await consumer.synchronize()
+  #expect(done.isComplete)
+  #expect(log.all == ["produce", "consume"])
+}
+
+@Test
+func eventsRecordedOnAFailedStreamRethrow() async throws {
+  struct Boom: Error {}
+  let producer = Stream(label: "producer"), consumer = Stream(label: "consumer")
+  producer.enqueue { () throws -> Void in throw Boom() }
+  let done = producer.record()
+  await #expect(throws: Boom.self) { try await done.wait() }
+  #expect(done.isComplete)
+
+  // A stream waiting on it fails too instead of hanging.
+  let log = StepLog()
+  consumer.wait(for: done)
+  consumer.enqueue { log.add("consume") }
+  await #expect(throws: Boom.self) { try await consumer.synchronize() }
+  #expect(log.all.isEmpty)
+
+  // Recording after the failure fires as well.
+  await #expect(throws: Boom.self) { try await producer.record().wait() }
+}
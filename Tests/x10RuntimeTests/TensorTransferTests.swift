@@ -0,0 +1,39 @@
+import Testing
+import Foundation
+import x10Core
+import x10Runtime
+
+/// Keeps uploads as host bytes; only implements the raw `fromDevice`.
+private struct HostBackend: Backend {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+  struct B: Buffer { let bytes: [UInt8] }
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { B(bytes: []) }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer { B(bytes: Array(host)) }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { (buffer as? B)?.bytes ?? [] }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable { Executable() }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] { inputs }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+}
+
+@Test
+func tensorsRoundTripThroughABackend() throws {
+  let be = HostBackend()
+  let t = Tensor<Float>(shape: [2, 2], scalars: [1, 2, 3, 4])
+  let buffer = try be.toDevice(t, on: HostBackend.Dev(ordinal: 0))
+  let back: Tensor<Float> = try be.tensor(from: buffer, shape: [2, 2])
+  #expect(back.scalars == [1, 2, 3, 4])
+  #expect(Int(bitPattern: back.storage.data) % TensorStorage.alignment == 0)
+
+  #expect(throws: TensorTransferError.self) { try be.tensor(from: buffer, shape: [3, 2], as: Float.self) }
+}
+
+@Test
+func materializeHostReturnsTheTensorBytes() async throws {
+  let t = Tensor<Int32>(shape: [3], scalars: [5, 6, 7])
+  let data = try await t.materializeHost()
+  #expect(data.withUnsafeBytes { Array($0.bindMemory(to: Int32.self)) } == [5, 6, 7])
+}
@@ -0,0 +1,60 @@
+import Testing
+import Foundation
+@testable import x10Core
+@testable import x10Runtime
+import x10Diagnostics
+
+private struct TracedBackend: Backend {
+  struct Dev: Hashable, Sendable { let ordinal: Int }
+
+  func devices() throws -> [Dev] { [Dev(ordinal: 0)] }
+  func allocate(shape: [Int], dtype: DType, on: Dev) throws -> Buffer { StubBuffer() }
+  func toDevice(_ host: UnsafeRawBufferPointer, shape: [Int], dtype: DType, on: Dev) throws -> Buffer { StubBuffer() }
+  func fromDevice(_ buffer: Buffer) throws -> [UInt8] { [] }
+  func compile(stablehlo: StableHLOModule, options: CompileOptions) throws -> Executable { Executable() }
+  func execute(_ exec: Executable, inputs: [Buffer], stream: Stream?) async throws -> [Buffer] { inputs }
+  func allReduce(_ b: Buffer, op: ReduceOp, group: CollectiveGroup) async throws -> Buffer { b }
+  func stream(device: Dev) throws -> Stream { Stream() }
+  func event(device: Dev) throws -> Event { Event() }
+
+  private struct StubBuffer: Buffer {}
+}
+
+private struct ChromeTrace: Decodable {
+  struct Event: Decodable {
+    let name: String
+    let ph: String
+    let ts: Double
+    let dur: Double
+  }
+  let traceEvents: [Event]
+}
+
+@Test
+func compileSpansLandInChromeTraceDump() async throws {
+  let builder = IRBuilder()
+  let fn = builder.function(
+    name: "traced_main",
+    args: [("a", [4], .f32)],
+    results: [("r", [4], .f32)]
+  ) { f in
+    f.parameter(0, into: f.args[0])
+    f.returnValues([f.results[0]])
+  }
+  let module = StableHLOModule(functions: [fn])
+  let options = CompileOptions(flags: ["trace": UUID().uuidString])
+
+  Trace.enable()
+  defer { Trace.disable() }
+  _ = try await JIT.compileCached(module, with: TracedBackend(), options: options)
+
+  let url = FileManager.default.temporaryDirectory
+    .appendingPathComponent("x10-trace-\(UUID().uuidString).json")
+  defer { try? FileManager.default.removeItem(at: url) }
+  try Trace.dump(to: url)
+
+  let trace = try JSONDecoder().decode(ChromeTrace.self, from: Data(contentsOf: url))
+  let names = Set(trace.traceEvents.map(\.name))
+  #expect(names.isSuperset(of: ["JIT.compileCached", "JIT.cacheKey", "ExecutableCache.lookup", "Backend.compile"]))
+  #expect(trace.traceEvents.allSatisfy { $0.ph == "X" && $0.dur >= 0 })
+}
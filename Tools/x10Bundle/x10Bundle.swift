@@ -0,0 +1,94 @@
+import Foundation
+import x10Core
+import x10Runtime
+import x10BackendsIREE
+
+/// x10Bundle — compiles StableHLO modules ahead of time into one
+/// `IREEBundle` for hosts without iree-compile.
+///
+///   swift run x10Bundle MANIFEST.json -o OUT.x10bundle
+///
+/// The manifest lists module text files (e.g. the `.stablehlo` dumps written
+/// under X10_DEBUG_IR=1) with the shapes and options they will run with:
+///
+///   { "modules": [ { "ir": "add.stablehlo", "shapes": [[2, 3], [8, 3]],
+///                    "device": "cpu:0", "flags": { "iree_target": "llvm-cpu" } } ] }
+///
+/// `shapes` are concrete shapes of the first argument, one compile each;
+/// text modules carry no signature, so at least one is required. `ir` paths
+/// are relative to the manifest. Modules are compiled with portable flags,
+/// never this host's tuned ones; an optional `"compileFlags": ["--flag", …]`
+/// replaces them. Load the result with
+/// `IREEBundle(contentsOf:).install()`.
+@main
+struct X10Bundle {
+  struct Manifest: Decodable {
+    struct Module: Decodable {
+      var ir: String
+      var shapes: [[Int]]
+      var device: String?
+      var flags: [String: String]?
+      var compileFlags: [String]?
+    }
+    var modules: [Module]
+  }
+
+  static func main() {
+    var manifestPath: String?
+    var outPath: String?
+    var args = CommandLine.arguments.dropFirst().makeIterator()
+    while let arg = args.next() {
+      switch arg {
+      case "-o", "--out": outPath = args.next()
+      default:
+        guard manifestPath == nil, !arg.hasPrefix("-") else { fail("unknown argument: \(arg)", code: 2) }
+        manifestPath = arg
+      }
+    }
+    guard let manifestPath, let outPath else { fail("usage: x10Bundle MANIFEST.json -o OUT.x10bundle", code: 2) }
+
+    do {
+      let manifestURL = URL(fileURLWithPath: manifestPath)
+      let manifest = try JSONDecoder().decode(Manifest.self, from: Data(contentsOf: manifestURL))
+      var builder = IREEBundleBuilder()
+      for m in manifest.modules {
+        guard !m.shapes.isEmpty else { fail("\(m.ir): no shapes given", code: 2) }
+        let irURL = URL(fileURLWithPath: m.ir, relativeTo: manifestURL.deletingLastPathComponent())
+        let module = StableHLOModule(text: try String(contentsOf: irURL, encoding: .utf8))
+        let options = CompileOptions(device: try m.device.map(parseDevice), flags: m.flags ?? [:])
+        try builder.add(module, shapes: m.shapes, options: options, flags: m.compileFlags)
+        print("compiled \(m.ir) for \(m.shapes.count) shape(s)")
+      }
+      let size = try builder.write(to: URL(fileURLWithPath: outPath))
+      print("wrote \(outPath): \(builder.entries.count) entries, \(size) bytes")
+    } catch {
+      fail("x10Bundle: \(error.localizedDescription)", code: 1)
+    }
+  }
+
+  /// "cpu:N" / "gpu:N", as in `Device.stableKey`.
+  static func parseDevice(_ key: String) throws -> Device {
+    let parts = key.split(separator: ":")
+    guard parts.count == 2, let n = Int(parts[1]) else { throw IREEBundleToolError.badDevice(key) }
+    switch parts[0] {
+    case "cpu": return .cpu(n)
+    case "gpu": return .gpu(n)
+    default: throw IREEBundleToolError.badDevice(key)
+    }
+  }
+
+  static func fail(_ message: String, code: Int32) -> Never {
+    FileHandle.standardError.write(Data("\(message)\n".utf8))
+    exit(code)
+  }
+}
+
+enum IREEBundleToolError: LocalizedError {
+  case badDevice(String)
+
+  var errorDescription: String? {
+    switch self {
+    case .badDevice(let key): return "bad device \"\(key)\" (expected cpu:N or gpu:N)"
+    }
+  }
+}